@@ -0,0 +1,25 @@
+// batch mode: convert many colors at once
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "converter.h"
+#include "types.h"
+
+// print n packed 0xrrggbb colors in opts->format:
+// lines or a json array (-j) converted to opts->conversion (hex if unset), csv, raw rgb bytes or a c array
+void batch_print(const uint32_t *rgb, size_t n, const prog_opts_t *opts);
+
+// graph model of a -c conversion that prints numbers (cmyk, hsl, hsv, oklab, oklch), false for rgb, hex and named
+bool conversion_model(const char *conversion, cv_model_t *m);
+
+// print n colors given as float columns of model m (see conversion_model) as lines or a json array (-j)
+// like batch_print, without going through 8-bit rgb
+void batch_print_f32(cv_model_t m, const float *const *cols, size_t n, const prog_opts_t *opts);
+
+// read colors (one per line) from opts->batch, optionally dedupe / sort them and print
+// each one in opts->format (see batch_print)
+//
+// returns the process exit code
+int run_batch(const prog_opts_t *opts, const char *progname);
+
+#endif
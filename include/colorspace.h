@@ -0,0 +1,56 @@
+// wide-gamut rgb spaces (display p3, rec. 2020, linear srgb), cie xyz and cielab / lch as in css color 4
+//
+// xyz is relative to d65 throughout, lab and lch to d50 (bradford adapted) like css lab() / lch()
+// the rgb <-> xyz matrices are derived from the primaries offline and stored precomposed (see src/colorspace.c)
+#ifndef COLORSPACE_H
+#define COLORSPACE_H
+
+#include "types.h"
+
+// colors per thread chunk of rgbspace_rgb8_to_srgb8
+#define RGBSPACE_CHUNK 16384
+
+// default luminance in cd/m2 of srgb white (linear 1.0) in the hdr spaces, the itu-r bt.2408 reference white
+#define SDR_WHITE_DEFAULT 203.0
+
+// luminance srgb white is placed at when converting from and to the hdr spaces (rec2100-pq, rec2100-hlg)
+void   set_sdr_white(double nits);
+double get_sdr_white();
+
+// css name of a space ("srgb", "srgb-linear", "display-p3", "rec2020")
+const char *rgbspace_name(rgbspace_t s);
+
+// space of a css name ("p3", "pq" and "hlg" are accepted for "display-p3", "rec2100-pq" and "rec2100-hlg"), false if unknown
+bool rgbspace_from_name(const char *name, rgbspace_t *s);
+
+// encoded rgb of space s (nominally 0..1, values outside are extended like css does) <-> xyz
+xyz_t rgbspace_to_xyz(rgbspace_t s, const double rgb[3]);
+void  xyz_to_rgbspace(rgbspace_t s, const xyz_t *xyz, double rgb[3]);
+
+// bradford chromatic adaptation between the d65 and d50 white points
+xyz_t xyz_d65_to_d50(const xyz_t *xyz);
+xyz_t xyz_d50_to_d65(const xyz_t *xyz);
+
+// cielab / lch relative to d50 from and to xyz (d65)
+lab_t xyz_to_lab_d50(const xyz_t *xyz);
+xyz_t lab_d50_to_xyz(const lab_t *lab);
+lch_t lab_to_lch(const lab_t *lab);
+lab_t lch_to_lab(const lch_t *lch);
+
+// xyz of the models color_t keeps (oklab is not clipped to srgb on the way)
+xyz_t   rgb_to_xyz(const rgb_t *rgb);
+xyz_t   oklab_to_xyz(const oklab_t *oklab);
+oklab_t xyz_to_oklab(const xyz_t *xyz);
+
+// convert n packed 0xrrggbb colors encoded in space s to srgb in chunks spread over threads,
+// one rgb8_mat3_gamut pass with a precomposed matrix, then only the out-of-gamut colors are clipped or gamut mapped
+// (same algorithm as oklab_to_rgb), in and out may be the same array
+//
+// returns the number of colors that were out of the srgb gamut
+size_t rgbspace_rgb8_to_srgb8(rgbspace_t s, gamut_t mode, const uint32_t *in, size_t n, uint32_t *out);
+
+// same for n colors of 3 interleaved samples in 0..maxval (1..65535, e.g. 10-bit frames), which are decoded through a
+// table with one entry per code value (built on first use for this space and maxval), in and out must not overlap
+size_t rgbspace_rgb16_to_srgb8(rgbspace_t s, gamut_t mode, unsigned maxval, const uint16_t *in, size_t n, uint32_t *out);
+
+#endif
@@ -0,0 +1,29 @@
+// alpha compositing of translucent colors onto opaque backdrops: porter-duff source-over with the blend modes of
+// w3c compositing and blending level 1, on gamma-encoded srgb like css does or in linear light
+//
+// with an opaque backdrop b, a source c of opacity a gives (1 - a) * b + a * B(b, c) per channel, where B is the blend
+// mode (normal: B(b, c) = c), so the result is opaque aswell
+#ifndef COMPOSITE_H
+#define COMPOSITE_H
+
+#include "types.h"
+
+// colors per thread chunk of composite_rgb8
+#define COMPOSITE_CHUNK 16384
+
+// css name of a blend mode ("normal", "multiply", ..., "color-dodge", ..., "luminosity")
+const char *blend_name(blend_t mode);
+
+// blend mode of a css name, false if unknown
+bool blend_from_name(const char *name, blend_t *mode);
+
+// src with opacity alpha (0..1, clamped) over the opaque dst, rounded to 8 bits
+rgb_t composite_over(const rgb_t *src, double alpha, const rgb_t *dst, blend_t mode, bool linear);
+
+// n packed 0xrrggbb colors with 8-bit opacities over the backdrops bg[i * bgstep] (bgstep 0: one backdrop for all) in
+// chunks spread over threads, normal blending through the rgba8_over_rgb8 kernel and the other modes per color with
+// composite_over (same results, up to float rounding in linear light), rgb and out may be the same array
+void composite_rgb8(const uint32_t *rgb, const uint8_t *alpha, const uint32_t *bg, size_t bgstep, size_t n,
+                    blend_t mode, bool linear, uint32_t *out);
+
+#endif
@@ -0,0 +1,76 @@
+// contrast mode: wcag contrast solver and palette contrast matrix
+#ifndef CONTRAST_H
+#define CONTRAST_H
+
+#include "types.h"
+
+// wcag 2 success criteria 1.4.3 / 1.4.6 minimum ratios
+#define WCAG_AA_LARGE 3.0
+#define WCAG_AA       4.5
+#define WCAG_AAA      7.0
+
+// apca (wcag 3 draft) minimum |Lc| levels: large / non-body text, body text, fluent body text
+#define APCA_LC_LARGE  60.0
+#define APCA_LC_BODY   75.0
+#define APCA_LC_FLUENT 90.0
+
+// number of per-color double columns used by contrast_rows (see contrast_columns)
+#define CONTRAST_COLS(_m) ((_m) == CONTRAST_APCA ? 5 : 1)
+
+// rows of the contrast matrix computed (and held in memory) at once, memory use is CMATRIX_BAND_ROWS * n doubles (twice that
+// for apca)
+#define CMATRIX_BAND_ROWS 256
+
+// result of fixing one foreground color
+typedef struct {
+    hex_t  hex;      // fixed foreground (the input itself if it already met the target)
+    double contrast; // wcag ratio or apca Lc (signed) of hex against the background
+    double delta;    // deltaEOK (not squared) between the input and hex
+    bool   met;      // does the contrast (|Lc| for apca) reach the target? (false only if neither black nor white do)
+} contrast_fix_t;
+
+// wcag contrast ratio between two relative luminances (order does not matter), 1..21
+double contrast_ratio(double la, double lb);
+
+// apca-w3 0.0.98G-4g screen luminance of an 8-bit color, soft black clamp included ((c / 255)^2.4 from a lookup table)
+double apca_y(const rgb_t *rgb);
+
+// apca lightness contrast Lc of text on a background from their apca_y, about -108..106,
+// positive for dark text on a light background and negative for light text on a dark one
+double apca_lc(double ytxt, double ybg);
+
+// apca Lc of txt on bg
+double apca_contrast(const rgb_t *txt, const rgb_t *bg);
+
+// perceptually nearest foreground to fg with a contrast of at least target against bg (wcag ratio or |Lc| of fg as text)
+// bisects the oklch lightness of fg (chroma and hue kept) towards white and towards black and keeps the closer result,
+// candidates outside srgb are gamut mapped (chroma reduced) with GAMUT_MAP or clipped with GAMUT_CLIP
+// the ratio is checked on the rounded 8-bit color, so the result always meets the target unless met is false
+contrast_fix_t fix_contrast(contrast_metric_t metric, const rgb_t *fg, const rgb_t *bg, double target, gamut_t mode);
+
+// fix_contrast for n packed 0xrrggbb pairs, spread over threads
+void fix_contrast_batch(contrast_metric_t metric, const uint32_t *fg, const uint32_t *bg, size_t n, double target, gamut_t mode, contrast_fix_t *out);
+
+// per-color columns of n packed 0xrrggbb colors for contrast_rows, CONTRAST_COLS(metric) columns of n doubles each:
+// the wcag relative luminance, or the apca luminance followed by its four power curves (text and background of both polarities)
+void contrast_columns(contrast_metric_t metric, const uint32_t *rgb, size_t n, double *cols);
+
+// contrast between colors r0..r1-1 and the colors after them from their columns, only the entries j > i of row i at
+// out + (i - r0) * n are written: wcag ratios (symmetric) or the apca Lc of color i as text on color j, and for apca
+// the Lc of color j as text on color i at the same place in rev (unused for wcag), rows are spread over threads
+void contrast_rows(contrast_metric_t metric, const double *cols, size_t n, size_t r0, size_t r1, double *out, double *rev);
+
+// read the palette in opts->cmatrix and print every pair meeting at least the lowest level (with its flags for all three
+// levels) followed by the number of compliant partners of every color per level, in opts->format (text / csv / json)
+// wcag pairs are listed once (i < j), apca pairs in both orders (color i as text on color j, every pair i < j followed
+// by its reverse j, i)
+//
+// returns the process exit code
+int run_contrast_matrix(const prog_opts_t *opts, const char *progname);
+
+// fix the pair in opts->fix or every "fg bg" line of opts->fixbatch and print the results in opts->format
+//
+// returns the process exit code
+int run_fix_contrast(const prog_opts_t *opts, const char *progname);
+
+#endif
@@ -1,7 +1,7 @@
 // converter functions for converting colors from one model to another
 //
-// mainly to and from rgb, which makes conversion a tiny bit slower
-// but doesn't explode code size
+// single colors go to and from rgb, which makes conversion a tiny bit slower
+// but doesn't explode code size, bulk data takes the float32 conversion graph below instead
 //
 // comments omitted, function names should be self-explanatory
 #ifndef CONVERTER_H
@@ -9,6 +9,17 @@
 
 #include "types.h"
 
+// precision used by the oklab / oklch conversions (default: PRECISION_EXACT)
+void set_precision(precision_t p);
+precision_t get_precision();
+
+// out-of-gamut handling of oklab_to_rgb / oklch_to_rgb (default: GAMUT_CLIP)
+// instead of warning per color, conversions count the colors that were out of gamut
+void set_gamut(gamut_t g);
+gamut_t get_gamut();
+unsigned long gamut_count();
+void gamut_count_reset();
+
 hex_t rgb_to_hex(const rgb_t *rgb);
 rgb_t hex_to_rgb(const hex_t hex);
 
@@ -22,16 +33,85 @@ rgb_t hsv_to_rgb(const hsv_t *hsv);
 
 oklab_t rgb_to_oklab(const rgb_t *rgb);
 oklch_t rgb_to_oklch(const rgb_t *rgb);
+lab_t   rgb_to_lab(const rgb_t *rgb);
 rgb_t oklab_to_rgb(const oklab_t *oklab);
 rgb_t oklch_to_rgb(const oklch_t *ch);
 oklch_t oklab_to_oklch(const oklab_t *lab);
 oklab_t oklch_to_oklab(const oklch_t *ch);
 
+// the same math on unclipped linear srgb, for modules working in linear light (--precision applies aswell)
+// oklab_to_linear gamut maps like oklab_to_rgb if map is set and the color is out of gamut (nothing is counted),
+// gamut_map_linear does so in place for a linear color, lab_f is the cielab companding of a white-relative value
+oklab_t linear_to_oklab(const double lin[3]);
+void    oklab_to_linear(const oklab_t *oklab, bool map, double lin[3]);
+void    gamut_map_linear(double lin[3]);
+double  lab_f(double t);
+
+// ansi 16 palette (system colors 0..15 of the 256 color palette)
+extern const rgb_t ansi16_rgb[16];
+
 rgb_t ansi256_idx_to_rgb(int idx);
 rgb_t ansi16_idx_to_rgb(int idx);
 int rgb_to_ansi256_idx(const rgb_t *rgb);
 int rgb_to_ansi16_idx(const rgb_t *rgb);
+int rgb_to_ansi256_idx_scan(const rgb_t *rgb); // ignores lookup tables (see lut.h)
+int rgb_to_ansi16_idx_scan(const rgb_t *rgb);  // ignores lookup tables (see lut.h)
 int ansi16_idx_to_sgr_fg(int idx);
 int ansi16_idx_to_sgr_bg(int idx);
 
+// float32 bulk variants over columns, for batch data (src/converter_f32.c)
+//
+// generated from the same source as the double functions above (src/convert_impl.h), results agree to float precision
+// the double api stays the reference for printed output
+// colors are packed 0xrrggbb, results going back to rgb are clamped to the gamut without warnings unless stated otherwise
+void rgb8_to_cmyk_f32(const uint32_t *rgb, size_t n, float *c, float *m, float *y, float *k);
+void rgb8_to_hsl_f32(const uint32_t *rgb, size_t n, float *h, float *s, float *l);
+void rgb8_to_hsv_f32(const uint32_t *rgb, size_t n, float *h, float *s, float *v);
+void cmyk_to_rgb8_f32(const float *c, const float *m, const float *y, const float *k, size_t n, uint32_t *rgb);
+void hsl_to_rgb8_f32(const float *h, const float *s, const float *l, size_t n, uint32_t *rgb);
+void hsv_to_rgb8_f32(const float *h, const float *s, const float *v, size_t n, uint32_t *rgb);
+// clips or gamut maps (same algorithm as the double api), returns the number of colors that were out of gamut
+// colors are converted in one vectorizable pass, only the out-of-gamut ones are mapped in a second (threaded) pass
+size_t oklab_to_rgb8_f32(const float *L, const float *a, const float *b, size_t n, gamut_t mode, uint32_t *rgb);
+void oklch_to_oklab_f32(const float *C, const float *h, size_t n, float *a, float *b);
+// rgb8_to_oklab_f32 and oklab_to_oklch_f32 are dispatched kernels (see kernels.h)
+
+// squared weighted rgb distance from q to every color (0..255 scale, like weighted_dist2_rgb)
+void wdist2_rgb8_f32(const uint32_t *rgb, size_t n, uint32_t q, float wr, float wg, float wb, float *out);
+
+// pack normalized srgb columns to 0xrrggbb, clamping to [0,1]
+void srgb_to_rgb8_f32(const float *r, const float *g, const float *b, size_t n, uint32_t *rgb);
+
+// conversion graph of the float32 api: the models are nodes, the direct conversions are edges
+//   srgb <-> linear rgb, srgb <-> hsl / hsv / cmyk, hsl <-> hsv,
+//   linear rgb <-> oklab (out-of-gamut colors are clipped or mapped here), oklab <-> oklch, linear rgb -> cielab
+// a conversion follows the shortest route and runs all of its edges on one block of CONVERT_BLOCK colors
+// before the next, so intermediate columns stay in the l1 cache and nothing is rounded to 8 bits on the way
+typedef enum {
+    CVM_SRGB = 0,  // gamma-encoded rgb, 0..1
+    CVM_LINEAR,    // linear-light rgb, 0..1
+    CVM_HSL,       // hue in degrees, saturation and lightness 0..1
+    CVM_HSV,       // hue in degrees, saturation and value 0..1
+    CVM_CMYK,      // 0..1, four columns
+    CVM_OKLAB,
+    CVM_OKLCH,     // hue in degrees
+    CVM_LAB,       // cielab (d65), output only
+    CVM_COUNT
+} cv_model_t;
+
+// colors per block of convert_f32
+#define CONVERT_BLOCK 256
+
+// number of columns of a model
+int cv_model_channels(cv_model_t m);
+
+// shortest route from -> to: path[0..n] are the visited models (path needs CVM_COUNT entries)
+// returns the number of edges n, or -1 if to cannot be reached
+int convert_route(cv_model_t from, cv_model_t to, cv_model_t *path);
+
+// convert n colors given as columns (in[0..channels(from)), out[0..channels(to))), in and out may be the same columns
+// blocks are spread over threads for large n
+// returns the number of colors that were out of gamut on the way (see above), or -1 if there is no route
+long convert_f32(cv_model_t from, cv_model_t to, const float *const *in, size_t n, gamut_t mode, float *const *out);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+// 3d lookup tables: adobe / resolve .cube files, generated from the color transformations or applied to colors
+#ifndef CUBE_H
+#define CUBE_H
+
+#include <stdio.h>
+#include "kernels.h"
+#include "types.h"
+
+// largest number of nodes per axis (the .cube specification allows 2..256)
+#define CUBE_MAX_SIZE 256
+
+// colors per chunk of cube_apply, each thread works on whole chunks
+#define CUBE_CHUNK 16384
+
+// a 3d lookup table as stored in a .cube file
+typedef struct {
+    size_t size;               // nodes per axis
+    float  dmin[3], dmax[3];   // input domain per channel (default 0..1)
+    float *data;               // size^3 output rgb triples, red varying fastest
+} cube_t;
+
+// read a .cube file (LUT_3D_SIZE, DOMAIN_MIN / DOMAIN_MAX or LUT_3D_INPUT_RANGE, TITLE and comments are understood)
+// returns false on failure: *bad_line is the 1-based line that could not be parsed (the line after the last one if
+// entries are missing), or 0 if memory could not be allocated
+bool cube_load(FILE *f, cube_t *c, size_t *bad_line);
+
+// release the node data
+void cube_free(cube_t *c);
+
+// write c as .cube, title may be NULL
+void cube_write(FILE *f, const cube_t *c, const char *title);
+
+// sample the transformations of opts at size^3 nodes spread over threads:
+// --cvd (in linear light), out-of-gamut results clipped or gamut mapped (--gamut), then --snap to a palette
+// returns false if memory could not be allocated
+bool cube_generate(const prog_opts_t *opts, size_t size, cube_t *c);
+
+// per-code node offsets and fractions of c for rgb8_lut3d, lut->data points into c
+void cube_prepare(const cube_t *c, lut3d_t *lut);
+
+// rgb8_lut3d in chunks spread over threads, in and out may be the same array
+void cube_apply(const lut3d_t *lut, bool tetra, const uint32_t *in, size_t n, uint32_t *out);
+
+// load and prepare the .cube file at path, exits with an error message if it cannot be read
+void cube_open(const char *path, cube_t *c, lut3d_t *lut, const char *progname);
+
+// write the lookup table of opts->lutsize nodes per axis generated from the transformations of opts to opts->makelut
+//
+// returns the process exit code
+int run_make_lut(const prog_opts_t *opts, const char *progname);
+
+#endif
@@ -0,0 +1,20 @@
+// color vision deficiency simulation
+#ifndef CVD_H
+#define CVD_H
+
+#include "types.h"
+
+// name of a deficiency ("protan", "deutan", "tritan", "none")
+const char *cvd_name(cvd_t type);
+
+// row-major linear rgb simulation matrix of machado et al. (2009) for severity 0..1 (1: dichromacy),
+// interpolated between the tabulated steps of 0.1, the identity for CVD_NONE
+void cvd_matrix(cvd_t type, double severity, double m[9]);
+
+// simulated 8-bit color (double precision reference)
+rgb_t cvd_simulate(cvd_t type, double severity, const rgb_t *rgb);
+
+// simulate n packed 0xrrggbb colors in chunks spread over threads (rgb8_mat3_linear), in and out may be the same array
+void cvd_rgb8(cvd_t type, double severity, const uint32_t *in, size_t n, uint32_t *out);
+
+#endif
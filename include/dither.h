@@ -0,0 +1,72 @@
+// dithering of images to a fixed palette (--snap named | ansi16 | ansi256): ordered with a bayer matrix or a blue noise
+// mask, or error diffusion (floyd-steinberg, atkinson) in linear light or oklab
+//
+// ordered dithering offsets every pixel by the threshold of its position and takes the closest palette color, so tiles of
+// a band are independent and spread over threads; error diffusion runs as a wavefront, every row staying DITHER_LAG
+// pixels behind the row above, so rows of a band run on different threads and the result is the same as a serial scan
+#ifndef DITHER_H
+#define DITHER_H
+
+#include "types.h"
+
+// columns per tile of ordered dithering (tiles are as high as the band)
+#define DITHER_TILE 64
+
+// pixels a row of error diffusion stays behind the row above: a row writes error up to 2 pixels ahead into its own row
+// and 1 pixel back into the row below, so with 4 the rows never touch the same pixels at the same time
+#define DITHER_LAG 4
+
+// pixels between two progress updates of a row of error diffusion
+#define DITHER_STEP 64
+
+// pixels per band above which dithering is spread over threads
+#define DITHER_PAR_MIN 65536
+
+// side of the blue noise mask
+#define BLUE_NOISE_SIZE 64
+
+// cells per axis of the grid that narrows the closest palette color search down to the candidates of a cell
+#define DITHER_GRID 16
+
+// rows of error diffusion that reach past the current row (atkinson: 2)
+#define DITHER_CARRY 2
+
+// css name of a method ("none", "floyd-steinberg", "atkinson", "bayer", "blue-noise"), "fs" is accepted as well
+const char *dither_name(dither_t method);
+bool dither_from_name(const char *name, dither_t *method);
+
+// blue noise mask, thresholds in (-0.5, 0.5) row by row, built on first use (void-and-cluster, fixed seed)
+const float *blue_noise_mask();
+
+// state of one image dithered band by band
+typedef struct {
+    dither_t     method;
+    bool         linear;        // working space linear light (otherwise oklab)
+    size_t       w, rows;       // image width, most rows per band
+    size_t       y;             // image row of the next band (ordered thresholds continue across bands)
+    size_t       n;             // palette colors
+    float       *pal[3];        // palette in the working space
+    uint32_t    *hex;           // palette as packed 0xrrggbb
+    float        lo[3], hi[3];  // bounding box of the palette, diffused values are clamped to it
+    float        spread;        // amplitude of the ordered thresholds (mean distance between closest palette colors)
+    float        glo[3];        // origin of the grid (it covers the bounding box plus spread on every side)
+    float        ginv[3];       // grid cells per unit
+    uint32_t    *goff;          // candidates of cell c: gidx[goff[c]] .. gidx[goff[c + 1] - 1], ascending
+    uint16_t    *gidx;
+    const float *mask;          // thresholds of ordered dithering (side x side), NULL for none
+    size_t       side;
+    float       *c[3];          // working values of a band plus DITHER_CARRY rows of error reaching past it
+    float       *carry[3];      // error the previous band left for its first DITHER_CARRY rows
+    size_t      *done;          // pixels finished per row of a band (error diffusion)
+} ditherer_t;
+
+// set up dithering of images w pixels wide in bands of at most rows rows to the palette snap ("named" uses the current
+// name set), false if out of memory or snap is SNAP_NONE
+bool dither_init(ditherer_t *d, snap_t snap, dither_t method, bool linear, size_t w, size_t rows);
+void dither_free(ditherer_t *d);
+
+// dither the next n pixels (whole rows) of the image in place, and write their palette indices to idx if non-null
+// ordered thresholds shift the lightness (oklab L, or all three channels in linear light) by up to spread / 2
+void dither_band(ditherer_t *d, uint32_t *px, size_t n, uint16_t *idx);
+
+#endif
@@ -0,0 +1,40 @@
+// gradient mode: interpolate between two or more colors
+#ifndef GRADIENT_H
+#define GRADIENT_H
+
+#include "converter.h"
+#include "types.h"
+
+// interpolation spaces
+typedef enum {
+    GRAD_OKLAB = 0, // straight lines in oklab
+    GRAD_OKLCH,     // lightness, chroma and hue separately (see hue_interp_t)
+    GRAD_RGB        // gamma-encoded srgb channels (css "srgb")
+} grad_space_t;
+
+// hue interpolation for oklch, same meaning as in css color 4
+typedef enum {
+    HUE_SHORTER = 0, // take the shorter arc (at most 180 degrees)
+    HUE_LONGER,      // take the longer arc
+    HUE_INCREASING,  // always go counter-clockwise (increasing angle)
+    HUE_DECREASING   // always go clockwise (decreasing angle)
+} hue_interp_t;
+
+// fill rgb[0..steps) (packed 0xrrggbb) with the gradient through nstops colors, evenly spaced, first and last included
+// stops are interpolated from their oklab / oklch values (before any gamut handling), every step goes through gamut
+// handling afterwards, an achromatic stop takes the hue of its neighbour in oklch
+//
+// the whole gradient is computed in float columns with the bulk conversions (see converter.h)
+// returns the number of out-of-gamut steps, or -1 if memory could not be allocated
+long gradient_fill(const color_t *stops, size_t nstops, size_t steps, grad_space_t space, hue_interp_t hue, gamut_t mode, uint32_t *rgb);
+
+// like gradient_fill, but the steps stay floats: out[0..cv_model_channels(to)) are columns of steps values in model to,
+// converted from the interpolation space without rounding to 8 bits in between
+long gradient_fill_f32(const color_t *stops, size_t nstops, size_t steps, grad_space_t space, hue_interp_t hue, gamut_t mode, cv_model_t to, float *const *out);
+
+// parse opts->gradient, generate opts->steps colors and print them in opts->format
+//
+// returns the process exit code
+int run_gradient(const prog_opts_t *opts, const char *progname);
+
+#endif
@@ -0,0 +1,69 @@
+// image mode: stream binary ppm (and 8-bit rgb / rgb_alpha pam) images through per-pixel color transformations
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <stdio.h>
+#include "types.h"
+
+// rows of the image held in memory at once, memory use is IMAGE_BAND_ROWS * width * 7 bytes (9 with alpha, 16 above 8 bits)
+#define IMAGE_BAND_ROWS 64
+
+// read the header of a binary ppm (P6, maxval 1..65535, comments allowed), leaving f at the first pixel
+// returns false if f does not start with such a header
+bool ppm_read_header(FILE *f, size_t *w, size_t *h, unsigned *maxval);
+
+// the same for a ppm or a pam (P7) with maxval 255 and depth 3 (tuple type RGB) or 4 (RGB_ALPHA, *alpha set)
+bool pam_read_header(FILE *f, size_t *w, size_t *h, unsigned *maxval, bool *alpha);
+
+// write a P6 header
+void ppm_write_header(FILE *f, size_t w, size_t h);
+
+// read / write n pixels between rgb byte triples and packed 0xrrggbb, buf holds 3 * n bytes
+// ppm_read_pixels returns false on a short read
+bool ppm_read_pixels(FILE *f, uint8_t *buf, uint32_t *px, size_t n);
+void ppm_write_pixels(FILE *f, uint8_t *buf, const uint32_t *px, size_t n);
+
+// read n rgba pixels of a pam with alpha to packed 0xrrggbb and their opacities, buf holds 4 * n bytes
+bool pam_read_pixels(FILE *f, uint8_t *buf, uint32_t *px, uint8_t *alpha, size_t n);
+
+// read n pixels of any maxval as 3 interleaved samples (two big-endian bytes each above 255, clamped to maxval),
+// buf holds 6 * n bytes, returns false on a short read
+bool ppm_read_samples(FILE *f, uint8_t *buf, uint16_t *s, size_t n, unsigned maxval);
+
+// band reader shared by the modes working on images: pixels of a ppm / pam brought to packed 8-bit srgb, IMAGE_BAND_ROWS
+// rows at a time, with --from (out-of-gamut colors gamut mapped unless --gamut clip) and alpha composited over --over
+typedef struct {
+    FILE              *f;
+    const char        *path;
+    const prog_opts_t *opts;
+    size_t             w, h;   // image size
+    size_t             y;      // first row of the next band
+    unsigned           maxval;
+    bool               alpha;  // pam with an alpha channel?
+    gamut_t            mode;   // handling of out-of-gamut --from colors
+    unsigned long      oog;    // colors that were out of gamut so far
+    uint32_t          *px;     // packed 0xrrggbb pixels of the current band
+    uint8_t           *buf;    // file bytes of one band, free to reuse for output between reads
+    uint16_t          *smp;    // samples of images above 8 bits
+    uint8_t           *opa;    // opacities of images with alpha
+} image_reader_t;
+
+// open path ("-" for stdin), read its header and allocate one band, exits on errors
+void image_open(image_reader_t *r, const char *path, const prog_opts_t *opts, const char *progname);
+
+// read the next band into r->px, returns its number of pixels (0 after the last row), exits if the file ends early
+size_t image_read_band(image_reader_t *r, const char *progname);
+
+// close the file, free the band and print the gamut warning
+void image_close(image_reader_t *r);
+
+// read the ppm in opts->image, apply the requested transformations (--from, --lut, --cvd, then --snap with --dither) and
+// write the result as ppm, sixel or kitty graphics (--render, see render.h) to stdout
+// images with more (or fewer) than 8 bits per sample are written as 8-bit srgb, pams with alpha are composited over
+// opts->over (with opts->blend) right after --from
+// in bands of IMAGE_BAND_ROWS rows, so memory stays bounded for any image size
+//
+// returns the process exit code
+int run_image(const prog_opts_t *opts, const char *progname);
+
+#endif
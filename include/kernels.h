@@ -0,0 +1,149 @@
+// batch kernels working on structure-of-arrays data
+//
+// the loops are written in fixed-size blocks so the compiler can vectorize them (8-16 lanes per instruction, depending on isa)
+// every nearest search returns the index of the first minimum, i.e. ties always resolve to the lowest index,
+// which is the same result a plain scalar loop using strict < would give
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "types.h"
+
+// number of candidates processed per block
+#define KERNEL_BLOCK 16
+
+// instruction set levels the kernels are compiled for
+// the best one supported by the cpu is picked on first use, COLOR_CPU_LEVEL=base|v2|v3 forces a lower one
+typedef enum {
+    ISA_BASE = 0,  // x86-64 (sse2), or the plain build on other architectures
+    ISA_V2,        // x86-64-v2 (sse4.2, popcnt)
+    ISA_V3         // x86-64-v3 (avx2, fma, bmi2)
+} isa_level_t;
+
+// active level and its name
+isa_level_t kernels_isa();
+const char *isa_level_name(isa_level_t isa);
+
+// switch the kernels to another level at runtime (tests compare the levels with it), false if the cpu does not support
+// it or it was not compiled in, not to be called while kernels run on other threads
+bool kernels_force_isa(isa_level_t isa);
+
+// print the detected / active level and the dispatched kernels
+void kernels_print_info(FILE *f);
+
+// weighted squared euclidian nearest search over three int32 columns
+// returns the index of the closest entry (0 if n is 0) and writes its distance to *dist if non-null
+size_t nearest3_i32(const int32_t *x, const int32_t *y, const int32_t *z, size_t n,
+                    int32_t qx, int32_t qy, int32_t qz,
+                    int32_t wx, int32_t wy, int32_t wz, int32_t *dist);
+
+// squared euclidian nearest search over three float columns
+// returns the index of the closest entry (0 if n is 0) and writes its distance to *dist if non-null
+size_t nearest3_f32(const float *x, const float *y, const float *z, size_t n,
+                    float qx, float qy, float qz, float *dist);
+
+// squared euclidian distances from (qx, qy, qz) to every entry of three float columns
+void dist2_3_f32(const float *x, const float *y, const float *z, size_t n,
+                 float qx, float qy, float qz, float *out);
+
+// index of the nearest of k centers (cx, cy, cz) for every entry of three float columns (squared euclidian distance,
+// ties to the lowest center, k at most 65536), and the squared distance to it in dist if non-null
+void assign3_f32(const float *x, const float *y, const float *z, size_t n,
+                 const float *cx, const float *cy, const float *cz, size_t k, uint16_t *idx, float *dist);
+
+// weighted squared euclidian distances between every query (qx, qy, qz)[q] and every entry of three float columns
+// row q of the block is written to out + q * stride, meant for cache-sized tiles of an all-pairs matrix
+void wdist2_block_f32(const float *qx, const float *qy, const float *qz, size_t nq,
+                      const float *x, const float *y, const float *z, size_t n,
+                      float wx, float wy, float wz, float *out, size_t stride);
+
+// bulk conversion of packed 0xrrggbb colors to float oklab columns
+void rgb8_to_oklab_f32(const uint32_t *rgb, size_t n, float *L, float *a, float *b);
+
+// bulk conversion of packed 0xrrggbb colors to float cielab (d65) columns
+void rgb8_to_lab_f32(const uint32_t *rgb, size_t n, float *L, float *a, float *b);
+
+// color differences (metric CDIFF_DE76 / DE94 / DE2000 / CMC) from the reference (qL, qa, qb) to every entry of three
+// float cielab columns, same formulas as delta_e in utility.h
+void delta_e_f32(cdiff_t metric, const float *L, const float *a, const float *b, size_t n,
+                 float qL, float qa, float qb, float *out);
+
+// nearest search by color difference, (qL, qa, qb) is the reference
+// returns the index of the closest entry (0 if n is 0) and writes its difference to *dist if non-null
+size_t nearest_delta_e_f32(cdiff_t metric, const float *L, const float *a, const float *b, size_t n,
+                           float qL, float qa, float qb, float *dist);
+
+// bulk conversion of float oklab a / b columns to oklch chroma / hue (degrees in [0,360)) columns
+void oklab_to_oklch_f32(const float *a, const float *b, size_t n, float *C, float *h);
+
+// 16-bit fixed-point scales: hue in 1/65536 turns (360 degrees wrap to 0), everything else in 1/65535
+#define FIX_ONE  65535
+#define FIX_TURN 65536
+
+// exact integer conversions of packed 0xrrggbb colors to 16-bit hsl / hsv / cmyk columns and back
+// results are the double versions (rgb_to_hsl, hsl_to_rgb, ...) rounded half up to the fixed-point scale,
+// computed without floating point math or epsilon thresholds
+void rgb8_to_hsl16(const uint32_t *rgb, size_t n, uint16_t *h, uint16_t *s, uint16_t *l);
+void rgb8_to_hsv16(const uint32_t *rgb, size_t n, uint16_t *h, uint16_t *s, uint16_t *v);
+void rgb8_to_cmyk16(const uint32_t *rgb, size_t n, uint16_t *c, uint16_t *m, uint16_t *y, uint16_t *k);
+void hsl16_to_rgb8(const uint16_t *h, const uint16_t *s, const uint16_t *l, size_t n, uint32_t *rgb);
+void hsv16_to_rgb8(const uint16_t *h, const uint16_t *s, const uint16_t *v, size_t n, uint32_t *rgb);
+void cmyk16_to_rgb8(const uint16_t *c, const uint16_t *m, const uint16_t *y, const uint16_t *k, size_t n, uint32_t *rgb);
+
+// 3x3 matrix (row-major) applied to packed 0xrrggbb colors in linear light, results clipped and encoded back to 8 bits
+// with linear_to_srgb8_lut (no pow), in and out may be the same array
+void rgb8_mat3_linear(const float m[9], const uint32_t *in, size_t n, uint32_t *out);
+
+// like rgb8_mat3_linear, but the 8-bit codes are decoded to linear light through dec (any transfer function) and
+// oog[i] flags the colors whose linear result was out of the srgb gamut before clipping, returns their number
+size_t rgb8_mat3_gamut(const float dec[256], const float m[9], const uint32_t *in, size_t n, uint32_t *out, uint8_t *oog);
+
+// the same for n colors of 3 interleaved samples (up to 16 bits), each an index into dec, results are packed 0xrrggbb
+size_t rgb16_mat3_gamut(const float *dec, const float m[9], const uint16_t *in, size_t n, uint32_t *out, uint8_t *oog);
+
+// 3d lookup table prepared for rgb8_lut3d: data holds 3 floats (output rgb, nominally 0..1) per node with red varying fastest
+// (.cube order), idx / frac give the offset of the lower node (already scaled by the axis stride, at most size - 2 so the
+// upper node exists) and the position between both for every 8-bit code of each channel, step the stride of each axis
+typedef struct {
+    const float *data;
+    int32_t      step[3];
+    int32_t      idx[3][256];
+    float        frac[3][256];
+} lut3d_t;
+
+// packed 0xrrggbb colors through a 3d lookup table, trilinear (8 nodes) or tetrahedral (4 nodes) interpolation,
+// results clipped and rounded to 8 bits, in and out may be the same array
+void rgb8_lut3d(const lut3d_t *lut, bool tetra, const uint32_t *in, size_t n, uint32_t *out);
+
+// fixed-point (16 fractional bits) ycbcr coefficients of one standard and range for the 4:2:0 kernels below, see yuv.h
+typedef struct {
+    int32_t y[3], cb[3], cr[3]; // rgb -> ycbcr weights, cb / cr include the 0.5 / (1 - k) and range scale
+    int32_t ylo;                // code of black (16 limited, 0 full)
+    int32_t ys;                 // ycbcr -> rgb: luma scale (255 / 219 or 1)
+    int32_t rcr, gcb, gcr, bcb; // ycbcr -> rgb: chroma weights, including the range scale
+} yuv_coef_t;
+
+// luma of n packed 0xrrggbb colors, rounded and clamped to 8 bits
+void rgb8_to_y8(const yuv_coef_t *c, const uint32_t *rgb, size_t n, uint8_t *y);
+
+// 4:2:0 chroma of two rows of w pixels (row1 may equal row0 for an odd last row): one cb / cr pair from the sum of
+// every 2x2 block ((w + 1) / 2 of them, the last column repeats for odd w), stored step bytes apart (1: i420, 2: nv12)
+void rgb8_to_cbcr420(const yuv_coef_t *c, const uint32_t *row0, const uint32_t *row1, size_t w, uint8_t *cb, uint8_t *cr, size_t step);
+
+// one row of w pixels from its luma and the chroma of its row pair (step bytes apart, each sample used by 2 pixels),
+// clamped to 8 bits and packed 0xrrggbb
+void yuv420_to_rgb8(const yuv_coef_t *c, const uint8_t *y, const uint8_t *cb, const uint8_t *cr, size_t step, size_t w, uint32_t *rgb);
+
+// porter-duff source-over of n packed 0xrrggbb colors with 8-bit opacities alpha onto the opaque backdrops bg[i * bgstep]
+// (bgstep 0: the same backdrop for all), on the gamma-encoded codes (exact integer math, rounded) or in linear light
+// (8-bit decoding table, encoded back with linear_to_srgb8_lut), rgb and out may be the same array
+void rgba8_over_rgb8(const uint32_t *rgb, const uint8_t *alpha, const uint32_t *bg, size_t bgstep, size_t n, bool linear, uint32_t *out);
+
+// bulk nearest ansi 256 index of packed 0xrrggbb colors, same result as rgb_to_ansi256_idx
+void rgb8_to_ansi256_idx(const uint32_t *rgb, size_t n, uint8_t *out);
+
+#endif
@@ -0,0 +1,52 @@
+// precomputed 24-bit nearest-color lookup tables
+//
+// for every one of the 2^24 rgb values, the cache file stores:
+//   - the index of the closest css name    (16 bit)
+//   - the index of the closest xkcd name   (16 bit)
+//   - the closest ansi 256 color index     (8 bit)
+//   - the closest ansi 16 color index      (8 bit)
+//
+// the file is generated once (see lut_build) and mapped read-only on first use
+// if it is missing, truncated or was built from different tables, lookups report a miss and callers compute the result themselves
+//
+// cache location: $COLOR_LUT, otherwise $XDG_CACHE_HOME/color/nearest.lut, otherwise $HOME/.cache/color/nearest.lut
+#ifndef LUT_H
+#define LUT_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "types.h"
+
+// bump whenever the meaning of any table changes (e.g. different distance metric)
+#define LUT_VERSION 1
+
+// named table selection for lookups
+typedef enum {
+    LUT_CSS = 0,
+    LUT_XKCD
+} lut_names_t;
+
+// look up the closest named color index for a hex value
+// returns the index into the chosen name table or -1 if no valid cache is available
+int lut_named_idx(lut_names_t set, hex_t hex);
+
+// look up the closest ansi 256 / ansi 16 color index for a hex value
+// returns -1 if no valid cache is available
+int lut_ansi256_idx(hex_t hex);
+int lut_ansi16_idx(hex_t hex);
+
+// write the default cache path into buf
+// returns false if no path could be determined or it didn't fit
+bool lut_default_path(char *buf, size_t bufsz);
+
+// generate all tables and write them to the cache path, which lookups map from then on
+// the file is written to a temporary name first and renamed, so readers never see a partial file
+// not to be called while other threads look colors up
+//
+// returns 0 on success or -1 on failure (errno is set and a message is printed to stderr)
+int lut_build();
+
+// print cache status (path, validity) to stream
+void lut_print_info(FILE *stream);
+
+#endif
@@ -0,0 +1,23 @@
+// matrix mode: all-pairs color distances of a palette
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include "types.h"
+
+// rows of the matrix computed (and held in memory) at once, memory use is MATRIX_BAND_ROWS * n floats
+#define MATRIX_BAND_ROWS 256
+
+// distances between colors r0..r1-1 and all n colors of three float columns, written row-major (row i at out + (i - r0) * n)
+// the columns hold rgb (CDIFF_RGB / WRGB, squared), oklab (CDIFF_OKLAB, squared) or cielab (CDIFF_DE*, color i is the reference)
+// the band is split into cache-sized tiles spread over threads, with upper only the entries j > i are written
+void matrix_rows(cdiff_t metric, const float *x, const float *y, const float *z, size_t n,
+                 size_t r0, size_t r1, bool upper, float *out);
+
+// read the palette in opts->matrix and print its distance matrix (-D metric, same units as -d) in opts->format,
+// either dense (full or upper triangle) or as the list of pairs closer than opts->epsilon
+// the asymmetric metrics (CDIFF_DE94, CDIFF_CMC) are only printed as the full matrix
+//
+// returns the process exit code
+int run_matrix(const prog_opts_t *opts, const char *progname);
+
+#endif
@@ -0,0 +1,76 @@
+// palette extraction: the dominant colors of an image in oklab, by k-means++ clustering, median cut or a streaming octree
+//
+// k-means and median cut work on a histogram of the image with PALETTE_BITS bits per channel: every bin is one point at
+// the mean color of its pixels, weighted by their number, so neither memory nor the cost of an iteration grow with the
+// image size; the octree takes every pixel at full precision and merges leaves whenever there are more than
+// OCTREE_LEAVES of them, so its memory is fixed aswell
+#ifndef PALETTE_H
+#define PALETTE_H
+
+#include "types.h"
+
+// most colors one extraction may ask for
+#define PALETTE_MAX 256
+
+// histogram bits per rgb channel (2^18 bins)
+#define PALETTE_BITS 6
+
+// points per thread chunk of the k-means steps
+#define PALETTE_CHUNK 16384
+
+// most partial histograms filled at once by as many threads (PALETTE_BINS * 32 bytes each): every band of the image is
+// split between them, and they are merged when the image is read
+#define PALETTE_HISTS 8
+
+// lloyd iterations end once no center moves further than KMEANS_EPS (oklab distance), or after KMEANS_MAX_ITER
+#define KMEANS_MAX_ITER 100
+#define KMEANS_EPS      1e-4
+
+// levels below the root (cells of 1 / 2^OCTREE_DEPTH of the oklab box) and leaves kept while streaming
+#define OCTREE_DEPTH  6
+#define OCTREE_LEAVES 4096
+
+// the finished tree is reduced to OCTREE_MERGE * k leaves, from there the closest pairs of leaves are merged regardless
+// of the tree (merging siblings only would collapse whole subtrees into one color close to k)
+#define OCTREE_MERGE  4
+
+// css name of a method ("kmeans", "median-cut", "octree")
+const char *extract_name(extract_t method);
+
+// method of a name, false if unknown
+bool extract_from_name(const char *name, extract_t *method);
+
+// up to k colors (pL, pa, pb) of n oklab points with weights w, and the total weight of the points each color stands for
+// in pw, zero-weight colors are dropped, returns the number of colors (less than k if there are fewer distinct points)
+//
+// k-means++ seeding is deterministic (fixed seed), the assignment steps run the assign3_f32 kernel over chunks of
+// PALETTE_CHUNK points spread over threads, every thread summing its points into its own accumulators
+size_t palette_kmeans(const float *L, const float *a, const float *b, const double *w, size_t n, size_t k,
+                      float *pL, float *pa, float *pb, double *pw);
+
+// same for median cut: the box with the largest weighted squared error is split along its axis of largest variance at
+// the weighted median until there are k boxes, the colors are the weighted means of the boxes
+size_t palette_median_cut(const float *L, const float *a, const float *b, const double *w, size_t n, size_t k,
+                          float *pL, float *pa, float *pb, double *pw);
+
+// streaming octree over oklab
+typedef struct octree octree_t;
+
+// NULL if out of memory
+octree_t *octree_new();
+void      octree_free(octree_t *t);
+
+// add n pixels given as oklab columns
+void octree_add(octree_t *t, const float *L, const float *a, const float *b, size_t n);
+
+// merge the leaves down to at most k and return them like palette_kmeans, pw holds pixel counts (the tree is reduced)
+// leaves merge by the squared error they add (ward), first within the tree, then freely
+size_t octree_palette(octree_t *t, size_t k, float *pL, float *pa, float *pb, double *pw);
+
+// read the image opts->extract, find opts->ncolors dominant colors with opts->method and print them by decreasing share,
+// labeled with the closest named color (weighted rgb), in opts->format
+//
+// returns the process exit code
+int run_extract(const prog_opts_t *opts, const char *progname);
+
+#endif
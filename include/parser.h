@@ -6,8 +6,30 @@
 #include "types.h"
 
 // find closest named color using weighted squared rgb distance for currently chosen name set
+// uses the precomputed lookup tables (see lut.h) if available
 named_t closest_named_weighted_rgb(const rgb_t *in);
 
+// find closest named color for the currently chosen name set and metric (see set_named_metric)
+// this is what the parsers use to fill the "named" field
+named_t closest_named(const rgb_t *in);
+
+// choose the metric used by closest_named
+// CDIFF_RGB: plain rgb, CDIFF_OKLAB: oklab, CDIFF_DE*: cielab color difference, CDIFF_WRGB / CDIFF_ALL: weighted rgb (default)
+void set_named_metric(cdiff_t metric);
+
+// find closest named color in tbl by scanning all entries, never consulting lookup tables
+// returns the index of the closest entry and writes its distance to *diff if non-null
+size_t closest_named_index_scan(const named_table_t *tbl, const rgb_t *in, double *diff);
+
+// fill all color models of out from an rgb color
+void color_from_rgb(const rgb_t *rgb, color_t *out);
+
+// get the css or xkcd name table
+const named_table_t *get_named_table(bool xkcd);
+
+// get the name table currently in use (css unless use_xkcd was called)
+const named_table_t *get_current_named_table();
+
 // master parser: tries parsers in order
 // takes as parameters the input string to be parsed and a color_t out parameter
 //
@@ -18,6 +40,11 @@ named_t closest_named_weighted_rgb(const rgb_t *in);
 // returns 0 if the string could not be parsed and does nothing with *out
 int parse_color(const char *in, color_t *out);
 
+// parse_color for bulk input that only needs the color itself: the packed rgb and the opacity, without the closest named
+// color search
+// returns 1 and writes *hex and *alpha on success, 0 otherwise
+int parse_hex_alpha(const char *in, hex_t *hex, double *alpha);
+
 // master parser for parsing (at most) two colors from an input string, where the colors in the input string
 // are separated by whitespace and the substrings for the individual colors themselves may also contain whitespace
 //
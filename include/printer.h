@@ -11,6 +11,9 @@ void print_usage(FILE* stream, const char *progname);
 // print help string
 void print_help(const char *progname);
 
+// print how many colors were out of gamut and how they were handled (nothing if none were)
+void print_gamut_warning(FILE *stream, unsigned long n, gamut_t mode);
+
 // prints a labeled line and decrements height to detect color preview printing borders
 // specifically, if the height is negative, we're done printing the color preview
 void print_color_line(print_ctx_t *ctx, const char *label, const char *fmt, ...);
@@ -18,6 +21,12 @@ void print_color_line(print_ctx_t *ctx, const char *label, const char *fmt, ...)
 // prints an empty color preview line (or nothing if the preview is finished)
 void print_color_line_empty(print_ctx_t *ctx);
 
+// print the conversion of a color to the model chosen via "-c <model>" as a single line
+void print_conversion(const color_t *colorptr, const prog_opts_t *opts);
+
+// print the conversion of a color to the model chosen via "-c <model>" as a json key-value pair (no surrounding braces, no newline)
+void print_conversion_json(const color_t *colorptr, const prog_opts_t *opts);
+
 // print a single color block
 //
 // this may either be complete color information (all formats), possibly including a color preview,
@@ -0,0 +1,57 @@
+// terminal graphics output of image mode: dec sixel with a palette from --snap, and the kitty graphics protocol with raw
+// rgb sent in base64 chunks
+//
+// both encoders take the image a few rows at a time and keep only what they need across calls (up to 5 rows of palette
+// indices for sixel, less than one chunk for kitty), the output is collected in a buffer of RENDER_BUFSIZE bytes and
+// written with a single fwrite per frame (more only if a frame does not fit)
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdio.h>
+#include "types.h"
+
+// output buffer size
+#define RENDER_BUFSIZE (1 << 20)
+
+// most colors of a sixel palette
+#define SIXEL_COLORS 256
+
+// rows per sixel band
+#define SIXEL_ROWS 6
+
+// shortest run of a sixel character written as a repeat (!<n><char>)
+#define SIXEL_RUN 4
+
+// raw bytes per kitty chunk (4096 bytes of base64, the most the protocol allows)
+#define KITTY_RAW 3072
+
+// name of an output ("ppm", "sixel", "kitty")
+const char *render_name(render_t mode);
+bool render_from_name(const char *name, render_t *mode);
+
+typedef struct {
+    FILE           *f;
+    render_t        mode;
+    size_t          w, h;
+    char           *out;                   // output buffer and its fill
+    size_t          len;
+    const uint32_t *pal;                   // sixel: palette (packed 0xrrggbb) and its size
+    size_t          n;
+    bool            defined[SIXEL_COLORS]; // sixel: color registers already set
+    uint16_t       *rows;                  // sixel: palette indices of the band being filled
+    size_t          nrows, band;           // sixel: rows in it, bands written
+    uint8_t        *raw;                   // kitty: bytes of the chunk being filled
+    size_t          nraw, sent;            // kitty: bytes in it, bytes sent before
+} renderer_t;
+
+// start a frame of w x h pixels on f, pal (at most SIXEL_COLORS colors) is needed for sixel only
+// false if out of memory
+bool render_open(renderer_t *r, FILE *f, render_t mode, size_t w, size_t h, const uint32_t *pal, size_t n);
+
+// add the next n pixels (whole rows), as packed 0xrrggbb for kitty or as palette indices for sixel
+void render_rows(renderer_t *r, const uint32_t *px, const uint16_t *idx, size_t n);
+
+// finish the frame, write it out and free the encoder
+void render_close(renderer_t *r);
+
+#endif
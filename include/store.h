@@ -0,0 +1,64 @@
+// compact columnar color container for large palettes and batch data
+//
+// a color_t holds every model in doubles plus a named_t (well over 150 bytes),
+// the store only keeps a packed 24-bit rgb column (4 bytes per color) and materializes
+// float oklab / oklch columns on demand (12 / 20 more bytes per color), and an 8-bit opacity column once a translucent color
+// is loaded
+//
+// derived columns follow the rgb column through push, sort and dedupe
+#ifndef STORE_H
+#define STORE_H
+
+#include <stdio.h>
+#include "types.h"
+
+typedef struct {
+    size_t    size;    // number of colors
+    size_t    cap;     // allocated capacity of every column
+    uint32_t *rgb;     // packed 0xrrggbb, always present
+    uint8_t  *alpha;   // opacity 0..255, NULL while every color is opaque
+    float    *L;       // oklab L (shared with oklch), NULL until materialized
+    float    *a, *b;   // oklab a, b, NULL until materialized
+    float    *C, *h;   // oklch chroma and hue in degrees, NULL until materialized
+} color_store_t;
+
+// sort keys
+typedef enum {
+    STORE_KEY_HEX = 0,  // packed rgb value
+    STORE_KEY_L,        // oklab / oklch lightness
+    STORE_KEY_C,        // oklch chroma
+    STORE_KEY_H         // oklch hue
+} store_key_t;
+
+// initialize an empty store / release all memory
+void store_init(color_store_t *s);
+void store_free(color_store_t *s);
+
+// append a color, computing already materialized columns for it aswell
+// returns false if memory could not be allocated
+bool store_push(color_store_t *s, hex_t hex);
+
+// read colors from a stream, one color per line in any format parse_color accepts (blank lines are skipped),
+// opacities (e.g. "#rrggbbaa") go to the alpha column, only the color itself is parsed (see parse_hex_alpha)
+// returns the number of colors read, or -1 on failure (a line that could not be parsed or out of memory)
+// on a parse error, the 1-based line number is written to *bad_line if non-null
+long store_load(color_store_t *s, FILE *f, size_t *bad_line);
+
+// materialize the oklab / oklch columns (bulk conversion of the whole rgb column)
+// oklch implies oklab; returns false if memory could not be allocated
+bool store_need_oklab(color_store_t *s);
+bool store_need_oklch(color_store_t *s);
+
+// sort all columns by key (stable), materializing columns needed by the key
+// returns false if memory could not be allocated
+bool store_sort(color_store_t *s, store_key_t key, bool descending);
+
+// remove repeated colors, keeping the first occurrence of each (stable)
+// only the rgb column is compared, opacities differing or not
+// returns false if memory could not be allocated, the store is left as it was then
+bool store_dedupe(color_store_t *s);
+
+// composite the translucent colors over the opaque backdrop bg (see composite.h) and drop the alpha column
+void store_flatten(color_store_t *s, hex_t bg, blend_t mode, bool linear);
+
+#endif
@@ -1,294 +1,501 @@
 // lookup tables used throughout the program
+//
+// each named color table is stored as three parallel arrays:
+//   <set>_pool: all names concatenated into a single blob, each terminated by '\0'
+//   <set>_offs: 32-bit offset of each name inside the pool
+//   <set>_hex:  the matching hex value of each name
+//
+// compared to an array of { const char *, hex_t, double } this needs no load-time relocations
+// for the name pointers and keeps the hex values densely packed for the nearest-name scan
 #ifndef TABLES_H
 #define TABLES_H
 
+#include <stdint.h>
 #include "types.h"
 
 // all 148 named css colors
 // source: https://github.com/bahamas10/css-color-names/
-const named_t css_colors[] = {
-    { "aliceblue"           , 0xf0f8ff, 0.0 }, { "antiquewhite"        , 0xfaebd7, 0.0 }, { "aqua"                , 0x00ffff, 0.0 }, { "aquamarine"          , 0x7fffd4, 0.0 }, 
-    { "azure"               , 0xf0ffff, 0.0 }, { "beige"               , 0xf5f5dc, 0.0 }, { "bisque"              , 0xffe4c4, 0.0 }, { "black"               , 0x000000, 0.0 }, 
-    { "blanchedalmond"      , 0xffebcd, 0.0 }, { "blue"                , 0x0000ff, 0.0 }, { "blueviolet"          , 0x8a2be2, 0.0 }, { "brown"               , 0xa52a2a, 0.0 }, 
-    { "burlywood"           , 0xdeb887, 0.0 }, { "cadetblue"           , 0x5f9ea0, 0.0 }, { "chartreuse"          , 0x7fff00, 0.0 }, { "chocolate"           , 0xd2691e, 0.0 }, 
-    { "coral"               , 0xff7f50, 0.0 }, { "cornflowerblue"      , 0x6495ed, 0.0 }, { "cornsilk"            , 0xfff8dc, 0.0 }, { "crimson"             , 0xdc143c, 0.0 }, 
-    { "cyan"                , 0x00ffff, 0.0 }, { "darkblue"            , 0x00008b, 0.0 }, { "darkcyan"            , 0x008b8b, 0.0 }, { "darkgoldenrod"       , 0xb8860b, 0.0 }, 
-    { "darkgray"            , 0xa9a9a9, 0.0 }, { "darkgreen"           , 0x006400, 0.0 }, { "darkgrey"            , 0xa9a9a9, 0.0 }, { "darkkhaki"           , 0xbdb76b, 0.0 }, 
-    { "darkmagenta"         , 0x8b008b, 0.0 }, { "darkolivegreen"      , 0x556b2f, 0.0 }, { "darkorange"          , 0xff8c00, 0.0 }, { "darkorchid"          , 0x9932cc, 0.0 }, 
-    { "darkred"             , 0x8b0000, 0.0 }, { "darksalmon"          , 0xe9967a, 0.0 }, { "darkseagreen"        , 0x8fbc8f, 0.0 }, { "darkslateblue"       , 0x483d8b, 0.0 }, 
-    { "darkslategray"       , 0x2f4f4f, 0.0 }, { "darkslategrey"       , 0x2f4f4f, 0.0 }, { "darkturquoise"       , 0x00ced1, 0.0 }, { "darkviolet"          , 0x9400d3, 0.0 }, 
-    { "deeppink"            , 0xff1493, 0.0 }, { "deepskyblue"         , 0x00bfff, 0.0 }, { "dimgray"             , 0x696969, 0.0 }, { "dimgrey"             , 0x696969, 0.0 }, 
-    { "dodgerblue"          , 0x1e90ff, 0.0 }, { "firebrick"           , 0xb22222, 0.0 }, { "floralwhite"         , 0xfffaf0, 0.0 }, { "forestgreen"         , 0x228b22, 0.0 }, 
-    { "fuchsia"             , 0xff00ff, 0.0 }, { "gainsboro"           , 0xdcdcdc, 0.0 }, { "ghostwhite"          , 0xf8f8ff, 0.0 }, { "goldenrod"           , 0xdaa520, 0.0 }, 
-    { "gold"                , 0xffd700, 0.0 }, { "gray"                , 0x808080, 0.0 }, { "green"               , 0x008000, 0.0 }, { "greenyellow"         , 0xadff2f, 0.0 }, 
-    { "grey"                , 0x808080, 0.0 }, { "honeydew"            , 0xf0fff0, 0.0 }, { "hotpink"             , 0xff69b4, 0.0 }, { "indianred"           , 0xcd5c5c, 0.0 }, 
-    { "indigo"              , 0x4b0082, 0.0 }, { "ivory"               , 0xfffff0, 0.0 }, { "khaki"               , 0xf0e68c, 0.0 }, { "lavenderblush"       , 0xfff0f5, 0.0 }, 
-    { "lavender"            , 0xe6e6fa, 0.0 }, { "lawngreen"           , 0x7cfc00, 0.0 }, { "lemonchiffon"        , 0xfffacd, 0.0 }, { "lightblue"           , 0xadd8e6, 0.0 }, 
-    { "lightcoral"          , 0xf08080, 0.0 }, { "lightcyan"           , 0xe0ffff, 0.0 }, { "lightgoldenrodyellow", 0xfafad2, 0.0 }, { "lightgray"           , 0xd3d3d3, 0.0 }, 
-    { "lightgreen"          , 0x90ee90, 0.0 }, { "lightgrey"           , 0xd3d3d3, 0.0 }, { "lightpink"           , 0xffb6c1, 0.0 }, { "lightsalmon"         , 0xffa07a, 0.0 }, 
-    { "lightseagreen"       , 0x20b2aa, 0.0 }, { "lightskyblue"        , 0x87cefa, 0.0 }, { "lightslategray"      , 0x778899, 0.0 }, { "lightslategrey"      , 0x778899, 0.0 }, 
-    { "lightsteelblue"      , 0xb0c4de, 0.0 }, { "lightyellow"         , 0xffffe0, 0.0 }, { "lime"                , 0x00ff00, 0.0 }, { "limegreen"           , 0x32cd32, 0.0 }, 
-    { "linen"               , 0xfaf0e6, 0.0 }, { "magenta"             , 0xff00ff, 0.0 }, { "maroon"              , 0x800000, 0.0 }, { "mediumaquamarine"    , 0x66cdaa, 0.0 }, 
-    { "mediumblue"          , 0x0000cd, 0.0 }, { "mediumorchid"        , 0xba55d3, 0.0 }, { "mediumpurple"        , 0x9370db, 0.0 }, { "mediumseagreen"      , 0x3cb371, 0.0 }, 
-    { "mediumslateblue"     , 0x7b68ee, 0.0 }, { "mediumspringgreen"   , 0x00fa9a, 0.0 }, { "mediumturquoise"     , 0x48d1cc, 0.0 }, { "mediumvioletred"     , 0xc71585, 0.0 }, 
-    { "midnightblue"        , 0x191970, 0.0 }, { "mintcream"           , 0xf5fffa, 0.0 }, { "mistyrose"           , 0xffe4e1, 0.0 }, { "moccasin"            , 0xffe4b5, 0.0 }, 
-    { "navajowhite"         , 0xffdead, 0.0 }, { "navy"                , 0x000080, 0.0 }, { "oldlace"             , 0xfdf5e6, 0.0 }, { "olive"               , 0x808000, 0.0 }, 
-    { "olivedrab"           , 0x6b8e23, 0.0 }, { "orange"              , 0xffa500, 0.0 }, { "orangered"           , 0xff4500, 0.0 }, { "orchid"              , 0xda70d6, 0.0 }, 
-    { "palegoldenrod"       , 0xeee8aa, 0.0 }, { "palegreen"           , 0x98fb98, 0.0 }, { "paleturquoise"       , 0xafeeee, 0.0 }, { "palevioletred"       , 0xdb7093, 0.0 }, 
-    { "papayawhip"          , 0xffefd5, 0.0 }, { "peachpuff"           , 0xffdab9, 0.0 }, { "peru"                , 0xcd853f, 0.0 }, { "pink"                , 0xffc0cb, 0.0 }, 
-    { "plum"                , 0xdda0dd, 0.0 }, { "powderblue"          , 0xb0e0e6, 0.0 }, { "purple"              , 0x800080, 0.0 }, { "rebeccapurple"       , 0x663399, 0.0 }, 
-    { "red"                 , 0xff0000, 0.0 }, { "rosybrown"           , 0xbc8f8f, 0.0 }, { "royalblue"           , 0x4169e1, 0.0 }, { "saddlebrown"         , 0x8b4513, 0.0 }, 
-    { "salmon"              , 0xfa8072, 0.0 }, { "sandybrown"          , 0xf4a460, 0.0 }, { "seagreen"            , 0x2e8b57, 0.0 }, { "seashell"            , 0xfff5ee, 0.0 }, 
-    { "sienna"              , 0xa0522d, 0.0 }, { "silver"              , 0xc0c0c0, 0.0 }, { "skyblue"             , 0x87ceeb, 0.0 }, { "slateblue"           , 0x6a5acd, 0.0 }, 
-    { "slategray"           , 0x708090, 0.0 }, { "slategrey"           , 0x708090, 0.0 }, { "snow"                , 0xfffafa, 0.0 }, { "springgreen"         , 0x00ff7f, 0.0 }, 
-    { "steelblue"           , 0x4682b4, 0.0 }, { "tan"                 , 0xd2b48c, 0.0 }, { "teal"                , 0x008080, 0.0 }, { "thistle"             , 0xd8bfd8, 0.0 }, 
-    { "tomato"              , 0xff6347, 0.0 }, { "turquoise"           , 0x40e0d0, 0.0 }, { "violet"              , 0xee82ee, 0.0 }, { "wheat"               , 0xf5deb3, 0.0 }, 
-    { "white"               , 0xffffff, 0.0 }, { "whitesmoke"          , 0xf5f5f5, 0.0 }, { "yellow"              , 0xffff00, 0.0 }, { "yellowgreen"         , 0x9acd32, 0.0 }
+const char css_pool[] =
+    "aliceblue\0"            "antiquewhite\0"         "aqua\0"                 "aquamarine\0"
+    "azure\0"                "beige\0"                "bisque\0"               "black\0"
+    "blanchedalmond\0"       "blue\0"                 "blueviolet\0"           "brown\0"
+    "burlywood\0"            "cadetblue\0"            "chartreuse\0"           "chocolate\0"
+    "coral\0"                "cornflowerblue\0"       "cornsilk\0"             "crimson\0"
+    "cyan\0"                 "darkblue\0"             "darkcyan\0"             "darkgoldenrod\0"
+    "darkgray\0"             "darkgreen\0"            "darkgrey\0"             "darkkhaki\0"
+    "darkmagenta\0"          "darkolivegreen\0"       "darkorange\0"           "darkorchid\0"
+    "darkred\0"              "darksalmon\0"           "darkseagreen\0"         "darkslateblue\0"
+    "darkslategray\0"        "darkslategrey\0"        "darkturquoise\0"        "darkviolet\0"
+    "deeppink\0"             "deepskyblue\0"          "dimgray\0"              "dimgrey\0"
+    "dodgerblue\0"           "firebrick\0"            "floralwhite\0"          "forestgreen\0"
+    "fuchsia\0"              "gainsboro\0"            "ghostwhite\0"           "goldenrod\0"
+    "gold\0"                 "gray\0"                 "green\0"                "greenyellow\0"
+    "grey\0"                 "honeydew\0"             "hotpink\0"              "indianred\0"
+    "indigo\0"               "ivory\0"                "khaki\0"                "lavenderblush\0"
+    "lavender\0"             "lawngreen\0"            "lemonchiffon\0"         "lightblue\0"
+    "lightcoral\0"           "lightcyan\0"            "lightgoldenrodyellow\0" "lightgray\0"
+    "lightgreen\0"           "lightgrey\0"            "lightpink\0"            "lightsalmon\0"
+    "lightseagreen\0"        "lightskyblue\0"         "lightslategray\0"       "lightslategrey\0"
+    "lightsteelblue\0"       "lightyellow\0"          "lime\0"                 "limegreen\0"
+    "linen\0"                "magenta\0"              "maroon\0"               "mediumaquamarine\0"
+    "mediumblue\0"           "mediumorchid\0"         "mediumpurple\0"         "mediumseagreen\0"
+    "mediumslateblue\0"      "mediumspringgreen\0"    "mediumturquoise\0"      "mediumvioletred\0"
+    "midnightblue\0"         "mintcream\0"            "mistyrose\0"            "moccasin\0"
+    "navajowhite\0"          "navy\0"                 "oldlace\0"              "olive\0"
+    "olivedrab\0"            "orange\0"               "orangered\0"            "orchid\0"
+    "palegoldenrod\0"        "palegreen\0"            "paleturquoise\0"        "palevioletred\0"
+    "papayawhip\0"           "peachpuff\0"            "peru\0"                 "pink\0"
+    "plum\0"                 "powderblue\0"           "purple\0"               "rebeccapurple\0"
+    "red\0"                  "rosybrown\0"            "royalblue\0"            "saddlebrown\0"
+    "salmon\0"               "sandybrown\0"           "seagreen\0"             "seashell\0"
+    "sienna\0"               "silver\0"               "skyblue\0"              "slateblue\0"
+    "slategray\0"            "slategrey\0"            "snow\0"                 "springgreen\0"
+    "steelblue\0"            "tan\0"                  "teal\0"                 "thistle\0"
+    "tomato\0"               "turquoise\0"            "violet\0"               "wheat\0"
+    "white\0"                "whitesmoke\0"           "yellow\0"               "yellowgreen\0";
+
+const uint32_t css_offs[] = {
+        0,    10,    23,    28,    39,    45,    51,    58,    64,    79,    84,    95,
+      101,   111,   121,   132,   142,   148,   163,   172,   180,   185,   194,   203,
+      217,   226,   236,   245,   255,   267,   282,   293,   304,   312,   323,   336,
+      350,   364,   378,   392,   403,   412,   424,   432,   440,   451,   461,   473,
+      485,   493,   503,   514,   524,   529,   534,   540,   552,   557,   566,   574,
+      584,   591,   597,   603,   617,   626,   636,   649,   659,   670,   680,   701,
+      711,   722,   732,   742,   754,   768,   781,   796,   811,   826,   838,   843,
+      853,   859,   867,   874,   891,   902,   915,   928,   943,   959,   977,   993,
+     1009,  1022,  1032,  1042,  1051,  1063,  1068,  1076,  1082,  1092,  1099,  1109,
+     1116,  1130,  1140,  1154,  1168,  1179,  1189,  1194,  1199,  1204,  1215,  1222,
+     1236,  1240,  1250,  1260,  1272,  1279,  1290,  1299,  1308,  1315,  1322,  1330,
+     1340,  1350,  1360,  1365,  1377,  1387,  1391,  1396,  1404,  1411,  1421,  1428,
+     1434,  1440,  1451,  1458
+};
+
+const hex_t css_hex[] = {
+    0xf0f8ff, 0xfaebd7, 0x00ffff, 0x7fffd4, 0xf0ffff, 0xf5f5dc, 0xffe4c4, 0x000000, 0xffebcd, 0x0000ff, 0x8a2be2, 0xa52a2a,
+    0xdeb887, 0x5f9ea0, 0x7fff00, 0xd2691e, 0xff7f50, 0x6495ed, 0xfff8dc, 0xdc143c, 0x00ffff, 0x00008b, 0x008b8b, 0xb8860b,
+    0xa9a9a9, 0x006400, 0xa9a9a9, 0xbdb76b, 0x8b008b, 0x556b2f, 0xff8c00, 0x9932cc, 0x8b0000, 0xe9967a, 0x8fbc8f, 0x483d8b,
+    0x2f4f4f, 0x2f4f4f, 0x00ced1, 0x9400d3, 0xff1493, 0x00bfff, 0x696969, 0x696969, 0x1e90ff, 0xb22222, 0xfffaf0, 0x228b22,
+    0xff00ff, 0xdcdcdc, 0xf8f8ff, 0xdaa520, 0xffd700, 0x808080, 0x008000, 0xadff2f, 0x808080, 0xf0fff0, 0xff69b4, 0xcd5c5c,
+    0x4b0082, 0xfffff0, 0xf0e68c, 0xfff0f5, 0xe6e6fa, 0x7cfc00, 0xfffacd, 0xadd8e6, 0xf08080, 0xe0ffff, 0xfafad2, 0xd3d3d3,
+    0x90ee90, 0xd3d3d3, 0xffb6c1, 0xffa07a, 0x20b2aa, 0x87cefa, 0x778899, 0x778899, 0xb0c4de, 0xffffe0, 0x00ff00, 0x32cd32,
+    0xfaf0e6, 0xff00ff, 0x800000, 0x66cdaa, 0x0000cd, 0xba55d3, 0x9370db, 0x3cb371, 0x7b68ee, 0x00fa9a, 0x48d1cc, 0xc71585,
+    0x191970, 0xf5fffa, 0xffe4e1, 0xffe4b5, 0xffdead, 0x000080, 0xfdf5e6, 0x808000, 0x6b8e23, 0xffa500, 0xff4500, 0xda70d6,
+    0xeee8aa, 0x98fb98, 0xafeeee, 0xdb7093, 0xffefd5, 0xffdab9, 0xcd853f, 0xffc0cb, 0xdda0dd, 0xb0e0e6, 0x800080, 0x663399,
+    0xff0000, 0xbc8f8f, 0x4169e1, 0x8b4513, 0xfa8072, 0xf4a460, 0x2e8b57, 0xfff5ee, 0xa0522d, 0xc0c0c0, 0x87ceeb, 0x6a5acd,
+    0x708090, 0x708090, 0xfffafa, 0x00ff7f, 0x4682b4, 0xd2b48c, 0x008080, 0xd8bfd8, 0xff6347, 0x40e0d0, 0xee82ee, 0xf5deb3,
+    0xffffff, 0xf5f5f5, 0xffff00, 0x9acd32
 };
-const size_t css_colors_size = ARRAY_LENGTH(css_colors);
+
+const named_table_t css_colors = { css_pool, css_offs, css_hex, ARRAY_LENGTH(css_hex) };
 
 // "The 954 most common RGB monitor colors, as defined by several hundred thousand participants in the xkcd color name survey."
 // source: https://xkcd.com/color/rgb/
-const named_t xkcd_colors[] = {
-    { "black"                       , 0x000000, 0.0 }, { "verydarkblue"                , 0x000133, 0.0 }, { "darknavyblue"                , 0x00022e, 0.0 }, { "darkblue"                    , 0x00035b, 0.0 }, 
-    { "darknavy"                    , 0x000435, 0.0 }, { "navyblue"                    , 0x001146, 0.0 }, { "darkforestgreen"             , 0x002d04, 0.0 }, { "prussianblue"                , 0x004577, 0.0 }, 
-    { "darkbluegreen"               , 0x005249, 0.0 }, { "deepteal"                    , 0x00555a, 0.0 }, { "petrol"                      , 0x005f6a, 0.0 }, { "kelleygreen"                 , 0x009337, 0.0 }, 
-    { "greenishturquoise"           , 0x00fbb0, 0.0 }, { "cyan"                        , 0x00ffff, 0.0 }, { "trueblue"                    , 0x010fcc, 0.0 }, { "navy"                        , 0x01153e, 0.0 }, 
-    { "marineblue"                  , 0x01386a, 0.0 }, { "darkishblue"                 , 0x014182, 0.0 }, { "racinggreen"                 , 0x014600, 0.0 }, { "darkteal"                    , 0x014d4e, 0.0 }, 
-    { "deepseablue"                 , 0x015482, 0.0 }, { "brightblue"                  , 0x0165fc, 0.0 }, { "peacockblue"                 , 0x016795, 0.0 }, { "darkaquamarine"              , 0x017371, 0.0 }, 
-    { "deepturquoise"               , 0x017374, 0.0 }, { "bluegreen"                   , 0x017a79, 0.0 }, { "ocean"                       , 0x017b92, 0.0 }, { "tealblue"                    , 0x01889f, 0.0 }, 
-    { "irishgreen"                  , 0x019529, 0.0 }, { "emerald"                     , 0x01a049, 0.0 }, { "shamrock"                    , 0x01b44c, 0.0 }, { "green/blue"                  , 0x01c08d, 0.0 }, 
-    { "brightteal"                  , 0x01f9c6, 0.0 }, { "brightgreen"                 , 0x01ff07, 0.0 }, { "midnightblue"                , 0x020035, 0.0 }, { "pureblue"                    , 0x0203e2, 0.0 }, 
-    { "darkroyalblue"               , 0x02066f, 0.0 }, { "richblue"                    , 0x021bf9, 0.0 }, { "deepgreen"                   , 0x02590f, 0.0 }, { "emeraldgreen"                , 0x028f1e, 0.0 }, 
-    { "teal"                        , 0x029386, 0.0 }, { "kellygreen"                  , 0x02ab2e, 0.0 }, { "shamrockgreen"               , 0x02c14d, 0.0 }, { "brightskyblue"               , 0x02ccfe, 0.0 }, 
-    { "aquablue"                    , 0x02d8e9, 0.0 }, { "midnight"                    , 0x03012d, 0.0 }, { "darkblue"                    , 0x030764, 0.0 }, { "cobaltblue"                  , 0x030aa7, 0.0 }, 
-    { "darkgreen"                   , 0x033500, 0.0 }, { "vibrantblue"                 , 0x0339f8, 0.0 }, { "blue"                        , 0x0343df, 0.0 }, { "oceanblue"                   , 0x03719c, 0.0 }, 
-    { "deepblue"                    , 0x040273, 0.0 }, { "nightblue"                   , 0x040348, 0.0 }, { "marine"                      , 0x042e60, 0.0 }, { "bottlegreen"                 , 0x044a05, 0.0 }, 
-    { "darkturquoise"               , 0x045c5a, 0.0 }, { "seablue"                     , 0x047495, 0.0 }, { "junglegreen"                 , 0x048243, 0.0 }, { "cerulean"                    , 0x0485d1, 0.0 }, 
-    { "aquamarine"                  , 0x04d8b2, 0.0 }, { "neonblue"                    , 0x04d9ff, 0.0 }, { "turquoisegreen"              , 0x04f489, 0.0 }, { "royalblue"                   , 0x0504aa, 0.0 }, 
-    { "evergreen"                   , 0x05472a, 0.0 }, { "britishracinggreen"          , 0x05480d, 0.0 }, { "dark-green"                  , 0x054907, 0.0 }, { "darkaqua"                    , 0x05696b, 0.0 }, 
-    { "ceruleanblue"                , 0x056eee, 0.0 }, { "brightseagreen"              , 0x05ffa6, 0.0 }, { "verydarkgreen"               , 0x062e03, 0.0 }, { "forestgreen"                 , 0x06470c, 0.0 }, 
-    { "electricblue"                , 0x0652ff, 0.0 }, { "azure"                       , 0x069af3, 0.0 }, { "turquoiseblue"               , 0x06b1c4, 0.0 }, { "greenblue"                   , 0x06b48b, 0.0 }, 
-    { "turquoise"                   , 0x06c2ac, 0.0 }, { "almostblack"                 , 0x070d0d, 0.0 }, { "primaryblue"                 , 0x0804f9, 0.0 }, { "deepaqua"                    , 0x08787f, 0.0 }, 
-    { "truegreen"                   , 0x089404, 0.0 }, { "fluorescentgreen"            , 0x08ff08, 0.0 }, { "twilightblue"                , 0x0a437a, 0.0 }, { "pinegreen"                   , 0x0a481e, 0.0 }, 
-    { "spruce"                      , 0x0a5f38, 0.0 }, { "darkcyan"                    , 0x0a888a, 0.0 }, { "vibrantgreen"                , 0x0add08, 0.0 }, { "flurogreen"                  , 0x0aff02, 0.0 }, 
-    { "huntergreen"                 , 0x0b4008, 0.0 }, { "forest"                      , 0x0b5509, 0.0 }, { "greenishblue"                , 0x0b8b87, 0.0 }, { "mintygreen"                  , 0x0bf77d, 0.0 }, 
-    { "brightaqua"                  , 0x0bf9ea, 0.0 }, { "strongblue"                  , 0x0c06f7, 0.0 }, { "royal"                       , 0x0c1793, 0.0 }, { "greenteal"                   , 0x0cb577, 0.0 }, 
-    { "tealishgreen"                , 0x0cdc73, 0.0 }, { "neongreen"                   , 0x0cff0c, 0.0 }, { "deepskyblue"                 , 0x0d75f8, 0.0 }, { "waterblue"                   , 0x0e87cc, 0.0 }, 
-    { "blue/green"                  , 0x0f9b8e, 0.0 }, { "brightturquoise"             , 0x0ffef9, 0.0 }, { "niceblue"                    , 0x107ab0, 0.0 }, { "bluishgreen"                 , 0x10a674, 0.0 }, 
-    { "darkseagreen"                , 0x11875d, 0.0 }, { "aquagreen"                   , 0x12e193, 0.0 }, { "bluegreen"                   , 0x137e6d, 0.0 }, { "topaz"                       , 0x13bbaf, 0.0 }, 
-    { "aqua"                        , 0x13eac9, 0.0 }, { "vividblue"                   , 0x152eff, 0.0 }, { "forrestgreen"                , 0x154406, 0.0 }, { "lightnavy"                   , 0x155084, 0.0 }, 
-    { "green"                       , 0x15b01a, 0.0 }, { "ultramarineblue"             , 0x1805db, 0.0 }, { "seaweed"                     , 0x18d17b, 0.0 }, { "dark"                        , 0x1b2431, 0.0 }, 
-    { "highlightergreen"            , 0x1bfc06, 0.0 }, { "verydarkbrown"               , 0x1d0200, 0.0 }, { "azul"                        , 0x1d5dec, 0.0 }, { "cobalt"                      , 0x1e488f, 0.0 }, 
-    { "viridian"                    , 0x1e9167, 0.0 }, { "spearmint"                   , 0x1ef876, 0.0 }, { "darkindigo"                  , 0x1f0954, 0.0 }, { "darkbluegrey"                , 0x1f3b4d, 0.0 }, 
-    { "darkgreenblue"               , 0x1f6357, 0.0 }, { "jade"                        , 0x1fa774, 0.0 }, { "darkseafoam"                 , 0x1fb57a, 0.0 }, { "ultramarine"                 , 0x2000b1, 0.0 }, 
-    { "darkmintgreen"               , 0x20c073, 0.0 }, { "wintergreen"                 , 0x20f986, 0.0 }, { "sapphire"                    , 0x2138ab, 0.0 }, { "darkslateblue"               , 0x214761, 0.0 }, 
-    { "algaegreen"                  , 0x21c36f, 0.0 }, { "electricgreen"               , 0x21fc0d, 0.0 }, { "blueblue"                    , 0x2242c7, 0.0 }, { "greenblue"                   , 0x23c48b, 0.0 }, 
-    { "clearblue"                   , 0x247afd, 0.0 }, { "tealish"                     , 0x24bca8, 0.0 }, { "tealgreen"                   , 0x25a36f, 0.0 }, { "hotgreen"                    , 0x25ff29, 0.0 }, 
-    { "duskblue"                    , 0x26538d, 0.0 }, { "brightlightblue"             , 0x26f7fd, 0.0 }, { "midblue"                     , 0x276ab3, 0.0 }, { "midnightpurple"              , 0x280137, 0.0 }, 
-    { "darkishgreen"                , 0x287c37, 0.0 }, { "darkgreyblue"                , 0x29465b, 0.0 }, { "bluish"                      , 0x2976bb, 0.0 }, { "verydarkpurple"              , 0x2a0134, 0.0 }, 
-    { "treegreen"                   , 0x2a7e19, 0.0 }, { "greenishcyan"                , 0x2afeb7, 0.0 }, { "pine"                        , 0x2b5d34, 0.0 }, { "jadegreen"                   , 0x2baf6a, 0.0 }, 
-    { "blueygreen"                  , 0x2bb179, 0.0 }, { "mediumblue"                  , 0x2c6fbb, 0.0 }, { "radioactivegreen"            , 0x2cfa1f, 0.0 }, { "brightlightgreen"            , 0x2dfe54, 0.0 }, 
-    { "lightnavyblue"               , 0x2e5a88, 0.0 }, { "aquamarine"                  , 0x2ee8bb, 0.0 }, { "vividgreen"                  , 0x2fef10, 0.0 }, { "uglyblue"                    , 0x31668a, 0.0 }, 
-    { "greenishteal"                , 0x32bf84, 0.0 }, { "coolgreen"                   , 0x33b864, 0.0 }, { "darkviolet"                  , 0x34013f, 0.0 }, { "darkbrown"                   , 0x341c02, 0.0 }, 
-    { "charcoal"                    , 0x343837, 0.0 }, { "darkpurple"                  , 0x35063e, 0.0 }, { "navygreen"                   , 0x35530a, 0.0 }, { "seaweedgreen"                , 0x35ad6b, 0.0 }, 
-    { "deeppurple"                  , 0x36013f, 0.0 }, { "darkgrey"                    , 0x363737, 0.0 }, { "darkolive"                   , 0x373e02, 0.0 }, { "windowsblue"                 , 0x3778bf, 0.0 }, 
-    { "indigo"                      , 0x380282, 0.0 }, { "eggplant"                    , 0x380835, 0.0 }, { "darkgrassgreen"              , 0x388004, 0.0 }, { "mediumgreen"                 , 0x39ad48, 0.0 }, 
-    { "indigoblue"                  , 0x3a18b1, 0.0 }, { "lightroyalblue"              , 0x3a2efe, 0.0 }, { "weirdgreen"                  , 0x3ae57f, 0.0 }, { "denimblue"                   , 0x3b5b92, 0.0 }, 
-    { "denim"                       , 0x3b638c, 0.0 }, { "mutedblue"                   , 0x3b719f, 0.0 }, { "darkmaroon"                  , 0x3c0008, 0.0 }, { "charcoalgrey"                , 0x3c4142, 0.0 }, 
-    { "darkolivegreen"              , 0x3c4d03, 0.0 }, { "flatblue"                    , 0x3c73a8, 0.0 }, { "sea"                         , 0x3c9992, 0.0 }, { "aubergine"                   , 0x3d0734, 0.0 }, 
-    { "chocolate"                   , 0x3d1c02, 0.0 }, { "lightishblue"                , 0x3d7afd, 0.0 }, { "oceangreen"                  , 0x3d9973, 0.0 }, { "dodgerblue"                  , 0x3e82fc, 0.0 }, 
-    { "darkseafoamgreen"            , 0x3eaf76, 0.0 }, { "darkplum"                    , 0x3f012c, 0.0 }, { "dirtyblue"                   , 0x3f829d, 0.0 }, { "grassgreen"                  , 0x3f9b0b, 0.0 }, 
-    { "greenish"                    , 0x40a368, 0.0 }, { "poisongreen"                 , 0x40fd14, 0.0 }, { "deepbrown"                   , 0x410200, 0.0 }, { "chocolatebrown"              , 0x411900, 0.0 }, 
-    { "grassygreen"                 , 0x419c03, 0.0 }, { "brightcyan"                  , 0x41fdfe, 0.0 }, { "greenyblue"                  , 0x42b395, 0.0 }, { "eggplantpurple"              , 0x430541, 0.0 }, 
-    { "frenchblue"                  , 0x436bad, 0.0 }, { "darkskyblue"                 , 0x448ee4, 0.0 }, { "blueberry"                   , 0x464196, 0.0 }, { "duskyblue"                   , 0x475f94, 0.0 }, 
-    { "darkmint"                    , 0x48c072, 0.0 }, { "deepviolet"                  , 0x490648, 0.0 }, { "dullblue"                    , 0x49759c, 0.0 }, { "coolblue"                    , 0x4984b8, 0.0 }, 
-    { "mahogany"                    , 0x4a0100, 0.0 }, { "royalpurple"                 , 0x4b006e, 0.0 }, { "driedblood"                  , 0x4b0101, 0.0 }, { "warmblue"                    , 0x4b57db, 0.0 }, 
-    { "armygreen"                   , 0x4b5d16, 0.0 }, { "camouflagegreen"             , 0x4b6113, 0.0 }, { "dustyteal"                   , 0x4c9085, 0.0 }, { "lawngreen"                   , 0x4da409, 0.0 }, 
-    { "plumpurple"                  , 0x4e0550, 0.0 }, { "twilight"                    , 0x4e518b, 0.0 }, { "dusk"                        , 0x4e5481, 0.0 }, { "cadetblue"                   , 0x4e7496, 0.0 }, 
-    { "lightneongreen"              , 0x4efd54, 0.0 }, { "metallicblue"                , 0x4f738e, 0.0 }, { "lightforestgreen"            , 0x4f9153, 0.0 }, { "stormyblue"                  , 0x507b9c, 0.0 }, 
-    { "midgreen"                    , 0x50a747, 0.0 }, { "violetblue"                  , 0x510ac9, 0.0 }, { "slate"                       , 0x516572, 0.0 }, { "cornflowerblue"              , 0x5170d7, 0.0 }, 
-    { "leafygreen"                  , 0x51b73b, 0.0 }, { "camogreen"                   , 0x526525, 0.0 }, { "bluewithahintofpurple"       , 0x533cc6, 0.0 }, { "gunmetal"                    , 0x536267, 0.0 }, 
-    { "seagreen"                    , 0x53fca1, 0.0 }, { "lightbrightgreen"            , 0x53fe5c, 0.0 }, { "greenbrown"                  , 0x544e03, 0.0 }, { "ferngreen"                   , 0x548d44, 0.0 }, 
-    { "algae"                       , 0x54ac68, 0.0 }, { "blurple"                     , 0x5539cc, 0.0 }, { "offblue"                     , 0x5684ae, 0.0 }, { "darkpastelgreen"             , 0x56ae57, 0.0 }, 
-    { "lightgreenblue"              , 0x56fca2, 0.0 }, { "bluepurple"                  , 0x5729ce, 0.0 }, { "plum"                        , 0x580f41, 0.0 }, { "froggreen"                   , 0x58bc08, 0.0 }, 
-    { "slategrey"                   , 0x59656d, 0.0 }, { "darksage"                    , 0x598556, 0.0 }, { "blue/purple"                 , 0x5a06ef, 0.0 }, { "steelblue"                   , 0x5a7d9a, 0.0 }, 
-    { "dustyblue"                   , 0x5a86ad, 0.0 }, { "slateblue"                   , 0x5b7c99, 0.0 }, { "sapgreen"                    , 0x5c8b15, 0.0 }, { "leafgreen"                   , 0x5ca904, 0.0 }, 
-    { "grass"                       , 0x5cac2d, 0.0 }, { "kermitgreen"                 , 0x5cb200, 0.0 }, { "blueviolet"                  , 0x5d06e9, 0.0 }, { "grapepurple"                 , 0x5d1451, 0.0 }, 
-    { "purple/blue"                 , 0x5d21d0, 0.0 }, { "greyishblue"                 , 0x5e819d, 0.0 }, { "greyteal"                    , 0x5e9b8a, 0.0 }, { "greenapple"                  , 0x5edc1f, 0.0 }, 
-    { "purpleyblue"                 , 0x5f34e7, 0.0 }, { "dullteal"                    , 0x5f9e8f, 0.0 }, { "mutedgreen"                  , 0x5fa052, 0.0 }, { "purplishblue"                , 0x601ef9, 0.0 }, 
-    { "mudbrown"                    , 0x60460f, 0.0 }, { "mudgreen"                    , 0x606602, 0.0 }, { "bluegrey"                    , 0x607c8e, 0.0 }, { "burgundy"                    , 0x610023, 0.0 }, 
-    { "purpleishblue"               , 0x6140ef, 0.0 }, { "toxicgreen"                  , 0x61de2a, 0.0 }, { "lightishgreen"               , 0x61e160, 0.0 }, { "blueypurple"                 , 0x6241c7, 0.0 }, 
-    { "iris"                        , 0x6258c4, 0.0 }, { "purpleblue"                  , 0x632de9, 0.0 }, { "mossygreen"                  , 0x638b27, 0.0 }, { "fern"                        , 0x63a950, 0.0 }, 
-    { "boringgreen"                 , 0x63b365, 0.0 }, { "lightgreenishblue"           , 0x63f7b4, 0.0 }, { "olivebrown"                  , 0x645403, 0.0 }, { "grey/blue"                   , 0x647d8e, 0.0 }, 
-    { "softblue"                    , 0x6488ea, 0.0 }, { "maroon"                      , 0x650021, 0.0 }, { "brown"                       , 0x653700, 0.0 }, { "muddygreen"                  , 0x657432, 0.0 }, 
-    { "mossgreen"                   , 0x658b38, 0.0 }, { "fadedblue"                   , 0x658cbb, 0.0 }, { "slategreen"                  , 0x658d6d, 0.0 }, { "tea"                         , 0x65ab7c, 0.0 }, 
-    { "brightlimegreen"             , 0x65fe08, 0.0 }, { "purplyblue"                  , 0x661aee, 0.0 }, { "darkperiwinkle"              , 0x665fd1, 0.0 }, { "militarygreen"               , 0x667c3e, 0.0 }, 
-    { "dirtygreen"                  , 0x667e2c, 0.0 }, { "purplebrown"                 , 0x673a3f, 0.0 }, { "olivegreen"                  , 0x677a04, 0.0 }, { "claret"                      , 0x680018, 0.0 }, 
-    { "burple"                      , 0x6832e3, 0.0 }, { "greenybrown"                 , 0x696006, 0.0 }, { "greenishbrown"               , 0x696112, 0.0 }, { "swamp"                       , 0x698339, 0.0 }, 
-    { "flatgreen"                   , 0x699d4c, 0.0 }, { "freshgreen"                  , 0x69d84f, 0.0 }, { "brownishgreen"               , 0x6a6e09, 0.0 }, { "cornflower"                  , 0x6a79f7, 0.0 }, 
-    { "purplishbrown"               , 0x6b4247, 0.0 }, { "battleshipgrey"              , 0x6b7c85, 0.0 }, { "greyblue"                    , 0x6b8ba4, 0.0 }, { "offgreen"                    , 0x6ba353, 0.0 }, 
-    { "grape"                       , 0x6c3461, 0.0 }, { "murkygreen"                  , 0x6c7a0e, 0.0 }, { "lightindigo"                 , 0x6d5acf, 0.0 }, { "robin'segg"                  , 0x6dedfd, 0.0 }, 
-    { "reddybrown"                  , 0x6e1005, 0.0 }, { "olive"                       , 0x6e750e, 0.0 }, { "apple"                       , 0x6ecb3c, 0.0 }, { "brownygreen"                 , 0x6f6c0a, 0.0 }, 
-    { "olivedrab"                   , 0x6f7632, 0.0 }, { "poopgreen"                   , 0x6f7c00, 0.0 }, { "steelgrey"                   , 0x6f828a, 0.0 }, { "softgreen"                   , 0x6fc276, 0.0 }, 
-    { "bluishpurple"                , 0x703be7, 0.0 }, { "browngreen"                  , 0x706c11, 0.0 }, { "nastygreen"                  , 0x70b23f, 0.0 }, { "greyishteal"                 , 0x719f91, 0.0 }, 
-    { "leaf"                        , 0x71aa34, 0.0 }, { "richpurple"                  , 0x720058, 0.0 }, { "khakigreen"                  , 0x728639, 0.0 }, { "darkyellowgreen"             , 0x728f02, 0.0 }, 
-    { "merlot"                      , 0x730039, 0.0 }, { "dirtypurple"                 , 0x734a65, 0.0 }, { "mud"                         , 0x735c12, 0.0 }, { "steel"                       , 0x738595, 0.0 }, 
-    { "chestnut"                    , 0x742802, 0.0 }, { "swampgreen"                  , 0x748500, 0.0 }, { "bluishgrey"                  , 0x748b97, 0.0 }, { "drabgreen"                   , 0x749551, 0.0 }, 
-    { "dullgreen"                   , 0x74a662, 0.0 }, { "velvet"                      , 0x750851, 0.0 }, { "darkishpurple"               , 0x751973, 0.0 }, { "shitgreen"                   , 0x758000, 0.0 }, 
-    { "blue/grey"                   , 0x758da3, 0.0 }, { "turtlegreen"                 , 0x75b84f, 0.0 }, { "skyblue"                     , 0x75bbfd, 0.0 }, { "lightergreen"                , 0x75fd63, 0.0 }, 
-    { "brownishpurple"              , 0x76424e, 0.0 }, { "moss"                        , 0x769958, 0.0 }, { "dustygreen"                  , 0x76a973, 0.0 }, { "applegreen"                  , 0x76cd26, 0.0 }, 
-    { "lightbluishgreen"            , 0x76fda8, 0.0 }, { "lightgreen"                  , 0x76ff7b, 0.0 }, { "blood"                       , 0x770001, 0.0 }, { "greengrey"                   , 0x77926f, 0.0 }, 
-    { "greyblue"                    , 0x77a1b5, 0.0 }, { "asparagus"                   , 0x77ab56, 0.0 }, { "greygreen"                   , 0x789b73, 0.0 }, { "seafoamblue"                 , 0x78d1b6, 0.0 }, 
-    { "poopbrown"                   , 0x7a5901, 0.0 }, { "purplishgrey"                , 0x7a687f, 0.0 }, { "greyishbrown"                , 0x7a6a4f, 0.0 }, { "uglygreen"                   , 0x7a9703, 0.0 }, 
-    { "seafoamgreen"                , 0x7af9ab, 0.0 }, { "bordeaux"                    , 0x7b002c, 0.0 }, { "winered"                     , 0x7b0323, 0.0 }, { "shitbrown"                   , 0x7b5804, 0.0 }, 
-    { "fadedgreen"                  , 0x7bb274, 0.0 }, { "lightblue"                   , 0x7bc8f6, 0.0 }, { "tiffanyblue"                 , 0x7bf2da, 0.0 }, { "lightaquamarine"             , 0x7bfdc7, 0.0 }, 
-    { "uglybrown"                   , 0x7d7103, 0.0 }, { "mediumgrey"                  , 0x7d7f7c, 0.0 }, { "purple"                      , 0x7e1e9c, 0.0 }, { "bruise"                      , 0x7e4071, 0.0 }, 
-    { "greenygrey"                  , 0x7ea07a, 0.0 }, { "darklimegreen"               , 0x7ebd01, 0.0 }, { "lightturquoise"              , 0x7ef4cc, 0.0 }, { "lightbluegreen"              , 0x7efbb3, 0.0 }, 
-    { "reddishbrown"                , 0x7f2b0a, 0.0 }, { "milkchocolate"               , 0x7f4e1e, 0.0 }, { "mediumbrown"                 , 0x7f5112, 0.0 }, { "poop"                        , 0x7f5e00, 0.0 }, 
-    { "shit"                        , 0x7f5f00, 0.0 }, { "darktaupe"                   , 0x7f684e, 0.0 }, { "greybrown"                   , 0x7f7053, 0.0 }, { "camo"                        , 0x7f8f4e, 0.0 }, 
-    { "wine"                        , 0x80013f, 0.0 }, { "mutedpurple"                 , 0x805b87, 0.0 }, { "seafoam"                     , 0x80f9ad, 0.0 }, { "redpurple"                   , 0x820747, 0.0 }, 
-    { "dustypurple"                 , 0x825f87, 0.0 }, { "greypurple"                  , 0x826d8c, 0.0 }, { "drab"                        , 0x828344, 0.0 }, { "greyishgreen"                , 0x82a67d, 0.0 }, 
-    { "sky"                         , 0x82cafc, 0.0 }, { "paleteal"                    , 0x82cbb2, 0.0 }, { "dirtbrown"                   , 0x836539, 0.0 }, { "darkred"                     , 0x840000, 0.0 }, 
-    { "dullpurple"                  , 0x84597e, 0.0 }, { "darklime"                    , 0x84b701, 0.0 }, { "indianred"                   , 0x850e04, 0.0 }, { "darklavender"                , 0x856798, 0.0 }, 
-    { "bluegrey"                    , 0x85a3b2, 0.0 }, { "purplegrey"                  , 0x866f85, 0.0 }, { "brownishgrey"                , 0x86775f, 0.0 }, { "grey/green"                  , 0x86a17d, 0.0 }, 
-    { "darkmauve"                   , 0x874c62, 0.0 }, { "purpley"                     , 0x8756e4, 0.0 }, { "cocoa"                       , 0x875f42, 0.0 }, { "dullbrown"                   , 0x876e4b, 0.0 }, 
-    { "avocadogreen"                , 0x87a922, 0.0 }, { "sage"                        , 0x87ae73, 0.0 }, { "brightlime"                  , 0x87fd05, 0.0 }, { "poobrown"                    , 0x885f01, 0.0 }, 
-    { "muddybrown"                  , 0x886806, 0.0 }, { "greyishpurple"               , 0x887191, 0.0 }, { "babyshitgreen"               , 0x889717, 0.0 }, { "sagegreen"                   , 0x88b378, 0.0 }, 
-    { "lighteggplant"               , 0x894585, 0.0 }, { "duskypurple"                 , 0x895b7b, 0.0 }, { "blueygrey"                   , 0x89a0b0, 0.0 }, { "vomitgreen"                  , 0x89a203, 0.0 }, 
-    { "limegreen"                   , 0x89fe05, 0.0 }, { "dirt"                        , 0x8a6e45, 0.0 }, { "carolinablue"                , 0x8ab8fe, 0.0 }, { "robineggblue"                , 0x8af1fe, 0.0 }, 
-    { "redbrown"                    , 0x8b2e16, 0.0 }, { "rustbrown"                   , 0x8b3103, 0.0 }, { "lavenderblue"                , 0x8b88f8, 0.0 }, { "crimson"                     , 0x8c000f, 0.0 }, 
-    { "redwine"                     , 0x8c0034, 0.0 }, { "eastergreen"                 , 0x8cfd7e, 0.0 }, { "babygreen"                   , 0x8cff9e, 0.0 }, { "lightaqua"                   , 0x8cffdb, 0.0 }, 
-    { "deeplavender"                , 0x8d5eb7, 0.0 }, { "browngrey"                   , 0x8d8468, 0.0 }, { "hazel"                       , 0x8e7618, 0.0 }, { "periwinkle"                  , 0x8e82fe, 0.0 }, 
-    { "peagreen"                    , 0x8eab12, 0.0 }, { "kiwigreen"                   , 0x8ee53f, 0.0 }, { "brickred"                    , 0x8f1402, 0.0 }, { "poo"                         , 0x8f7303, 0.0 }, 
-    { "perrywinkle"                 , 0x8f8ce7, 0.0 }, { "babypoopgreen"               , 0x8f9805, 0.0 }, { "periwinkleblue"              , 0x8f99fb, 0.0 }, { "ickygreen"                   , 0x8fae22, 0.0 }, 
-    { "lichen"                      , 0x8fb67b, 0.0 }, { "acidgreen"                   , 0x8ffe09, 0.0 }, { "mintgreen"                   , 0x8fff9f, 0.0 }, { "avocado"                     , 0x90b134, 0.0 }, 
-    { "lightteal"                   , 0x90e4c1, 0.0 }, { "foamgreen"                   , 0x90fda9, 0.0 }, { "reddishpurple"               , 0x910951, 0.0 }, { "fadedpurple"                 , 0x916e99, 0.0 }, 
-    { "mulberry"                    , 0x920a4e, 0.0 }, { "brownred"                    , 0x922b05, 0.0 }, { "grey"                        , 0x929591, 0.0 }, { "peasoup"                     , 0x929901, 0.0 }, 
-    { "babypoop"                    , 0x937c00, 0.0 }, { "purplish"                    , 0x94568c, 0.0 }, { "pukebrown"                   , 0x947706, 0.0 }, { "purpleygrey"                 , 0x947e94, 0.0 }, 
-    { "peasoupgreen"                , 0x94a617, 0.0 }, { "barfgreen"                   , 0x94ac02, 0.0 }, { "sicklygreen"                 , 0x94b21c, 0.0 }, { "warmpurple"                  , 0x952e8f, 0.0 }, 
-    { "coolgrey"                    , 0x95a3a6, 0.0 }, { "lightblue"                   , 0x95d0fc, 0.0 }, { "darkmagenta"                 , 0x960056, 0.0 }, { "warmbrown"                   , 0x964e02, 0.0 }, 
-    { "deeplilac"                   , 0x966ebd, 0.0 }, { "greenishgrey"                , 0x96ae8d, 0.0 }, { "boogergreen"                 , 0x96b403, 0.0 }, { "lightgreen"                  , 0x96f97b, 0.0 }, 
-    { "warmgrey"                    , 0x978a84, 0.0 }, { "bloodred"                    , 0x980002, 0.0 }, { "purply"                      , 0x983fb2, 0.0 }, { "purpleish"                   , 0x98568d, 0.0 }, 
-    { "sepia"                       , 0x985e2b, 0.0 }, { "robin'seggblue"              , 0x98eff9, 0.0 }, { "lightseagreen"               , 0x98f6b0, 0.0 }, { "vividpurple"                 , 0x9900fa, 0.0 }, 
-    { "purplered"                   , 0x990147, 0.0 }, { "berry"                       , 0x990f4b, 0.0 }, { "reddishgrey"                 , 0x997570, 0.0 }, { "slimegreen"                  , 0x99cc04, 0.0 }, 
-    { "deepred"                     , 0x9a0200, 0.0 }, { "violet"                      , 0x9a0eea, 0.0 }, { "auburn"                      , 0x9a3001, 0.0 }, { "rawsienna"                   , 0x9a6200, 0.0 }, 
-    { "pukegreen"                   , 0x9aae07, 0.0 }, { "lightgrassgreen"             , 0x9af764, 0.0 }, { "amethyst"                    , 0x9b5fc0, 0.0 }, { "yellowishbrown"              , 0x9b7a01, 0.0 }, 
-    { "darkkhaki"                   , 0x9b8f55, 0.0 }, { "booger"                      , 0x9bb53c, 0.0 }, { "hospitalgreen"               , 0x9be5aa, 0.0 }, { "brownish"                    , 0x9c6d57, 0.0 }, 
-    { "darklilac"                   , 0x9c6da5, 0.0 }, { "brightolive"                 , 0x9cbb04, 0.0 }, { "kiwi"                        , 0x9cef43, 0.0 }, { "carmine"                     , 0x9d0216, 0.0 }, 
-    { "darkfuchsia"                 , 0x9d0759, 0.0 }, { "lightplum"                   , 0x9d5783, 0.0 }, { "mocha"                       , 0x9d7651, 0.0 }, { "sickgreen"                   , 0x9db92c, 0.0 }, 
-    { "lightgreyblue"               , 0x9dbcd4, 0.0 }, { "snotgreen"                   , 0x9dc100, 0.0 }, { "brightyellowgreen"           , 0x9dff00, 0.0 }, { "cranberry"                   , 0x9e003a, 0.0 }, 
-    { "redviolet"                   , 0x9e0168, 0.0 }, { "brownishred"                 , 0x9e3623, 0.0 }, { "mediumpurple"                , 0x9e43a2, 0.0 }, { "burntred"                    , 0x9f2305, 0.0 }, 
-    { "diarrhea"                    , 0x9f8303, 0.0 }, { "mint"                        , 0x9ffeb0, 0.0 }, { "deepmagenta"                 , 0xa0025c, 0.0 }, { "barneypurple"                , 0xa00498, 0.0 }, 
-    { "brick"                       , 0xa03623, 0.0 }, { "burntumber"                  , 0xa0450e, 0.0 }, { "grossgreen"                  , 0xa0bf16, 0.0 }, { "lightseafoam"                , 0xa0febf, 0.0 }, 
-    { "russet"                      , 0xa13905, 0.0 }, { "lightmaroon"                 , 0xa24857, 0.0 }, { "earth"                       , 0xa2653e, 0.0 }, { "vomit"                       , 0xa2a415, 0.0 }, 
-    { "pastelblue"                  , 0xa2bffe, 0.0 }, { "babyblue"                    , 0xa2cffe, 0.0 }, { "uglypurple"                  , 0xa442a0, 0.0 }, { "heather"                     , 0xa484ac, 0.0 }, 
-    { "lightolivegreen"             , 0xa4be5c, 0.0 }, { "pea"                         , 0xa4bf20, 0.0 }, { "violetred"                   , 0xa50055, 0.0 }, { "lightishpurple"              , 0xa552e6, 0.0 }, 
-    { "lighterpurple"               , 0xa55af4, 0.0 }, { "puce"                        , 0xa57e52, 0.0 }, { "cement"                      , 0xa5a391, 0.0 }, { "puke"                        , 0xa5a502, 0.0 }, 
-    { "paleturquoise"               , 0xa5fbd5, 0.0 }, { "softpurple"                  , 0xa66fb5, 0.0 }, { "coffee"                      , 0xa6814c, 0.0 }, { "lightmossgreen"              , 0xa6c875, 0.0 }, 
-    { "lightmintgreen"              , 0xa6fbb2, 0.0 }, { "rawumber"                    , 0xa75e09, 0.0 }, { "lightseafoamgreen"           , 0xa7ffb5, 0.0 }, { "rust"                        , 0xa83c09, 0.0 }, 
-    { "lightburgundy"               , 0xa8415b, 0.0 }, { "bronze"                      , 0xa87900, 0.0 }, { "wisteria"                    , 0xa87dc2, 0.0 }, { "darkmustard"                 , 0xa88905, 0.0 }, 
-    { "darksand"                    , 0xa88f59, 0.0 }, { "greyish"                     , 0xa8a495, 0.0 }, { "mustardgreen"                , 0xa8b504, 0.0 }, { "electriclime"                , 0xa8ff04, 0.0 }, 
-    { "darkishred"                  , 0xa90308, 0.0 }, { "sienna"                      , 0xa9561e, 0.0 }, { "tangreen"                    , 0xa9be70, 0.0 }, { "springgreen"                 , 0xa9f971, 0.0 }, 
-    { "electricpurple"              , 0xaa23ff, 0.0 }, { "rustred"                     , 0xaa2704, 0.0 }, { "khaki"                       , 0xaaa662, 0.0 }, { "lime"                        , 0xaaff32, 0.0 }, 
-    { "rouge"                       , 0xab1239, 0.0 }, { "tanbrown"                    , 0xab7e4c, 0.0 }, { "babypoo"                     , 0xab9004, 0.0 }, { "barney"                      , 0xac1db8, 0.0 }, 
-    { "cinnamon"                    , 0xac4f06, 0.0 }, { "leather"                     , 0xac7434, 0.0 }, { "mustardbrown"                , 0xac7e04, 0.0 }, { "dustylavender"               , 0xac86a8, 0.0 }, 
-    { "darkbeige"                   , 0xac9362, 0.0 }, { "snot"                        , 0xacbb0d, 0.0 }, { "lightolive"                  , 0xacbf69, 0.0 }, { "cloudyblue"                  , 0xacc2d9, 0.0 }, 
-    { "lightcyan"                   , 0xacfffc, 0.0 }, { "vibrantpurple"               , 0xad03de, 0.0 }, { "brightviolet"                , 0xad0afd, 0.0 }, { "lightbrown"                  , 0xad8150, 0.0 }, 
-    { "babyshitbrown"               , 0xad900d, 0.0 }, { "stone"                       , 0xada587, 0.0 }, { "lemongreen"                  , 0xadf802, 0.0 }, { "mauve"                       , 0xae7181, 0.0 }, 
-    { "yellowybrown"                , 0xae8b0c, 0.0 }, { "lightlime"                   , 0xaefd6c, 0.0 }, { "keylime"                     , 0xaeff6e, 0.0 }, { "rustyred"                    , 0xaf2f0d, 0.0 }, 
-    { "caramel"                     , 0xaf6f09, 0.0 }, { "darktan"                     , 0xaf884a, 0.0 }, { "bland"                       , 0xafa88b, 0.0 }, { "raspberry"                   , 0xb00149, 0.0 }, 
-    { "purplishred"                 , 0xb0054b, 0.0 }, { "burntsienna"                 , 0xb04e0f, 0.0 }, { "yellowishgreen"              , 0xb0dd16, 0.0 }, { "pastelgreen"                 , 0xb0ff9d, 0.0 }, 
-    { "orangeybrown"                , 0xb16002, 0.0 }, { "pinkishbrown"                , 0xb17261, 0.0 }, { "palebrown"                   , 0xb1916e, 0.0 }, { "powderblue"                  , 0xb1d1fc, 0.0 }, 
-    { "paleolivegreen"              , 0xb1d27b, 0.0 }, { "palelightgreen"              , 0xb1fc99, 0.0 }, { "palelimegreen"               , 0xb1ff65, 0.0 }, { "orangishbrown"               , 0xb25f03, 0.0 }, 
-    { "umber"                       , 0xb26400, 0.0 }, { "claybrown"                   , 0xb2713d, 0.0 }, { "goldenbrown"                 , 0xb27a01, 0.0 }, { "brownyellow"                 , 0xb29705, 0.0 }, 
-    { "dust"                        , 0xb2996e, 0.0 }, { "lightpastelgreen"            , 0xb2fba5, 0.0 }, { "lighturple"                  , 0xb36ff6, 0.0 }, { "darkrose"                    , 0xb5485d, 0.0 }, 
-    { "darkgold"                    , 0xb59410, 0.0 }, { "bile"                        , 0xb5c306, 0.0 }, { "green/yellow"                , 0xb5ce08, 0.0 }, { "copper"                      , 0xb66325, 0.0 }, 
-    { "clay"                        , 0xb66a50, 0.0 }, { "babypukegreen"               , 0xb6c406, 0.0 }, { "lightmint"                   , 0xb6ffbb, 0.0 }, { "burntsiena"                  , 0xb75203, 0.0 }, 
-    { "palepurple"                  , 0xb790d4, 0.0 }, { "yellowbrown"                 , 0xb79400, 0.0 }, { "lightbluegrey"               , 0xb7c9e2, 0.0 }, { "lightgreygreen"              , 0xb7e1a1, 0.0 }, 
-    { "palecyan"                    , 0xb7fffa, 0.0 }, { "paleaqua"                    , 0xb8ffeb, 0.0 }, { "dustyred"                    , 0xb9484e, 0.0 }, { "brownorange"                 , 0xb96902, 0.0 }, 
-    { "taupe"                       , 0xb9a281, 0.0 }, { "paleolive"                   , 0xb9cc81, 0.0 }, { "lightlimegreen"              , 0xb9ff66, 0.0 }, { "duskyrose"                   , 0xba6873, 0.0 }, 
-    { "mushroom"                    , 0xba9e88, 0.0 }, { "dullred"                     , 0xbb3f3f, 0.0 }, { "yellowgreen"                 , 0xbbf90f, 0.0 }, { "neonpurple"                  , 0xbc13fe, 0.0 }, 
-    { "greenishtan"                 , 0xbccb7a, 0.0 }, { "lightsage"                   , 0xbcecac, 0.0 }, { "washedoutgreen"              , 0xbcf5a6, 0.0 }, { "adobe"                       , 0xbd6c48, 0.0 }, 
-    { "paleskyblue"                 , 0xbdf6fe, 0.0 }, { "teagreen"                    , 0xbdf8a3, 0.0 }, { "scarlet"                     , 0xbe0119, 0.0 }, { "rosered"                     , 0xbe013c, 0.0 }, 
-    { "brightpurple"                , 0xbe03fd, 0.0 }, { "orangebrown"                 , 0xbe6400, 0.0 }, { "putty"                       , 0xbeae8a, 0.0 }, { "palelime"                    , 0xbefd73, 0.0 }, 
-    { "celadon"                     , 0xbefdb7, 0.0 }, { "lightpurple"                 , 0xbf77f6, 0.0 }, { "ochre"                       , 0xbf9005, 0.0 }, { "ocher"                       , 0xbf9b0c, 0.0 }, 
-    { "muddyyellow"                 , 0xbfac05, 0.0 }, { "yellowygreen"                , 0xbff128, 0.0 }, { "lemonlime"                   , 0xbffe28, 0.0 }, { "lipstickred"                 , 0xc0022f, 0.0 }, 
-    { "burntorange"                 , 0xc04e01, 0.0 }, { "easterpurple"                , 0xc071fe, 0.0 }, { "dustyrose"                   , 0xc0737a, 0.0 }, { "pistachio"                   , 0xc0fa8b, 0.0 }, 
-    { "yellowgreen"                 , 0xc0fb2d, 0.0 }, { "brickorange"                 , 0xc14a09, 0.0 }, { "lightperiwinkle"             , 0xc1c6fc, 0.0 }, { "chartreuse"                  , 0xc1f80a, 0.0 }, 
-    { "celery"                      , 0xc1fd95, 0.0 }, { "magenta"                     , 0xc20078, 0.0 }, { "brownishpink"                , 0xc27e79, 0.0 }, { "lightmauve"                  , 0xc292a1, 0.0 }, 
-    { "oliveyellow"                 , 0xc2b709, 0.0 }, { "pukeyellow"                  , 0xc2be0e, 0.0 }, { "lightyellowishgreen"         , 0xc2ff89, 0.0 }, { "greypink"                    , 0xc3909b, 0.0 }, 
-    { "duckeggblue"                 , 0xc3fbf4, 0.0 }, { "reddish"                     , 0xc44240, 0.0 }, { "rustorange"                  , 0xc45508, 0.0 }, { "liliac"                      , 0xc48efd, 0.0 }, 
-    { "sandybrown"                  , 0xc4a661, 0.0 }, { "lightpeagreen"               , 0xc4fe82, 0.0 }, { "eggshellblue"                , 0xc4fff7, 0.0 }, { "silver"                      , 0xc5c9c7, 0.0 }, 
-    { "darkorange"                  , 0xc65102, 0.0 }, { "ocre"                        , 0xc69c04, 0.0 }, { "camel"                       , 0xc69f59, 0.0 }, { "greenyyellow"                , 0xc6f808, 0.0 }, 
-    { "lightskyblue"                , 0xc6fcff, 0.0 }, { "deeprose"                    , 0xc74767, 0.0 }, { "brightlavender"              , 0xc760ff, 0.0 }, { "oldpink"                     , 0xc77986, 0.0 }, 
-    { "lavender"                    , 0xc79fef, 0.0 }, { "toupe"                       , 0xc7ac7d, 0.0 }, { "vomityellow"                 , 0xc7c10c, 0.0 }, { "palegreen"                   , 0xc7fdb5, 0.0 }, 
-    { "purpleypink"                 , 0xc83cb9, 0.0 }, { "darksalmon"                  , 0xc85a53, 0.0 }, { "orchid"                      , 0xc875c4, 0.0 }, { "dirtyorange"                 , 0xc87606, 0.0 }, 
-    { "oldrose"                     , 0xc87f89, 0.0 }, { "greyishpink"                 , 0xc88d94, 0.0 }, { "pinkishgrey"                 , 0xc8aca9, 0.0 }, { "yellow/green"                , 0xc8fd3d, 0.0 }, 
-    { "lightlightgreen"             , 0xc8ffb0, 0.0 }, { "pinkypurple"                 , 0xc94cbe, 0.0 }, { "brightlilac"                 , 0xc95efb, 0.0 }, { "terracotta"                  , 0xc9643b, 0.0 }, 
-    { "sandstone"                   , 0xc9ae74, 0.0 }, { "brownishyellow"              , 0xc9b003, 0.0 }, { "greenishbeige"               , 0xc9d179, 0.0 }, { "greenyellow"                 , 0xc9ff27, 0.0 }, 
-    { "ruby"                        , 0xca0147, 0.0 }, { "terracotta"                  , 0xca6641, 0.0 }, { "brownyorange"                , 0xca6b02, 0.0 }, { "dirtypink"                   , 0xca7b80, 0.0 }, 
-    { "babypurple"                  , 0xca9bf7, 0.0 }, { "pastelpurple"                , 0xcaa0ff, 0.0 }, { "lightlightblue"              , 0xcafffb, 0.0 }, { "hotpurple"                   , 0xcb00f5, 0.0 }, 
-    { "deeppink"                    , 0xcb0162, 0.0 }, { "darkpink"                    , 0xcb416b, 0.0 }, { "terracota"                   , 0xcb6843, 0.0 }, { "brownishorange"              , 0xcb7723, 0.0 }, 
-    { "yellowochre"                 , 0xcb9d06, 0.0 }, { "sandbrown"                   , 0xcba560, 0.0 }, { "pear"                        , 0xcbf85f, 0.0 }, { "duskypink"                   , 0xcc7a8b, 0.0 }, 
-    { "desert"                      , 0xccad60, 0.0 }, { "lightyellowgreen"            , 0xccfd7f, 0.0 }, { "rustyorange"                 , 0xcd5909, 0.0 }, { "uglypink"                    , 0xcd7584, 0.0 }, 
-    { "dirtyyellow"                 , 0xcdc50a, 0.0 }, { "greenishyellow"              , 0xcdfd02, 0.0 }, { "purplishpink"                , 0xce5dae, 0.0 }, { "lilac"                       , 0xcea2fd, 0.0 }, 
-    { "paleviolet"                  , 0xceaefa, 0.0 }, { "mustard"                     , 0xceb301, 0.0 }, { "cherry"                      , 0xcf0234, 0.0 }, { "darkcoral"                   , 0xcf524e, 0.0 }, 
-    { "rose"                        , 0xcf6275, 0.0 }, { "fawn"                        , 0xcfaf7b, 0.0 }, { "verypalegreen"               , 0xcffdbc, 0.0 }, { "neonyellow"                  , 0xcfff04, 0.0 }, 
-    { "uglyyellow"                  , 0xd0c101, 0.0 }, { "sicklyyellow"                , 0xd0e429, 0.0 }, { "limeyellow"                  , 0xd0fe1d, 0.0 }, { "paleblue"                    , 0xd0fefe, 0.0 }, 
-    { "mutedpink"                   , 0xd1768f, 0.0 }, { "tan"                         , 0xd1b26f, 0.0 }, { "verylightgreen"              , 0xd1ffbd, 0.0 }, { "mustardyellow"               , 0xd2bd0a, 0.0 }, 
-    { "fadedred"                    , 0xd3494e, 0.0 }, { "verylightbrown"              , 0xd3b683, 0.0 }, { "pinkish"                     , 0xd46a7e, 0.0 }, { "reallylightblue"             , 0xd4ffff, 0.0 }, 
-    { "lipstick"                    , 0xd5174e, 0.0 }, { "dullpink"                    , 0xd5869d, 0.0 }, { "dustypink"                   , 0xd58a94, 0.0 }, { "burntyellow"                 , 0xd5ab09, 0.0 }, 
-    { "darkyellow"                  , 0xd5b60a, 0.0 }, { "verylightblue"               , 0xd5ffff, 0.0 }, { "pinkishpurple"               , 0xd648d7, 0.0 }, { "lightviolet"                 , 0xd6b4fc, 0.0 }, 
-    { "ice"                         , 0xd6fffa, 0.0 }, { "verypaleblue"                , 0xd6fffe, 0.0 }, { "purple/pink"                 , 0xd725de, 0.0 }, { "palemagenta"                 , 0xd767ad, 0.0 }, 
-    { "iceblue"                     , 0xd7fffe, 0.0 }, { "dullorange"                  , 0xd8863b, 0.0 }, { "lightgrey"                   , 0xd8dcd6, 0.0 }, { "darkhotpink"                 , 0xd90166, 0.0 }, 
-    { "heliotrope"                  , 0xd94ff5, 0.0 }, { "palered"                     , 0xd9544d, 0.0 }, { "pinkishtan"                  , 0xd99b82, 0.0 }, { "darkishpink"                 , 0xda467d, 0.0 }, 
-    { "pinkpurple"                  , 0xdb4bda, 0.0 }, { "pastelred"                   , 0xdb5856, 0.0 }, { "gold"                        , 0xdbb40c, 0.0 }, { "deeporange"                  , 0xdc4d01, 0.0 }, 
-    { "lavenderpink"                , 0xdd85d7, 0.0 }, { "pissyellow"                  , 0xddd618, 0.0 }, { "cerise"                      , 0xde0c62, 0.0 }, { "darkpeach"                   , 0xde7e5d, 0.0 }, 
-    { "fadedpink"                   , 0xde9dac, 0.0 }, { "purpleishpink"               , 0xdf4ec8, 0.0 }, { "lightlavender"               , 0xdfc5fe, 0.0 }, { "purplepink"                  , 0xe03fd8, 0.0 }, 
-    { "pumpkin"                     , 0xe17701, 0.0 }, { "sand"                        , 0xe2ca76, 0.0 }, { "palelilac"                   , 0xe4cbff, 0.0 }, { "red"                         , 0xe50000, 0.0 }, 
-    { "beige"                       , 0xe6daa6, 0.0 }, { "lightkhaki"                  , 0xe6f2a2, 0.0 }, { "pigpink"                     , 0xe78ea5, 0.0 }, { "tomatored"                   , 0xec2d01, 0.0 }, 
-    { "fuchsia"                     , 0xed0dd9, 0.0 }, { "lightlilac"                  , 0xedc8ff, 0.0 }, { "palelavender"                , 0xeecffe, 0.0 }, { "dullyellow"                  , 0xeedc5b, 0.0 }, 
-    { "pink/purple"                 , 0xef1de7, 0.0 }, { "tomato"                      , 0xef4026, 0.0 }, { "macaroniandcheese"           , 0xefb435, 0.0 }, { "lightlavendar"               , 0xefc0fe, 0.0 }, 
-    { "purplypink"                  , 0xf075e6, 0.0 }, { "dustyorange"                 , 0xf0833a, 0.0 }, { "fadedorange"                 , 0xf0944d, 0.0 }, { "pinkishred"                  , 0xf10c45, 0.0 }, 
-    { "sandy"                       , 0xf1da7a, 0.0 }, { "offyellow"                   , 0xf1f33f, 0.0 }, { "blush"                       , 0xf29e8e, 0.0 }, { "squash"                      , 0xf2ab15, 0.0 }, 
-    { "mediumpink"                  , 0xf36196, 0.0 }, { "vermillion"                  , 0xf4320c, 0.0 }, { "orangishred"                 , 0xf43605, 0.0 }, { "maize"                       , 0xf4d054, 0.0 }, 
-    { "hotmagenta"                  , 0xf504c9, 0.0 }, { "pinkred"                     , 0xf5054f, 0.0 }, { "golden"                      , 0xf5bf03, 0.0 }, { "rosypink"                    , 0xf6688e, 0.0 }, 
-    { "verylightpurple"             , 0xf6cefc, 0.0 }, { "cherryred"                   , 0xf7022a, 0.0 }, { "rosepink"                    , 0xf7879a, 0.0 }, { "lightmustard"                , 0xf7d560, 0.0 }, 
-    { "reddishorange"               , 0xf8481c, 0.0 }, { "orange"                      , 0xf97306, 0.0 }, { "goldenrod"                   , 0xf9bc08, 0.0 }, { "redpink"                     , 0xfa2a55, 0.0 }, 
-    { "orangeyred"                  , 0xfa4224, 0.0 }, { "lightmagenta"                , 0xfa5ff7, 0.0 }, { "goldenrod"                   , 0xfac205, 0.0 }, { "yellowish"                   , 0xfaee66, 0.0 }, 
-    { "bananayellow"                , 0xfafe4b, 0.0 }, { "strawberry"                  , 0xfb2943, 0.0 }, { "warmpink"                    , 0xfb5581, 0.0 }, { "violetpink"                  , 0xfb5ffc, 0.0 }, 
-    { "pumpkinorange"               , 0xfb7d07, 0.0 }, { "wheat"                       , 0xfbdd7e, 0.0 }, { "lighttan"                    , 0xfbeeac, 0.0 }, { "pinkyred"                    , 0xfc2647, 0.0 }, 
-    { "coral"                       , 0xfc5a50, 0.0 }, { "orangish"                    , 0xfc824a, 0.0 }, { "pinky"                       , 0xfc86aa, 0.0 }, { "yelloworange"                , 0xfcb001, 0.0 }, 
-    { "marigold"                    , 0xfcc006, 0.0 }, { "sandyellow"                  , 0xfce166, 0.0 }, { "straw"                       , 0xfcf679, 0.0 }, { "yellowishtan"                , 0xfcfc81, 0.0 }, 
-    { "redorange"                   , 0xfd3c06, 0.0 }, { "orangered"                   , 0xfd411e, 0.0 }, { "watermelon"                  , 0xfd4659, 0.0 }, { "grapefruit"                  , 0xfd5956, 0.0 }, 
-    { "carnation"                   , 0xfd798f, 0.0 }, { "orangeish"                   , 0xfd8d49, 0.0 }, { "lightorange"                 , 0xfdaa48, 0.0 }, { "softpink"                    , 0xfdb0c0, 0.0 }, 
-    { "butterscotch"                , 0xfdb147, 0.0 }, { "orangeyyellow"               , 0xfdb915, 0.0 }, { "palerose"                    , 0xfdc1c5, 0.0 }, { "lightgold"                   , 0xfddc5c, 0.0 }, 
-    { "palegold"                    , 0xfdde6c, 0.0 }, { "sandyyellow"                 , 0xfdee73, 0.0 }, { "palegrey"                    , 0xfdfdfe, 0.0 }, { "lemonyellow"                 , 0xfdff38, 0.0 }, 
-    { "lemon"                       , 0xfdff52, 0.0 }, { "canary"                      , 0xfdff63, 0.0 }, { "fireenginered"               , 0xfe0002, 0.0 }, { "neonpink"                    , 0xfe019a, 0.0 }, 
-    { "brightpink"                  , 0xfe01b1, 0.0 }, { "shockingpink"                , 0xfe02a2, 0.0 }, { "reddishpink"                 , 0xfe2c54, 0.0 }, { "lightishred"                 , 0xfe2f4a, 0.0 }, 
-    { "orangered"                   , 0xfe420f, 0.0 }, { "barbiepink"                  , 0xfe46a5, 0.0 }, { "bloodorange"                 , 0xfe4b03, 0.0 }, { "salmonpink"                  , 0xfe7b7c, 0.0 }, 
-    { "blushpink"                   , 0xfe828c, 0.0 }, { "bubblegumpink"               , 0xfe83cc, 0.0 }, { "rosa"                        , 0xfe86a4, 0.0 }, { "lightsalmon"                 , 0xfea993, 0.0 }, 
-    { "saffron"                     , 0xfeb209, 0.0 }, { "amber"                       , 0xfeb308, 0.0 }, { "goldenyellow"                , 0xfec615, 0.0 }, { "palemauve"                   , 0xfed0fc, 0.0 }, 
-    { "dandelion"                   , 0xfedf08, 0.0 }, { "buff"                        , 0xfef69e, 0.0 }, { "parchment"                   , 0xfefcaf, 0.0 }, { "fadedyellow"                 , 0xfeff7f, 0.0 }, 
-    { "ecru"                        , 0xfeffca, 0.0 }, { "brightred"                   , 0xff000d, 0.0 }, { "hotpink"                     , 0xff028d, 0.0 }, { "electricpink"                , 0xff0490, 0.0 }, 
-    { "neonred"                     , 0xff073a, 0.0 }, { "strongpink"                  , 0xff0789, 0.0 }, { "brightmagenta"               , 0xff08e8, 0.0 }, { "lightred"                    , 0xff474c, 0.0 }, 
-    { "brightorange"                , 0xff5b00, 0.0 }, { "coralpink"                   , 0xff6163, 0.0 }, { "candypink"                   , 0xff63e9, 0.0 }, { "bubblegumpink"               , 0xff69af, 0.0 }, 
-    { "bubblegum"                   , 0xff6cb5, 0.0 }, { "orangepink"                  , 0xff6f52, 0.0 }, { "pinkishorange"               , 0xff724c, 0.0 }, { "melon"                       , 0xff7855, 0.0 }, 
-    { "salmon"                      , 0xff796c, 0.0 }, { "carnationpink"               , 0xff7fa7, 0.0 }, { "pink"                        , 0xff81c0, 0.0 }, { "tangerine"                   , 0xff9408, 0.0 }, 
-    { "pastelorange"                , 0xff964f, 0.0 }, { "peachypink"                  , 0xff9a8a, 0.0 }, { "mango"                       , 0xffa62b, 0.0 }, { "paleorange"                  , 0xffa756, 0.0 }, 
-    { "yellowishorange"             , 0xffab0f, 0.0 }, { "orangeyellow"                , 0xffad01, 0.0 }, { "peach"                       , 0xffb07c, 0.0 }, { "apricot"                     , 0xffb16d, 0.0 }, 
-    { "palesalmon"                  , 0xffb19a, 0.0 }, { "powderpink"                  , 0xffb2d0, 0.0 }, { "babypink"                    , 0xffb7ce, 0.0 }, { "pastelpink"                  , 0xffbacd, 0.0 }, 
-    { "sunflower"                   , 0xffc512, 0.0 }, { "lightrose"                   , 0xffc5cb, 0.0 }, { "palepink"                    , 0xffcfdc, 0.0 }, { "lightpink"                   , 0xffd1df, 0.0 }, 
-    { "lightpeach"                  , 0xffd8b1, 0.0 }, { "sunfloweryellow"             , 0xffda03, 0.0 }, { "sunyellow"                   , 0xffdf22, 0.0 }, { "yellowtan"                   , 0xffe36e, 0.0 }, 
-    { "palepeach"                   , 0xffe5ad, 0.0 }, { "darkcream"                   , 0xfff39a, 0.0 }, { "verylightpink"               , 0xfff4f2, 0.0 }, { "sunnyyellow"                 , 0xfff917, 0.0 }, 
-    { "pale"                        , 0xfff9d0, 0.0 }, { "manilla"                     , 0xfffa86, 0.0 }, { "eggshell"                    , 0xfffcc4, 0.0 }, { "brightyellow"                , 0xfffd01, 0.0 }, 
-    { "sunshineyellow"              , 0xfffd37, 0.0 }, { "butteryellow"                , 0xfffd74, 0.0 }, { "custard"                     , 0xfffd78, 0.0 }, { "canaryyellow"                , 0xfffe40, 0.0 }, 
-    { "pastelyellow"                , 0xfffe71, 0.0 }, { "lightyellow"                 , 0xfffe7a, 0.0 }, { "lightbeige"                  , 0xfffeb6, 0.0 }, { "yellow"                      , 0xffff14, 0.0 }, 
-    { "banana"                      , 0xffff7e, 0.0 }, { "butter"                      , 0xffff81, 0.0 }, { "paleyellow"                  , 0xffff84, 0.0 }, { "creme"                       , 0xffffb6, 0.0 }, 
-    { "cream"                       , 0xffffc2, 0.0 }, { "ivory"                       , 0xffffcb, 0.0 }, { "eggshell"                    , 0xffffd4, 0.0 }, { "offwhite"                    , 0xffffe4, 0.0 }, 
-    { "white"                       , 0xffffff, 0.0 }, 
+const char xkcd_pool[] =
+    "black\0"                        "verydarkblue\0"                 "darknavyblue\0"                 "darkblue\0"
+    "darknavy\0"                     "navyblue\0"                     "darkforestgreen\0"              "prussianblue\0"
+    "darkbluegreen\0"                "deepteal\0"                     "petrol\0"                       "kelleygreen\0"
+    "greenishturquoise\0"            "cyan\0"                         "trueblue\0"                     "navy\0"
+    "marineblue\0"                   "darkishblue\0"                  "racinggreen\0"                  "darkteal\0"
+    "deepseablue\0"                  "brightblue\0"                   "peacockblue\0"                  "darkaquamarine\0"
+    "deepturquoise\0"                "bluegreen\0"                    "ocean\0"                        "tealblue\0"
+    "irishgreen\0"                   "emerald\0"                      "shamrock\0"                     "green/blue\0"
+    "brightteal\0"                   "brightgreen\0"                  "midnightblue\0"                 "pureblue\0"
+    "darkroyalblue\0"                "richblue\0"                     "deepgreen\0"                    "emeraldgreen\0"
+    "teal\0"                         "kellygreen\0"                   "shamrockgreen\0"                "brightskyblue\0"
+    "aquablue\0"                     "midnight\0"                     "darkblue\0"                     "cobaltblue\0"
+    "darkgreen\0"                    "vibrantblue\0"                  "blue\0"                         "oceanblue\0"
+    "deepblue\0"                     "nightblue\0"                    "marine\0"                       "bottlegreen\0"
+    "darkturquoise\0"                "seablue\0"                      "junglegreen\0"                  "cerulean\0"
+    "aquamarine\0"                   "neonblue\0"                     "turquoisegreen\0"               "royalblue\0"
+    "evergreen\0"                    "britishracinggreen\0"           "dark-green\0"                   "darkaqua\0"
+    "ceruleanblue\0"                 "brightseagreen\0"               "verydarkgreen\0"                "forestgreen\0"
+    "electricblue\0"                 "azure\0"                        "turquoiseblue\0"                "greenblue\0"
+    "turquoise\0"                    "almostblack\0"                  "primaryblue\0"                  "deepaqua\0"
+    "truegreen\0"                    "fluorescentgreen\0"             "twilightblue\0"                 "pinegreen\0"
+    "spruce\0"                       "darkcyan\0"                     "vibrantgreen\0"                 "flurogreen\0"
+    "huntergreen\0"                  "forest\0"                       "greenishblue\0"                 "mintygreen\0"
+    "brightaqua\0"                   "strongblue\0"                   "royal\0"                        "greenteal\0"
+    "tealishgreen\0"                 "neongreen\0"                    "deepskyblue\0"                  "waterblue\0"
+    "blue/green\0"                   "brightturquoise\0"              "niceblue\0"                     "bluishgreen\0"
+    "darkseagreen\0"                 "aquagreen\0"                    "bluegreen\0"                    "topaz\0"
+    "aqua\0"                         "vividblue\0"                    "forrestgreen\0"                 "lightnavy\0"
+    "green\0"                        "ultramarineblue\0"              "seaweed\0"                      "dark\0"
+    "highlightergreen\0"             "verydarkbrown\0"                "azul\0"                         "cobalt\0"
+    "viridian\0"                     "spearmint\0"                    "darkindigo\0"                   "darkbluegrey\0"
+    "darkgreenblue\0"                "jade\0"                         "darkseafoam\0"                  "ultramarine\0"
+    "darkmintgreen\0"                "wintergreen\0"                  "sapphire\0"                     "darkslateblue\0"
+    "algaegreen\0"                   "electricgreen\0"                "blueblue\0"                     "greenblue\0"
+    "clearblue\0"                    "tealish\0"                      "tealgreen\0"                    "hotgreen\0"
+    "duskblue\0"                     "brightlightblue\0"              "midblue\0"                      "midnightpurple\0"
+    "darkishgreen\0"                 "darkgreyblue\0"                 "bluish\0"                       "verydarkpurple\0"
+    "treegreen\0"                    "greenishcyan\0"                 "pine\0"                         "jadegreen\0"
+    "blueygreen\0"                   "mediumblue\0"                   "radioactivegreen\0"             "brightlightgreen\0"
+    "lightnavyblue\0"                "aquamarine\0"                   "vividgreen\0"                   "uglyblue\0"
+    "greenishteal\0"                 "coolgreen\0"                    "darkviolet\0"                   "darkbrown\0"
+    "charcoal\0"                     "darkpurple\0"                   "navygreen\0"                    "seaweedgreen\0"
+    "deeppurple\0"                   "darkgrey\0"                     "darkolive\0"                    "windowsblue\0"
+    "indigo\0"                       "eggplant\0"                     "darkgrassgreen\0"               "mediumgreen\0"
+    "indigoblue\0"                   "lightroyalblue\0"               "weirdgreen\0"                   "denimblue\0"
+    "denim\0"                        "mutedblue\0"                    "darkmaroon\0"                   "charcoalgrey\0"
+    "darkolivegreen\0"               "flatblue\0"                     "sea\0"                          "aubergine\0"
+    "chocolate\0"                    "lightishblue\0"                 "oceangreen\0"                   "dodgerblue\0"
+    "darkseafoamgreen\0"             "darkplum\0"                     "dirtyblue\0"                    "grassgreen\0"
+    "greenish\0"                     "poisongreen\0"                  "deepbrown\0"                    "chocolatebrown\0"
+    "grassygreen\0"                  "brightcyan\0"                   "greenyblue\0"                   "eggplantpurple\0"
+    "frenchblue\0"                   "darkskyblue\0"                  "blueberry\0"                    "duskyblue\0"
+    "darkmint\0"                     "deepviolet\0"                   "dullblue\0"                     "coolblue\0"
+    "mahogany\0"                     "royalpurple\0"                  "driedblood\0"                   "warmblue\0"
+    "armygreen\0"                    "camouflagegreen\0"              "dustyteal\0"                    "lawngreen\0"
+    "plumpurple\0"                   "twilight\0"                     "dusk\0"                         "cadetblue\0"
+    "lightneongreen\0"               "metallicblue\0"                 "lightforestgreen\0"             "stormyblue\0"
+    "midgreen\0"                     "violetblue\0"                   "slate\0"                        "cornflowerblue\0"
+    "leafygreen\0"                   "camogreen\0"                    "bluewithahintofpurple\0"        "gunmetal\0"
+    "seagreen\0"                     "lightbrightgreen\0"             "greenbrown\0"                   "ferngreen\0"
+    "algae\0"                        "blurple\0"                      "offblue\0"                      "darkpastelgreen\0"
+    "lightgreenblue\0"               "bluepurple\0"                   "plum\0"                         "froggreen\0"
+    "slategrey\0"                    "darksage\0"                     "blue/purple\0"                  "steelblue\0"
+    "dustyblue\0"                    "slateblue\0"                    "sapgreen\0"                     "leafgreen\0"
+    "grass\0"                        "kermitgreen\0"                  "blueviolet\0"                   "grapepurple\0"
+    "purple/blue\0"                  "greyishblue\0"                  "greyteal\0"                     "greenapple\0"
+    "purpleyblue\0"                  "dullteal\0"                     "mutedgreen\0"                   "purplishblue\0"
+    "mudbrown\0"                     "mudgreen\0"                     "bluegrey\0"                     "burgundy\0"
+    "purpleishblue\0"                "toxicgreen\0"                   "lightishgreen\0"                "blueypurple\0"
+    "iris\0"                         "purpleblue\0"                   "mossygreen\0"                   "fern\0"
+    "boringgreen\0"                  "lightgreenishblue\0"            "olivebrown\0"                   "grey/blue\0"
+    "softblue\0"                     "maroon\0"                       "brown\0"                        "muddygreen\0"
+    "mossgreen\0"                    "fadedblue\0"                    "slategreen\0"                   "tea\0"
+    "brightlimegreen\0"              "purplyblue\0"                   "darkperiwinkle\0"               "militarygreen\0"
+    "dirtygreen\0"                   "purplebrown\0"                  "olivegreen\0"                   "claret\0"
+    "burple\0"                       "greenybrown\0"                  "greenishbrown\0"                "swamp\0"
+    "flatgreen\0"                    "freshgreen\0"                   "brownishgreen\0"                "cornflower\0"
+    "purplishbrown\0"                "battleshipgrey\0"               "greyblue\0"                     "offgreen\0"
+    "grape\0"                        "murkygreen\0"                   "lightindigo\0"                  "robin'segg\0"
+    "reddybrown\0"                   "olive\0"                        "apple\0"                        "brownygreen\0"
+    "olivedrab\0"                    "poopgreen\0"                    "steelgrey\0"                    "softgreen\0"
+    "bluishpurple\0"                 "browngreen\0"                   "nastygreen\0"                   "greyishteal\0"
+    "leaf\0"                         "richpurple\0"                   "khakigreen\0"                   "darkyellowgreen\0"
+    "merlot\0"                       "dirtypurple\0"                  "mud\0"                          "steel\0"
+    "chestnut\0"                     "swampgreen\0"                   "bluishgrey\0"                   "drabgreen\0"
+    "dullgreen\0"                    "velvet\0"                       "darkishpurple\0"                "shitgreen\0"
+    "blue/grey\0"                    "turtlegreen\0"                  "skyblue\0"                      "lightergreen\0"
+    "brownishpurple\0"               "moss\0"                         "dustygreen\0"                   "applegreen\0"
+    "lightbluishgreen\0"             "lightgreen\0"                   "blood\0"                        "greengrey\0"
+    "greyblue\0"                     "asparagus\0"                    "greygreen\0"                    "seafoamblue\0"
+    "poopbrown\0"                    "purplishgrey\0"                 "greyishbrown\0"                 "uglygreen\0"
+    "seafoamgreen\0"                 "bordeaux\0"                     "winered\0"                      "shitbrown\0"
+    "fadedgreen\0"                   "lightblue\0"                    "tiffanyblue\0"                  "lightaquamarine\0"
+    "uglybrown\0"                    "mediumgrey\0"                   "purple\0"                       "bruise\0"
+    "greenygrey\0"                   "darklimegreen\0"                "lightturquoise\0"               "lightbluegreen\0"
+    "reddishbrown\0"                 "milkchocolate\0"                "mediumbrown\0"                  "poop\0"
+    "shit\0"                         "darktaupe\0"                    "greybrown\0"                    "camo\0"
+    "wine\0"                         "mutedpurple\0"                  "seafoam\0"                      "redpurple\0"
+    "dustypurple\0"                  "greypurple\0"                   "drab\0"                         "greyishgreen\0"
+    "sky\0"                          "paleteal\0"                     "dirtbrown\0"                    "darkred\0"
+    "dullpurple\0"                   "darklime\0"                     "indianred\0"                    "darklavender\0"
+    "bluegrey\0"                     "purplegrey\0"                   "brownishgrey\0"                 "grey/green\0"
+    "darkmauve\0"                    "purpley\0"                      "cocoa\0"                        "dullbrown\0"
+    "avocadogreen\0"                 "sage\0"                         "brightlime\0"                   "poobrown\0"
+    "muddybrown\0"                   "greyishpurple\0"                "babyshitgreen\0"                "sagegreen\0"
+    "lighteggplant\0"                "duskypurple\0"                  "blueygrey\0"                    "vomitgreen\0"
+    "limegreen\0"                    "dirt\0"                         "carolinablue\0"                 "robineggblue\0"
+    "redbrown\0"                     "rustbrown\0"                    "lavenderblue\0"                 "crimson\0"
+    "redwine\0"                      "eastergreen\0"                  "babygreen\0"                    "lightaqua\0"
+    "deeplavender\0"                 "browngrey\0"                    "hazel\0"                        "periwinkle\0"
+    "peagreen\0"                     "kiwigreen\0"                    "brickred\0"                     "poo\0"
+    "perrywinkle\0"                  "babypoopgreen\0"                "periwinkleblue\0"               "ickygreen\0"
+    "lichen\0"                       "acidgreen\0"                    "mintgreen\0"                    "avocado\0"
+    "lightteal\0"                    "foamgreen\0"                    "reddishpurple\0"                "fadedpurple\0"
+    "mulberry\0"                     "brownred\0"                     "grey\0"                         "peasoup\0"
+    "babypoop\0"                     "purplish\0"                     "pukebrown\0"                    "purpleygrey\0"
+    "peasoupgreen\0"                 "barfgreen\0"                    "sicklygreen\0"                  "warmpurple\0"
+    "coolgrey\0"                     "lightblue\0"                    "darkmagenta\0"                  "warmbrown\0"
+    "deeplilac\0"                    "greenishgrey\0"                 "boogergreen\0"                  "lightgreen\0"
+    "warmgrey\0"                     "bloodred\0"                     "purply\0"                       "purpleish\0"
+    "sepia\0"                        "robin'seggblue\0"               "lightseagreen\0"                "vividpurple\0"
+    "purplered\0"                    "berry\0"                        "reddishgrey\0"                  "slimegreen\0"
+    "deepred\0"                      "violet\0"                       "auburn\0"                       "rawsienna\0"
+    "pukegreen\0"                    "lightgrassgreen\0"              "amethyst\0"                     "yellowishbrown\0"
+    "darkkhaki\0"                    "booger\0"                       "hospitalgreen\0"                "brownish\0"
+    "darklilac\0"                    "brightolive\0"                  "kiwi\0"                         "carmine\0"
+    "darkfuchsia\0"                  "lightplum\0"                    "mocha\0"                        "sickgreen\0"
+    "lightgreyblue\0"                "snotgreen\0"                    "brightyellowgreen\0"            "cranberry\0"
+    "redviolet\0"                    "brownishred\0"                  "mediumpurple\0"                 "burntred\0"
+    "diarrhea\0"                     "mint\0"                         "deepmagenta\0"                  "barneypurple\0"
+    "brick\0"                        "burntumber\0"                   "grossgreen\0"                   "lightseafoam\0"
+    "russet\0"                       "lightmaroon\0"                  "earth\0"                        "vomit\0"
+    "pastelblue\0"                   "babyblue\0"                     "uglypurple\0"                   "heather\0"
+    "lightolivegreen\0"              "pea\0"                          "violetred\0"                    "lightishpurple\0"
+    "lighterpurple\0"                "puce\0"                         "cement\0"                       "puke\0"
+    "paleturquoise\0"                "softpurple\0"                   "coffee\0"                       "lightmossgreen\0"
+    "lightmintgreen\0"               "rawumber\0"                     "lightseafoamgreen\0"            "rust\0"
+    "lightburgundy\0"                "bronze\0"                       "wisteria\0"                     "darkmustard\0"
+    "darksand\0"                     "greyish\0"                      "mustardgreen\0"                 "electriclime\0"
+    "darkishred\0"                   "sienna\0"                       "tangreen\0"                     "springgreen\0"
+    "electricpurple\0"               "rustred\0"                      "khaki\0"                        "lime\0"
+    "rouge\0"                        "tanbrown\0"                     "babypoo\0"                      "barney\0"
+    "cinnamon\0"                     "leather\0"                      "mustardbrown\0"                 "dustylavender\0"
+    "darkbeige\0"                    "snot\0"                         "lightolive\0"                   "cloudyblue\0"
+    "lightcyan\0"                    "vibrantpurple\0"                "brightviolet\0"                 "lightbrown\0"
+    "babyshitbrown\0"                "stone\0"                        "lemongreen\0"                   "mauve\0"
+    "yellowybrown\0"                 "lightlime\0"                    "keylime\0"                      "rustyred\0"
+    "caramel\0"                      "darktan\0"                      "bland\0"                        "raspberry\0"
+    "purplishred\0"                  "burntsienna\0"                  "yellowishgreen\0"               "pastelgreen\0"
+    "orangeybrown\0"                 "pinkishbrown\0"                 "palebrown\0"                    "powderblue\0"
+    "paleolivegreen\0"               "palelightgreen\0"               "palelimegreen\0"                "orangishbrown\0"
+    "umber\0"                        "claybrown\0"                    "goldenbrown\0"                  "brownyellow\0"
+    "dust\0"                         "lightpastelgreen\0"             "lighturple\0"                   "darkrose\0"
+    "darkgold\0"                     "bile\0"                         "green/yellow\0"                 "copper\0"
+    "clay\0"                         "babypukegreen\0"                "lightmint\0"                    "burntsiena\0"
+    "palepurple\0"                   "yellowbrown\0"                  "lightbluegrey\0"                "lightgreygreen\0"
+    "palecyan\0"                     "paleaqua\0"                     "dustyred\0"                     "brownorange\0"
+    "taupe\0"                        "paleolive\0"                    "lightlimegreen\0"               "duskyrose\0"
+    "mushroom\0"                     "dullred\0"                      "yellowgreen\0"                  "neonpurple\0"
+    "greenishtan\0"                  "lightsage\0"                    "washedoutgreen\0"               "adobe\0"
+    "paleskyblue\0"                  "teagreen\0"                     "scarlet\0"                      "rosered\0"
+    "brightpurple\0"                 "orangebrown\0"                  "putty\0"                        "palelime\0"
+    "celadon\0"                      "lightpurple\0"                  "ochre\0"                        "ocher\0"
+    "muddyyellow\0"                  "yellowygreen\0"                 "lemonlime\0"                    "lipstickred\0"
+    "burntorange\0"                  "easterpurple\0"                 "dustyrose\0"                    "pistachio\0"
+    "yellowgreen\0"                  "brickorange\0"                  "lightperiwinkle\0"              "chartreuse\0"
+    "celery\0"                       "magenta\0"                      "brownishpink\0"                 "lightmauve\0"
+    "oliveyellow\0"                  "pukeyellow\0"                   "lightyellowishgreen\0"          "greypink\0"
+    "duckeggblue\0"                  "reddish\0"                      "rustorange\0"                   "liliac\0"
+    "sandybrown\0"                   "lightpeagreen\0"                "eggshellblue\0"                 "silver\0"
+    "darkorange\0"                   "ocre\0"                         "camel\0"                        "greenyyellow\0"
+    "lightskyblue\0"                 "deeprose\0"                     "brightlavender\0"               "oldpink\0"
+    "lavender\0"                     "toupe\0"                        "vomityellow\0"                  "palegreen\0"
+    "purpleypink\0"                  "darksalmon\0"                   "orchid\0"                       "dirtyorange\0"
+    "oldrose\0"                      "greyishpink\0"                  "pinkishgrey\0"                  "yellow/green\0"
+    "lightlightgreen\0"              "pinkypurple\0"                  "brightlilac\0"                  "terracotta\0"
+    "sandstone\0"                    "brownishyellow\0"               "greenishbeige\0"                "greenyellow\0"
+    "ruby\0"                         "terracotta\0"                   "brownyorange\0"                 "dirtypink\0"
+    "babypurple\0"                   "pastelpurple\0"                 "lightlightblue\0"               "hotpurple\0"
+    "deeppink\0"                     "darkpink\0"                     "terracota\0"                    "brownishorange\0"
+    "yellowochre\0"                  "sandbrown\0"                    "pear\0"                         "duskypink\0"
+    "desert\0"                       "lightyellowgreen\0"             "rustyorange\0"                  "uglypink\0"
+    "dirtyyellow\0"                  "greenishyellow\0"               "purplishpink\0"                 "lilac\0"
+    "paleviolet\0"                   "mustard\0"                      "cherry\0"                       "darkcoral\0"
+    "rose\0"                         "fawn\0"                         "verypalegreen\0"                "neonyellow\0"
+    "uglyyellow\0"                   "sicklyyellow\0"                 "limeyellow\0"                   "paleblue\0"
+    "mutedpink\0"                    "tan\0"                          "verylightgreen\0"               "mustardyellow\0"
+    "fadedred\0"                     "verylightbrown\0"               "pinkish\0"                      "reallylightblue\0"
+    "lipstick\0"                     "dullpink\0"                     "dustypink\0"                    "burntyellow\0"
+    "darkyellow\0"                   "verylightblue\0"                "pinkishpurple\0"                "lightviolet\0"
+    "ice\0"                          "verypaleblue\0"                 "purple/pink\0"                  "palemagenta\0"
+    "iceblue\0"                      "dullorange\0"                   "lightgrey\0"                    "darkhotpink\0"
+    "heliotrope\0"                   "palered\0"                      "pinkishtan\0"                   "darkishpink\0"
+    "pinkpurple\0"                   "pastelred\0"                    "gold\0"                         "deeporange\0"
+    "lavenderpink\0"                 "pissyellow\0"                   "cerise\0"                       "darkpeach\0"
+    "fadedpink\0"                    "purpleishpink\0"                "lightlavender\0"                "purplepink\0"
+    "pumpkin\0"                      "sand\0"                         "palelilac\0"                    "red\0"
+    "beige\0"                        "lightkhaki\0"                   "pigpink\0"                      "tomatored\0"
+    "fuchsia\0"                      "lightlilac\0"                   "palelavender\0"                 "dullyellow\0"
+    "pink/purple\0"                  "tomato\0"                       "macaroniandcheese\0"            "lightlavendar\0"
+    "purplypink\0"                   "dustyorange\0"                  "fadedorange\0"                  "pinkishred\0"
+    "sandy\0"                        "offyellow\0"                    "blush\0"                        "squash\0"
+    "mediumpink\0"                   "vermillion\0"                   "orangishred\0"                  "maize\0"
+    "hotmagenta\0"                   "pinkred\0"                      "golden\0"                       "rosypink\0"
+    "verylightpurple\0"              "cherryred\0"                    "rosepink\0"                     "lightmustard\0"
+    "reddishorange\0"                "orange\0"                       "goldenrod\0"                    "redpink\0"
+    "orangeyred\0"                   "lightmagenta\0"                 "goldenrod\0"                    "yellowish\0"
+    "bananayellow\0"                 "strawberry\0"                   "warmpink\0"                     "violetpink\0"
+    "pumpkinorange\0"                "wheat\0"                        "lighttan\0"                     "pinkyred\0"
+    "coral\0"                        "orangish\0"                     "pinky\0"                        "yelloworange\0"
+    "marigold\0"                     "sandyellow\0"                   "straw\0"                        "yellowishtan\0"
+    "redorange\0"                    "orangered\0"                    "watermelon\0"                   "grapefruit\0"
+    "carnation\0"                    "orangeish\0"                    "lightorange\0"                  "softpink\0"
+    "butterscotch\0"                 "orangeyyellow\0"                "palerose\0"                     "lightgold\0"
+    "palegold\0"                     "sandyyellow\0"                  "palegrey\0"                     "lemonyellow\0"
+    "lemon\0"                        "canary\0"                       "fireenginered\0"                "neonpink\0"
+    "brightpink\0"                   "shockingpink\0"                 "reddishpink\0"                  "lightishred\0"
+    "orangered\0"                    "barbiepink\0"                   "bloodorange\0"                  "salmonpink\0"
+    "blushpink\0"                    "bubblegumpink\0"                "rosa\0"                         "lightsalmon\0"
+    "saffron\0"                      "amber\0"                        "goldenyellow\0"                 "palemauve\0"
+    "dandelion\0"                    "buff\0"                         "parchment\0"                    "fadedyellow\0"
+    "ecru\0"                         "brightred\0"                    "hotpink\0"                      "electricpink\0"
+    "neonred\0"                      "strongpink\0"                   "brightmagenta\0"                "lightred\0"
+    "brightorange\0"                 "coralpink\0"                    "candypink\0"                    "bubblegumpink\0"
+    "bubblegum\0"                    "orangepink\0"                   "pinkishorange\0"                "melon\0"
+    "salmon\0"                       "carnationpink\0"                "pink\0"                         "tangerine\0"
+    "pastelorange\0"                 "peachypink\0"                   "mango\0"                        "paleorange\0"
+    "yellowishorange\0"              "orangeyellow\0"                 "peach\0"                        "apricot\0"
+    "palesalmon\0"                   "powderpink\0"                   "babypink\0"                     "pastelpink\0"
+    "sunflower\0"                    "lightrose\0"                    "palepink\0"                     "lightpink\0"
+    "lightpeach\0"                   "sunfloweryellow\0"              "sunyellow\0"                    "yellowtan\0"
+    "palepeach\0"                    "darkcream\0"                    "verylightpink\0"                "sunnyyellow\0"
+    "pale\0"                         "manilla\0"                      "eggshell\0"                     "brightyellow\0"
+    "sunshineyellow\0"               "butteryellow\0"                 "custard\0"                      "canaryyellow\0"
+    "pastelyellow\0"                 "lightyellow\0"                  "lightbeige\0"                   "yellow\0"
+    "banana\0"                       "butter\0"                       "paleyellow\0"                   "creme\0"
+    "cream\0"                        "ivory\0"                        "eggshell\0"                     "offwhite\0"
+    "white\0";
+
+const uint32_t xkcd_offs[] = {
+        0,     6,    19,    32,    41,    50,    59,    75,    88,   102,   111,   118,
+      130,   148,   153,   162,   167,   178,   190,   202,   211,   223,   234,   246,
+      261,   275,   285,   291,   300,   311,   319,   328,   339,   350,   362,   375,
+      384,   398,   407,   417,   430,   435,   446,   460,   474,   483,   492,   501,
+      512,   522,   534,   539,   549,   558,   568,   575,   587,   601,   609,   621,
+      630,   641,   650,   665,   675,   685,   704,   715,   724,   737,   752,   766,
+      778,   791,   797,   811,   821,   831,   843,   855,   864,   874,   891,   904,
+      914,   921,   930,   943,   954,   966,   973,   986,   997,  1008,  1019,  1025,
+     1035,  1048,  1058,  1070,  1080,  1091,  1107,  1116,  1128,  1141,  1151,  1161,
+     1167,  1172,  1182,  1195,  1205,  1211,  1227,  1235,  1240,  1257,  1271,  1276,
+     1283,  1292,  1302,  1313,  1326,  1340,  1345,  1357,  1369,  1383,  1395,  1404,
+     1418,  1429,  1443,  1452,  1462,  1472,  1480,  1490,  1499,  1508,  1524,  1532,
+     1547,  1560,  1573,  1580,  1595,  1605,  1618,  1623,  1633,  1644,  1655,  1672,
+     1689,  1703,  1714,  1725,  1734,  1747,  1757,  1768,  1778,  1787,  1798,  1808,
+     1821,  1832,  1841,  1851,  1863,  1870,  1879,  1894,  1906,  1917,  1932,  1943,
+     1953,  1959,  1969,  1980,  1993,  2008,  2017,  2021,  2031,  2041,  2054,  2065,
+     2076,  2093,  2102,  2112,  2123,  2132,  2144,  2154,  2169,  2181,  2192,  2203,
+     2218,  2229,  2241,  2251,  2261,  2270,  2281,  2290,  2299,  2308,  2320,  2331,
+     2340,  2350,  2366,  2376,  2386,  2397,  2406,  2411,  2421,  2436,  2449,  2466,
+     2477,  2486,  2497,  2503,  2518,  2529,  2539,  2561,  2570,  2579,  2596,  2607,
+     2617,  2623,  2631,  2639,  2655,  2670,  2681,  2686,  2696,  2706,  2715,  2727,
+     2737,  2747,  2757,  2766,  2776,  2782,  2794,  2805,  2817,  2829,  2841,  2850,
+     2861,  2873,  2882,  2893,  2906,  2915,  2924,  2933,  2942,  2956,  2967,  2981,
+     2993,  2998,  3009,  3020,  3025,  3037,  3055,  3066,  3076,  3085,  3092,  3098,
+     3109,  3119,  3129,  3140,  3144,  3160,  3171,  3186,  3200,  3211,  3223,  3234,
+     3241,  3248,  3260,  3274,  3280,  3290,  3301,  3315,  3326,  3340,  3355,  3364,
+     3373,  3379,  3390,  3402,  3413,  3424,  3430,  3436,  3448,  3458,  3468,  3478,
+     3488,  3501,  3512,  3523,  3535,  3540,  3551,  3562,  3578,  3585,  3597,  3601,
+     3607,  3616,  3627,  3638,  3648,  3658,  3665,  3679,  3689,  3699,  3711,  3719,
+     3732,  3747,  3752,  3763,  3774,  3791,  3802,  3808,  3818,  3827,  3837,  3847,
+     3859,  3869,  3882,  3895,  3905,  3918,  3927,  3935,  3945,  3956,  3966,  3978,
+     3994,  4004,  4015,  4022,  4029,  4040,  4054,  4069,  4084,  4097,  4111,  4123,
+     4128,  4133,  4143,  4153,  4158,  4163,  4175,  4183,  4193,  4205,  4216,  4221,
+     4234,  4238,  4247,  4257,  4265,  4276,  4285,  4295,  4308,  4317,  4328,  4341,
+     4352,  4362,  4370,  4376,  4386,  4399,  4404,  4415,  4424,  4435,  4449,  4463,
+     4473,  4487,  4499,  4509,  4520,  4530,  4535,  4548,  4561,  4570,  4580,  4593,
+     4601,  4609,  4621,  4631,  4641,  4654,  4664,  4670,  4681,  4690,  4700,  4709,
+     4713,  4725,  4739,  4754,  4764,  4771,  4781,  4791,  4799,  4809,  4819,  4833,
+     4845,  4854,  4863,  4868,  4876,  4885,  4894,  4904,  4916,  4929,  4939,  4951,
+     4962,  4971,  4981,  4993,  5003,  5013,  5026,  5038,  5049,  5058,  5067,  5074,
+     5084,  5090,  5105,  5119,  5131,  5141,  5147,  5159,  5170,  5178,  5185,  5192,
+     5202,  5212,  5228,  5237,  5252,  5262,  5269,  5283,  5292,  5302,  5314,  5319,
+     5327,  5339,  5349,  5355,  5365,  5379,  5389,  5407,  5417,  5427,  5439,  5452,
+     5461,  5470,  5475,  5487,  5500,  5506,  5517,  5528,  5541,  5548,  5560,  5566,
+     5572,  5583,  5592,  5603,  5611,  5627,  5631,  5641,  5656,  5670,  5675,  5682,
+     5687,  5701,  5712,  5719,  5734,  5749,  5758,  5776,  5781,  5795,  5802,  5811,
+     5823,  5832,  5840,  5853,  5866,  5877,  5884,  5893,  5905,  5920,  5928,  5934,
+     5939,  5945,  5954,  5962,  5969,  5978,  5986,  5999,  6013,  6023,  6028,  6039,
+     6050,  6060,  6074,  6087,  6098,  6112,  6118,  6129,  6135,  6148,  6158,  6166,
+     6175,  6183,  6191,  6197,  6207,  6219,  6231,  6246,  6258,  6271,  6284,  6294,
+     6305,  6320,  6335,  6349,  6363,  6369,  6379,  6391,  6403,  6408,  6425,  6436,
+     6445,  6454,  6459,  6472,  6479,  6484,  6498,  6508,  6519,  6530,  6542,  6556,
+     6571,  6580,  6589,  6598,  6610,  6616,  6626,  6641,  6651,  6660,  6668,  6680,
+     6691,  6703,  6713,  6728,  6734,  6746,  6755,  6763,  6771,  6784,  6796,  6802,
+     6811,  6819,  6831,  6837,  6843,  6855,  6868,  6878,  6890,  6902,  6915,  6925,
+     6935,  6947,  6959,  6975,  6986,  6993,  7001,  7014,  7025,  7037,  7048,  7068,
+     7077,  7089,  7097,  7108,  7115,  7126,  7140,  7153,  7160,  7171,  7176,  7182,
+     7195,  7208,  7217,  7232,  7240,  7249,  7255,  7267,  7277,  7289,  7300,  7307,
+     7319,  7327,  7339,  7351,  7364,  7380,  7392,  7404,  7415,  7425,  7440,  7454,
+     7466,  7471,  7482,  7495,  7505,  7516,  7529,  7544,  7554,  7563,  7572,  7582,
+     7597,  7609,  7619,  7624,  7634,  7641,  7658,  7670,  7679,  7691,  7706,  7719,
+     7725,  7736,  7744,  7751,  7761,  7766,  7771,  7785,  7796,  7807,  7820,  7831,
+     7840,  7850,  7854,  7869,  7883,  7892,  7907,  7915,  7931,  7940,  7949,  7959,
+     7971,  7982,  7996,  8010,  8022,  8026,  8039,  8051,  8063,  8071,  8082,  8092,
+     8104,  8115,  8123,  8134,  8146,  8157,  8167,  8172,  8183,  8196,  8207,  8214,
+     8224,  8234,  8248,  8262,  8273,  8281,  8286,  8296,  8300,  8306,  8317,  8325,
+     8335,  8343,  8354,  8367,  8378,  8390,  8397,  8415,  8429,  8440,  8452,  8464,
+     8475,  8481,  8491,  8497,  8504,  8515,  8526,  8538,  8544,  8555,  8563,  8570,
+     8579,  8595,  8605,  8614,  8627,  8641,  8648,  8658,  8666,  8677,  8690,  8700,
+     8710,  8723,  8734,  8743,  8754,  8768,  8774,  8783,  8792,  8798,  8807,  8813,
+     8826,  8835,  8846,  8852,  8865,  8875,  8885,  8896,  8907,  8917,  8927,  8939,
+     8948,  8961,  8975,  8984,  8994,  9003,  9015,  9024,  9036,  9042,  9049,  9063,
+     9072,  9083,  9096,  9108,  9120,  9130,  9141,  9153,  9164,  9174,  9188,  9193,
+     9205,  9213,  9219,  9232,  9242,  9252,  9257,  9267,  9279,  9284,  9294,  9302,
+     9315,  9323,  9334,  9348,  9357,  9370,  9380,  9390,  9404,  9414,  9425,  9439,
+     9445,  9452,  9466,  9471,  9481,  9494,  9505,  9511,  9522,  9538,  9551,  9557,
+     9565,  9576,  9587,  9596,  9607,  9617,  9627,  9636,  9646,  9657,  9673,  9683,
+     9693,  9703,  9713,  9727,  9739,  9744,  9752,  9761,  9774,  9789,  9802,  9810,
+     9823,  9836,  9848,  9859,  9866,  9873,  9880,  9891,  9897,  9903,  9909,  9918,
+     9927
+};
+
+const hex_t xkcd_hex[] = {
+    0x000000, 0x000133, 0x00022e, 0x00035b, 0x000435, 0x001146, 0x002d04, 0x004577, 0x005249, 0x00555a, 0x005f6a, 0x009337,
+    0x00fbb0, 0x00ffff, 0x010fcc, 0x01153e, 0x01386a, 0x014182, 0x014600, 0x014d4e, 0x015482, 0x0165fc, 0x016795, 0x017371,
+    0x017374, 0x017a79, 0x017b92, 0x01889f, 0x019529, 0x01a049, 0x01b44c, 0x01c08d, 0x01f9c6, 0x01ff07, 0x020035, 0x0203e2,
+    0x02066f, 0x021bf9, 0x02590f, 0x028f1e, 0x029386, 0x02ab2e, 0x02c14d, 0x02ccfe, 0x02d8e9, 0x03012d, 0x030764, 0x030aa7,
+    0x033500, 0x0339f8, 0x0343df, 0x03719c, 0x040273, 0x040348, 0x042e60, 0x044a05, 0x045c5a, 0x047495, 0x048243, 0x0485d1,
+    0x04d8b2, 0x04d9ff, 0x04f489, 0x0504aa, 0x05472a, 0x05480d, 0x054907, 0x05696b, 0x056eee, 0x05ffa6, 0x062e03, 0x06470c,
+    0x0652ff, 0x069af3, 0x06b1c4, 0x06b48b, 0x06c2ac, 0x070d0d, 0x0804f9, 0x08787f, 0x089404, 0x08ff08, 0x0a437a, 0x0a481e,
+    0x0a5f38, 0x0a888a, 0x0add08, 0x0aff02, 0x0b4008, 0x0b5509, 0x0b8b87, 0x0bf77d, 0x0bf9ea, 0x0c06f7, 0x0c1793, 0x0cb577,
+    0x0cdc73, 0x0cff0c, 0x0d75f8, 0x0e87cc, 0x0f9b8e, 0x0ffef9, 0x107ab0, 0x10a674, 0x11875d, 0x12e193, 0x137e6d, 0x13bbaf,
+    0x13eac9, 0x152eff, 0x154406, 0x155084, 0x15b01a, 0x1805db, 0x18d17b, 0x1b2431, 0x1bfc06, 0x1d0200, 0x1d5dec, 0x1e488f,
+    0x1e9167, 0x1ef876, 0x1f0954, 0x1f3b4d, 0x1f6357, 0x1fa774, 0x1fb57a, 0x2000b1, 0x20c073, 0x20f986, 0x2138ab, 0x214761,
+    0x21c36f, 0x21fc0d, 0x2242c7, 0x23c48b, 0x247afd, 0x24bca8, 0x25a36f, 0x25ff29, 0x26538d, 0x26f7fd, 0x276ab3, 0x280137,
+    0x287c37, 0x29465b, 0x2976bb, 0x2a0134, 0x2a7e19, 0x2afeb7, 0x2b5d34, 0x2baf6a, 0x2bb179, 0x2c6fbb, 0x2cfa1f, 0x2dfe54,
+    0x2e5a88, 0x2ee8bb, 0x2fef10, 0x31668a, 0x32bf84, 0x33b864, 0x34013f, 0x341c02, 0x343837, 0x35063e, 0x35530a, 0x35ad6b,
+    0x36013f, 0x363737, 0x373e02, 0x3778bf, 0x380282, 0x380835, 0x388004, 0x39ad48, 0x3a18b1, 0x3a2efe, 0x3ae57f, 0x3b5b92,
+    0x3b638c, 0x3b719f, 0x3c0008, 0x3c4142, 0x3c4d03, 0x3c73a8, 0x3c9992, 0x3d0734, 0x3d1c02, 0x3d7afd, 0x3d9973, 0x3e82fc,
+    0x3eaf76, 0x3f012c, 0x3f829d, 0x3f9b0b, 0x40a368, 0x40fd14, 0x410200, 0x411900, 0x419c03, 0x41fdfe, 0x42b395, 0x430541,
+    0x436bad, 0x448ee4, 0x464196, 0x475f94, 0x48c072, 0x490648, 0x49759c, 0x4984b8, 0x4a0100, 0x4b006e, 0x4b0101, 0x4b57db,
+    0x4b5d16, 0x4b6113, 0x4c9085, 0x4da409, 0x4e0550, 0x4e518b, 0x4e5481, 0x4e7496, 0x4efd54, 0x4f738e, 0x4f9153, 0x507b9c,
+    0x50a747, 0x510ac9, 0x516572, 0x5170d7, 0x51b73b, 0x526525, 0x533cc6, 0x536267, 0x53fca1, 0x53fe5c, 0x544e03, 0x548d44,
+    0x54ac68, 0x5539cc, 0x5684ae, 0x56ae57, 0x56fca2, 0x5729ce, 0x580f41, 0x58bc08, 0x59656d, 0x598556, 0x5a06ef, 0x5a7d9a,
+    0x5a86ad, 0x5b7c99, 0x5c8b15, 0x5ca904, 0x5cac2d, 0x5cb200, 0x5d06e9, 0x5d1451, 0x5d21d0, 0x5e819d, 0x5e9b8a, 0x5edc1f,
+    0x5f34e7, 0x5f9e8f, 0x5fa052, 0x601ef9, 0x60460f, 0x606602, 0x607c8e, 0x610023, 0x6140ef, 0x61de2a, 0x61e160, 0x6241c7,
+    0x6258c4, 0x632de9, 0x638b27, 0x63a950, 0x63b365, 0x63f7b4, 0x645403, 0x647d8e, 0x6488ea, 0x650021, 0x653700, 0x657432,
+    0x658b38, 0x658cbb, 0x658d6d, 0x65ab7c, 0x65fe08, 0x661aee, 0x665fd1, 0x667c3e, 0x667e2c, 0x673a3f, 0x677a04, 0x680018,
+    0x6832e3, 0x696006, 0x696112, 0x698339, 0x699d4c, 0x69d84f, 0x6a6e09, 0x6a79f7, 0x6b4247, 0x6b7c85, 0x6b8ba4, 0x6ba353,
+    0x6c3461, 0x6c7a0e, 0x6d5acf, 0x6dedfd, 0x6e1005, 0x6e750e, 0x6ecb3c, 0x6f6c0a, 0x6f7632, 0x6f7c00, 0x6f828a, 0x6fc276,
+    0x703be7, 0x706c11, 0x70b23f, 0x719f91, 0x71aa34, 0x720058, 0x728639, 0x728f02, 0x730039, 0x734a65, 0x735c12, 0x738595,
+    0x742802, 0x748500, 0x748b97, 0x749551, 0x74a662, 0x750851, 0x751973, 0x758000, 0x758da3, 0x75b84f, 0x75bbfd, 0x75fd63,
+    0x76424e, 0x769958, 0x76a973, 0x76cd26, 0x76fda8, 0x76ff7b, 0x770001, 0x77926f, 0x77a1b5, 0x77ab56, 0x789b73, 0x78d1b6,
+    0x7a5901, 0x7a687f, 0x7a6a4f, 0x7a9703, 0x7af9ab, 0x7b002c, 0x7b0323, 0x7b5804, 0x7bb274, 0x7bc8f6, 0x7bf2da, 0x7bfdc7,
+    0x7d7103, 0x7d7f7c, 0x7e1e9c, 0x7e4071, 0x7ea07a, 0x7ebd01, 0x7ef4cc, 0x7efbb3, 0x7f2b0a, 0x7f4e1e, 0x7f5112, 0x7f5e00,
+    0x7f5f00, 0x7f684e, 0x7f7053, 0x7f8f4e, 0x80013f, 0x805b87, 0x80f9ad, 0x820747, 0x825f87, 0x826d8c, 0x828344, 0x82a67d,
+    0x82cafc, 0x82cbb2, 0x836539, 0x840000, 0x84597e, 0x84b701, 0x850e04, 0x856798, 0x85a3b2, 0x866f85, 0x86775f, 0x86a17d,
+    0x874c62, 0x8756e4, 0x875f42, 0x876e4b, 0x87a922, 0x87ae73, 0x87fd05, 0x885f01, 0x886806, 0x887191, 0x889717, 0x88b378,
+    0x894585, 0x895b7b, 0x89a0b0, 0x89a203, 0x89fe05, 0x8a6e45, 0x8ab8fe, 0x8af1fe, 0x8b2e16, 0x8b3103, 0x8b88f8, 0x8c000f,
+    0x8c0034, 0x8cfd7e, 0x8cff9e, 0x8cffdb, 0x8d5eb7, 0x8d8468, 0x8e7618, 0x8e82fe, 0x8eab12, 0x8ee53f, 0x8f1402, 0x8f7303,
+    0x8f8ce7, 0x8f9805, 0x8f99fb, 0x8fae22, 0x8fb67b, 0x8ffe09, 0x8fff9f, 0x90b134, 0x90e4c1, 0x90fda9, 0x910951, 0x916e99,
+    0x920a4e, 0x922b05, 0x929591, 0x929901, 0x937c00, 0x94568c, 0x947706, 0x947e94, 0x94a617, 0x94ac02, 0x94b21c, 0x952e8f,
+    0x95a3a6, 0x95d0fc, 0x960056, 0x964e02, 0x966ebd, 0x96ae8d, 0x96b403, 0x96f97b, 0x978a84, 0x980002, 0x983fb2, 0x98568d,
+    0x985e2b, 0x98eff9, 0x98f6b0, 0x9900fa, 0x990147, 0x990f4b, 0x997570, 0x99cc04, 0x9a0200, 0x9a0eea, 0x9a3001, 0x9a6200,
+    0x9aae07, 0x9af764, 0x9b5fc0, 0x9b7a01, 0x9b8f55, 0x9bb53c, 0x9be5aa, 0x9c6d57, 0x9c6da5, 0x9cbb04, 0x9cef43, 0x9d0216,
+    0x9d0759, 0x9d5783, 0x9d7651, 0x9db92c, 0x9dbcd4, 0x9dc100, 0x9dff00, 0x9e003a, 0x9e0168, 0x9e3623, 0x9e43a2, 0x9f2305,
+    0x9f8303, 0x9ffeb0, 0xa0025c, 0xa00498, 0xa03623, 0xa0450e, 0xa0bf16, 0xa0febf, 0xa13905, 0xa24857, 0xa2653e, 0xa2a415,
+    0xa2bffe, 0xa2cffe, 0xa442a0, 0xa484ac, 0xa4be5c, 0xa4bf20, 0xa50055, 0xa552e6, 0xa55af4, 0xa57e52, 0xa5a391, 0xa5a502,
+    0xa5fbd5, 0xa66fb5, 0xa6814c, 0xa6c875, 0xa6fbb2, 0xa75e09, 0xa7ffb5, 0xa83c09, 0xa8415b, 0xa87900, 0xa87dc2, 0xa88905,
+    0xa88f59, 0xa8a495, 0xa8b504, 0xa8ff04, 0xa90308, 0xa9561e, 0xa9be70, 0xa9f971, 0xaa23ff, 0xaa2704, 0xaaa662, 0xaaff32,
+    0xab1239, 0xab7e4c, 0xab9004, 0xac1db8, 0xac4f06, 0xac7434, 0xac7e04, 0xac86a8, 0xac9362, 0xacbb0d, 0xacbf69, 0xacc2d9,
+    0xacfffc, 0xad03de, 0xad0afd, 0xad8150, 0xad900d, 0xada587, 0xadf802, 0xae7181, 0xae8b0c, 0xaefd6c, 0xaeff6e, 0xaf2f0d,
+    0xaf6f09, 0xaf884a, 0xafa88b, 0xb00149, 0xb0054b, 0xb04e0f, 0xb0dd16, 0xb0ff9d, 0xb16002, 0xb17261, 0xb1916e, 0xb1d1fc,
+    0xb1d27b, 0xb1fc99, 0xb1ff65, 0xb25f03, 0xb26400, 0xb2713d, 0xb27a01, 0xb29705, 0xb2996e, 0xb2fba5, 0xb36ff6, 0xb5485d,
+    0xb59410, 0xb5c306, 0xb5ce08, 0xb66325, 0xb66a50, 0xb6c406, 0xb6ffbb, 0xb75203, 0xb790d4, 0xb79400, 0xb7c9e2, 0xb7e1a1,
+    0xb7fffa, 0xb8ffeb, 0xb9484e, 0xb96902, 0xb9a281, 0xb9cc81, 0xb9ff66, 0xba6873, 0xba9e88, 0xbb3f3f, 0xbbf90f, 0xbc13fe,
+    0xbccb7a, 0xbcecac, 0xbcf5a6, 0xbd6c48, 0xbdf6fe, 0xbdf8a3, 0xbe0119, 0xbe013c, 0xbe03fd, 0xbe6400, 0xbeae8a, 0xbefd73,
+    0xbefdb7, 0xbf77f6, 0xbf9005, 0xbf9b0c, 0xbfac05, 0xbff128, 0xbffe28, 0xc0022f, 0xc04e01, 0xc071fe, 0xc0737a, 0xc0fa8b,
+    0xc0fb2d, 0xc14a09, 0xc1c6fc, 0xc1f80a, 0xc1fd95, 0xc20078, 0xc27e79, 0xc292a1, 0xc2b709, 0xc2be0e, 0xc2ff89, 0xc3909b,
+    0xc3fbf4, 0xc44240, 0xc45508, 0xc48efd, 0xc4a661, 0xc4fe82, 0xc4fff7, 0xc5c9c7, 0xc65102, 0xc69c04, 0xc69f59, 0xc6f808,
+    0xc6fcff, 0xc74767, 0xc760ff, 0xc77986, 0xc79fef, 0xc7ac7d, 0xc7c10c, 0xc7fdb5, 0xc83cb9, 0xc85a53, 0xc875c4, 0xc87606,
+    0xc87f89, 0xc88d94, 0xc8aca9, 0xc8fd3d, 0xc8ffb0, 0xc94cbe, 0xc95efb, 0xc9643b, 0xc9ae74, 0xc9b003, 0xc9d179, 0xc9ff27,
+    0xca0147, 0xca6641, 0xca6b02, 0xca7b80, 0xca9bf7, 0xcaa0ff, 0xcafffb, 0xcb00f5, 0xcb0162, 0xcb416b, 0xcb6843, 0xcb7723,
+    0xcb9d06, 0xcba560, 0xcbf85f, 0xcc7a8b, 0xccad60, 0xccfd7f, 0xcd5909, 0xcd7584, 0xcdc50a, 0xcdfd02, 0xce5dae, 0xcea2fd,
+    0xceaefa, 0xceb301, 0xcf0234, 0xcf524e, 0xcf6275, 0xcfaf7b, 0xcffdbc, 0xcfff04, 0xd0c101, 0xd0e429, 0xd0fe1d, 0xd0fefe,
+    0xd1768f, 0xd1b26f, 0xd1ffbd, 0xd2bd0a, 0xd3494e, 0xd3b683, 0xd46a7e, 0xd4ffff, 0xd5174e, 0xd5869d, 0xd58a94, 0xd5ab09,
+    0xd5b60a, 0xd5ffff, 0xd648d7, 0xd6b4fc, 0xd6fffa, 0xd6fffe, 0xd725de, 0xd767ad, 0xd7fffe, 0xd8863b, 0xd8dcd6, 0xd90166,
+    0xd94ff5, 0xd9544d, 0xd99b82, 0xda467d, 0xdb4bda, 0xdb5856, 0xdbb40c, 0xdc4d01, 0xdd85d7, 0xddd618, 0xde0c62, 0xde7e5d,
+    0xde9dac, 0xdf4ec8, 0xdfc5fe, 0xe03fd8, 0xe17701, 0xe2ca76, 0xe4cbff, 0xe50000, 0xe6daa6, 0xe6f2a2, 0xe78ea5, 0xec2d01,
+    0xed0dd9, 0xedc8ff, 0xeecffe, 0xeedc5b, 0xef1de7, 0xef4026, 0xefb435, 0xefc0fe, 0xf075e6, 0xf0833a, 0xf0944d, 0xf10c45,
+    0xf1da7a, 0xf1f33f, 0xf29e8e, 0xf2ab15, 0xf36196, 0xf4320c, 0xf43605, 0xf4d054, 0xf504c9, 0xf5054f, 0xf5bf03, 0xf6688e,
+    0xf6cefc, 0xf7022a, 0xf7879a, 0xf7d560, 0xf8481c, 0xf97306, 0xf9bc08, 0xfa2a55, 0xfa4224, 0xfa5ff7, 0xfac205, 0xfaee66,
+    0xfafe4b, 0xfb2943, 0xfb5581, 0xfb5ffc, 0xfb7d07, 0xfbdd7e, 0xfbeeac, 0xfc2647, 0xfc5a50, 0xfc824a, 0xfc86aa, 0xfcb001,
+    0xfcc006, 0xfce166, 0xfcf679, 0xfcfc81, 0xfd3c06, 0xfd411e, 0xfd4659, 0xfd5956, 0xfd798f, 0xfd8d49, 0xfdaa48, 0xfdb0c0,
+    0xfdb147, 0xfdb915, 0xfdc1c5, 0xfddc5c, 0xfdde6c, 0xfdee73, 0xfdfdfe, 0xfdff38, 0xfdff52, 0xfdff63, 0xfe0002, 0xfe019a,
+    0xfe01b1, 0xfe02a2, 0xfe2c54, 0xfe2f4a, 0xfe420f, 0xfe46a5, 0xfe4b03, 0xfe7b7c, 0xfe828c, 0xfe83cc, 0xfe86a4, 0xfea993,
+    0xfeb209, 0xfeb308, 0xfec615, 0xfed0fc, 0xfedf08, 0xfef69e, 0xfefcaf, 0xfeff7f, 0xfeffca, 0xff000d, 0xff028d, 0xff0490,
+    0xff073a, 0xff0789, 0xff08e8, 0xff474c, 0xff5b00, 0xff6163, 0xff63e9, 0xff69af, 0xff6cb5, 0xff6f52, 0xff724c, 0xff7855,
+    0xff796c, 0xff7fa7, 0xff81c0, 0xff9408, 0xff964f, 0xff9a8a, 0xffa62b, 0xffa756, 0xffab0f, 0xffad01, 0xffb07c, 0xffb16d,
+    0xffb19a, 0xffb2d0, 0xffb7ce, 0xffbacd, 0xffc512, 0xffc5cb, 0xffcfdc, 0xffd1df, 0xffd8b1, 0xffda03, 0xffdf22, 0xffe36e,
+    0xffe5ad, 0xfff39a, 0xfff4f2, 0xfff917, 0xfff9d0, 0xfffa86, 0xfffcc4, 0xfffd01, 0xfffd37, 0xfffd74, 0xfffd78, 0xfffe40,
+    0xfffe71, 0xfffe7a, 0xfffeb6, 0xffff14, 0xffff7e, 0xffff81, 0xffff84, 0xffffb6, 0xffffc2, 0xffffcb, 0xffffd4, 0xffffe4,
+    0xffffff
 };
-const size_t xkcd_colors_size = ARRAY_LENGTH(xkcd_colors);
 
-#endif
\ No newline at end of file
+const named_table_t xkcd_colors = { xkcd_pool, xkcd_offs, xkcd_hex, ARRAY_LENGTH(xkcd_hex) };
+
+#endif
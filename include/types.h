@@ -3,6 +3,8 @@
 #define TYPES_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #define ARRAY_LENGTH(x)       (sizeof(x) / sizeof((x)[0]))
 #define CLAMP(_n, _l, _r)     ((_n) < (_l) ? (_l) : ((_n) > (_r) ? (_r) : (_n)))
@@ -20,6 +22,12 @@
 #define W_G 0.587
 #define W_B 0.114
 
+// integer versions of the weights above (scaled by 1000) for exact, overflow-free integer distances on 8-bit channels
+#define W_SCALE 1000
+#define W_R_I   ((int)(W_R * W_SCALE + 0.5))
+#define W_G_I   ((int)(W_G * W_SCALE + 0.5))
+#define W_B_I   ((int)(W_B * W_SCALE + 0.5))
+
 #define NULLSTR  "<NULL>"
 
 // used in tests (assume color supported, cba disabling now)
@@ -30,15 +38,39 @@
 #define C_GREEN  "\x1b[32m"
 #define C_LGREEN "\x1b[92m"
 
+// color difference method
+typedef enum {
+    CDIFF_RGB = 0,  // plain RGB squared distance
+    CDIFF_WRGB,     // weighted RGB squared distance (W_R, W_G, W_B)
+    CDIFF_OKLAB,    // perceptual Oklab squared distance
+    CDIFF_DE76,     // CIELAB euclidian distance (CIE76)
+    CDIFF_DE94,     // CIE94 (graphic arts)
+    CDIFF_DE2000,   // CIEDE2000
+    CDIFF_CMC,      // CMC l:c (2:1)
+    CDIFF_ALL      // print all of the above
+} cdiff_t;
+
 // supported color models
-typedef struct { int r, g, b; }                              rgb_t;
-typedef struct { double c, m, y, k; }                        cmyk_t;
-typedef struct { double h, sat, l; }                         hsl_t;
-typedef struct { double h, sat, v; }                         hsv_t;
-typedef unsigned                                             hex_t;
-typedef struct { double L; double a; double b; }             oklab_t;
-typedef struct { double L; double c; double h; }             oklch_t;
-typedef struct { const char *name; hex_t hex; double diff; } named_t;
+typedef struct { int r, g, b; }                                              rgb_t;
+typedef struct { double c, m, y, k; }                                        cmyk_t;
+typedef struct { double h, sat, l; }                                         hsl_t;
+typedef struct { double h, sat, v; }                                         hsv_t;
+typedef unsigned                                                             hex_t;
+typedef struct { double L; double a; double b; }                             oklab_t;
+typedef struct { double L; double c; double h; }                             oklch_t;
+typedef struct { double L; double a; double b; }                             lab_t;
+typedef struct { double L; double c; double h; }                             lch_t;
+typedef struct { double x; double y; double z; }                             xyz_t;   // cie xyz (d65), y = 1 for white
+typedef struct { double y; double cb; double cr; }                           ycbcr_t; // 8-bit code values (see yuv.h)
+typedef struct { const char *name; hex_t hex; double diff; cdiff_t metric; } named_t; // diff: distance in metric
+
+// packed named color table (see include/tables.h)
+typedef struct {
+    const char     *pool; // all names, nul-separated
+    const uint32_t *offs; // offset of each name in pool
+    const hex_t    *hex;  // hex value of each name
+    size_t          size; // number of entries
+} named_table_t;
 
 // color struct including all color models
 typedef struct { 
@@ -49,7 +81,9 @@ typedef struct {
     hsv_t   hsv;
     oklab_t oklab;
     oklch_t oklch;
+    xyz_t   xyz;   // unclipped source of the wide-gamut models (-c p3 / rec2020 / xyz / lab / lch)
     named_t named;
+    double  alpha; // opacity from 0 (transparent) to 1 (opaque), the other models are the color itself, not composited
 } color_t;
 
 // parser function for parsing a string
@@ -76,13 +110,116 @@ typedef struct {
     char *fgbufptr;    // pointer to char buffer containing foreground color ANSI escape code
 } print_ctx_t;
 
-// color difference method
+// math precision for the oklab / oklch conversions
 typedef enum {
-    CDIFF_RGB = 0,  // plain RGB squared distance
-    CDIFF_WRGB,     // weighted RGB squared distance (W_R, W_G, W_B)
-    CDIFF_OKLAB,    // perceptual Oklab squared distance
-    CDIFF_ALL      // print both RGB and Oklab distances
-} cdiff_t;
+    PRECISION_EXACT = 0, // libm (cbrt, atan2, sin, cos)
+    PRECISION_FAST       // polynomial approximations, printed output identical to exact (see converter.c)
+} precision_t;
+
+// handling of colors outside the srgb gamut when converting back to rgb
+typedef enum {
+    GAMUT_CLIP = 0, // clamp every channel to [0,1] (may shift hue and lightness)
+    GAMUT_MAP       // css color 4 gamut mapping: reduce oklch chroma, keep lightness and hue (see convert_impl.h)
+} gamut_t;
+
+// contrast metric of the solver and contrast matrix
+typedef enum {
+    CONTRAST_WCAG = 0, // wcag 2 contrast ratio (1..21, symmetric)
+    CONTRAST_APCA      // apca lightness contrast Lc (wcag 3 draft, depends on which color is the text)
+} contrast_metric_t;
+
+// simulated color vision deficiency
+typedef enum {
+    CVD_NONE = 0,
+    CVD_PROTAN,  // missing / anomalous l cones (red)
+    CVD_DEUTAN,  // missing / anomalous m cones (green)
+    CVD_TRITAN   // missing / anomalous s cones (blue)
+} cvd_t;
+
+// palette the output of a generated 3d lookup table is snapped to
+typedef enum {
+    SNAP_NONE = 0,
+    SNAP_NAMED,    // closest named color (css, or xkcd with -x)
+    SNAP_ANSI16,   // closest of the 16 ansi colors
+    SNAP_ANSI256   // closest of the 256 ansi colors
+} snap_t;
+
+// rgb spaces of color(...) and --from (css color 4 names)
+typedef enum {
+    RGBSPACE_SRGB = 0,
+    RGBSPACE_SRGB_LINEAR, // srgb primaries, linear light
+    RGBSPACE_DISPLAY_P3,  // dci-p3 primaries, d65 white, srgb transfer function
+    RGBSPACE_REC2020,     // itu-r bt.2020 primaries and transfer function
+    RGBSPACE_REC2100_PQ,  // bt.2020 primaries, hdr pq transfer function (absolute, srgb white at the sdr white level)
+    RGBSPACE_REC2100_HLG, // bt.2020 primaries, hdr hlg transfer function and ootf (1000 cd/m2 display, reference white 0.75 at about 203 cd/m2)
+    RGBSPACE_COUNT
+} rgbspace_t;
+
+// ycbcr matrix coefficients (luma weights of the standard)
+typedef enum {
+    YCBCR_BT601 = 0, // W_R, W_G, W_B (sd video, jpeg)
+    YCBCR_BT709,     // hd video
+    YCBCR_BT2020     // uhd video (non-constant luminance)
+} ycbcr_std_t;
+
+// memory layout of raw 4:2:0 frames
+typedef enum {
+    YUV_I420 = 0, // y plane, then the cb and cr planes at half width and height
+    YUV_NV12      // y plane, then one plane of interleaved cb / cr pairs
+} yuv_layout_t;
+
+// blend modes of alpha compositing (w3c compositing and blending level 1, the css mix-blend-mode names)
+typedef enum {
+    BLEND_NORMAL = 0,  // plain source-over
+    BLEND_MULTIPLY,
+    BLEND_SCREEN,
+    BLEND_OVERLAY,
+    BLEND_DARKEN,
+    BLEND_LIGHTEN,
+    BLEND_COLOR_DODGE,
+    BLEND_COLOR_BURN,
+    BLEND_HARD_LIGHT,
+    BLEND_SOFT_LIGHT,
+    BLEND_DIFFERENCE,
+    BLEND_EXCLUSION,
+    BLEND_HUE,         // non-separable modes: hue / saturation / luminosity of one color with the rest of the other
+    BLEND_SATURATION,
+    BLEND_COLOR,
+    BLEND_LUMINOSITY,
+    BLEND_COUNT
+} blend_t;
+
+// palette extraction methods (see palette.h)
+typedef enum {
+    EXTRACT_KMEANS = 0, // k-means++ seeding, then lloyd iterations
+    EXTRACT_MEDIAN_CUT, // split the box with the largest error at its weighted median
+    EXTRACT_OCTREE      // streaming octree, leaves merged as they exceed a fixed budget
+} extract_t;
+
+// dithering of images snapped to a palette (see dither.h)
+typedef enum {
+    DITHER_NONE = 0,        // closest palette color per pixel
+    DITHER_FLOYD_STEINBERG, // error diffusion to 4 neighbours (7, 3, 5, 1 / 16)
+    DITHER_ATKINSON,        // error diffusion of 6 / 8 of the error to 6 neighbours
+    DITHER_BAYER,           // ordered, 8x8 bayer matrix
+    DITHER_BLUE_NOISE       // ordered, 64x64 void-and-cluster blue noise mask
+} dither_t;
+
+// output of image mode (see render.h)
+typedef enum {
+    RENDER_PPM = 0, // binary ppm
+    RENDER_SIXEL,   // dec sixel graphics, palette of --snap (ansi256 if none)
+    RENDER_KITTY    // kitty graphics protocol, raw rgb in base64 chunks
+} render_t;
+
+// output format of lists of colors and matrices (batch / gradient / matrix mode)
+typedef enum {
+    FORMAT_TEXT = 0, // one color per line, converted to -c <model>
+    FORMAT_JSON,     // json array of -c <model> objects
+    FORMAT_CSV,      // index,hex,r,g,b
+    FORMAT_BIN,      // raw 8-bit rgb triples
+    FORMAT_C         // c array of 8-bit rgb triples
+} format_t;
 
 // program options container
 typedef struct {
@@ -97,6 +234,50 @@ typedef struct {
     bool        distance;      // should we do distance calculation between two colors?
     bool        contrast;      // should we do contrast calculation between two colors?
     cdiff_t     cdiff;         // color difference metric
+    precision_t precision;     // math precision for oklab / oklch conversions
+    gamut_t     gamut;         // out-of-gamut handling for oklab / oklch input
+    bool        gamutset;      // did we set the gamut handling manually via the command line?
+    const char *batch;         // batch input file ("-" for stdin), NULL if not in batch mode
+    bool        unique;        // batch: drop repeated colors?
+    int         sortkey;       // batch: sort key (store_key_t), -1 to keep input order
+    bool        reverse;       // batch: sort in descending order?
+    char      **gradient;      // gradient: stop colors (pointer into argv), NULL if not in gradient mode
+    int         gradient_n;    // gradient: number of stop colors
+    int         steps;         // gradient: number of colors to generate
+    int         space;         // gradient: interpolation space (grad_space_t)
+    int         hue;           // gradient: oklch hue interpolation (hue_interp_t)
+    format_t    format;        // batch / gradient / matrix: output format
+    const char *matrix;        // matrix input file ("-" for stdin), NULL if not in matrix mode
+    bool        upper;         // matrix: only the upper triangle (pairs i < j)?
+    double      epsilon;       // matrix: print pairs closer than this instead of the dense matrix, < 0 for dense
+    char      **fix;           // fix contrast: fg and bg words (pointer into argv), NULL if not fixing a single pair
+    int         fix_n;         // fix contrast: number of words in fix
+    const char *fixbatch;      // fix contrast: "fg bg" pairs file ("-" for stdin), NULL if not in batch mode
+    double      target;        // fix contrast: wcag contrast ratio or apca |Lc| to reach, < 0 for the metric's default
+    int         cmetric;       // fix contrast / contrast matrix: contrast metric (contrast_metric_t)
+    cvd_t       cvd;           // simulated color vision deficiency, CVD_NONE for normal vision
+    double      severity;      // cvd: severity from 0 (normal) to 1 (dichromacy)
+    const char *image;         // image mode: input ppm file ("-" for stdin), NULL if not in image mode
+    const char *makelut;       // lut mode: output .cube file ("-" for stdout), NULL if not generating a lut
+    int         lutsize;       // lut mode: nodes per axis (2..256)
+    snap_t      snap;          // lut / image mode: palette the output is snapped to after --cvd / --gamut
+    dither_t    dither;        // image mode: dithering of --snap
+    bool        ditherlin;     // image mode: diffuse the error in linear light instead of oklab?
+    render_t    render;        // image mode: output format
+    const char *lut;           // .cube file applied to --image and --batch colors, NULL for none
+    bool        tetra;         // lut: tetrahedral (true) or trilinear interpolation
+    const char *cmatrix;       // contrast matrix input file ("-" for stdin), NULL if not in contrast matrix mode
+    rgbspace_t  from;          // rgb space of --image and --batch input, converted to srgb first
+    const char *yuv;           // yuv mode: raw 4:2:0 frames to convert to ppm ("-" for stdin), NULL if not in yuv mode
+    const char *toyuv;         // yuv mode: ppm images to convert to raw 4:2:0 frames ("-" for stdin), NULL for none
+    size_t      yuvw, yuvh;    // yuv mode: frame size of the raw input
+    int         layout;        // yuv mode: layout of the raw frames (yuv_layout_t)
+    hex_t       over;          // opaque backdrop translucent colors and pixels are composited over (--batch, --image, -C)
+    blend_t     blend;         // blend mode of the compositing
+    bool        blendlinear;   // composite in linear light instead of gamma-encoded srgb?
+    const char *extract;       // extract mode: image to take the dominant colors of ("-" for stdin), NULL if not in extract mode
+    int         ncolors;       // extract: number of colors
+    extract_t   method;        // extract: clustering method
 } prog_opts_t;
 
 
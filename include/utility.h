@@ -2,15 +2,60 @@
 #ifndef UTILITY_H
 #define UTILITY_H
 
+#include <stdatomic.h>
 #include <stdio.h>
 #include "types.h"
 
+// tables built on first use: the first caller builds them inside a named omp critical section and only then sets the
+// ready flag (release), every caller checks it first (acquire), so whoever finds it set also sees the complete table
+static inline bool once_ready(atomic_bool *flag) { return atomic_load_explicit(flag, memory_order_acquire); }
+static inline void once_done(atomic_bool *flag)  { atomic_store_explicit(flag, true, memory_order_release); }
+
 // linearize
 double srgb_to_linear(double c);
 
 // gamma-encode
 double linear_to_srgb(double c);
 
+// hdr (rec. 2100) transfer functions in absolute luminance: pq spans 0..PQ_MAX_NITS, hlg is scene referred and shown
+// on a display of HLG_PEAK_NITS, which puts signal 0.75 (bt.2408 reference white) at about 203 cd/m2
+#define PQ_MAX_NITS   10000.0
+#define HLG_PEAK_NITS 1000.0
+#define HLG_GAMMA     1.2
+double pq_to_nits(double e);
+double nits_to_pq(double nits);
+
+// hlg signal <-> scene light (0..1) of one channel (inverse oetf / oetf)
+double hlg_to_scene(double e);
+double scene_to_hlg(double l);
+
+// bt.2100 ootf of hlg: scene light to display light in cd/m2, every channel scaled by HLG_PEAK_NITS * Ys^(HLG_GAMMA - 1)
+// with Ys the bt.2020 luminance of the scene light, so it needs all three channels, and its inverse
+void hlg_ootf(double rgb[3]);
+void hlg_inverse_ootf(double rgb[3]);
+
+// hlg signal of a gray <-> its display luminance (inverse oetf and ootf)
+double hlg_to_nits(double e);
+double nits_to_hlg(double nits);
+
+// 8-bit lookup table for srgb_to_linear (entry i = srgb_to_linear(i / 255.0)), built on first use
+const float *srgb_to_linear_lut8();
+
+// same as above in double precision (bit-identical to srgb_to_linear(i / 255.0))
+const double *srgb_to_linear_lut8d();
+
+// linear light to 8-bit srgb without pow: a value v in [0,1] falls into bucket (int)(v * SRGB8_ENC_BUCKETS), which starts
+// at code lo[bucket] and holds at most one rounding threshold (8-bit steps are wider than a bucket even near black),
+// so code = lo[bucket] + (v >= mid[lo[bucket]]), bit-identical to round(linear_to_srgb(v) * 255) up to float rounding of v
+#define SRGB8_ENC_BUCKETS 4096
+typedef struct {
+    int32_t lo[SRGB8_ENC_BUCKETS + 1]; // code at the start of every bucket (the last entry is v == 1), 32 bits for vector gathers
+    float   mid[256];                  // linear value halfway between code k and k + 1 (infinite for 255)
+} srgb8_enc_t;
+
+// encoding table above, built on first use
+const srgb8_enc_t *linear_to_srgb8_lut();
+
 // compute WCAG relative luminance
 double relative_luminance_rgb(const rgb_t *rgb);
 
@@ -23,6 +68,16 @@ double weighted_dist2_rgb(const rgb_t *a, const rgb_t *b, double wr, double wg,
 // squared euclidian distance between two oklab colors, more perceptually accurate than rgb euclidian distance
 double dist2_oklab(const oklab_t *a, const oklab_t *b);
 
+// cielab color difference of sample from ref for metric CDIFF_DE76 / DE94 / DE2000 / CMC (anything else: de76)
+// cie94 and cmc (2:1) are asymmetric and weight the difference by the chroma / hue of the reference
+double delta_e(cdiff_t metric, const lab_t *ref, const lab_t *sample);
+
+// json key of a distance in metric, the same as -d prints ("rgb2", "wrgb2", "oklab2", "de76", "de94", "de2000", "cmc")
+const char *cdiff_key(cdiff_t metric);
+
+// json key of the distance to a closest named color: the key of its metric, "wsqrdist" for the default weighted rgb
+const char *named_dist_key(const named_t *named);
+
 // string representation of terminal color mode
 const char *tcolor_tostr(color_cap_t c);
 
@@ -54,7 +109,11 @@ bool strncasecmp_own(const char *a, const char *b, size_t n);
 // case-insensitive strstr
 bool strcasestr_own(const char *hay, const char *needle);
 
+// decimal places of printed opacities (at least 2, so 8-bit alphas survive -f 0 and -f 1)
+#define ALPHA_PLACES(_d) MAX((_d), 2)
+
 // format textual representations for a color into provided buffers
+// translucent colors get their opacity appended (#rrggbbaa, rgba() / hsla() / hsva() in web format, " / a" otherwise)
 void fmt_color_strings(const color_t *colorptr, bool webfmt, int dplaces,
                        char *rgb,   size_t rgb_s,
                        char *hex,   size_t hex_s,
@@ -0,0 +1,40 @@
+// ycbcr (itu-r bt.601 / 709 / 2020, limited or full range) for single colors, and raw 4:2:0 video frames (i420, nv12)
+// converted to and from ppm
+//
+// ycbcr values are 8-bit code values of gamma-encoded (non-linear) r'g'b', as in video files: limited range puts black
+// and white at luma 16 and 235 and the chroma extremes at 16 and 240, full range (jpeg) uses 0..255 for all three
+#ifndef YUV_H
+#define YUV_H
+
+#include <stdio.h>
+#include "kernels.h"
+#include "types.h"
+
+// pixels per frame above which the frame conversions are spread over threads (by row pairs)
+#define YUV_PAR_MIN 65536
+
+// standard and range of rgb_to_ycbcr, ycbcr_to_rgb, yuv_coefficients and ycbcr(...) input (default: bt.709, limited)
+void set_ycbcr(ycbcr_std_t std, bool full);
+
+// single colors in double precision, ycbcr_to_rgb rounds and clamps to 8 bits
+ycbcr_t rgb_to_ycbcr(const rgb_t *rgb);
+rgb_t   ycbcr_to_rgb(const ycbcr_t *ycc);
+
+// fixed-point coefficients of the current standard and range for the 4:2:0 kernels
+void yuv_coefficients(yuv_coef_t *c);
+
+// bytes of one w x h frame: the full size y plane and two chroma planes of ((w + 1) / 2) x ((h + 1) / 2)
+size_t yuv_frame_size(size_t w, size_t h);
+
+// one frame between packed 0xrrggbb pixels and its raw layout (YUV_I420 / YUV_NV12)
+// chroma is the average of every 2x2 block when encoding and repeated over the block when decoding
+void yuv_frame_encode(const yuv_coef_t *c, int layout, const uint32_t *rgb, size_t w, size_t h, uint8_t *frame);
+void yuv_frame_decode(const yuv_coef_t *c, int layout, const uint8_t *frame, size_t w, size_t h, uint32_t *rgb);
+
+// convert the raw frames of opts->yuv (opts->yuvw x opts->yuvh) to concatenated binary ppm images, or the ppm images in
+// opts->toyuv (all of the same size, any maxval) to raw frames, on stdout and one frame at a time
+//
+// returns the process exit code
+int run_yuv(const prog_opts_t *opts, const char *progname);
+
+#endif
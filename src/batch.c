@@ -0,0 +1,139 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "batch.h"
+#include "colorspace.h"
+#include "converter.h"
+#include "cube.h"
+#include "cvd.h"
+#include "parser.h"
+#include "printer.h"
+#include "store.h"
+#include "utility.h"
+
+void batch_print(const uint32_t *rgb, size_t n, const prog_opts_t *opts) {
+    // conversion defaults to hex
+    prog_opts_t o = *opts;
+    if (!o.conversion) o.conversion = "hex";
+
+    if (o.format == FORMAT_BIN) {
+        // one write for the whole list
+        uint8_t *buf = malloc(n ? 3 * n : 1);
+        if (!buf) { fprintf(stderr, "error: out of memory while writing %zu colors\n", n); return; }
+        for (size_t i = 0; i < n; ++i) { buf[3 * i] = (rgb[i] >> 16) & 0xFF; buf[3 * i + 1] = (rgb[i] >> 8) & 0xFF; buf[3 * i + 2] = rgb[i] & 0xFF; }
+        fwrite(buf, 3, n, stdout);
+        free(buf);
+        return;
+    }
+    if (o.format == FORMAT_CSV) {
+        printf("index,hex,r,g,b\n");
+        for (size_t i = 0; i < n; ++i) printf("%zu,#%06x,%u,%u,%u\n", i, rgb[i], (rgb[i] >> 16) & 0xFF, (rgb[i] >> 8) & 0xFF, rgb[i] & 0xFF);
+        return;
+    }
+    if (o.format == FORMAT_C) {
+        printf("static const unsigned char colors[%zu][3] = {\n", n);
+        for (size_t i = 0; i < n; ++i) printf("    { %3u, %3u, %3u },\n", (rgb[i] >> 16) & 0xFF, (rgb[i] >> 8) & 0xFF, rgb[i] & 0xFF);
+        printf("};\n");
+        return;
+    }
+
+    // only the printed model is derived, color_from_rgb would add all of them and a closest named search
+    cv_model_t m     = CVM_SRGB;
+    bool       num   = conversion_model(o.conversion, &m);
+    bool       named = strcasecmp_own(o.conversion, "named");
+
+    bool json = o.format == FORMAT_JSON;
+    if (json) printf("[\n");
+    for (size_t i = 0; i < n; ++i) {
+        color_t c;
+        c.rgb   = hex_to_rgb(rgb[i]);
+        c.hex   = rgb[i];
+        c.xyz   = rgb_to_xyz(&c.rgb);
+        c.alpha = 1.0;
+        if (num) switch (m) {
+            case CVM_CMYK:  c.cmyk  = rgb_to_cmyk(&c.rgb);  break;
+            case CVM_HSL:   c.hsl   = rgb_to_hsl(&c.rgb);   break;
+            case CVM_HSV:   c.hsv   = rgb_to_hsv(&c.rgb);   break;
+            case CVM_OKLAB: c.oklab = rgb_to_oklab(&c.rgb); break;
+            default:        c.oklch = rgb_to_oklch(&c.rgb); break;
+        }
+        if (named) c.named = closest_named(&c.rgb);
+
+        if (json) { printf("  { "); print_conversion_json(&c, &o); printf(" }%s\n", (i + 1 < n) ? "," : ""); }
+        else      print_conversion(&c, &o);
+    }
+    if (json) printf("]\n");
+}
+
+bool conversion_model(const char *conversion, cv_model_t *m) {
+    static const struct { const char *name; cv_model_t model; } models[] = {
+        { "cmyk", CVM_CMYK }, { "hsl", CVM_HSL }, { "hsv", CVM_HSV }, { "oklab", CVM_OKLAB }, { "oklch", CVM_OKLCH }
+    };
+    for (size_t i = 0; conversion && i < sizeof(models) / sizeof(models[0]); ++i)
+        if (strcasecmp_own(conversion, models[i].name)) { *m = models[i].model; return true; }
+    return false;
+}
+
+void batch_print_f32(cv_model_t m, const float *const *cols, size_t n, const prog_opts_t *opts) {
+    prog_opts_t o = *opts;
+    o.conversion  = (m == CVM_CMYK) ? "cmyk" : (m == CVM_HSL) ? "hsl" : (m == CVM_HSV) ? "hsv" : (m == CVM_OKLAB) ? "oklab" : "oklch";
+
+    bool json = o.format == FORMAT_JSON;
+    if (json) printf("[\n");
+    for (size_t i = 0; i < n; ++i) {
+        color_t c = { .alpha = 1.0 };
+        double  x = cols[0][i], y = cols[1][i], z = cols[2][i];
+        switch (m) {
+            case CVM_CMYK:  c.cmyk  = (cmyk_t){ .c = x, .m = y, .y = z, .k = cols[3][i] }; break;
+            case CVM_HSL:   c.hsl   = (hsl_t){ .h = x, .sat = y, .l = z };                 break;
+            case CVM_HSV:   c.hsv   = (hsv_t){ .h = x, .sat = y, .v = z };                 break;
+            case CVM_OKLAB: c.oklab = (oklab_t){ .L = x, .a = y, .b = z };                 break;
+            default:        c.oklch = (oklch_t){ .L = x, .c = y, .h = z };                 break;
+        }
+
+        if (json) { printf("  { "); print_conversion_json(&c, &o); printf(" }%s\n", (i + 1 < n) ? "," : ""); }
+        else      print_conversion(&c, &o);
+    }
+    if (json) printf("]\n");
+}
+
+int run_batch(const prog_opts_t *opts, const char *progname) {
+    // wide-gamut input is gamut mapped unless clipping was asked for
+    if (opts->from != RGBSPACE_SRGB && !opts->gamutset) set_gamut(GAMUT_MAP);
+
+    FILE *f = (strcmp(opts->batch, "-") == 0) ? stdin : fopen(opts->batch, "r");
+    if (!f) ERROR_EXIT("could not open batch input %s", opts->batch);
+
+    color_store_t store;
+    store_init(&store);
+
+    size_t bad_line = 0;
+    long   n        = store_load(&store, f, &bad_line);
+    if (f != stdin) fclose(f);
+    if (n < 0 && bad_line) ERROR_EXIT("could not parse color in %s, line %zu", opts->batch, bad_line);
+    if (n < 0)             ERROR_EXIT("out of memory while reading %s", opts->batch);
+
+    // transform before dedupe and sort, so colors that become indistinguishable collapse (no derived column exists yet)
+    unsigned long oog = 0;
+    if (opts->from != RGBSPACE_SRGB) oog = rgbspace_rgb8_to_srgb8(opts->from, get_gamut(), store.rgb, store.size, store.rgb);
+    store_flatten(&store, opts->over, opts->blend, opts->blendlinear);
+    if (opts->lut) {
+        cube_t   cube;
+        lut3d_t *lut = malloc(sizeof(lut3d_t));
+        if (!lut) ERROR_EXIT("out of memory while reading %s", opts->lut);
+        cube_open(opts->lut, &cube, lut, progname);
+        cube_apply(lut, opts->tetra, store.rgb, store.size, store.rgb);
+        cube_free(&cube);
+        free(lut);
+    }
+    if (opts->cvd != CVD_NONE) cvd_rgb8(opts->cvd, opts->severity, store.rgb, store.size, store.rgb);
+
+    if (opts->unique && !store_dedupe(&store)) ERROR_EXIT("out of memory while removing repeated colors");
+    if (opts->sortkey >= 0 && !store_sort(&store, (store_key_t)opts->sortkey, opts->reverse)) ERROR_EXIT("out of memory while sorting");
+
+    batch_print(store.rgb, store.size, opts);
+    print_gamut_warning(stderr, gamut_count() + oog, get_gamut());
+
+    store_free(&store);
+    return 0;
+}
@@ -3,16 +3,34 @@
 #include <unistd.h>
 
 #include "cli.h"
+#include "colorspace.h"
+#include "composite.h"
+#include "converter.h"
+#include "dither.h"
+#include "gradient.h"
+#include "kernels.h"
+#include "lut.h"
+#include "matrix.h"
+#include "palette.h"
 #include "utility.h"
 #include "parser.h"
 #include "printer.h"
+#include "render.h"
+#include "store.h"
+#include "yuv.h"
 
 // helper function to immediately validate conversion
 static void validate_conversion(const char *conv, const char *progname) {
-    if (!strcasecmp_own(conv, "rgb")   && !strcasecmp_own(conv, "hex")
-     && !strcasecmp_own(conv, "cmyk")  && !strcasecmp_own(conv, "hsl")
-     && !strcasecmp_own(conv, "hsv")   && !strcasecmp_own(conv, "named")
-     && !strcasecmp_own(conv, "oklab") && !strcasecmp_own(conv, "oklch")) ERROR_EXIT("unknown conversion type %s", conv);
+    if (!strcasecmp_own(conv, "rgb")     && !strcasecmp_own(conv, "hex")
+     && !strcasecmp_own(conv, "cmyk")    && !strcasecmp_own(conv, "hsl")
+     && !strcasecmp_own(conv, "hsv")     && !strcasecmp_own(conv, "named")
+     && !strcasecmp_own(conv, "oklab")   && !strcasecmp_own(conv, "oklch")
+     && !strcasecmp_own(conv, "p3")      && !strcasecmp_own(conv, "display-p3")
+     && !strcasecmp_own(conv, "rec2020") && !strcasecmp_own(conv, "xyz")
+     && !strcasecmp_own(conv, "lab")     && !strcasecmp_own(conv, "lch")
+     && !strcasecmp_own(conv, "pq")      && !strcasecmp_own(conv, "rec2100-pq")
+     && !strcasecmp_own(conv, "hlg")     && !strcasecmp_own(conv, "rec2100-hlg")
+     && !strcasecmp_own(conv, "ycbcr")) ERROR_EXIT("unknown conversion type %s", conv);
 }
 
 color_cap_t detect_terminal_color() {
@@ -49,12 +67,278 @@ void parse_cli_args(int argc, char **argv, const char *pname, prog_opts_t *opts,
     opts->cwset       = false; opts->cwidth      = 18;        opts->mapping     = tmode;
     opts->dplaces     = 2;     opts->webfmt      = false;     opts->txtclr      = true;
     opts->json        = false; opts->conversion  = NULL;      opts->distance    = false;
-    opts->contrast    = false; opts->cdiff       = CDIFF_ALL;
+    opts->contrast    = false; opts->cdiff       = CDIFF_ALL; opts->batch       = NULL;
+    opts->unique      = false; opts->sortkey     = -1;        opts->reverse     = false;
+    opts->gradient    = NULL;  opts->gradient_n  = 0;         opts->steps       = 16;
+    opts->gamutset    = false; opts->precision   = PRECISION_EXACT;
+    opts->gamut       = GAMUT_CLIP;
+    opts->space       = GRAD_OKLAB;
+    opts->hue         = HUE_SHORTER;
+    opts->format      = FORMAT_TEXT;
+    opts->matrix      = NULL;  opts->upper       = false;     opts->epsilon     = -1.0;
+    opts->fix         = NULL;  opts->fix_n       = 0;         opts->fixbatch    = NULL;
+    opts->target      = -1.0;  opts->cmatrix     = NULL;      opts->cmetric     = CONTRAST_WCAG;
+    opts->cvd         = CVD_NONE;
+    opts->severity    = 1.0;   opts->image       = NULL;      opts->makelut     = NULL;
+    opts->lutsize     = 33;    opts->snap        = SNAP_NONE; opts->lut         = NULL;
+    opts->tetra       = true;  opts->from        = RGBSPACE_SRGB;
+    opts->dither      = DITHER_NONE;
+    opts->ditherlin   = false;
+    opts->render      = RENDER_PPM;
+    opts->yuv         = NULL;  opts->toyuv       = NULL;      opts->layout      = YUV_I420;
+    opts->yuvw        = 0;     opts->yuvh        = 0;
+    opts->over        = 0xFFFFFF;
+    opts->blend       = BLEND_NORMAL;
+    opts->blendlinear = false;
+    opts->extract     = NULL;  opts->ncolors     = 0;         opts->method      = EXTRACT_KMEANS;
+
+    // --ycbcr and --range set the model together
+    ycbcr_std_t ycbcr_std  = YCBCR_BT709;
+    bool        ycbcr_full = false;
+
+    // colors given with options are parsed after the loop like the trailing ones, once every setting is known
+    const char *over = NULL;
+    char        cbuf[STR_BUFSIZE] = "", dbuf[STR_BUFSIZE] = "";
+    bool        cpair = false, dpair = false;
 
     int arg = 1;
     while ((argc > arg) && (argv[arg][0] == '-')) {
+        // long options that alter main program execution
+        if (strcmp(argv[arg], "--build-lut") == 0) {
+            if (argc > arg + 1) ERROR_EXIT("--build-lut takes no arguments (set COLOR_LUT to choose the cache path)");
+            if (lut_build() != 0) exit(EXIT_FAILURE);
+            exit(0);
+        }
+        else if (strcmp(argv[arg], "--cpu-info") == 0) {
+            kernels_print_info(stdout);
+            lut_print_info(stdout);
+            exit(0);
+        }
+
+        // batch mode options
+        else if (strcmp(argv[arg], "--batch") == 0 && argc > arg + 1) opts->batch   = argv[++arg];
+        else if (strcmp(argv[arg], "--unique") == 0)                 opts->unique  = true;
+        else if (strcmp(argv[arg], "--reverse") == 0)                opts->reverse = true;
+        else if (strcmp(argv[arg], "--sort") == 0 && argc > arg + 1) {
+            const char *k = argv[++arg];
+
+            if      (strcasecmp_own(k, "hex")) opts->sortkey = STORE_KEY_HEX;
+            else if (strcasecmp_own(k, "l"))   opts->sortkey = STORE_KEY_L;
+            else if (strcasecmp_own(k, "c"))   opts->sortkey = STORE_KEY_C;
+            else if (strcasecmp_own(k, "h"))   opts->sortkey = STORE_KEY_H;
+            else    ERROR_EXIT("unknown sort key %s", k);
+        }
+
+        else if (strcmp(argv[arg], "--precision") == 0 && argc > arg + 1) {
+            const char *p = argv[++arg];
+
+            if      (strcasecmp_own(p, "exact")) opts->precision = PRECISION_EXACT;
+            else if (strcasecmp_own(p, "fast"))  opts->precision = PRECISION_FAST;
+            else    ERROR_EXIT("unknown precision %s", p);
+        }
+        else if (strcmp(argv[arg], "--gamut") == 0 && argc > arg + 1) {
+            const char *g = argv[++arg];
+
+            if      (strcasecmp_own(g, "clip")) opts->gamut = GAMUT_CLIP;
+            else if (strcasecmp_own(g, "map"))  opts->gamut = GAMUT_MAP;
+            else    ERROR_EXIT("unknown gamut mode %s", g);
+            opts->gamutset = true;
+        }
+
+        // matrix mode options
+        else if (strcmp(argv[arg], "--matrix") == 0 && argc > arg + 1) opts->matrix = argv[++arg];
+        else if (strcmp(argv[arg], "--upper") == 0)                    opts->upper  = true;
+        else if (strcmp(argv[arg], "--epsilon") == 0 && argc > arg + 1) {
+            char *end = NULL;
+            opts->epsilon = strtod(argv[++arg], &end);
+            if (end == argv[arg] || *end || !(opts->epsilon >= 0.0)) ERROR_EXIT("invalid epsilon %s", argv[arg]);
+        }
+
+        // contrast solver options
+        else if (strcmp(argv[arg], "--fix-contrast") == 0) {
+            opts->fix = &argv[arg + 1];
+            while (arg + 1 < argc && argv[arg + 1][0] != '-') { ++arg; ++opts->fix_n; }
+            if (opts->fix_n < 2) ERROR_EXIT("--fix-contrast needs a foreground and a background color");
+        }
+        else if (strcmp(argv[arg], "--fix-contrast-batch") == 0 && argc > arg + 1) opts->fixbatch = argv[++arg];
+        else if (strcmp(argv[arg], "--contrast-matrix") == 0 && argc > arg + 1)    opts->cmatrix  = argv[++arg];
+        else if (strcmp(argv[arg], "--target") == 0 && argc > arg + 1) {
+            char *end = NULL;
+            opts->target = strtod(argv[++arg], &end);
+            if (end == argv[arg] || *end || !(opts->target >= 0.0)) ERROR_EXIT("invalid contrast target %s", argv[arg]);
+        }
+        else if (strcmp(argv[arg], "--contrast-metric") == 0 && argc > arg + 1) {
+            const char *m = argv[++arg];
+
+            if      (strcasecmp_own(m, "wcag")) opts->cmetric = CONTRAST_WCAG;
+            else if (strcasecmp_own(m, "apca")) opts->cmetric = CONTRAST_APCA;
+            else    ERROR_EXIT("unknown contrast metric %s", m);
+        }
+
+        // color vision deficiency simulation and image mode
+        else if (strcmp(argv[arg], "--cvd") == 0 && argc > arg + 1) {
+            const char *t = argv[++arg];
+
+            if      (strcasecmp_own(t, "protan")) opts->cvd = CVD_PROTAN;
+            else if (strcasecmp_own(t, "deutan")) opts->cvd = CVD_DEUTAN;
+            else if (strcasecmp_own(t, "tritan")) opts->cvd = CVD_TRITAN;
+            else    ERROR_EXIT("unknown color vision deficiency %s", t);
+        }
+        else if (strcmp(argv[arg], "--severity") == 0 && argc > arg + 1) {
+            char *end = NULL;
+            opts->severity = strtod(argv[++arg], &end);
+            if (end == argv[arg] || *end || !(opts->severity >= 0.0 && opts->severity <= 1.0)) ERROR_EXIT("invalid severity %s (must be between 0 and 1)", argv[arg]);
+        }
+        else if (strcmp(argv[arg], "--image") == 0 && argc > arg + 1) opts->image = argv[++arg];
+        else if (strcmp(argv[arg], "--from") == 0 && argc > arg + 1) {
+            if (!rgbspace_from_name(argv[++arg], &opts->from)) ERROR_EXIT("unknown rgb space %s", argv[arg]);
+        }
+        else if (strcmp(argv[arg], "--sdr-white") == 0 && argc > arg + 1) {
+            char  *end  = NULL;
+            double nits = strtod(argv[++arg], &end);
+            if (end == argv[arg] || *end || !(nits >= 1.0 && nits <= PQ_MAX_NITS)) ERROR_EXIT("invalid sdr white %s (must be between 1 and 10000 cd/m2)", argv[arg]);
+            set_sdr_white(nits);
+        }
+
+        // ycbcr and raw 4:2:0 frames
+        else if (strcmp(argv[arg], "--yuv") == 0 && argc > arg + 1)    opts->yuv   = argv[++arg];
+        else if (strcmp(argv[arg], "--to-yuv") == 0 && argc > arg + 1) opts->toyuv = argv[++arg];
+        else if (strcmp(argv[arg], "--size") == 0 && argc > arg + 1) {
+            char         *end = NULL;
+            unsigned long w   = strtoul(argv[++arg], &end, 10), h = 0;
+            if (end != argv[arg] && (*end == 'x' || *end == 'X')) h = strtoul(end + 1, &end, 10);
+            if (*end || w < 1 || h < 1 || w > 65536 || h > 65536) ERROR_EXIT("invalid frame size %s (must be <w>x<h>, 1 to 65536 each)", argv[arg]);
+            opts->yuvw = w;
+            opts->yuvh = h;
+        }
+        else if (strcmp(argv[arg], "--layout") == 0 && argc > arg + 1) {
+            const char *l = argv[++arg];
+
+            if      (strcasecmp_own(l, "i420")) opts->layout = YUV_I420;
+            else if (strcasecmp_own(l, "nv12")) opts->layout = YUV_NV12;
+            else    ERROR_EXIT("unknown frame layout %s", l);
+        }
+        else if (strcmp(argv[arg], "--ycbcr") == 0 && argc > arg + 1) {
+            const char *y = argv[++arg];
+
+            if      (strcasecmp_own(y, "601"))  ycbcr_std = YCBCR_BT601;
+            else if (strcasecmp_own(y, "709"))  ycbcr_std = YCBCR_BT709;
+            else if (strcasecmp_own(y, "2020")) ycbcr_std = YCBCR_BT2020;
+            else    ERROR_EXIT("unknown ycbcr standard %s", y);
+            set_ycbcr(ycbcr_std, ycbcr_full);
+        }
+        else if (strcmp(argv[arg], "--range") == 0 && argc > arg + 1) {
+            const char *r = argv[++arg];
+
+            if      (strcasecmp_own(r, "limited")) ycbcr_full = false;
+            else if (strcasecmp_own(r, "full"))    ycbcr_full = true;
+            else    ERROR_EXIT("unknown ycbcr range %s", r);
+            set_ycbcr(ycbcr_std, ycbcr_full);
+        }
+
+        // alpha compositing
+        else if (strcmp(argv[arg], "--over") == 0 && argc > arg + 1) over = argv[++arg];
+        else if (strcmp(argv[arg], "--blend") == 0 && argc > arg + 1) {
+            const char *b = argv[++arg];
+            if (!blend_from_name(b, &opts->blend)) ERROR_EXIT("unknown blend mode %s", b);
+        }
+        else if (strcmp(argv[arg], "--blend-space") == 0 && argc > arg + 1) {
+            const char *b = argv[++arg];
+
+            if      (strcasecmp_own(b, "gamma"))  opts->blendlinear = false;
+            else if (strcasecmp_own(b, "linear")) opts->blendlinear = true;
+            else    ERROR_EXIT("unknown blend space %s", b);
+        }
+
+        // palette extraction
+        else if (strcmp(argv[arg], "--extract") == 0 && argc > arg + 2) {
+            opts->ncolors = safe_atoi(argv[++arg], progname);
+            if (opts->ncolors < 1 || opts->ncolors > PALETTE_MAX) ERROR_EXIT("invalid number of colors %d (must be between 1 and %d)", opts->ncolors, PALETTE_MAX);
+            opts->extract = argv[++arg];
+        }
+        else if (strcmp(argv[arg], "--method") == 0 && argc > arg + 1) {
+            const char *m = argv[++arg];
+            if (!extract_from_name(m, &opts->method)) ERROR_EXIT("unknown extraction method %s", m);
+        }
+
+        // 3d lookup tables
+        else if (strcmp(argv[arg], "--make-lut") == 0 && argc > arg + 1) opts->makelut = argv[++arg];
+        else if (strcmp(argv[arg], "--lut-size") == 0 && argc > arg + 1) {
+            opts->lutsize = safe_atoi(argv[++arg], progname);
+            if (opts->lutsize < 2 || opts->lutsize > 256) ERROR_EXIT("invalid lut size %d (must be between 2 and 256)", opts->lutsize);
+        }
+        else if (strcmp(argv[arg], "--snap") == 0 && argc > arg + 1) {
+            const char *p = argv[++arg];
+
+            if      (strcasecmp_own(p, "named"))   opts->snap = SNAP_NAMED;
+            else if (strcasecmp_own(p, "ansi16"))  opts->snap = SNAP_ANSI16;
+            else if (strcasecmp_own(p, "ansi256")) opts->snap = SNAP_ANSI256;
+            else    ERROR_EXIT("unknown palette %s", p);
+        }
+        else if (strcmp(argv[arg], "--dither") == 0 && argc > arg + 1) {
+            const char *m = argv[++arg];
+            if (!dither_from_name(m, &opts->dither)) ERROR_EXIT("unknown dithering %s", m);
+        }
+        else if (strcmp(argv[arg], "--dither-space") == 0 && argc > arg + 1) {
+            const char *sp = argv[++arg];
+
+            if      (strcasecmp_own(sp, "oklab"))  opts->ditherlin = false;
+            else if (strcasecmp_own(sp, "linear")) opts->ditherlin = true;
+            else    ERROR_EXIT("unknown dithering space %s", sp);
+        }
+        else if (strcmp(argv[arg], "--render") == 0 && argc > arg + 1) {
+            const char *m = argv[++arg];
+            if (!render_from_name(m, &opts->render)) ERROR_EXIT("unknown output %s", m);
+        }
+        else if (strcmp(argv[arg], "--lut") == 0 && argc > arg + 1) opts->lut = argv[++arg];
+        else if (strcmp(argv[arg], "--interp") == 0 && argc > arg + 1) {
+            const char *m = argv[++arg];
+
+            if      (strcasecmp_own(m, "tetrahedral")) opts->tetra = true;
+            else if (strcasecmp_own(m, "trilinear"))   opts->tetra = false;
+            else    ERROR_EXIT("unknown interpolation %s", m);
+        }
+
+        // gradient mode options
+        else if (strcmp(argv[arg], "--gradient") == 0) {
+            opts->gradient = &argv[arg + 1];
+            while (arg + 1 < argc && argv[arg + 1][0] != '-') { ++arg; ++opts->gradient_n; }
+            if (opts->gradient_n < 2) ERROR_EXIT("--gradient needs at least two colors");
+        }
+        else if (strcmp(argv[arg], "--steps") == 0 && argc > arg + 1) {
+            opts->steps = safe_atoi(argv[++arg], progname);
+            if (opts->steps < 2 || opts->steps > (1 << 24)) ERROR_EXIT("invalid number of steps %d (must be between 2 and 16777216)", opts->steps);
+        }
+        else if (strcmp(argv[arg], "--space") == 0 && argc > arg + 1) {
+            const char *sp = argv[++arg];
+
+            if      (strcasecmp_own(sp, "oklab")) opts->space = GRAD_OKLAB;
+            else if (strcasecmp_own(sp, "oklch")) opts->space = GRAD_OKLCH;
+            else if (strcasecmp_own(sp, "rgb"))   opts->space = GRAD_RGB;
+            else    ERROR_EXIT("unknown interpolation space %s", sp);
+        }
+        else if (strcmp(argv[arg], "--hue") == 0 && argc > arg + 1) {
+            const char *h = argv[++arg];
+
+            if      (strcasecmp_own(h, "shorter"))    opts->hue = HUE_SHORTER;
+            else if (strcasecmp_own(h, "longer"))     opts->hue = HUE_LONGER;
+            else if (strcasecmp_own(h, "increasing")) opts->hue = HUE_INCREASING;
+            else if (strcasecmp_own(h, "decreasing")) opts->hue = HUE_DECREASING;
+            else    ERROR_EXIT("unknown hue interpolation %s", h);
+        }
+        else if (strcmp(argv[arg], "--format") == 0 && argc > arg + 1) {
+            const char *f = argv[++arg];
+
+            if      (strcasecmp_own(f, "text")) opts->format = FORMAT_TEXT;
+            else if (strcasecmp_own(f, "json")) opts->format = FORMAT_JSON;
+            else if (strcasecmp_own(f, "csv"))  opts->format = FORMAT_CSV;
+            else if (strcasecmp_own(f, "bin"))  opts->format = FORMAT_BIN;
+            else if (strcasecmp_own(f, "c"))    opts->format = FORMAT_C;
+            else    ERROR_EXIT("unknown output format %s", f);
+        }
+
         // options that alter main program execution
-        if      (argv[arg][1] == 'h') { print_help(progname); exit(0); }
+        else if (argv[arg][1] == 'h') { print_help(progname); exit(0); }
         else if (argv[arg][1] == 'l') {
             int lmode = 0;
             if (argc > arg + 1)         lmode = safe_atoi(argv[++arg], progname);
@@ -71,21 +355,15 @@ void parse_cli_args(int argc, char **argv, const char *pname, prog_opts_t *opts,
 
         // options that expect an argument
         else if (argv[arg][1] == 'C' && argc > arg + 1) {
-            char buf[STR_BUFSIZE] = "";
-            for (++arg; arg < argc && argv[arg][0] != '-'; ++arg) if (!strncat_safe(buf, sizeof(buf), argv[arg], strlen(buf) > 0)) ERROR_EXIT("input too large");
-
-            int end = arg;
-            if (end < argc) { if (!parse_color(buf, colorC))             ERROR_EXIT("could not parse -C color %s", buf);                            arg = end - 1; }
-            else            { if (parse_color2(buf, colorC, color) != 2) ERROR_EXIT("could not parse -C color1 color2 %s", buf); *color_set = true; arg = end - 1; }
+            cbuf[0] = '\0';
+            for (++arg; arg < argc && argv[arg][0] != '-'; ++arg) if (!strncat_safe(cbuf, sizeof(cbuf), argv[arg], strlen(cbuf) > 0)) ERROR_EXIT("input too large");
+            cpair = arg == argc; --arg;
             opts->contrast = true;
         }
         else if (argv[arg][1] == 'd' && argc > arg + 1) {
-            char buf[STR_BUFSIZE] = "";
-            for (++arg; arg < argc && argv[arg][0] != '-'; ++arg) if (!strncat_safe(buf, sizeof(buf), argv[arg], strlen(buf) > 0)) ERROR_EXIT("input too large");
-
-            int end = arg;
-            if (end < argc) { if (!parse_color(buf, colorD))             ERROR_EXIT("could not parse -d color %s", buf);                            arg = end - 1; } 
-            else {            if (parse_color2(buf, colorD, color) != 2) ERROR_EXIT("could not parse -d color1 color2 %s", buf); *color_set = true; arg = end - 1; }
+            dbuf[0] = '\0';
+            for (++arg; arg < argc && argv[arg][0] != '-'; ++arg) if (!strncat_safe(dbuf, sizeof(dbuf), argv[arg], strlen(dbuf) > 0)) ERROR_EXIT("input too large");
+            dpair = arg == argc; --arg;
             opts->distance = true;
         }
         else if (argv[arg][1] == 'D' && argc > arg + 1) {
@@ -94,8 +372,13 @@ void parse_cli_args(int argc, char **argv, const char *pname, prog_opts_t *opts,
             if      (strcasecmp_own(m, "rgb"))                                   opts->cdiff = CDIFF_RGB;
             else if (strcasecmp_own(m, "wrgb") || strcasecmp_own(m, "weighted")) opts->cdiff = CDIFF_WRGB;
             else if (strcasecmp_own(m, "oklab"))                                 opts->cdiff = CDIFF_OKLAB;
+            else if (strcasecmp_own(m, "de76")   || strcasecmp_own(m, "cie76"))  opts->cdiff = CDIFF_DE76;
+            else if (strcasecmp_own(m, "de94")   || strcasecmp_own(m, "cie94"))  opts->cdiff = CDIFF_DE94;
+            else if (strcasecmp_own(m, "de2000") || strcasecmp_own(m, "de00"))   opts->cdiff = CDIFF_DE2000;
+            else if (strcasecmp_own(m, "cmc"))                                   opts->cdiff = CDIFF_CMC;
             else if (strcasecmp_own(m, "all"))                                   opts->cdiff = CDIFF_ALL;
             else    ERROR_EXIT("unknown diff method %s", m);
+            set_named_metric(opts->cdiff);
         }
         else if (argv[arg][1] == 'c' && argc > arg + 1) { opts->conversion = argv[++arg]; validate_conversion(opts->conversion, progname); }
         else if (argv[arg][1] == 'f' && argc > arg + 1) { opts->dplaces = safe_atoi(argv[++arg], progname); opts->dplaces = CLAMP(opts->dplaces, 0, 5); }
@@ -113,9 +396,31 @@ void parse_cli_args(int argc, char **argv, const char *pname, prog_opts_t *opts,
         arg++;
     }
 
+    // -j selects json for list outputs aswell
+    if (opts->json && opts->format == FORMAT_TEXT) opts->format = FORMAT_JSON;
+
     // increase width by one to cover extra line added for mapping info
     if (!opts->cwset && opts->mapping != TC_TRUECOLOR) ++opts->cwidth;
 
+    // conversions of every color below follow the final --precision and --gamut, closest names -x and -D
+    set_precision(opts->precision);
+    set_gamut(opts->gamut);
+
+    if (over) {
+        color_t bg;
+        if (!parse_color(over, &bg)) ERROR_EXIT("could not parse --over color %s", over);
+        if (bg.alpha < 1.0)          ERROR_EXIT("the --over backdrop %s must be opaque", over);
+        opts->over = bg.hex;
+    }
+    if (opts->contrast) {
+        if (!cpair) { if (!parse_color(cbuf, colorC))             ERROR_EXIT("could not parse -C color %s", cbuf); }
+        else        { if (parse_color2(cbuf, colorC, color) != 2) ERROR_EXIT("could not parse -C color1 color2 %s", cbuf); *color_set = true; }
+    }
+    if (opts->distance) {
+        if (!dpair) { if (!parse_color(dbuf, colorD))             ERROR_EXIT("could not parse -d color %s", dbuf); }
+        else        { if (parse_color2(dbuf, colorD, color) != 2) ERROR_EXIT("could not parse -d color1 color2 %s", dbuf); *color_set = true; }
+    }
+
     // now concatenate remaining argv into colorbuf
     char colorbuf[STR_BUFSIZE] = "";
     if (arg < argc) {
@@ -126,6 +431,4 @@ void parse_cli_args(int argc, char **argv, const char *pname, prog_opts_t *opts,
             *color_set = true;
         }
     }
-
-    
 }
@@ -0,0 +1,421 @@
+#include <math.h>
+#include <string.h>
+
+#include "colorspace.h"
+#include "converter.h"
+#include "kernels.h"
+#include "utility.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// row-major matrices (indexed by the primaries, see prim) derived exactly from the primaries and white points (css color 4: d65 = 0.3127 / 0.3290,
+// d50 = 0.3457 / 0.3585) and rounded once, so nothing is inverted or multiplied at run time
+static const double to_xyz[4][9] = {
+    { 0.4123907992659595, 0.3575843393838780, 0.1804807884018343,    // srgb
+      0.2126390058715104, 0.7151686787677559, 0.0721923153607337,
+      0.0193308187155918, 0.1191947797946260, 0.9505321522496606 },
+    { 0.4123907992659595, 0.3575843393838780, 0.1804807884018343,    // srgb-linear
+      0.2126390058715104, 0.7151686787677559, 0.0721923153607337,
+      0.0193308187155918, 0.1191947797946260, 0.9505321522496606 },
+    { 0.4865709486482163, 0.2656676931690929, 0.1982172852343625,    // display-p3
+      0.2289745640697488, 0.6917385218365062, 0.0792869140937450,
+      0.0000000000000000, 0.0451133818589026, 1.0439443689009757 },
+    { 0.6369580483012913, 0.1446169035862084, 0.1688809751641721,    // rec2020
+      0.2627002120112670, 0.6779980715188710, 0.0593017164698619,
+      0.0000000000000000, 0.0280726930490875, 1.0609850577107909 },
+};
+
+static const double from_xyz[4][9] = {
+    {  3.2409699419045213, -1.5373831775700935, -0.4986107602930033,
+      -0.9692436362808798,  1.8759675015077206,  0.0415550574071756,
+       0.0556300796969936, -0.2039769588889766,  1.0569715142428786 },
+    {  3.2409699419045213, -1.5373831775700935, -0.4986107602930033,
+      -0.9692436362808798,  1.8759675015077206,  0.0415550574071756,
+       0.0556300796969936, -0.2039769588889766,  1.0569715142428786 },
+    {  2.4934969119414245, -0.9313836179191236, -0.4027107844507168,
+      -0.8294889695615750,  1.7626640603183468,  0.0236246858419436,
+       0.0358458302437843, -0.0761723892680417,  0.9568845240076873 },
+    {  1.7166511879712676, -0.3556707837763924, -0.2533662813736598,
+      -0.6666843518324890,  1.6164812366349390,  0.0157685458139111,
+       0.0176398574453109, -0.0427706132578087,  0.9421031212354740 },
+};
+
+// linear rgb of each space straight to linear srgb (from_xyz[srgb] * to_xyz[s]), used by the bulk path
+static const double to_srgb[4][9] = {
+    {  1.0,                 0.0,                 0.0,
+       0.0,                 1.0,                 0.0,
+       0.0,                 0.0,                 1.0 },
+    {  1.0,                 0.0,                 0.0,
+       0.0,                 1.0,                 0.0,
+       0.0,                 0.0,                 1.0 },
+    {  1.2249401762805598, -0.2249401762805600,  0.0000000000000000,
+      -0.0420569547096882,  1.0420569547096881,  0.0000000000000000,
+      -0.0196375545903344, -0.0786360455506319,  1.0982736001409663 },
+    {  1.6604910021084345, -0.5876411387885495, -0.0728498633198849,
+      -0.1245504745215907,  1.1328998971259603, -0.0083494226043695,
+      -0.0181507633549053, -0.1005788980080074,  1.1187296613629127 },
+};
+
+// bradford chromatic adaptation
+static const double d65_to_d50[9] = {
+     1.0479297925449966,  0.0229468706016095, -0.0501922662892052,
+     0.0296278087700557,  0.9904344267538800, -0.0170737990634188,
+    -0.0092430406462045,  0.0150551914902982,  0.7518742814281369,
+};
+
+static const double d50_to_d65[9] = {
+     0.9554734214880752, -0.0230984549487645,  0.0632592432005707,
+    -0.0283697093338636,  1.0099953980813041,  0.0210414411919173,
+     0.0123140148644820, -0.0205076492988990,  1.3303659262421239,
+};
+
+// d50 white point (y = 1)
+static const double white_d50[3] = { 0.9642956764295676, 1.0, 0.8251046025104602 };
+
+// itu-r bt.2020 transfer function constants (12-bit precision values, as in css color 4)
+#define REC2020_ALPHA 1.09929682680944
+#define REC2020_BETA  0.018053968510807
+
+static const char *rgbspace_names[RGBSPACE_COUNT] = { "srgb", "srgb-linear", "display-p3", "rec2020", "rec2100-pq", "rec2100-hlg" };
+
+// luminance of srgb white for the hdr spaces
+static double sdr_white = SDR_WHITE_DEFAULT;
+
+void   set_sdr_white(double nits) { sdr_white = nits; }
+double get_sdr_white()            { return sdr_white; }
+
+const char *rgbspace_name(rgbspace_t s) { return rgbspace_names[s]; }
+
+bool rgbspace_from_name(const char *name, rgbspace_t *s) {
+    for (int i = 0; i < RGBSPACE_COUNT; ++i) if (strcasecmp_own(name, rgbspace_names[i])) { *s = (rgbspace_t)i; return true; }
+    if      (strcasecmp_own(name, "p3"))  *s = RGBSPACE_DISPLAY_P3;
+    else if (strcasecmp_own(name, "pq"))  *s = RGBSPACE_REC2100_PQ;
+    else if (strcasecmp_own(name, "hlg")) *s = RGBSPACE_REC2100_HLG;
+    else    return false;
+    return true;
+}
+
+// the rec. 2100 spaces share the bt.2020 primaries
+static inline rgbspace_t prim(rgbspace_t s) { return (s == RGBSPACE_REC2100_PQ || s == RGBSPACE_REC2100_HLG) ? RGBSPACE_REC2020 : s; }
+
+static inline bool is_hdr(rgbspace_t s) { return s != prim(s); }
+
+// linear light per unit of transfer(), pq decodes to cd/m2, hlg to scene light (see hlg_display)
+static inline double unit(rgbspace_t s) { return (s == RGBSPACE_REC2100_PQ) ? 1.0 / sdr_white : 1.0; }
+
+// hlg scene light <-> linear light in units of srgb white, through the ootf of a HLG_PEAK_NITS display
+static void hlg_display(double rgb[3]) {
+    hlg_ootf(rgb);
+    for (int k = 0; k < 3; ++k) rgb[k] /= sdr_white;
+}
+
+static void hlg_scene(double rgb[3]) {
+    for (int k = 0; k < 3; ++k) rgb[k] *= sdr_white;
+    hlg_inverse_ootf(rgb);
+}
+
+static inline void mat3(const double *m, double x, double y, double z, double out[3]) {
+    out[0] = m[0] * x + m[1] * y + m[2] * z;
+    out[1] = m[3] * x + m[4] * y + m[5] * z;
+    out[2] = m[6] * x + m[7] * y + m[8] * z;
+}
+
+// transfer function of a non-negative code value, in units of unit(s)
+static double transfer(rgbspace_t s, double a) {
+    switch (s) {
+        case RGBSPACE_SRGB_LINEAR:  return a;
+        case RGBSPACE_REC2020:      return (a < REC2020_BETA * 4.5) ? a / 4.5 : pow((a + REC2020_ALPHA - 1.0) / REC2020_ALPHA, 1.0 / 0.45);
+        case RGBSPACE_REC2100_PQ:   return pq_to_nits(a);
+        case RGBSPACE_REC2100_HLG:  return hlg_to_scene(a);
+        default:                    return srgb_to_linear(a);
+    }
+}
+
+// code values <-> linear light, odd-extended below 0 like css does
+static double decode(rgbspace_t s, double v) { return copysign(transfer(s, fabs(v)) * unit(s), v); }
+
+static double encode(rgbspace_t s, double v) {
+    double a = fabs(v), e;
+    switch (s) {
+        case RGBSPACE_SRGB_LINEAR:  return v;
+        case RGBSPACE_REC2020:      e = (a > REC2020_BETA) ? REC2020_ALPHA * pow(a, 0.45) - (REC2020_ALPHA - 1.0) : 4.5 * a; break;
+        case RGBSPACE_REC2100_PQ:   e = nits_to_pq(a * sdr_white);  break;
+        case RGBSPACE_REC2100_HLG:  e = scene_to_hlg(a); break;
+        default:                    e = linear_to_srgb(a); break;
+    }
+    return copysign(e, v);
+}
+
+xyz_t rgbspace_to_xyz(rgbspace_t s, const double rgb[3]) {
+    double lin[3] = { decode(s, rgb[0]), decode(s, rgb[1]), decode(s, rgb[2]) }, out[3];
+    if (s == RGBSPACE_REC2100_HLG) hlg_display(lin);
+    mat3(to_xyz[prim(s)], lin[0], lin[1], lin[2], out);
+    return (xyz_t){ .x = out[0], .y = out[1], .z = out[2] };
+}
+
+void xyz_to_rgbspace(rgbspace_t s, const xyz_t *xyz, double rgb[3]) {
+    mat3(from_xyz[prim(s)], xyz->x, xyz->y, xyz->z, rgb);
+    if (s == RGBSPACE_REC2100_HLG) hlg_scene(rgb);
+    for (int k = 0; k < 3; ++k) rgb[k] = encode(s, rgb[k]);
+}
+
+xyz_t xyz_d65_to_d50(const xyz_t *xyz) {
+    double out[3];
+    mat3(d65_to_d50, xyz->x, xyz->y, xyz->z, out);
+    return (xyz_t){ .x = out[0], .y = out[1], .z = out[2] };
+}
+
+xyz_t xyz_d50_to_d65(const xyz_t *xyz) {
+    double out[3];
+    mat3(d50_to_d65, xyz->x, xyz->y, xyz->z, out);
+    return (xyz_t){ .x = out[0], .y = out[1], .z = out[2] };
+}
+
+lab_t xyz_to_lab_d50(const xyz_t *xyz) {
+    xyz_t  d  = xyz_d65_to_d50(xyz);
+    double fx = lab_f(d.x / white_d50[0]), fy = lab_f(d.y / white_d50[1]), fz = lab_f(d.z / white_d50[2]);
+    return (lab_t){ .L = 116.0 * fy - 16.0, .a = 500.0 * (fx - fy), .b = 200.0 * (fy - fz) };
+}
+
+// inverse of lab_f (epsilon = 216 / 24389, kappa = 24389 / 27)
+static double lab_finv(double f) {
+    return (f > 6.0 / 29.0) ? f * f * f : (116.0 * f - 16.0) / (24389.0 / 27.0);
+}
+
+xyz_t lab_d50_to_xyz(const lab_t *lab) {
+    double fy = (lab->L + 16.0) / 116.0, fx = fy + lab->a / 500.0, fz = fy - lab->b / 200.0;
+    xyz_t  d  = { .x = lab_finv(fx) * white_d50[0], .y = lab_finv(fy) * white_d50[1], .z = lab_finv(fz) * white_d50[2] };
+    return xyz_d50_to_d65(&d);
+}
+
+// the polar form is the same as oklch's
+lch_t lab_to_lch(const lab_t *lab) {
+    oklch_t p = oklab_to_oklch(&(oklab_t){ .L = lab->L, .a = lab->a, .b = lab->b });
+    return (lch_t){ .L = lab->L, .c = p.c, .h = p.h };
+}
+
+lab_t lch_to_lab(const lch_t *lch) {
+    oklab_t p = oklch_to_oklab(&(oklch_t){ .L = lch->L, .c = lch->c, .h = lch->h });
+    return (lab_t){ .L = lch->L, .a = p.a, .b = p.b };
+}
+
+xyz_t rgb_to_xyz(const rgb_t *rgb) {
+    const double *lin = srgb_to_linear_lut8d();
+    double out[3];
+    mat3(to_xyz[RGBSPACE_SRGB], lin[CLAMP(rgb->r, 0, 255)], lin[CLAMP(rgb->g, 0, 255)], lin[CLAMP(rgb->b, 0, 255)], out);
+    return (xyz_t){ .x = out[0], .y = out[1], .z = out[2] };
+}
+
+xyz_t oklab_to_xyz(const oklab_t *oklab) {
+    double lin[3], out[3];
+    oklab_to_linear(oklab, false, lin);
+    mat3(to_xyz[RGBSPACE_SRGB_LINEAR], lin[0], lin[1], lin[2], out);
+    return (xyz_t){ .x = out[0], .y = out[1], .z = out[2] };
+}
+
+oklab_t xyz_to_oklab(const xyz_t *xyz) {
+    double lin[3];
+    mat3(from_xyz[RGBSPACE_SRGB_LINEAR], xyz->x, xyz->y, xyz->z, lin);
+    return linear_to_oklab(lin);
+}
+
+// 8-bit code -> transfer() of each space, in float for rgb8_mat3_gamut and in double for the mapping pass
+static const double *decode_lut8d(rgbspace_t s) {
+    static double      lut[RGBSPACE_COUNT][256];
+    static atomic_bool ready = false;
+
+    if (!once_ready(&ready)) {
+        #pragma omp critical(rgbspace_lut8)
+        if (!once_ready(&ready)) {
+            for (int k = 0; k < RGBSPACE_COUNT; ++k) for (int i = 0; i < 256; ++i) lut[k][i] = transfer((rgbspace_t)k, i / 255.0);
+            once_done(&ready);
+        }
+    }
+    return lut[s];
+}
+
+static const float *decode_lut8(rgbspace_t s) {
+    static float       lut[RGBSPACE_COUNT][256];
+    static atomic_bool ready = false;
+
+    if (!once_ready(&ready)) {
+        #pragma omp critical(rgbspace_lut8f)
+        if (!once_ready(&ready)) {
+            for (int k = 0; k < RGBSPACE_COUNT; ++k) for (int i = 0; i < 256; ++i) lut[k][i] = (float)decode_lut8d((rgbspace_t)k)[i];
+            once_done(&ready);
+        }
+    }
+    return lut[s];
+}
+
+// the same for codes 0..maxval of one space at a time (the one of the current image), rebuilt when either changes
+// one exact entry per code, so no pow / exp runs per pixel and nothing is interpolated
+static double dec16d[65536];
+static float  dec16[65536];
+
+static void decode_lut16(rgbspace_t s, unsigned maxval) {
+    static rgbspace_t space = RGBSPACE_COUNT;
+    static unsigned   max   = 0;
+
+    #pragma omp critical(rgbspace_lut16)
+    if (space != s || max != maxval) {
+        for (unsigned i = 0; i <= maxval; ++i) { dec16d[i] = transfer(s, (double)i / maxval); dec16[i] = (float)dec16d[i]; }
+        space = s;
+        max   = maxval;
+    }
+}
+
+// linear srgb to an 8-bit srgb color, clipped
+static uint32_t clip_linear(const double lin[3]) {
+    uint32_t c = 0;
+    for (int k = 0; k < 3; ++k) c = (c << 8) | (uint32_t)round(linear_to_srgb(CLAMP(lin[k], 0.0, 1.0)) * 255.0);
+    return c;
+}
+
+// the same gamut mapped through oklab like oklab_to_rgb
+static uint32_t map_linear(double lin[3]) {
+    gamut_map_linear(lin);
+    return clip_linear(lin);
+}
+
+// direct-mapped cache of gamut mapped colors per chunk, images repeat their saturated colors a lot
+#define MAP_CACHE 4096
+
+// gamut map the flagged colors in double, md is the scaled matrix to linear srgb
+static void map_flagged(const double *dec, const double *md, const uint32_t *in, const uint8_t *oog, size_t n, uint32_t *out) {
+    uint32_t key[MAP_CACHE], val[MAP_CACHE];
+    for (size_t k = 0; k < MAP_CACHE; ++k) key[k] = UINT32_MAX;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!oog[i]) continue;
+
+        size_t slot = ((in[i] * 2654435761u) >> 20) & (MAP_CACHE - 1);
+        if (key[slot] == in[i]) { out[i] = val[slot]; continue; }
+
+        double lin[3];
+        mat3(md, dec[(in[i] >> 16) & 0xFF], dec[(in[i] >> 8) & 0xFF], dec[in[i] & 0xFF], lin);
+        key[slot] = in[i]; val[slot] = out[i] = map_linear(lin);
+    }
+}
+
+static void map_flagged16(const double *md, const uint16_t *in, const uint8_t *oog, size_t n, uint32_t *out) {
+    uint64_t key[MAP_CACHE];
+    uint32_t val[MAP_CACHE];
+    for (size_t k = 0; k < MAP_CACHE; ++k) key[k] = UINT64_MAX;
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!oog[i]) continue;
+
+        const uint16_t *p    = in + 3 * i;
+        uint64_t        c    = ((uint64_t)p[0] << 32) | ((uint64_t)p[1] << 16) | p[2];
+        size_t          slot = ((c * 11400714819323198485ull) >> 52) & (MAP_CACHE - 1);
+        if (key[slot] == c) { out[i] = val[slot]; continue; }
+
+        double lin[3];
+        mat3(md, dec16d[p[0]], dec16d[p[1]], dec16d[p[2]], lin);
+        key[slot] = c; val[slot] = out[i] = map_linear(lin);
+    }
+}
+
+// hlg scene light of a color to 8-bit srgb through the ootf, true if it was out of gamut
+static bool hlg_srgb8(const double *md, gamut_t mode, double r, double g, double b, uint32_t *out) {
+    double sc[3] = { r, g, b }, lin[3];
+    hlg_display(sc);
+    mat3(md, sc[0], sc[1], sc[2], lin);
+
+    bool oog = false;
+    for (int k = 0; k < 3; ++k) oog |= !(lin[k] >= -1e-6 && lin[k] <= 1.0 + 1e-6);
+    *out = (oog && mode == GAMUT_MAP) ? map_linear(lin) : clip_linear(lin);
+    return oog;
+}
+
+// hlg in bulk: the ootf scales a color by a power of its luminance, so the channels do not decode one by one like the
+// kernels need, every color goes through hlg_srgb8 in double instead (repeated ones from a direct-mapped cache)
+static size_t hlg_rgb8(const double *dec, const double *md, gamut_t mode, const uint32_t *in, size_t n, uint32_t *out) {
+    uint32_t key[MAP_CACHE], val[MAP_CACHE];
+    bool     flag[MAP_CACHE];
+    size_t   cnt = 0;
+    for (size_t k = 0; k < MAP_CACHE; ++k) key[k] = UINT32_MAX;
+
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t c    = in[i];
+        size_t   slot = ((c * 2654435761u) >> 20) & (MAP_CACHE - 1);
+        if (key[slot] != c) { key[slot] = c; flag[slot] = hlg_srgb8(md, mode, dec[(c >> 16) & 0xFF], dec[(c >> 8) & 0xFF], dec[c & 0xFF], &val[slot]); }
+        out[i] = val[slot];
+        cnt   += flag[slot];
+    }
+    return cnt;
+}
+
+static size_t hlg_rgb16(const double *md, gamut_t mode, const uint16_t *in, size_t n, uint32_t *out) {
+    uint64_t key[MAP_CACHE];
+    uint32_t val[MAP_CACHE];
+    bool     flag[MAP_CACHE];
+    size_t   cnt = 0;
+    for (size_t k = 0; k < MAP_CACHE; ++k) key[k] = UINT64_MAX;
+
+    for (size_t i = 0; i < n; ++i) {
+        const uint16_t *p    = in + 3 * i;
+        uint64_t        c    = ((uint64_t)p[0] << 32) | ((uint64_t)p[1] << 16) | p[2];
+        size_t          slot = ((c * 11400714819323198485ull) >> 52) & (MAP_CACHE - 1);
+        if (key[slot] != c) { key[slot] = c; flag[slot] = hlg_srgb8(md, mode, dec16d[p[0]], dec16d[p[1]], dec16d[p[2]], &val[slot]); }
+        out[i] = val[slot];
+        cnt   += flag[slot];
+    }
+    return cnt;
+}
+
+// matrix from transfer() values of s to linear srgb
+static void srgb_matrix(rgbspace_t s, double md[9], float m[9]) {
+    for (int k = 0; k < 9; ++k) { md[k] = to_srgb[prim(s)][k] * unit(s); m[k] = (float)md[k]; }
+}
+
+size_t rgbspace_rgb8_to_srgb8(rgbspace_t s, gamut_t mode, const uint32_t *in, size_t n, uint32_t *out) {
+    const float  *dec  = decode_lut8(s);
+    const double *decd = decode_lut8d(s);
+    double        md[9];
+    float         m[9];
+    srgb_matrix(s, md, m);
+
+    size_t cnt = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:cnt) if (n > RGBSPACE_CHUNK)
+    for (size_t i = 0; i < n; i += RGBSPACE_CHUNK) {
+        size_t  len = MIN((size_t)RGBSPACE_CHUNK, n - i);
+        uint8_t oog[RGBSPACE_CHUNK];
+        if (s == RGBSPACE_REC2100_HLG) { cnt += hlg_rgb8(decd, md, mode, in + i, len, out + i); continue; }
+
+        // the mapping pass reads the source codes again, so in place conversion works on a copy
+        uint32_t        copy[RGBSPACE_CHUNK];
+        const uint32_t *src = in + i;
+        if (in == out) { memcpy(copy, src, len * sizeof(uint32_t)); src = copy; }
+
+        size_t o = rgb8_mat3_gamut(dec, m, src, len, out + i, oog);
+        if (o && mode == GAMUT_MAP) map_flagged(decd, md, src, oog, len, out + i);
+        cnt += o;
+    }
+    return cnt;
+}
+
+size_t rgbspace_rgb16_to_srgb8(rgbspace_t s, gamut_t mode, unsigned maxval, const uint16_t *in, size_t n, uint32_t *out) {
+    double md[9];
+    float  m[9];
+    srgb_matrix(s, md, m);
+    decode_lut16(s, maxval);
+
+    size_t cnt = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:cnt) if (n > RGBSPACE_CHUNK)
+    for (size_t i = 0; i < n; i += RGBSPACE_CHUNK) {
+        size_t  len = MIN((size_t)RGBSPACE_CHUNK, n - i);
+        uint8_t oog[RGBSPACE_CHUNK];
+        if (s == RGBSPACE_REC2100_HLG) { cnt += hlg_rgb16(md, mode, in + 3 * i, len, out + i); continue; }
+
+        size_t o = rgb16_mat3_gamut(dec16, m, in + 3 * i, len, out + i, oog);
+        if (o && mode == GAMUT_MAP) map_flagged16(md, in + 3 * i, oog, len, out + i);
+        cnt += o;
+    }
+    return cnt;
+}
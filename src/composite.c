@@ -0,0 +1,119 @@
+#include <math.h>
+
+#include "composite.h"
+#include "converter.h"
+#include "kernels.h"
+#include "utility.h"
+
+static const char *blend_names[BLEND_COUNT] = {
+    "normal",      "multiply",   "screen",     "overlay",    "darken",     "lighten",    "color-dodge", "color-burn",
+    "hard-light",  "soft-light", "difference", "exclusion",  "hue",        "saturation", "color",       "luminosity"
+};
+
+const char *blend_name(blend_t mode) { return (mode >= 0 && mode < BLEND_COUNT) ? blend_names[mode] : NULLSTR; }
+
+bool blend_from_name(const char *name, blend_t *mode) {
+    for (int i = 0; i < BLEND_COUNT; ++i) {
+        if (strcasecmp_own(name, blend_names[i])) { *mode = (blend_t)i; return true; }
+    }
+    return false;
+}
+
+// separable blend functions of backdrop b and source s (both 0..1)
+static double blend_channel(blend_t mode, double b, double s) {
+    switch (mode) {
+        case BLEND_MULTIPLY:    return b * s;
+        case BLEND_SCREEN:      return b + s - b * s;
+        case BLEND_OVERLAY:     return blend_channel(BLEND_HARD_LIGHT, s, b);
+        case BLEND_DARKEN:      return MIN(b, s);
+        case BLEND_LIGHTEN:     return MAX(b, s);
+        case BLEND_COLOR_DODGE: return (b <= 0.0) ? 0.0 : (s >= 1.0) ? 1.0 : MIN(1.0, b / (1.0 - s));
+        case BLEND_COLOR_BURN:  return (b >= 1.0) ? 1.0 : (s <= 0.0) ? 0.0 : 1.0 - MIN(1.0, (1.0 - b) / s);
+        case BLEND_HARD_LIGHT:  return (s <= 0.5) ? 2.0 * b * s : blend_channel(BLEND_SCREEN, b, 2.0 * s - 1.0);
+        case BLEND_SOFT_LIGHT: {
+            if (s <= 0.5) return b - (1.0 - 2.0 * s) * b * (1.0 - b);
+            double d = (b <= 0.25) ? ((16.0 * b - 12.0) * b + 4.0) * b : sqrt(b);
+            return b + (2.0 * s - 1.0) * (d - b);
+        }
+        case BLEND_DIFFERENCE:  return fabs(b - s);
+        case BLEND_EXCLUSION:   return b + s - 2.0 * b * s;
+        default:                return s;
+    }
+}
+
+// helpers of the non-separable modes, luminosity uses the weights of the spec
+static double lum(const double c[3]) { return 0.3 * c[0] + 0.59 * c[1] + 0.11 * c[2]; }
+static double sat(const double c[3]) { return MAX(MAX(c[0], c[1]), c[2]) - MIN(MIN(c[0], c[1]), c[2]); }
+
+// move the channels towards the luminosity until all of them are within [0,1]
+static void clip_color(double c[3]) {
+    double l = lum(c), n = MIN(MIN(c[0], c[1]), c[2]), x = MAX(MAX(c[0], c[1]), c[2]);
+    for (int k = 0; k < 3; ++k) {
+        if (n < 0.0 && l - n > ZERO_THRESH) c[k] = l + (c[k] - l) * l / (l - n);
+        if (x > 1.0 && x - l > ZERO_THRESH) c[k] = l + (c[k] - l) * (1.0 - l) / (x - l);
+    }
+}
+
+static void set_lum(double c[3], double l) {
+    double d = l - lum(c);
+    for (int k = 0; k < 3; ++k) c[k] += d;
+    clip_color(c);
+}
+
+static void set_sat(double c[3], double s) {
+    int imax = 0, imin = 0;
+    for (int k = 1; k < 3; ++k) { if (c[k] > c[imax]) imax = k; if (c[k] < c[imin]) imin = k; }
+    if (imax == imin) { c[0] = c[1] = c[2] = 0.0; return; }
+
+    int imid = 3 - imax - imin;
+    c[imid] = (c[imid] - c[imin]) * s / (c[imax] - c[imin]);
+    c[imax] = s;
+    c[imin] = 0.0;
+}
+
+// B(b, s) of any mode into m
+static void blend(blend_t mode, const double b[3], const double s[3], double m[3]) {
+    if (mode < BLEND_HUE) { for (int k = 0; k < 3; ++k) m[k] = blend_channel(mode, b[k], s[k]); return; }
+
+    switch (mode) {
+        case BLEND_HUE:        for (int k = 0; k < 3; ++k) m[k] = s[k]; set_sat(m, sat(b)); set_lum(m, lum(b)); break;
+        case BLEND_SATURATION: for (int k = 0; k < 3; ++k) m[k] = b[k]; set_sat(m, sat(s)); set_lum(m, lum(b)); break;
+        case BLEND_COLOR:      for (int k = 0; k < 3; ++k) m[k] = s[k];                     set_lum(m, lum(b)); break;
+        default:               for (int k = 0; k < 3; ++k) m[k] = b[k];                     set_lum(m, lum(s)); break;
+    }
+}
+
+rgb_t composite_over(const rgb_t *src, double alpha, const rgb_t *dst, blend_t mode, bool linear) {
+    const double *lin = srgb_to_linear_lut8d();
+    const int     sv[3] = { src->r, src->g, src->b }, dv[3] = { dst->r, dst->g, dst->b };
+    double        s[3], b[3], m[3], v[3];
+
+    for (int k = 0; k < 3; ++k) {
+        s[k] = linear ? lin[CLAMP(sv[k], 0, 255)] : CLAMP(sv[k], 0, 255) / 255.0;
+        b[k] = linear ? lin[CLAMP(dv[k], 0, 255)] : CLAMP(dv[k], 0, 255) / 255.0;
+    }
+    blend(mode, b, s, m);
+
+    double a = CLAMP(alpha, 0.0, 1.0);
+    for (int k = 0; k < 3; ++k) {
+        v[k] = CLAMP((1.0 - a) * b[k] + a * m[k], 0.0, 1.0);
+        if (linear) v[k] = linear_to_srgb(v[k]);
+    }
+    return (rgb_t){ .r = (int)round(v[0] * 255.0), .g = (int)round(v[1] * 255.0), .b = (int)round(v[2] * 255.0) };
+}
+
+void composite_rgb8(const uint32_t *rgb, const uint8_t *alpha, const uint32_t *bg, size_t bgstep, size_t n,
+                    blend_t mode, bool linear, uint32_t *out) {
+    #pragma omp parallel for schedule(static) if (n > COMPOSITE_CHUNK)
+    for (size_t i = 0; i < n; i += COMPOSITE_CHUNK) {
+        size_t len = MIN((size_t)COMPOSITE_CHUNK, n - i);
+
+        if (mode == BLEND_NORMAL) { rgba8_over_rgb8(rgb + i, alpha + i, bg + i * bgstep, bgstep, len, linear, out + i); continue; }
+
+        for (size_t j = i; j < i + len; ++j) {
+            rgb_t s = hex_to_rgb(rgb[j]), d = hex_to_rgb(bg[j * bgstep]);
+            rgb_t c = composite_over(&s, alpha[j] / 255.0, &d, mode, linear);
+            out[j]  = rgb_to_hex(&c);
+        }
+    }
+}
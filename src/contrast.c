@@ -0,0 +1,418 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "batch.h"
+#include "contrast.h"
+#include "converter.h"
+#include "parser.h"
+#include "printer.h"
+#include "store.h"
+#include "utility.h"
+
+// bisection steps over the oklch lightness, 2^-24 is far below one 8-bit step at any lightness
+#define FIX_ITERS 24
+
+// apca-w3 0.0.98G-4g constants (https://github.com/Myndex/apca-w3)
+#define APCA_EXP       2.4                                // simple srgb decoding exponent
+#define APCA_BLK_THRS  0.022                              // soft black clamp: start
+#define APCA_BLK_CLMP  1.414                              // soft black clamp: exponent
+#define APCA_NORM_BG   0.56                               // dark text on light background
+#define APCA_NORM_TXT  0.57
+#define APCA_REV_TXT   0.62                               // light text on dark background
+#define APCA_REV_BG    0.65
+#define APCA_SCALE     1.14
+#define APCA_OFFSET    0.027
+#define APCA_LO_CLIP   0.1
+#define APCA_DELTA_Y   0.0005
+
+// select-only forms, vectorize in contrast_rows
+static inline double wcag_ratio(double la, double lb) {
+    double lighter = (la > lb) ? la : lb;
+    double darker  = (la > lb) ? lb : la;
+    return (lighter + 0.05) / (darker + 0.05);
+}
+
+// Lc from the clamped luminances and their power curves (tn = yt^0.57, tr = yt^0.62, bn = yb^0.56, br = yb^0.65)
+static inline double apca_lc_curves(double yt, double yb, double tn, double tr, double bn, double br) {
+    double sn = (bn - tn) * APCA_SCALE, sr = (br - tr) * APCA_SCALE;
+    double lc = (yb > yt) ? ((sn < APCA_LO_CLIP) ? 0.0 : sn - APCA_OFFSET)
+                          : ((sr > -APCA_LO_CLIP) ? 0.0 : sr + APCA_OFFSET);
+    return (fabs(yb - yt) < APCA_DELTA_Y) ? 0.0 : lc * 100.0;
+}
+
+// 8-bit lookup table of the apca channel curve (i / 255)^2.4, built on first use
+static const double *apca_lut8() {
+    static double      lut[256];
+    static atomic_bool ready = false;
+
+    if (!once_ready(&ready)) {
+        #pragma omp critical(apca_lut8)
+        if (!once_ready(&ready)) {
+            for (int i = 0; i < 256; ++i) lut[i] = pow(i / 255.0, APCA_EXP);
+            once_done(&ready);
+        }
+    }
+    return lut;
+}
+
+double contrast_ratio(double la, double lb) { return wcag_ratio(la, lb); }
+
+double apca_y(const rgb_t *rgb) {
+    const double *lut = apca_lut8();
+    double y = 0.2126729 * lut[rgb->r] + 0.7151522 * lut[rgb->g] + 0.0721750 * lut[rgb->b];
+    return (y < APCA_BLK_THRS) ? y + pow(APCA_BLK_THRS - y, APCA_BLK_CLMP) : y;
+}
+
+double apca_lc(double ytxt, double ybg) {
+    return apca_lc_curves(ytxt, ybg, pow(ytxt, APCA_NORM_TXT), pow(ytxt, APCA_REV_TXT), pow(ybg, APCA_NORM_BG), pow(ybg, APCA_REV_BG));
+}
+
+double apca_contrast(const rgb_t *txt, const rgb_t *bg) { return apca_lc(apca_y(txt), apca_y(bg)); }
+
+// 8-bit color at oklab lightness L with the chroma and hue of (a,b), gamut mapped or clipped
+static hex_t fix_candidate(double L, double a, double b, gamut_t mode) {
+    double  lin[3];
+    oklab_t ok = { .L = L, .a = a, .b = b };
+    oklab_to_linear(&ok, mode == GAMUT_MAP, lin);
+
+    int r = (int)round(CLAMP(linear_to_srgb(lin[0]), 0.0, 1.0) * 255.0);
+    int g = (int)round(CLAMP(linear_to_srgb(lin[1]), 0.0, 1.0) * 255.0);
+    int v = (int)round(CLAMP(linear_to_srgb(lin[2]), 0.0, 1.0) * 255.0);
+    return ((hex_t)r << 16) | ((hex_t)g << 8) | (hex_t)v;
+}
+
+// luminance of the metric (wcag relative luminance or clamped apca luminance) of an 8-bit color
+static double fix_y(contrast_metric_t metric, hex_t c) {
+    rgb_t rgb = hex_to_rgb(c);
+    return (metric == CONTRAST_APCA) ? apca_y(&rgb) : relative_luminance_rgb(&rgb);
+}
+
+// signed contrast of text with luminance yt on a background with luminance yb (wcag ratio or apca Lc)
+static double fix_contrast_of(contrast_metric_t metric, double yt, double yb) {
+    return (metric == CONTRAST_APCA) ? apca_lc(yt, yb) : wcag_ratio(yt, yb);
+}
+
+// bisect L between L0 and 1 (up) or 0 (down) for the color closest to L0 which is lighter (up) or darker (down) than
+// the background and reaches the target, both contrasts grow with the distance in luminance from the background,
+// so the predicate flips once along the interval; the feasible end is only ever moved to checked candidates,
+// so the returned color always passes
+static bool fix_search(contrast_metric_t metric, double L0, double a, double b, bool up, double yb, double target, gamut_t mode, hex_t *out) {
+    hex_t  best = fix_candidate(up ? 1.0 : 0.0, a, b, mode);
+    double y    = fix_y(metric, best);
+    if ((up ? y < yb : y > yb) || fabs(fix_contrast_of(metric, y, yb)) < target) return false;
+
+    double pass = up ? 1.0 : 0.0, fail = L0;
+    for (int i = 0; i < FIX_ITERS; ++i) {
+        double mid = (pass + fail) * 0.5;
+        hex_t  c   = fix_candidate(mid, a, b, mode);
+
+        y = fix_y(metric, c);
+        if ((up ? y >= yb : y <= yb) && fabs(fix_contrast_of(metric, y, yb)) >= target) { pass = mid; best = c; }
+        else                                                                              fail = mid;
+    }
+
+    *out = best;
+    return true;
+}
+
+// deltaEOK between two 8-bit colors
+static double fix_delta(hex_t x, hex_t y) {
+    rgb_t   cx = hex_to_rgb(x), cy = hex_to_rgb(y);
+    oklab_t p  = rgb_to_oklab(&cx), q = rgb_to_oklab(&cy);
+    return sqrt((p.L - q.L) * (p.L - q.L) + (p.a - q.a) * (p.a - q.a) + (p.b - q.b) * (p.b - q.b));
+}
+
+contrast_fix_t fix_contrast(contrast_metric_t metric, const rgb_t *fg, const rgb_t *bg, double target, gamut_t mode) {
+    hex_t  fhex = rgb_to_hex(fg);
+    double yb   = fix_y(metric, rgb_to_hex(bg));
+
+    contrast_fix_t res = { .hex = fhex, .contrast = fix_contrast_of(metric, fix_y(metric, fhex), yb), .delta = 0.0, .met = true };
+    if (fabs(res.contrast) >= target) return res;
+
+    oklab_t ok = rgb_to_oklab(fg);
+    double  L = ok.L, a = ok.a, b = ok.b;
+
+    hex_t hup = 0, hdown = 0;
+    bool  okup   = fix_search(metric, L, a, b, true,  yb, target, mode, &hup);
+    bool  okdown = fix_search(metric, L, a, b, false, yb, target, mode, &hdown);
+
+    double dup   = okup   ? fix_delta(fhex, hup)   : INFINITY;
+    double ddown = okdown ? fix_delta(fhex, hdown) : INFINITY;
+
+    // neither direction reaches the target with the chroma and hue of fg: fall back to the extreme with the higher contrast
+    if (!okup && !okdown) {
+        bool white = fabs(fix_contrast_of(metric, fix_y(metric, 0xFFFFFF), yb)) >= fabs(fix_contrast_of(metric, fix_y(metric, 0x000000), yb));
+        res.hex   = white ? 0xFFFFFF : 0x000000;
+        res.delta = fix_delta(fhex, res.hex);
+    }
+    else if (dup <= ddown) { res.hex = hup;   res.delta = dup; }
+    else                   { res.hex = hdown; res.delta = ddown; }
+
+    res.contrast = fix_contrast_of(metric, fix_y(metric, res.hex), yb);
+    res.met      = fabs(res.contrast) >= target;
+    return res;
+}
+
+void fix_contrast_batch(contrast_metric_t metric, const uint32_t *fg, const uint32_t *bg, size_t n, double target, gamut_t mode, contrast_fix_t *out) {
+    // pairs which already pass return at once, the others bisect, so the work per pair varies
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (size_t i = 0; i < n; ++i) {
+        rgb_t f = hex_to_rgb(fg[i]), b = hex_to_rgb(bg[i]);
+        out[i] = fix_contrast(metric, &f, &b, target, mode);
+    }
+}
+
+// read "fg bg" lines (blank lines skipped) into growing arrays, returns the number of pairs or -1 (*bad_line set on parse errors)
+static long fix_load(FILE *f, uint32_t **fg, uint32_t **bg, size_t *bad_line) {
+    char   line[STR_BUFSIZE];
+    size_t lineno = 0, n = 0, cap = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        ++lineno;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        const char *p = line;
+        while (*p == ' ' || *p == '\t') ++p;
+        if (!*p) continue;
+
+        color_t c0, c1;
+        if (parse_color2(line, &c0, &c1) != 2) { *bad_line = lineno; return -1; }
+
+        if (n == cap) {
+            cap = cap ? 2 * cap : 256;
+            uint32_t *nf = realloc(*fg, cap * sizeof(uint32_t));
+            if (nf) *fg = nf;
+            uint32_t *nb = realloc(*bg, cap * sizeof(uint32_t));
+            if (nb) *bg = nb;
+            if (!nf || !nb) return -1;
+        }
+        (*fg)[n] = c0.hex; (*bg)[n] = c1.hex;
+        ++n;
+    }
+    return (long)n;
+}
+
+static void print_fix_pair(hex_t fg, hex_t bg, const contrast_fix_t *r, double target, const prog_opts_t *opts) {
+    if (opts->json) {
+        printf("{\n  \"fg\": \"#%06x\",\n  \"bg\": \"#%06x\",\n  \"target\": %.*f,\n  \"fixed\": \"#%06x\",\n  \"%s\": %.*f,\n  \"deltaEOK\": %.*f,\n  \"met\": %s\n}\n",
+               fg, bg, opts->dplaces, target, r->hex, (opts->cmetric == CONTRAST_APCA) ? "Lc" : "ratio", opts->dplaces, r->contrast, opts->dplaces, r->delta, r->met ? "true" : "false");
+        return;
+    }
+
+    // -c <model> prints just the fixed color
+    if (opts->conversion) {
+        color_t c;
+        rgb_t   rgb = hex_to_rgb(r->hex);
+        color_from_rgb(&rgb, &c);
+        print_conversion(&c, opts);
+        return;
+    }
+
+    printf("Fixed foreground: #%06x (was #%06x, background #%06x)\n", r->hex, fg, bg);
+    printf("%s: %.*f (target %.*f, %s)\n", (opts->cmetric == CONTRAST_APCA) ? "APCA Lc         " : "Contrast ratio  ", opts->dplaces, r->contrast, opts->dplaces, target, r->met ? "PASS" : "FAIL");
+    printf("Delta E (Oklab) : %.*f\n", opts->dplaces, r->delta);
+}
+
+int run_fix_contrast(const prog_opts_t *opts, const char *progname) {
+    // fixed colors are gamut mapped (chroma reduced) unless clipping was asked for
+    gamut_t mode = opts->gamutset ? opts->gamut : GAMUT_MAP;
+    set_gamut(mode);
+
+    // the target is a ratio for wcag and |Lc| for apca
+    bool   apca   = opts->cmetric == CONTRAST_APCA;
+    double target = (opts->target >= 0.0) ? opts->target : apca ? APCA_LC_BODY : WCAG_AA;
+    if (apca ? !(target > 0.0 && target <= 108.0) : !(target >= 1.0 && target <= 21.0))
+        ERROR_EXIT("invalid contrast target %.*f (must be between %s)", opts->dplaces, target, apca ? "0 and 108 for apca" : "1 and 21 for wcag");
+
+    if (opts->fix) {
+        char buf[STR_BUFSIZE] = "";
+        for (int i = 0; i < opts->fix_n; ++i) if (!strncat_safe(buf, sizeof(buf), opts->fix[i], i > 0)) ERROR_EXIT("input too large");
+
+        color_t fg, bg;
+        if (parse_color2(buf, &fg, &bg) != 2) ERROR_EXIT("could not parse --fix-contrast fg bg %s", buf);
+
+        contrast_fix_t r = fix_contrast((contrast_metric_t)opts->cmetric, &fg.rgb, &bg.rgb, target, mode);
+        if (!r.met) fprintf(stderr, "warning: no color reaches contrast %.*f against #%06x, using #%06x\n", opts->dplaces, target, bg.hex, r.hex);
+        print_fix_pair(fg.hex, bg.hex, &r, target, opts);
+        return 0;
+    }
+
+    FILE *f = (strcmp(opts->fixbatch, "-") == 0) ? stdin : fopen(opts->fixbatch, "r");
+    if (!f) ERROR_EXIT("could not open contrast input %s", opts->fixbatch);
+
+    uint32_t *fg = NULL, *bg = NULL;
+    size_t    bad_line = 0;
+    long      n        = fix_load(f, &fg, &bg, &bad_line);
+    if (f != stdin) fclose(f);
+    if (n < 0 && bad_line) ERROR_EXIT("could not parse fg bg in %s, line %zu", opts->fixbatch, bad_line);
+    if (n < 0)             ERROR_EXIT("out of memory while reading %s", opts->fixbatch);
+
+    contrast_fix_t *res   = malloc((n ? n : 1) * sizeof(contrast_fix_t));
+    uint32_t       *fixed = malloc((n ? n : 1) * sizeof(uint32_t));
+    if (!res || !fixed) ERROR_EXIT("out of memory for %ld pairs", n);
+
+    fix_contrast_batch((contrast_metric_t)opts->cmetric, fg, bg, n, target, mode, res);
+
+    size_t unmet = 0;
+    for (long i = 0; i < n; ++i) { fixed[i] = res[i].hex; unmet += !res[i].met; }
+
+    if (opts->format == FORMAT_JSON) {
+        printf("[\n");
+        for (long i = 0; i < n; ++i)
+            printf("  { \"fg\": \"#%06x\", \"bg\": \"#%06x\", \"fixed\": \"#%06x\", \"%s\": %.*f, \"deltaEOK\": %.*f, \"met\": %s }%s\n",
+                   fg[i], bg[i], res[i].hex, apca ? "Lc" : "ratio", opts->dplaces, res[i].contrast, opts->dplaces, res[i].delta, res[i].met ? "true" : "false", (i + 1 < n) ? "," : "");
+        printf("]\n");
+    }
+    else if (opts->format == FORMAT_CSV) {
+        printf("index,fg,bg,fixed,%s,delta_eok,met\n", apca ? "Lc" : "ratio");
+        for (long i = 0; i < n; ++i)
+            printf("%ld,#%06x,#%06x,#%06x,%.*f,%.*f,%d\n", i, fg[i], bg[i], res[i].hex, opts->dplaces, res[i].contrast, opts->dplaces, res[i].delta, res[i].met);
+    }
+    else batch_print(fixed, n, opts);
+
+    if (unmet) fprintf(stderr, "warning: %zu of %ld pairs cannot reach contrast %.*f, black or white used instead\n", unmet, n, opts->dplaces, target);
+
+    free(res);
+    free(fixed);
+    free(fg);
+    free(bg);
+    return 0;
+}
+
+void contrast_columns(contrast_metric_t metric, const uint32_t *rgb, size_t n, double *cols) {
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; ++i) {
+        rgb_t c = hex_to_rgb(rgb[i]);
+        if (metric != CONTRAST_APCA) { cols[i] = relative_luminance_rgb(&c); continue; }
+
+        double y = apca_y(&c);
+        cols[i] = y; cols[n + i] = pow(y, APCA_NORM_TXT); cols[2 * n + i] = pow(y, APCA_REV_TXT); cols[3 * n + i] = pow(y, APCA_NORM_BG); cols[4 * n + i] = pow(y, APCA_REV_BG);
+    }
+}
+
+void contrast_rows(contrast_metric_t metric, const double *cols, size_t n, size_t r0, size_t r1, double *out, double *rev) {
+    const double *y = cols, *tn = cols + n, *tr = cols + 2 * n, *bn = cols + 3 * n, *br = cols + 4 * n;
+
+    // rows get shorter towards the end of the triangle
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (size_t i = r0; i < r1; ++i) {
+        double *row = out + (i - r0) * n;
+
+        if (metric == CONTRAST_APCA) {
+            double *rrow = rev + (i - r0) * n;
+            double  yi = y[i], tni = tn[i], tri = tr[i], bni = bn[i], bri = br[i];
+
+            #pragma omp simd
+            for (size_t j = i + 1; j < n; ++j) {
+                row[j]  = apca_lc_curves(yi, y[j], tni, tri, bn[j], br[j]);
+                rrow[j] = apca_lc_curves(y[j], yi, tn[j], tr[j], bni, bri);
+            }
+        } else {
+            double yi = y[i];
+
+            #pragma omp simd
+            for (size_t j = i + 1; j < n; ++j) row[j] = wcag_ratio(yi, y[j]);
+        }
+    }
+}
+
+// add the compliant partners per level (3 counters per color) of the pairs i < j in rows r0..r1-1 of a band:
+// a wcag pair counts for both colors, an apca pair for the color used as text (row: i on j, rev: j on i)
+// rows first, then columns, so every counter is only ever written by one thread
+static void contrast_tally(const double *band, const double *rev, size_t n, size_t r0, size_t r1, const double lv[3], size_t *counts) {
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (size_t i = r0; i < r1; ++i) {
+        const double *row = band + (i - r0) * n;
+        for (size_t j = i + 1; j < n; ++j) {
+            double c = fabs(row[j]);
+            counts[3 * i] += c >= lv[0]; counts[3 * i + 1] += c >= lv[1]; counts[3 * i + 2] += c >= lv[2];
+        }
+    }
+
+    const double *col = rev ? rev : band;
+    #pragma omp parallel for schedule(static)
+    for (size_t j = r0 + 1; j < n; ++j) {
+        for (size_t i = r0; i < MIN(r1, j); ++i) {
+            double c = fabs(col[(i - r0) * n + j]);
+            counts[3 * j] += c >= lv[0]; counts[3 * j + 1] += c >= lv[1]; counts[3 * j + 2] += c >= lv[2];
+        }
+    }
+}
+
+// one line (csv) or object (json) of a pair meeting at least the lowest level
+static void print_contrast_pair(const prog_opts_t *opts, const uint32_t *rgb, size_t i, size_t j, double c, const double lv[3], const char *names[3], size_t *pairs) {
+    bool json = opts->format == FORMAT_JSON, l1 = fabs(c) >= lv[1], l2 = fabs(c) >= lv[2];
+    if (json) printf("%s\n    { \"i\": %zu, \"j\": %zu, \"%s\": %.*f, \"%s\": true, \"%s\": %s, \"%s\": %s }",
+                     *pairs ? "," : "", i, j, (opts->cmetric == CONTRAST_APCA) ? "Lc" : "ratio", opts->dplaces, c, names[0], names[1], l1 ? "true" : "false", names[2], l2 ? "true" : "false");
+    else      printf("%zu,%zu,#%06x,#%06x,%.*f,1,%d,%d\n", i, j, rgb[i], rgb[j], opts->dplaces, c, l1, l2);
+    ++*pairs;
+}
+
+int run_contrast_matrix(const prog_opts_t *opts, const char *progname) {
+    if (opts->format != FORMAT_TEXT && opts->format != FORMAT_CSV && opts->format != FORMAT_JSON) ERROR_EXIT("--contrast-matrix only prints text, csv or json");
+
+    FILE *f = (strcmp(opts->cmatrix, "-") == 0) ? stdin : fopen(opts->cmatrix, "r");
+    if (!f) ERROR_EXIT("could not open contrast matrix input %s", opts->cmatrix);
+
+    color_store_t store;
+    store_init(&store);
+
+    size_t bad_line = 0;
+    long   n        = store_load(&store, f, &bad_line);
+    if (f != stdin) fclose(f);
+    if (n < 0 && bad_line) ERROR_EXIT("could not parse color in %s, line %zu", opts->cmatrix, bad_line);
+    if (n < 0)             ERROR_EXIT("out of memory while reading %s", opts->cmatrix);
+    store_flatten(&store, opts->over, opts->blend, opts->blendlinear);
+
+    // levels and names of the metric, wcag is symmetric (pairs i < j), apca depends on polarity (color i as text on j)
+    bool          apca     = opts->cmetric == CONTRAST_APCA;
+    const double  lv[3]    = { apca ? APCA_LC_LARGE : WCAG_AA_LARGE, apca ? APCA_LC_BODY : WCAG_AA, apca ? APCA_LC_FLUENT : WCAG_AAA };
+    const char   *names[3] = { apca ? "Lc60" : "AA_large", apca ? "Lc75" : "AA", apca ? "Lc90" : "AAA" };
+    const char   *value    = apca ? "Lc" : "ratio";
+
+    // luminance (and for apca its power curves) once per color, compliant partners per color and level
+    size_t  sz     = store.size;
+    size_t  ncols  = CONTRAST_COLS(opts->cmetric);
+    double *cols   = malloc(ncols * (sz ? sz : 1) * sizeof(double));
+    size_t *counts = calloc(3 * (sz ? sz : 1), sizeof(size_t));
+    double *band   = malloc((apca ? 2 : 1) * CMATRIX_BAND_ROWS * (sz ? sz : 1) * sizeof(double));
+    double *rev    = apca ? band + CMATRIX_BAND_ROWS * (sz ? sz : 1) : NULL;
+    if (!cols || !counts || !band) ERROR_EXIT("out of memory for %zu colors", sz);
+
+    contrast_columns((contrast_metric_t)opts->cmetric, store.rgb, sz, cols);
+
+    bool   json  = opts->format == FORMAT_JSON;
+    size_t pairs = 0;
+    if (json) printf("{\n  \"pairs\": [");
+    else      printf("i,j,hex_i,hex_j,%s,%s,%s,%s\n", value, names[0], names[1], names[2]);
+
+    // bands of the upper triangle (pairs i < j, apca in both polarities): counted in parallel, then printed in order
+    for (size_t r0 = 0; r0 < sz; r0 += CMATRIX_BAND_ROWS) {
+        size_t r1 = MIN(r0 + CMATRIX_BAND_ROWS, sz);
+        contrast_rows((contrast_metric_t)opts->cmetric, cols, sz, r0, r1, band, rev);
+        contrast_tally(band, rev, sz, r0, r1, lv, counts);
+
+        for (size_t i = r0; i < r1; ++i) {
+            const double *row = band + (i - r0) * sz, *rrow = apca ? rev + (i - r0) * sz : NULL;
+            for (size_t j = i + 1; j < sz; ++j) {
+                if (fabs(row[j]) >= lv[0])          print_contrast_pair(opts, store.rgb, i, j, row[j], lv, names, &pairs);
+                if (rrow && fabs(rrow[j]) >= lv[0]) print_contrast_pair(opts, store.rgb, j, i, rrow[j], lv, names, &pairs);
+            }
+        }
+    }
+
+    if (json) printf("%s],\n  \"colors\": [\n", pairs ? "\n  " : "");
+    else      printf("\nindex,hex,%s,%s,%s\n", names[0], names[1], names[2]);
+    for (size_t i = 0; i < sz; ++i) {
+        if (json) printf("    { \"hex\": \"#%06x\", \"%s\": %zu, \"%s\": %zu, \"%s\": %zu }%s\n", store.rgb[i], names[0], counts[3 * i], names[1], counts[3 * i + 1], names[2], counts[3 * i + 2], (i + 1 < sz) ? "," : "");
+        else      printf("%zu,#%06x,%zu,%zu,%zu\n", i, store.rgb[i], counts[3 * i], counts[3 * i + 1], counts[3 * i + 2]);
+    }
+    if (json) printf("  ]\n}\n");
+
+    free(band);
+    free(counts);
+    free(cols);
+    store_free(&store);
+    return 0;
+}
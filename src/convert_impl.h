@@ -0,0 +1,452 @@
+// color model math shared by the double (reference) and float32 (bulk) apis
+//
+// included once per precision, no include guard on purpose
+// the including file defines:
+//   CV_REAL                  : double or float
+//   CV_SFX                   : name suffix (f64 or f32), functions are named cv_<name>_<sfx>
+//   CV_C(x)                  : floating point literal of type CV_REAL (x or x##f)
+//   CV_M(fn)                 : libm function of type CV_REAL (fn or fn##f)
+//   CV_ZERO                  : threshold below which a value counts as 0
+// and optionally (libm is used otherwise):
+//   CV_CBRT(x)               : cube root
+//   CV_ATAN2_DEG(y, x)       : atan2 in degrees, [-180,180]
+//   CV_SINCOS_DEG(d, s, c)   : sine and cosine of d degrees into *s and *c
+//   CV_EXP(x)                : e^x
+//   CV_INLINE                : function specifiers (default static inline), the kernels force inlining into their loops
+//
+// rgb inputs / outputs are normalized to [0,1] unless stated otherwise, the caller scales and rounds
+// expressions keep the operation order of the original double code, so the double api stays bit-identical
+#define CV_CAT_(_name, _sfx) cv_##_name##_##_sfx
+#define CV_CAT(_name, _sfx)  CV_CAT_(_name, _sfx)
+#define CVFN(_name)          CV_CAT(_name, CV_SFX)
+#define R                    CV_REAL
+
+#ifndef CV_INLINE
+#define CV_INLINE static inline
+#endif
+#ifndef CV_CBRT
+#define CV_CBRT(_x) CV_M(cbrt)(_x)
+#endif
+#ifndef CV_ATAN2_DEG
+#define CV_ATAN2_DEG(_y, _x) (CV_M(atan2)(_y, _x) * CV_C(180.0) / (R)M_PI)
+#endif
+#ifndef CV_EXP
+#define CV_EXP(_x) CV_M(exp)(_x)
+#endif
+#ifndef CV_SINCOS_DEG
+#define CV_SINCOS_DEG(_d, _s, _c) do { R _hr = (_d) * (R)M_PI / CV_C(180.0); *(_s) = CV_M(sin)(_hr); *(_c) = CV_M(cos)(_hr); } while (0)
+#endif
+
+CV_INLINE R CVFN(srgb_to_linear)(R c) {
+    if (c <= CV_C(0.04045)) return c / CV_C(12.92);
+    return CV_M(pow)((c + CV_C(0.055)) / CV_C(1.055), CV_C(2.4));
+}
+
+CV_INLINE R CVFN(linear_to_srgb)(R c) {
+    if (c <= CV_C(0.0031308)) return CV_C(12.92) * c;
+    return CV_C(1.055) * CV_M(pow)(c, CV_C(1.0) / CV_C(2.4)) - CV_C(0.055);
+}
+
+// rec. 2100 pq (smpte st 2084): signal <-> display light normalized to 10000 cd/m2
+CV_INLINE R CVFN(pq_to_linear)(R e) {
+    R p = CV_M(pow)(e, CV_C(1.0) / CV_C(78.84375));
+    R n = p - CV_C(0.8359375);
+    if (n < CV_C(0.0)) n = CV_C(0.0);
+    return CV_M(pow)(n / (CV_C(18.8515625) - CV_C(18.6875) * p), CV_C(1.0) / CV_C(0.1593017578125));
+}
+
+CV_INLINE R CVFN(linear_to_pq)(R y) {
+    R p = CV_M(pow)(y, CV_C(0.1593017578125));
+    return CV_M(pow)((CV_C(0.8359375) + CV_C(18.8515625) * p) / (CV_C(1.0) + CV_C(18.6875) * p), CV_C(78.84375));
+}
+
+// rec. 2100 hlg: signal <-> scene light in [0,1] (inverse oetf / oetf)
+CV_INLINE R CVFN(hlg_to_linear)(R e) {
+    if (e <= CV_C(0.5)) return e * e / CV_C(3.0);
+    return (CV_EXP((e - CV_C(0.559910729529562)) / CV_C(0.17883277)) + CV_C(0.28466892)) / CV_C(12.0);
+}
+
+CV_INLINE R CVFN(linear_to_hlg)(R l) {
+    if (l <= CV_C(1.0) / CV_C(12.0)) return CV_M(sqrt)(CV_C(3.0) * l);
+    return CV_C(0.17883277) * CV_M(log)(CV_C(12.0) * l - CV_C(0.28466892)) + CV_C(0.559910729529562);
+}
+
+// wrap a hue in degrees to [0,360)
+CV_INLINE R CVFN(wrap_hue)(R h) {
+    if    (h < CV_C(0.0))    h += CV_C(360.0);
+    while (h >= CV_C(360.0)) h -= CV_C(360.0);
+    return h;
+}
+
+CV_INLINE void CVFN(rgb_to_cmyk)(R r, R g, R b, R *c, R *m, R *y, R *k) {
+    R mrgb = MAX(MAX(r,g),b);
+    *k = CV_C(1.0) - mrgb;
+
+    if (*k >= CV_C(1.0) - CV_ZERO) { *c = *m = *y = CV_C(0.0); return; }
+
+    R denom = CV_C(1.0) - *k;
+    *c = (CV_C(1.0) - r - *k) / denom;
+    *m = (CV_C(1.0) - g - *k) / denom;
+    *y = (CV_C(1.0) - b - *k) / denom;
+
+    // safety clamps for minor floating point rounding errors
+    *c = CLAMP(*c, CV_C(0.0), CV_C(1.0));
+    *m = CLAMP(*m, CV_C(0.0), CV_C(1.0));
+    *y = CLAMP(*y, CV_C(0.0), CV_C(1.0));
+}
+
+// hue in [0,360) of a chromatic color, shared by hsl and hsv
+CV_INLINE R CVFN(rgb_hue)(R r, R g, R b, R cmax, R delta) {
+    R hp;
+    if      (CV_M(fabs)(cmax - r) < CV_ZERO) hp = (g - b) / delta;                // cmax = r'
+    else if (CV_M(fabs)(cmax - g) < CV_ZERO) hp = (b - r) / delta + CV_C(2.0);    // cmax = g'
+    else                                     hp = (r - g) / delta + CV_C(4.0);    // cmax = b'
+    return CVFN(wrap_hue)(hp * CV_C(60.0));
+}
+
+CV_INLINE void CVFN(rgb_to_hsl)(R r, R g, R b, R *h, R *s, R *l) {
+    R cmax  = MAX(MAX(r,g),b);
+    R cmin  = MIN(MIN(r,g),b);
+    R delta = cmax - cmin;
+
+    // lightness
+    *l = (cmax + cmin) / CV_C(2.0);
+
+    // achromatic -> hue and saturation 0
+    if (delta < CV_ZERO) { *h = *s = CV_C(0.0); return; }
+
+    // saturation
+    R denom = CV_C(1.0) - CV_M(fabs)(CV_C(2.0) * (*l) - CV_C(1.0));
+    if (denom <= CV_ZERO) *s = CV_C(0.0);
+    else                  *s = MIN(delta / denom, CV_C(1.0)); // example: 251,251,255 -> sat very slightly over 1.0
+
+    *h = CVFN(rgb_hue)(r, g, b, cmax, delta);
+}
+
+CV_INLINE void CVFN(rgb_to_hsv)(R r, R g, R b, R *h, R *s, R *v) {
+    R cmax  = MAX(MAX(r,g),b);
+    R cmin  = MIN(MIN(r,g),b);
+    R delta = cmax - cmin;
+
+    // value
+    *v = cmax;
+
+    // achromatic -> hue and saturation 0
+    if (delta < CV_ZERO) { *h = *s = CV_C(0.0); return; }
+
+    // saturation
+    *s = (cmax <= CV_ZERO) ? CV_C(0.0) : (delta / cmax);
+    if (*s > CV_C(1.0)) *s = CV_C(1.0);
+
+    *h = CVFN(rgb_hue)(r, g, b, cmax, delta);
+}
+
+// returns 0..255 (unrounded)
+CV_INLINE void CVFN(cmyk_to_rgb)(R c, R m, R y, R k, R *r, R *g, R *b) {
+    *r = CV_C(255.0) * (CV_C(1.0) - c) * (CV_C(1.0) - k);
+    *g = CV_C(255.0) * (CV_C(1.0) - m) * (CV_C(1.0) - k);
+    *b = CV_C(255.0) * (CV_C(1.0) - y) * (CV_C(1.0) - k);
+}
+
+// place chroma C and intermediate X by hue sextant, then add m
+CV_INLINE void CVFN(hue_to_rgb)(R h, R C, R X, R m, R *r, R *g, R *b) {
+    // h must be in [0,360)
+    R hp = CV_M(fmod)(h, CV_C(360.0));
+    if (hp < CV_C(0.0)) hp += CV_C(360.0);
+
+    R z = CV_C(0.0);
+    if      (hp < CV_C(60.0))  { *r = C; *g = X; *b = z; } // [  0,  60)
+    else if (hp < CV_C(120.0)) { *r = X; *g = C; *b = z; } // [ 60, 120)
+    else if (hp < CV_C(180.0)) { *r = z; *g = C; *b = X; } // [120, 180)
+    else if (hp < CV_C(240.0)) { *r = z; *g = X; *b = C; } // [180, 240)
+    else if (hp < CV_C(300.0)) { *r = X; *g = z; *b = C; } // [240, 300)
+    else                       { *r = C; *g = z; *b = X; } // [300, 360)
+
+    *r += m; *g += m; *b += m;
+}
+
+CV_INLINE void CVFN(hsl_to_rgb)(R h, R s, R l, R *r, R *g, R *b) {
+    R C = (CV_C(1.0) - CV_M(fabs)(CV_C(2.0) * l - CV_C(1.0))) * s;
+    R X = C * (CV_C(1.0) - CV_M(fabs)(CV_M(fmod)(h / CV_C(60.0), CV_C(2.0)) - CV_C(1.0)));
+    CVFN(hue_to_rgb)(h, C, X, l - C / CV_C(2.0), r, g, b);
+}
+
+CV_INLINE void CVFN(hsv_to_rgb)(R h, R s, R v, R *r, R *g, R *b) {
+    R C = v * s;
+    R X = C * (CV_C(1.0) - CV_M(fabs)(CV_M(fmod)(h / CV_C(60.0), CV_C(2.0)) - CV_C(1.0)));
+    CVFN(hue_to_rgb)(h, C, X, v - C, r, g, b);
+}
+
+// hsl <-> hsv without going through rgb, the hue is shared (selects only, vectorizable)
+CV_INLINE void CVFN(hsl_to_hsv)(R s, R l, R *sv, R *v) {
+    R vv = l + s * MIN(l, CV_C(1.0) - l);
+    *sv = (vv > CV_ZERO) ? CV_C(2.0) * (CV_C(1.0) - l / vv) : CV_C(0.0);
+    *v  = vv;
+}
+
+CV_INLINE void CVFN(hsv_to_hsl)(R s, R v, R *sl, R *l) {
+    R ll = v * (CV_C(1.0) - s / CV_C(2.0));
+    R m  = MIN(ll, CV_C(1.0) - ll);
+    *sl = (m > CV_ZERO) ? (v - ll) / m : CV_C(0.0);
+    *l  = ll;
+}
+
+// linear rgb -> oklab
+CV_INLINE void CVFN(linear_to_oklab)(R rlin, R glin, R blin, R *L, R *a, R *b) {
+    R l = CV_C(0.4122214708) * rlin + CV_C(0.5363325363) * glin + CV_C(0.0514459929) * blin;
+    R m = CV_C(0.2119034982) * rlin + CV_C(0.6806995451) * glin + CV_C(0.1073969566) * blin;
+    R s = CV_C(0.0883024619) * rlin + CV_C(0.2817188376) * glin + CV_C(0.6299787005) * blin;
+
+    R cl = CV_CBRT(l);
+    R cm = CV_CBRT(m);
+    R cs = CV_CBRT(s);
+
+    *L = CV_C(0.2104542553) * cl + CV_C(0.7936177850) * cm - CV_C(0.0040720468) * cs;
+    *a = CV_C(1.9779984951) * cl - CV_C(2.4285922050) * cm + CV_C(0.4505937099) * cs;
+    *b = CV_C(0.0259040371) * cl + CV_C(0.7827717662) * cm - CV_C(0.8086757660) * cs;
+}
+
+// oklab -> linear rgb (may be out of [0,1])
+CV_INLINE void CVFN(oklab_to_linear)(R L, R a, R b, R *rlin, R *glin, R *blin) {
+    R cl = L + CV_C(0.3963377774) * a + CV_C(0.2158037573) * b;
+    R cm = L - CV_C(0.1055613458) * a - CV_C(0.0638541728) * b;
+    R cs = L - CV_C(0.0894841775) * a - CV_C(1.2914855480) * b;
+
+    R l = cl * cl * cl;
+    R m = cm * cm * cm;
+    R s = cs * cs * cs;
+
+    *rlin =  CV_C(4.0767416621) * l - CV_C(3.3077115913) * m + CV_C(0.2309699292) * s;
+    *glin = -CV_C(1.2684380046) * l + CV_C(2.6097574011) * m - CV_C(0.3413193965) * s;
+    *blin = -CV_C(0.0041960863) * l - CV_C(0.7034186147) * m + CV_C(1.7076147010) * s;
+}
+
+CV_INLINE void CVFN(oklab_to_oklch)(R a, R b, R *c, R *h) {
+    *c = CV_M(sqrt)(a * a + b * b);
+    *h = CVFN(wrap_hue)(CV_ATAN2_DEG(b, a));
+}
+
+CV_INLINE void CVFN(oklch_to_oklab)(R c, R h, R *a, R *b) {
+    R sh, ch;
+    CV_SINCOS_DEG(h, &sh, &ch);
+    *a = c * ch;
+    *b = c * sh;
+}
+
+// cie lab f(t) with the exact cie constants (epsilon = 216 / 24389, kappa = 24389 / 27)
+CV_INLINE R CVFN(lab_f)(R t) {
+    return (t > CV_C(216.0) / CV_C(24389.0)) ? CV_CBRT(t) : (CV_C(24389.0) / CV_C(27.0) * t + CV_C(16.0)) / CV_C(116.0);
+}
+
+// linear rgb -> cie xyz (d65) -> cielab relative to the d65 white point
+CV_INLINE void CVFN(linear_to_lab)(R rlin, R glin, R blin, R *L, R *a, R *b) {
+    R x = (CV_C(0.4124564) * rlin + CV_C(0.3575761) * glin + CV_C(0.1804375) * blin) / CV_C(0.95047);
+    R y =  CV_C(0.2126729) * rlin + CV_C(0.7151522) * glin + CV_C(0.0721750) * blin;
+    R z = (CV_C(0.0193339) * rlin + CV_C(0.1191920) * glin + CV_C(0.9503041) * blin) / CV_C(1.08883);
+
+    R fx = CVFN(lab_f)(x), fy = CVFN(lab_f)(y), fz = CVFN(lab_f)(z);
+    *L = CV_C(116.0) * fy - CV_C(16.0);
+    *a = CV_C(500.0) * (fx - fy);
+    *b = CV_C(200.0) * (fy - fz);
+}
+
+// hue angle of (a, b) in [0,360) degrees, 0 for achromatic colors
+// selects only (atan2 lies in [-180,180]), so the difference formulas below stay vectorizable
+CV_INLINE R CVFN(lab_hue)(R a, R b, R C) {
+    R h = CV_ATAN2_DEG(b, a);
+    h = (h < CV_C(0.0)) ? h + CV_C(360.0) : h;
+    h = (h >= CV_C(360.0)) ? h - CV_C(360.0) : h;
+    return (C > CV_C(0.0)) ? h : CV_C(0.0);
+}
+
+// cielab color differences, (L1,a1,b1) is the reference (standard) for the asymmetric ones (cie94, cmc)
+//   cie76:    euclidian distance
+//   cie94:    graphic arts weights (kL = 1, K1 = 0.045, K2 = 0.015)
+//   ciede2000 (kL = kC = kH = 1), implementation notes and test data from
+//             G. Sharma, W. Wu, E. N. Dalal, "The CIEDE2000 color-difference formula", 2005
+//   cmc l:c
+CV_INLINE R CVFN(delta_e76)(R L1, R a1, R b1, R L2, R a2, R b2) {
+    return CV_M(sqrt)((L1 - L2) * (L1 - L2) + (a1 - a2) * (a1 - a2) + (b1 - b2) * (b1 - b2));
+}
+
+// squared hue difference da^2 + db^2 - dC^2, clamped against rounding below 0
+CV_INLINE R CVFN(delta_h2)(R a1, R b1, R a2, R b2, R dC) {
+    R dH2 = (a1 - a2) * (a1 - a2) + (b1 - b2) * (b1 - b2) - dC * dC;
+    return (dH2 > CV_C(0.0)) ? dH2 : CV_C(0.0);
+}
+
+CV_INLINE R CVFN(delta_e94)(R L1, R a1, R b1, R L2, R a2, R b2) {
+    R C1 = CV_M(sqrt)(a1 * a1 + b1 * b1), C2 = CV_M(sqrt)(a2 * a2 + b2 * b2);
+    R dL = L1 - L2, dC = C1 - C2;
+    R SC = CV_C(1.0) + CV_C(0.045) * C1, SH = CV_C(1.0) + CV_C(0.015) * C1;
+    return CV_M(sqrt)(dL * dL + (dC / SC) * (dC / SC) + CVFN(delta_h2)(a1, b1, a2, b2, dC) / (SH * SH));
+}
+
+CV_INLINE R CVFN(delta_e2000)(R L1, R a1, R b1, R L2, R a2, R b2) {
+    const R p25 = CV_C(6103515625.0); // 25^7
+
+    R C1 = CV_M(sqrt)(a1 * a1 + b1 * b1), C2 = CV_M(sqrt)(a2 * a2 + b2 * b2);
+    R Cb = (C1 + C2) * CV_C(0.5), Cb2 = Cb * Cb, Cb7 = Cb2 * Cb2 * Cb2 * Cb;
+    R G  = CV_C(0.5) * (CV_C(1.0) - CV_M(sqrt)(Cb7 / (Cb7 + p25)));
+
+    R ap1 = (CV_C(1.0) + G) * a1, ap2 = (CV_C(1.0) + G) * a2;
+    R Cp1 = CV_M(sqrt)(ap1 * ap1 + b1 * b1), Cp2 = CV_M(sqrt)(ap2 * ap2 + b2 * b2);
+    R hp1 = CVFN(lab_hue)(ap1, b1, Cp1), hp2 = CVFN(lab_hue)(ap2, b2, Cp2);
+
+    // hue difference and mean hue, both undefined (0 / plain sum) if one chroma is 0
+    bool chromatic = Cp1 * Cp2 > CV_C(0.0);
+    R dh = hp2 - hp1, hsum = hp1 + hp2;
+    R hb = (CV_M(fabs)(dh) <= CV_C(180.0)) ? hsum * CV_C(0.5)
+         : (hsum < CV_C(360.0))            ? (hsum + CV_C(360.0)) * CV_C(0.5)
+         :                                   (hsum - CV_C(360.0)) * CV_C(0.5);
+    dh = (dh > CV_C(180.0)) ? dh - CV_C(360.0) : (dh < -CV_C(180.0)) ? dh + CV_C(360.0) : dh;
+    hb = chromatic ? hb : hsum;
+    dh = chromatic ? dh : CV_C(0.0);
+
+    R sdh, cdh;
+    CV_SINCOS_DEG(dh * CV_C(0.5), &sdh, &cdh);
+    R dL = L2 - L1, dC = Cp2 - Cp1, dH = CV_C(2.0) * CV_M(sqrt)(Cp1 * Cp2) * sdh;
+
+    R s1, c1, s2, c2, s3, c3, s4, c4;
+    CV_SINCOS_DEG(hb - CV_C(30.0),               &s1, &c1);
+    CV_SINCOS_DEG(CV_C(2.0) * hb,                &s2, &c2);
+    CV_SINCOS_DEG(CV_C(3.0) * hb + CV_C(6.0),    &s3, &c3);
+    CV_SINCOS_DEG(CV_C(4.0) * hb - CV_C(63.0),   &s4, &c4);
+    R T = CV_C(1.0) - CV_C(0.17) * c1 + CV_C(0.24) * c2 + CV_C(0.32) * c3 - CV_C(0.20) * c4;
+
+    R Lb  = (L1 + L2) * CV_C(0.5) - CV_C(50.0), Lb2 = Lb * Lb;
+    R Cpb = (Cp1 + Cp2) * CV_C(0.5), Cpb2 = Cpb * Cpb, Cpb7 = Cpb2 * Cpb2 * Cpb2 * Cpb;
+    R ht  = (hb - CV_C(275.0)) / CV_C(25.0);
+    R RC  = CV_C(2.0) * CV_M(sqrt)(Cpb7 / (Cpb7 + p25));
+
+    R sdt, cdt;
+    CV_SINCOS_DEG(CV_C(60.0) * CV_EXP(-ht * ht), &sdt, &cdt); // sin(2 * dtheta), dtheta = 30 exp(-ht^2)
+
+    R SL = CV_C(1.0) + CV_C(0.015) * Lb2 / CV_M(sqrt)(CV_C(20.0) + Lb2);
+    R SC = CV_C(1.0) + CV_C(0.045) * Cpb;
+    R SH = CV_C(1.0) + CV_C(0.015) * Cpb * T;
+    R RT = -sdt * RC;
+
+    R tL = dL / SL, tC = dC / SC, tH = dH / SH;
+    return CV_M(sqrt)(tL * tL + tC * tC + tH * tH + RT * tC * tH);
+}
+
+CV_INLINE R CVFN(delta_e_cmc)(R L1, R a1, R b1, R L2, R a2, R b2, R l, R c) {
+    R C1 = CV_M(sqrt)(a1 * a1 + b1 * b1), C2 = CV_M(sqrt)(a2 * a2 + b2 * b2);
+    R H1 = CVFN(lab_hue)(a1, b1, C1);
+    R dL = L1 - L2, dC = C1 - C2;
+
+    R SL = (L1 < CV_C(16.0)) ? CV_C(0.511) : CV_C(0.040975) * L1 / (CV_C(1.0) + CV_C(0.01765) * L1);
+    R SC = CV_C(0.0638) * C1 / (CV_C(1.0) + CV_C(0.0131) * C1) + CV_C(0.638);
+
+    R C14 = C1 * C1 * C1 * C1, F = CV_M(sqrt)(C14 / (C14 + CV_C(1900.0)));
+    bool mid = CV_M(fabs)(H1 - CV_C(254.5)) <= CV_C(90.5); // 164 <= H1 <= 345 as one comparison
+    R sh, ch;
+    CV_SINCOS_DEG(H1 + (mid ? CV_C(168.0) : CV_C(35.0)), &sh, &ch);
+    R T  = mid ? CV_C(0.56) + CV_M(fabs)(CV_C(0.2) * ch) : CV_C(0.36) + CV_M(fabs)(CV_C(0.4) * ch);
+    R SH = SC * (F * T + CV_C(1.0) - F);
+
+    R tL = dL / (l * SL), tC = dC / (c * SC);
+    return CV_M(sqrt)(tL * tL + tC * tC + CVFN(delta_h2)(a1, b1, a2, b2, dC) / (SH * SH));
+}
+
+// squared (weighted) euclidian distance between two triples
+CV_INLINE R CVFN(dist2_3)(R ax, R ay, R az, R bx, R by, R bz) {
+    return (ax - bx) * (ax - bx) + (ay - by) * (ay - by) + (az - bz) * (az - bz);
+}
+
+CV_INLINE R CVFN(wdist2_3)(R ax, R ay, R az, R bx, R by, R bz, R wx, R wy, R wz) {
+    R dx = ax - bx, dy = ay - by, dz = az - bz;
+    return wx * dx * dx + wy * dy * dy + wz * dz * dz;
+}
+
+// gamut mapping (https://www.w3.org/TR/css-color-4/#gamut-mapping)
+//
+// a channel counts as out of gamut once it is more than 1e-6 outside [0,1] in linear light,
+// far below one 8-bit step (3e-4 near black) and above the round-trip noise of the oklab matrices (about 1e-10)
+#define CV_GAMUT_EPS CV_C(1e-6)
+#define CV_GAMUT_JND CV_C(0.02)   // deltaEOK below which clipping is not noticeable
+#define CV_GAMUT_RES CV_C(0.0001) // chroma resolution of the search
+
+CV_INLINE bool CVFN(in_gamut_linear)(R r, R g, R b) {
+    return r >= -CV_GAMUT_EPS && r <= CV_C(1.0) + CV_GAMUT_EPS
+        && g >= -CV_GAMUT_EPS && g <= CV_C(1.0) + CV_GAMUT_EPS
+        && b >= -CV_GAMUT_EPS && b <= CV_C(1.0) + CV_GAMUT_EPS;
+}
+
+// oklab distance from (L,a,b) to linear rgb clamped to [0,1], the clamped color is written to *r, *g, *b
+CV_INLINE R CVFN(clip_delta_eok)(R L, R a, R b, R rl, R gl, R bl, R *r, R *g, R *bo) {
+    *r  = CLAMP(rl, CV_C(0.0), CV_C(1.0));
+    *g  = CLAMP(gl, CV_C(0.0), CV_C(1.0));
+    *bo = CLAMP(bl, CV_C(0.0), CV_C(1.0));
+
+    R cL, ca, cb;
+    CVFN(linear_to_oklab)(*r, *g, *bo, &cL, &ca, &cb);
+    return CV_M(sqrt)(CVFN(dist2_3)(L, a, b, cL, ca, cb));
+}
+
+// css color 4 gamut mapping of an oklab color to linear rgb in [0,1]
+// bisects the oklch chroma (lightness and hue stay fixed) until clipping the color is no longer noticeable
+// the hue direction is taken from a / b directly, so no trigonometry is needed
+CV_INLINE void CVFN(gamut_map_oklab)(R L, R a, R b, R *r, R *g, R *bo) {
+    if (L >= CV_C(1.0)) { *r = *g = *bo = CV_C(1.0); return; }
+    if (L <= CV_C(0.0)) { *r = *g = *bo = CV_C(0.0); return; }
+
+    R rl, gl, bl;
+    CVFN(oklab_to_linear)(L, a, b, &rl, &gl, &bl);
+    if (CVFN(in_gamut_linear)(rl, gl, bl) || !(CV_M(fabs)(a) + CV_M(fabs)(b) > CV_C(0.0))) {
+        CVFN(clip_delta_eok)(L, a, b, rl, gl, bl, r, g, bo);
+        return;
+    }
+
+    R C  = CV_M(sqrt)(a * a + b * b);
+    R ua = a / C, ub = b / C;
+    if (CVFN(clip_delta_eok)(L, a, b, rl, gl, bl, r, g, bo) < CV_GAMUT_JND) return;
+
+    R    lo = CV_C(0.0), hi = C;
+    bool lo_in_gamut = true;
+    while (hi - lo > CV_GAMUT_RES) {
+        R chroma = (lo + hi) * CV_C(0.5), ca = chroma * ua, cb = chroma * ub;
+        CVFN(oklab_to_linear)(L, ca, cb, &rl, &gl, &bl);
+
+        if (lo_in_gamut && CVFN(in_gamut_linear)(rl, gl, bl)) { lo = chroma; continue; }
+
+        R E = CVFN(clip_delta_eok)(L, ca, cb, rl, gl, bl, r, g, bo);
+        if (E < CV_GAMUT_JND) {
+            if (CV_GAMUT_JND - E < CV_GAMUT_RES) return;
+            lo_in_gamut = false;
+            lo          = chroma;
+        }
+        else hi = chroma;
+    }
+
+    // no clipped candidate within the jnd was found, the in-gamut lower bound is closer than the last clipped one
+    // (the spec returns the latter, which is noticeably off by definition)
+    if (lo_in_gamut) {
+        CVFN(oklab_to_linear)(L, lo * ua, lo * ub, &rl, &gl, &bl);
+        CVFN(clip_delta_eok)(L, a, b, rl, gl, bl, r, g, bo);
+    }
+}
+
+// wcag relative luminance of linear rgb
+CV_INLINE R CVFN(luminance)(R rlin, R glin, R blin) {
+    return CV_C(0.2126) * rlin + CV_C(0.7152) * glin + CV_C(0.0722) * blin;
+}
+
+#undef R
+#undef CV_REAL
+#undef CV_SFX
+#undef CV_C
+#undef CV_M
+#undef CV_ZERO
+#undef CVFN
+#undef CV_CAT
+#undef CV_CAT_
+#undef CV_CBRT
+#undef CV_ATAN2_DEG
+#undef CV_SINCOS_DEG
+#undef CV_EXP
+#undef CV_INLINE
+#undef CV_GAMUT_EPS
+#undef CV_GAMUT_JND
+#undef CV_GAMUT_RES
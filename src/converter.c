@@ -1,8 +1,11 @@
 #include <assert.h> // debug checks only, shouldn't (tm) be needed in prod.
+#include <limits.h>
 #include <math.h>
 #include <stddef.h>
+#include <stdlib.h>
 
 #include "converter.h"
+#include "lut.h"
 #include "parser.h"
 #include "utility.h"
 
@@ -14,7 +17,7 @@
 // we assume the parser has done a good job before filtering / modifying the values beforehand
 
 // ansi 16 palette
-static const rgb_t ansi16_rgb[16] = {
+const rgb_t ansi16_rgb[16] = {
     {0,0,0},       {128,0,0},   {0,128,0},   {128,128,0},
     {0,0,128},     {128,0,128}, {0,128,128}, {192,192,192},
     {128,128,128}, {255,0,0},   {0,255,0},   {255,255,0},
@@ -45,30 +48,118 @@ rgb_t hex_to_rgb(const hex_t hex) {
                     .b =         hex & 0xFF };
 }
 
+// precision tiers for the oklab / oklch math
+//
+// the fast tier replaces libm with polynomials on reduced arguments, the error bounds below are relative to the exact result
+// and far below the smallest printed step (1e-5 with -f 5), so printed output is identical for both tiers (checked in tests)
+//   cbrt:  near-minimax quartic on [1,2) (1.3e-5), refined by two newton steps, within 1 ulp
+//   atan2: reduced to |u| <= 1/16 around k/8, odd series up to u^13 (truncation below 1e-19), within 2 ulp
+//   sin / cos (degrees): exact reduction by quadrant to [-45,45] degrees, series up to r^15 / r^16 (truncation below 5e-17)
+// anything outside the handled range (zero, subnormal, inf, nan, huge angles) falls back to libm
+static precision_t precision = PRECISION_EXACT;
+
+void set_precision(precision_t p) { precision = p; }
+precision_t get_precision() { return precision; }
+
+static inline double cbrt_fast(double x) {
+    static const double cbrt2[3] = { 1.0, 1.2599210498948732, 1.5874010519681994 };
+
+    union { double d; uint64_t u; } v = { .d = x };
+    int e = (int)((v.u >> 52) & 0x7FF);
+    if (e == 0 || e == 0x7FF) return cbrt(x);
+
+    // x = m * 2^(3q + r), m in [1,2), r in {0,1,2}
+    e -= 1023;
+    v.u = (v.u & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull;
+    int q = (e >= 0) ? e / 3 : -((2 - e) / 3);
+    int r = e - 3 * q;
+
+    double m = v.d, a = m * (double)(1 << r);
+    double y = (0.5092481335492542 + m * (0.7117423866025611 + m * (-0.29395411808479627 + m * (0.08307903547962527 + m * -0.010102212336337315)))) * cbrt2[r];
+    y += (a / (y * y) - y) * (1.0 / 3.0);
+    y += (a / (y * y) - y) * (1.0 / 3.0);
+
+    union { double d; uint64_t u; } scale = { .u = (uint64_t)(q + 1023) << 52 };
+    y *= scale.d;
+    return (x < 0.0) ? -y : y;
+}
+
+static inline double atan2_fast(double y, double x) {
+    static const double atan_k8[9] = {
+        0.0,                0.12435499454676144, 0.24497866312686414, 0.35877067027057225, 0.4636476090008061,
+        0.5585993153435624, 0.6435011087932844,  0.7188299996216245,  0.7853981633974483
+    };
+
+    double ax = fabs(x), ay = fabs(y);
+    if (!isfinite(ax) || !isfinite(ay) || (ax == 0.0 && ay == 0.0)) return atan2(y, x);
+
+    // t in [0,1], atan(t) = atan(k/8) + atan(u)
+    bool   swap = ay > ax;
+    double t    = swap ? ax / ay : ay / ax;
+    int    k    = (int)(t * 8.0 + 0.5);
+    double c    = k * 0.125;
+    double u    = (t - c) / (1.0 + t * c);
+    double u2   = u * u;
+    double p    = u + u * u2 * (-1.0 / 3.0 + u2 * (1.0 / 5.0 + u2 * (-1.0 / 7.0 + u2 * (1.0 / 9.0 + u2 * (-1.0 / 11.0 + u2 * (1.0 / 13.0))))));
+    double at   = atan_k8[k] + p;
+
+    if (swap)    at = M_PI / 2.0 - at;
+    if (x < 0.0) at = M_PI - at;
+    return signbit(y) ? -at : at;
+}
+
+static inline void sincos_deg_fast(double deg, double *s, double *c) {
+    if (!(fabs(deg) < 1e9)) { double hr = deg * M_PI / 180.0; *s = sin(hr); *c = cos(hr); return; }
+
+    double q  = floor(deg / 90.0 + 0.5);
+    double r  = (deg - 90.0 * q) * (M_PI / 180.0);
+    double r2 = r * r;
+
+    double sr = r + r * r2 * (-1.0 / 6.0 + r2 * (1.0 / 120.0 + r2 * (-1.0 / 5040.0 + r2 * (1.0 / 362880.0 + r2 * (-1.0 / 39916800.0 + r2 * (1.0 / 6227020800.0 + r2 * (-1.0 / 1307674368000.0)))))));
+    double cr = 1.0 + r2 * (-1.0 / 2.0 + r2 * (1.0 / 24.0 + r2 * (-1.0 / 720.0 + r2 * (1.0 / 40320.0 + r2 * (-1.0 / 3628800.0 + r2 * (1.0 / 479001600.0 + r2 * (-1.0 / 87178291200.0 + r2 * (1.0 / 20922789888000.0))))))));
+
+    switch ((long)q & 3) {
+        case 0:  *s =  sr; *c =  cr; break;
+        case 1:  *s =  cr; *c = -sr; break;
+        case 2:  *s = -sr; *c = -cr; break;
+        default: *s = -cr; *c =  sr; break;
+    }
+}
+
+// out-of-gamut handling, colors are counted instead of warned about one by one
+static gamut_t       gamut         = GAMUT_CLIP;
+static unsigned long gamut_counter = 0;
+
+void set_gamut(gamut_t g) { gamut = g; }
+gamut_t get_gamut() { return gamut; }
+unsigned long gamut_count() { return gamut_counter; }
+void gamut_count_reset() { gamut_counter = 0; }
+
+// dispatch on the selected precision
+static inline double cbrt_p(double x)                { return (precision == PRECISION_FAST) ? cbrt_fast(x) : cbrt(x); }
+static inline double atan2_deg_p(double y, double x) { return ((precision == PRECISION_FAST) ? atan2_fast(y, x) : atan2(y, x)) * 180.0 / M_PI; }
+static inline void   sincos_deg_p(double deg, double *s, double *c) {
+    if (precision == PRECISION_FAST) { sincos_deg_fast(deg, s, c); return; }
+    double hr = deg * M_PI / 180.0;
+    *s = sin(hr); *c = cos(hr);
+}
+
+// double instantiation of the shared model math, the float32 one lives in src/converter_f32.c
+#define CV_REAL                   double
+#define CV_SFX                    f64
+#define CV_C(_x)                  _x
+#define CV_M(_fn)                 _fn
+#define CV_ZERO                   ZERO_THRESH
+#define CV_CBRT(_x)               cbrt_p(_x)
+#define CV_ATAN2_DEG(_y, _x)      atan2_deg_p(_y, _x)
+#define CV_SINCOS_DEG(_d, _s, _c) sincos_deg_p(_d, _s, _c)
+#include "convert_impl.h"
+
 cmyk_t rgb_to_cmyk(const rgb_t *rgb) {
     assert(rgb);
 
     cmyk_t cmyk;
-    double r = rgb->r / 255.0;
-    double g = rgb->g / 255.0;
-    double b = rgb->b / 255.0;
-
-    double mrgb = MAX(MAX(r,g),b);
-    cmyk.k = 1.0 - mrgb;
-
-    if (cmyk.k >= 1.0 - ZERO_THRESH) cmyk.c = cmyk.m = cmyk.y = 0.0;
-    else {
-        double denom = 1.0 - cmyk.k;
-        cmyk.c = (1.0 - r - cmyk.k) / denom;
-        cmyk.m = (1.0 - g - cmyk.k) / denom;
-        cmyk.y = (1.0 - b - cmyk.k) / denom;
-
-        // safety clamps for minor floating point rounding errors
-        cmyk.c = CLAMP(cmyk.c, 0.0, 1.0);
-        cmyk.m = CLAMP(cmyk.m, 0.0, 1.0);
-        cmyk.y = CLAMP(cmyk.y, 0.0, 1.0);
-    }
-
+    cv_rgb_to_cmyk_f64(rgb->r / 255.0, rgb->g / 255.0, rgb->b / 255.0, &cmyk.c, &cmyk.m, &cmyk.y, &cmyk.k);
     return cmyk;
 }
 
@@ -76,40 +167,7 @@ hsl_t rgb_to_hsl(const rgb_t *rgb) {
     assert(rgb);
 
     hsl_t hsl;
-    double r = rgb->r / 255.0;
-    double g = rgb->g / 255.0;
-    double b = rgb->b / 255.0;
-
-    double cmax = MAX(MAX(r,g),b);
-    double cmin = MIN(MIN(r,g),b);
-    double delta = cmax - cmin;
-
-    // lightness
-    hsl.l = (cmax + cmin) / 2.0;
-
-    // achromatic -> hue and saturation 0
-    if (delta < ZERO_THRESH) { hsl.h = hsl.sat = 0.0; return hsl; }
-
-    // saturation
-    double denom = 1.0 - fabs(2.0 * (hsl.l) - 1.0);
-    if (denom <= ZERO_THRESH) hsl.sat = 0.0;
-    else {
-        hsl.sat = delta / denom; 
-        if (hsl.sat > 1.0) hsl.sat = 1.0; // example: 251,251,255 -> sat very slightly over 1.0
-    }
-
-    // hue in [0,360)
-    double hp;
-    if      (fabs(cmax - r) < ZERO_THRESH) hp = (g - b) / delta;        // cmax = r'
-    else if (fabs(cmax - g) < ZERO_THRESH) hp = (b - r) / delta + 2.0;  // cmax = g'
-    else                                   hp = (r - g) / delta + 4.0;  // cmax = b'
-    hp *= 60.0;
-    
-    // wrap
-    if (hp < 0.0)       hp += 360.0;
-    while (hp >= 360.0) hp -= 360.0;
-    hsl.h = hp;
-
+    cv_rgb_to_hsl_f64(rgb->r / 255.0, rgb->g / 255.0, rgb->b / 255.0, &hsl.h, &hsl.sat, &hsl.l);
     return hsl;
 }
 
@@ -117,141 +175,72 @@ hsv_t rgb_to_hsv(const rgb_t *rgb) {
     assert(rgb);
 
     hsv_t hsv;
-    double r = rgb->r / 255.0;
-    double g = rgb->g / 255.0;
-    double b = rgb->b / 255.0;
-
-    double cmax = MAX(MAX(r,g),b);
-    double cmin = MIN(MIN(r,g),b);
-    double delta = cmax - cmin;
-
-    // value
-    hsv.v = cmax;
-
-    // achromatic -> hue and saturation 0
-    if (delta < ZERO_THRESH) { hsv.h = hsv.sat = 0.0; return hsv; }
-
-    // saturation
-    hsv.sat = (cmax <= ZERO_THRESH) ? 0.0 : (delta / cmax);
-    if (hsv.sat > 1.0) hsv.sat = 1.0;
-
-    // hue in [0,360)
-    double hp;
-    if      (fabs(cmax - r) < ZERO_THRESH) hp = (g - b) / delta;       // cmax = r'
-    else if (fabs(cmax - g) < ZERO_THRESH) hp = (b - r) / delta + 2.0; // cmax = g'
-    else                                   hp = (r - g) / delta + 4.0; // cmax = b'
-    
-    // wrap
-    hp *= 60.0;
-    if (hp < 0.0) hp += 360.0;
-    while (hp >= 360.0) hp -= 360.0;
-    hsv.h = hp;
-
+    cv_rgb_to_hsv_f64(rgb->r / 255.0, rgb->g / 255.0, rgb->b / 255.0, &hsv.h, &hsv.sat, &hsv.v);
     return hsv;
 }
 
 rgb_t cmyk_to_rgb(const cmyk_t *cmyk) {
     assert(cmyk);
-    return (rgb_t){ .r = (int)round(255 * (1 - cmyk->c) * (1 - cmyk->k)),
-                    .g = (int)round(255 * (1 - cmyk->m) * (1 - cmyk->k)),
-                    .b = (int)round(255 * (1 - cmyk->y) * (1 - cmyk->k)) };
+
+    double r, g, b;
+    cv_cmyk_to_rgb_f64(cmyk->c, cmyk->m, cmyk->y, cmyk->k, &r, &g, &b);
+    return (rgb_t){ .r = (int)round(r), .g = (int)round(g), .b = (int)round(b) };
 }
 
 rgb_t hsl_to_rgb(const hsl_t *hsl) {
     assert(hsl);
 
-    double C = (1.0 - fabs(2.0 * hsl->l - 1.0)) * hsl->sat;
-    double X = C * (1.0 - fabs(fmod(hsl->h / 60.0, 2.0) - 1.0));
-    double m = hsl->l - C / 2.0;
-
-    // h must be in [0,360)
     double r, g, b;
-    double hp = fmod(hsl->h, 360.0);
-    if (hp < 0.0) hp += 360.0;
-
-    if (hp < 60.0)       { r = C;   g = X;   b = 0.0; } // [  0,  60)
-    else if (hp < 120.0) { r = X;   g = C;   b = 0.0; } // [ 60, 120)
-    else if (hp < 180.0) { r = 0.0; g = C;   b = X;   } // [120, 180)
-    else if (hp < 240.0) { r = 0.0; g = X;   b = C;   } // [180, 240)
-    else if (hp < 300.0) { r = X;   g = 0.0; b = C;   } // [240, 300)
-    else                 { r = C;   g = 0.0; b = X;   } // [300, 360)
-
-    return (rgb_t){ .r = (int)round((r + m) * 255),
-                    .g = (int)round((g + m) * 255),
-                    .b = (int)round((b + m) * 255) };
+    cv_hsl_to_rgb_f64(hsl->h, hsl->sat, hsl->l, &r, &g, &b);
+    return (rgb_t){ .r = (int)round(r * 255),
+                    .g = (int)round(g * 255),
+                    .b = (int)round(b * 255) };
 }
 
 rgb_t hsv_to_rgb(const hsv_t *hsv) {
     assert(hsv);
-    
-    double C = hsv->v * hsv->sat;
-    double X = C * (1.0 - fabs(fmod(hsv->h / 60.0, 2.0) - 1.0));
-    double m = hsv->v - C;
 
     double r, g, b;
-    double hp = fmod(hsv->h, 360.0);
-    if (hp < 0.0) hp += 360.0;
-
-    if (hp < 60.0)       { r = C;   g = X;   b = 0.0; } // [  0,  60)
-    else if (hp < 120.0) { r = X;   g = C;   b = 0.0; } // [ 60, 120)
-    else if (hp < 180.0) { r = 0.0; g = C;   b = X;   } // [120, 180)
-    else if (hp < 240.0) { r = 0.0; g = X;   b = C;   } // [180, 240)
-    else if (hp < 300.0) { r = X;   g = 0.0; b = C;   } // [240, 300)
-    else                 { r = C;   g = 0.0; b = X;   } // [300, 360)
-
-    return (rgb_t){ .r = (int)round((r + m) * 255),
-                    .g = (int)round((g + m) * 255),
-                    .b = (int)round((b + m) * 255) };
+    cv_hsv_to_rgb_f64(hsv->h, hsv->sat, hsv->v, &r, &g, &b);
+    return (rgb_t){ .r = (int)round(r * 255),
+                    .g = (int)round(g * 255),
+                    .b = (int)round(b * 255) };
 }
 
 oklab_t rgb_to_oklab(const rgb_t *rgb) {
     assert(rgb);
 
-    double r = rgb->r / 255.0;
-    double g = rgb->g / 255.0;
-    double b = rgb->b / 255.0;
-
-    double rlin = srgb_to_linear(r);
-    double glin = srgb_to_linear(g);
-    double blin = srgb_to_linear(b);
-
-    double l =  0.4122214708 * rlin + 0.5363325363 * glin + 0.0514459929 * blin;
-    double m =  0.2119034982 * rlin + 0.6806995451 * glin + 0.1073969566 * blin;
-    double s =  0.0883024619 * rlin + 0.2817188376 * glin + 0.6299787005 * blin;
-
-    double cl = cbrt(l);
-    double cm = cbrt(m);
-    double cs = cbrt(s);
+    double rlin, glin, blin;
+    if (precision == PRECISION_FAST) {
+        const double *lin = srgb_to_linear_lut8d();
+        rlin = lin[rgb->r]; glin = lin[rgb->g]; blin = lin[rgb->b];
+    } else {
+        rlin = srgb_to_linear(rgb->r / 255.0);
+        glin = srgb_to_linear(rgb->g / 255.0);
+        blin = srgb_to_linear(rgb->b / 255.0);
+    }
 
     oklab_t out;
-    out.L =  0.2104542553 * cl + 0.7936177850 * cm - 0.0040720468 * cs;
-    out.a =  1.9779984951 * cl - 2.4285922050 * cm + 0.4505937099 * cs;
-    out.b =  0.0259040371 * cl + 0.7827717662 * cm - 0.8086757660 * cs;
-
+    cv_linear_to_oklab_f64(rlin, glin, blin, &out.L, &out.a, &out.b);
     return out;
 }
 
 rgb_t oklab_to_rgb(const oklab_t *oklab) {
     assert(oklab);
 
-    double cl = oklab->L + 0.3963377774 * oklab->a + 0.2158037573 * oklab->b;
-    double cm = oklab->L - 0.1055613458 * oklab->a - 0.0638541728 * oklab->b;
-    double cs = oklab->L - 0.0894841775 * oklab->a - 1.2914855480 * oklab->b;
+    double rlin, glin, blin;
+    cv_oklab_to_linear_f64(oklab->L, oklab->a, oklab->b, &rlin, &glin, &blin);
 
-    double l = cl * cl * cl;
-    double m = cm * cm * cm;
-    double s = cs * cs * cs;
-
-    double rlin =  4.0767416621 * l - 3.3077115913 * m + 0.2309699292 * s;
-    double glin = -1.2684380046 * l + 2.6097574011 * m - 0.3413193965 * s;
-    double blin = -0.0041960863 * l - 0.7034186147 * m + 1.7076147010 * s;
+    if (!cv_in_gamut_linear_f64(rlin, glin, blin)) {
+        #pragma omp atomic
+        ++gamut_counter;
+        if (gamut == GAMUT_MAP && isfinite(oklab->L) && isfinite(oklab->a) && isfinite(oklab->b)) cv_gamut_map_oklab_f64(oklab->L, oklab->a, oklab->b, &rlin, &glin, &blin);
+    }
 
     double r = linear_to_srgb(rlin);
     double g = linear_to_srgb(glin);
     double b = linear_to_srgb(blin);
 
-    if (r < 0.0 || r > 1.0 || g < 0.0 || g > 1.0 || b < 0.0 || b > 1.0) fprintf(stderr, "warning: color out-of-gamut in rgb, clamping will be applied: %f, %f, %f\n", r, g, b);
-
     if (!isfinite(r)) r = 0.0;
     if (!isfinite(g)) g = 0.0;
     if (!isfinite(b)) b = 0.0;
@@ -265,31 +254,51 @@ rgb_t oklab_to_rgb(const oklab_t *oklab) {
                     .b = (int)round(b * 255.0) };
 }
 
+oklab_t linear_to_oklab(const double lin[3]) {
+    oklab_t out;
+    cv_linear_to_oklab_f64(lin[0], lin[1], lin[2], &out.L, &out.a, &out.b);
+    return out;
+}
+
+void oklab_to_linear(const oklab_t *oklab, bool map, double lin[3]) {
+    cv_oklab_to_linear_f64(oklab->L, oklab->a, oklab->b, &lin[0], &lin[1], &lin[2]);
+    if (map && !cv_in_gamut_linear_f64(lin[0], lin[1], lin[2])) cv_gamut_map_oklab_f64(oklab->L, oklab->a, oklab->b, &lin[0], &lin[1], &lin[2]);
+}
+
+void gamut_map_linear(double lin[3]) {
+    if (cv_in_gamut_linear_f64(lin[0], lin[1], lin[2])) return;
+
+    oklab_t ok = linear_to_oklab(lin);
+    cv_gamut_map_oklab_f64(ok.L, ok.a, ok.b, &lin[0], &lin[1], &lin[2]);
+}
+
+double lab_f(double t) { return cv_lab_f_f64(t); }
+
 oklch_t rgb_to_oklch(const rgb_t *rgb) {
     oklab_t okl = rgb_to_oklab(rgb);
     oklch_t ch;
 
     ch.L = okl.L;
-    ch.c = sqrt(okl.a * okl.a + okl.b * okl.b);
+    cv_oklab_to_oklch_f64(okl.a, okl.b, &ch.c, &ch.h);
+    return ch;
+}
 
-    double h = atan2(okl.b, okl.a) * 180.0 / M_PI;
-    if    (h < 0.0)    h += 360.0;
-    while (h >= 360.0) h -= 360.0;
-    ch.h = h;
+lab_t rgb_to_lab(const rgb_t *rgb) {
+    assert(rgb);
 
-    return ch;
+    double rlin = srgb_to_linear(rgb->r / 255.0);
+    double glin = srgb_to_linear(rgb->g / 255.0);
+    double blin = srgb_to_linear(rgb->b / 255.0);
+
+    lab_t out;
+    cv_linear_to_lab_f64(rlin, glin, blin, &out.L, &out.a, &out.b);
+    return out;
 }
 
 rgb_t oklch_to_rgb(const oklch_t *ch) {
     assert(ch);
 
-    double hr = ch->h * M_PI / 180.0;
-
-    oklab_t lab;
-    lab.L = ch->L;
-    lab.a = ch->c * cos(hr);
-    lab.b = ch->c * sin(hr);
-
+    oklab_t lab = oklch_to_oklab(ch);
     return oklab_to_rgb(&lab);
 }
 
@@ -298,26 +307,16 @@ oklch_t oklab_to_oklch(const oklab_t *lab) {
 
     oklch_t ch;
     ch.L = lab->L;
-    ch.c = sqrt(lab->a * lab->a + lab->b * lab->b);
-    
-    double h = atan2(lab->b, lab->a) * 180.0 / M_PI;
-    if    (h < 0.0)    h += 360.0;
-    while (h >= 360.0) h -= 360.0;
-    ch.h = h;
-
+    cv_oklab_to_oklch_f64(lab->a, lab->b, &ch.c, &ch.h);
     return ch;
 }
 
 oklab_t oklch_to_oklab(const oklch_t *ch) {
     assert(ch);
 
-    double hr = ch->h * M_PI / 180.0;
-
     oklab_t lab;
     lab.L = ch->L;
-    lab.a = ch->c * cos(hr);
-    lab.b = ch->c * sin(hr);
-
+    cv_oklch_to_oklab_f64(ch->c, ch->h, &lab.a, &lab.b);
     return lab;
 }
 
@@ -349,22 +348,52 @@ rgb_t ansi256_idx_to_rgb(int idx) {
 rgb_t ansi16_idx_to_rgb(int idx) { return ansi16_rgb[idx]; }
 
 int rgb_to_ansi256_idx(const rgb_t *rgb) {
-    int    best   = 0;
-    double best_d = 1e300;
-    for (int idx = 0; idx < 256; ++idx) {
-        rgb_t p = ansi256_idx_to_rgb(idx);
+    int idx = lut_ansi256_idx(rgb_to_hex(rgb));
+    return (idx >= 0) ? idx : rgb_to_ansi256_idx_scan(rgb);
+}
 
-        double rlin  = (double)(rgb->r) / 255.0, glin  = (double)(rgb->g) / 255.0, blin  = (double)(rgb->b) / 255.0;
-        double prlin = (double)(p.r)    / 255.0, pglin = (double)(p.g)    / 255.0, pblin = (double)(p.b)    / 255.0;
-        double dr    = rlin - prlin,             dg    = glin - pglin,             dbi   = blin - pblin;
-        double d     = dr*dr                           + dg*dg                           + dbi*dbi;
+int rgb_to_ansi16_idx(const rgb_t *rgb) {
+    int idx = lut_ansi16_idx(rgb_to_hex(rgb));
+    return (idx >= 0) ? idx : rgb_to_ansi16_idx_scan(rgb);
+}
 
-        if (d < best_d) { best_d = d; best = idx; }
+// the 6x6x6 cube is a cartesian product of levels, so its closest point is found per channel
+// the system colors and the grayscale ramp are then checked against it in index order (strict <),
+// which gives the same result as scanning all 256 entries and keeping the first minimum
+static inline int closest_cube_level(int c) {
+    int best = 0;
+    for (int i = 1; i < 6; ++i) if (abs(c - cube_levels[i]) < abs(c - cube_levels[best])) best = i;
+    return best;
+}
+
+int rgb_to_ansi256_idx_scan(const rgb_t *rgb) {
+    int best   = 0;
+    int best_d = INT_MAX;
+
+    // system colors (0..15)
+    for (int i = 0; i < 16; ++i) {
+        int d = (int)dist2_rgb(rgb, &ansi16_rgb[i]);
+        if (d < best_d) { best_d = d; best = i; }
     }
+
+    // cube (16..231)
+    int   r6 = closest_cube_level(rgb->r), g6 = closest_cube_level(rgb->g), b6 = closest_cube_level(rgb->b);
+    rgb_t cp = { cube_levels[r6], cube_levels[g6], cube_levels[b6] };
+    int   cd = (int)dist2_rgb(rgb, &cp);
+    if (cd < best_d) { best_d = cd; best = 16 + 36 * r6 + 6 * g6 + b6; }
+
+    // grayscale (232..255)
+    for (int gi = 0; gi < 24; ++gi) {
+        int   v  = 8 + gi * 10;
+        rgb_t gp = { v, v, v };
+        int   d  = (int)dist2_rgb(rgb, &gp);
+        if (d < best_d) { best_d = d; best = 232 + gi; }
+    }
+
     return best;
 }
 
-int rgb_to_ansi16_idx(const rgb_t *rgb) {
+int rgb_to_ansi16_idx_scan(const rgb_t *rgb) {
     int best      = 0;
     double best_d = 1e300;
     for (int i = 0; i < 16; ++i) {
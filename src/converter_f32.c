@@ -0,0 +1,348 @@
+#include <math.h>
+#include <string.h>
+
+#include "converter.h"
+#include "kernels.h"
+#include "utility.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// float32 instantiation of the model math shared with the double api (see src/convert_impl.h)
+// 1e-6 instead of ZERO_THRESH, values that should be equal differ by about one float ulp (6e-8) at most
+#define CV_REAL   float
+#define CV_SFX    f32
+#define CV_C(_x)  _x##f
+#define CV_M(_fn) _fn##f
+#define CV_ZERO   1e-6f
+#include "convert_impl.h"
+
+// unpack 0xrrggbb to normalized floats
+#define UNPACK(_v, _r, _g, _b) float _r = (float)(((_v) >> 16) & 0xFF) / 255.0f, \
+                                     _g = (float)(((_v) >> 8)  & 0xFF) / 255.0f, \
+                                     _b = (float)( (_v)        & 0xFF) / 255.0f
+
+// pack normalized floats to 0xrrggbb, clamping to [0,1] (nan becomes 0)
+static inline uint32_t pack(float r, float g, float b) {
+    r = (r > 0.0f) ? MIN(r, 1.0f) : 0.0f;
+    g = (g > 0.0f) ? MIN(g, 1.0f) : 0.0f;
+    b = (b > 0.0f) ? MIN(b, 1.0f) : 0.0f;
+    return ((uint32_t)lrintf(r * 255.0f) << 16) | ((uint32_t)lrintf(g * 255.0f) << 8) | (uint32_t)lrintf(b * 255.0f);
+}
+
+void rgb8_to_cmyk_f32(const uint32_t *rgb, size_t n, float *c, float *m, float *y, float *k) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) { UNPACK(rgb[i], r, g, b); cv_rgb_to_cmyk_f32(r, g, b, &c[i], &m[i], &y[i], &k[i]); }
+}
+
+void rgb8_to_hsl_f32(const uint32_t *rgb, size_t n, float *h, float *s, float *l) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) { UNPACK(rgb[i], r, g, b); cv_rgb_to_hsl_f32(r, g, b, &h[i], &s[i], &l[i]); }
+}
+
+void rgb8_to_hsv_f32(const uint32_t *rgb, size_t n, float *h, float *s, float *v) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) { UNPACK(rgb[i], r, g, b); cv_rgb_to_hsv_f32(r, g, b, &h[i], &s[i], &v[i]); }
+}
+
+void cmyk_to_rgb8_f32(const float *c, const float *m, const float *y, const float *k, size_t n, uint32_t *rgb) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        float r, g, b;
+        cv_cmyk_to_rgb_f32(c[i], m[i], y[i], k[i], &r, &g, &b);
+        rgb[i] = pack(r / 255.0f, g / 255.0f, b / 255.0f);
+    }
+}
+
+void hsl_to_rgb8_f32(const float *h, const float *s, const float *l, size_t n, uint32_t *rgb) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) { float r, g, b; cv_hsl_to_rgb_f32(h[i], s[i], l[i], &r, &g, &b); rgb[i] = pack(r, g, b); }
+}
+
+void hsv_to_rgb8_f32(const float *h, const float *s, const float *v, size_t n, uint32_t *rgb) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) { float r, g, b; cv_hsv_to_rgb_f32(h[i], s[i], v[i], &r, &g, &b); rgb[i] = pack(r, g, b); }
+}
+
+// minimum number of colors before the gamut mapping pass is spread over threads
+#define GAMUT_PAR_MIN 4096
+
+size_t oklab_to_rgb8_f32(const float *L, const float *a, const float *b, size_t n, gamut_t mode, uint32_t *rgb) {
+    size_t out = 0;
+
+    #pragma omp simd reduction(+:out)
+    for (size_t i = 0; i < n; ++i) {
+        float rl, gl, bl;
+        cv_oklab_to_linear_f32(L[i], a[i], b[i], &rl, &gl, &bl);
+        out   += !cv_in_gamut_linear_f32(rl, gl, bl);
+        rgb[i] = pack(cv_linear_to_srgb_f32(rl), cv_linear_to_srgb_f32(gl), cv_linear_to_srgb_f32(bl));
+    }
+    if (mode != GAMUT_MAP || out == 0) return out;
+
+    // the search takes a data-dependent number of steps, so it runs per color and only where needed
+    #pragma omp parallel for schedule(dynamic, 256) if (n >= GAMUT_PAR_MIN)
+    for (size_t i = 0; i < n; ++i) {
+        float rl, gl, bl;
+        cv_oklab_to_linear_f32(L[i], a[i], b[i], &rl, &gl, &bl);
+        if (cv_in_gamut_linear_f32(rl, gl, bl) || !isfinite(L[i]) || !isfinite(a[i]) || !isfinite(b[i])) continue;
+
+        cv_gamut_map_oklab_f32(L[i], a[i], b[i], &rl, &gl, &bl);
+        rgb[i] = pack(cv_linear_to_srgb_f32(rl), cv_linear_to_srgb_f32(gl), cv_linear_to_srgb_f32(bl));
+    }
+    return out;
+}
+
+void oklch_to_oklab_f32(const float *C, const float *h, size_t n, float *a, float *b) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) cv_oklch_to_oklab_f32(C[i], h[i], &a[i], &b[i]);
+}
+
+void wdist2_rgb8_f32(const uint32_t *rgb, size_t n, uint32_t q, float wr, float wg, float wb, float *out) {
+    float qr = (float)((q >> 16) & 0xFF), qg = (float)((q >> 8) & 0xFF), qb = (float)(q & 0xFF);
+
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        float r = (float)((rgb[i] >> 16) & 0xFF), g = (float)((rgb[i] >> 8) & 0xFF), b = (float)(rgb[i] & 0xFF);
+        out[i] = cv_wdist2_3_f32(r, g, b, qr, qg, qb, wr, wg, wb);
+    }
+}
+
+void srgb_to_rgb8_f32(const float *r, const float *g, const float *b, size_t n, uint32_t *rgb) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) rgb[i] = pack(r[i], g[i], b[i]);
+}
+
+// conversion graph: every edge converts m colors of a block from column pointers in to out (which may be the same),
+// the one edge that can leave the gamut (oklab -> linear rgb) takes the gamut handling and returns the number of
+// out-of-gamut colors
+typedef void   (*edge_fn_t)(const float *const *in, float *const *out, size_t m);
+typedef size_t (*edge_gamut_fn_t)(const float *const *in, float *const *out, size_t m, gamut_t mode);
+
+static void edge_srgb_linear(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float r = in[0][i], g = in[1][i], b = in[2][i];
+        out[0][i] = cv_srgb_to_linear_f32(r); out[1][i] = cv_srgb_to_linear_f32(g); out[2][i] = cv_srgb_to_linear_f32(b);
+    }
+}
+
+static void edge_linear_srgb(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float r = in[0][i], g = in[1][i], b = in[2][i];
+        out[0][i] = cv_linear_to_srgb_f32(r); out[1][i] = cv_linear_to_srgb_f32(g); out[2][i] = cv_linear_to_srgb_f32(b);
+    }
+}
+
+static void edge_srgb_hsl(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float h, s, l;
+        cv_rgb_to_hsl_f32(in[0][i], in[1][i], in[2][i], &h, &s, &l);
+        out[0][i] = h; out[1][i] = s; out[2][i] = l;
+    }
+}
+
+static void edge_hsl_srgb(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float r, g, b;
+        cv_hsl_to_rgb_f32(in[0][i], in[1][i], in[2][i], &r, &g, &b);
+        out[0][i] = r; out[1][i] = g; out[2][i] = b;
+    }
+}
+
+static void edge_srgb_hsv(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float h, s, v;
+        cv_rgb_to_hsv_f32(in[0][i], in[1][i], in[2][i], &h, &s, &v);
+        out[0][i] = h; out[1][i] = s; out[2][i] = v;
+    }
+}
+
+static void edge_hsv_srgb(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float r, g, b;
+        cv_hsv_to_rgb_f32(in[0][i], in[1][i], in[2][i], &r, &g, &b);
+        out[0][i] = r; out[1][i] = g; out[2][i] = b;
+    }
+}
+
+static void edge_hsl_hsv(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float h = in[0][i], s, v;
+        cv_hsl_to_hsv_f32(in[1][i], in[2][i], &s, &v);
+        out[0][i] = h; out[1][i] = s; out[2][i] = v;
+    }
+}
+
+static void edge_hsv_hsl(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float h = in[0][i], s, l;
+        cv_hsv_to_hsl_f32(in[1][i], in[2][i], &s, &l);
+        out[0][i] = h; out[1][i] = s; out[2][i] = l;
+    }
+}
+
+static void edge_srgb_cmyk(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float c, mm, y, k;
+        cv_rgb_to_cmyk_f32(in[0][i], in[1][i], in[2][i], &c, &mm, &y, &k);
+        out[0][i] = c; out[1][i] = mm; out[2][i] = y; out[3][i] = k;
+    }
+}
+
+static void edge_cmyk_srgb(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float r, g, b;
+        cv_cmyk_to_rgb_f32(in[0][i], in[1][i], in[2][i], in[3][i], &r, &g, &b);
+        out[0][i] = r / 255.0f; out[1][i] = g / 255.0f; out[2][i] = b / 255.0f;
+    }
+}
+
+static void edge_linear_oklab(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float L, a, b;
+        cv_linear_to_oklab_f32(in[0][i], in[1][i], in[2][i], &L, &a, &b);
+        out[0][i] = L; out[1][i] = a; out[2][i] = b;
+    }
+}
+
+// like oklab_to_rgb8_f32: one vectorizable pass that clips, the out-of-gamut colors are mapped in a second one
+// results go to a local block first, in and out may be the same columns and mapping needs the oklab source
+static size_t edge_oklab_linear(const float *const *in, float *const *out, size_t m, gamut_t mode) {
+    size_t cnt = 0;
+    float  rl[CONVERT_BLOCK], gl[CONVERT_BLOCK], bl[CONVERT_BLOCK];
+
+    #pragma omp simd reduction(+:cnt)
+    for (size_t i = 0; i < m; ++i) {
+        cv_oklab_to_linear_f32(in[0][i], in[1][i], in[2][i], &rl[i], &gl[i], &bl[i]);
+        cnt += !cv_in_gamut_linear_f32(rl[i], gl[i], bl[i]);
+    }
+
+    if (mode == GAMUT_MAP && cnt > 0)
+        for (size_t i = 0; i < m; ++i) {
+            float L = in[0][i], a = in[1][i], b = in[2][i];
+            if (cv_in_gamut_linear_f32(rl[i], gl[i], bl[i]) || !isfinite(L) || !isfinite(a) || !isfinite(b)) continue;
+            cv_gamut_map_oklab_f32(L, a, b, &rl[i], &gl[i], &bl[i]);
+        }
+
+    // clip what is left (nan becomes 0)
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        out[0][i] = (rl[i] > 0.0f) ? MIN(rl[i], 1.0f) : 0.0f;
+        out[1][i] = (gl[i] > 0.0f) ? MIN(gl[i], 1.0f) : 0.0f;
+        out[2][i] = (bl[i] > 0.0f) ? MIN(bl[i], 1.0f) : 0.0f;
+    }
+    return cnt;
+}
+
+static void edge_oklab_oklch(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float L = in[0][i], c, h;
+        cv_oklab_to_oklch_f32(in[1][i], in[2][i], &c, &h);
+        out[0][i] = L; out[1][i] = c; out[2][i] = h;
+    }
+}
+
+static void edge_oklch_oklab(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float L = in[0][i], a, b;
+        cv_oklch_to_oklab_f32(in[1][i], in[2][i], &a, &b);
+        out[0][i] = L; out[1][i] = a; out[2][i] = b;
+    }
+}
+
+static void edge_linear_lab(const float *const *in, float *const *out, size_t m) {
+    #pragma omp simd
+    for (size_t i = 0; i < m; ++i) {
+        float L, a, b;
+        cv_linear_to_lab_f32(in[0][i], in[1][i], in[2][i], &L, &a, &b);
+        out[0][i] = L; out[1][i] = a; out[2][i] = b;
+    }
+}
+
+static const struct { cv_model_t from, to; edge_fn_t fn; edge_gamut_fn_t gamut_fn; } edges[] = {
+    { CVM_SRGB,   CVM_LINEAR, edge_srgb_linear,  NULL              }, { CVM_LINEAR, CVM_SRGB,   edge_linear_srgb,  NULL              },
+    { CVM_SRGB,   CVM_HSL,    edge_srgb_hsl,     NULL              }, { CVM_HSL,    CVM_SRGB,   edge_hsl_srgb,     NULL              },
+    { CVM_SRGB,   CVM_HSV,    edge_srgb_hsv,     NULL              }, { CVM_HSV,    CVM_SRGB,   edge_hsv_srgb,     NULL              },
+    { CVM_HSL,    CVM_HSV,    edge_hsl_hsv,      NULL              }, { CVM_HSV,    CVM_HSL,    edge_hsv_hsl,      NULL              },
+    { CVM_SRGB,   CVM_CMYK,   edge_srgb_cmyk,    NULL              }, { CVM_CMYK,   CVM_SRGB,   edge_cmyk_srgb,    NULL              },
+    { CVM_LINEAR, CVM_OKLAB,  edge_linear_oklab, NULL              }, { CVM_OKLAB,  CVM_LINEAR, NULL,              edge_oklab_linear },
+    { CVM_OKLAB,  CVM_OKLCH,  edge_oklab_oklch,  NULL              }, { CVM_OKLCH,  CVM_OKLAB,  edge_oklch_oklab,  NULL              },
+    { CVM_LINEAR, CVM_LAB,    edge_linear_lab,   NULL              },
+};
+#define NEDGES (sizeof(edges) / sizeof(edges[0]))
+
+int cv_model_channels(cv_model_t m) { return (m == CVM_CMYK) ? 4 : 3; }
+
+int convert_route(cv_model_t from, cv_model_t to, cv_model_t *path) {
+    // breadth-first search, prev[] doubles as the visited set
+    int prev[CVM_COUNT], queue[CVM_COUNT], head = 0, tail = 0;
+    for (int v = 0; v < CVM_COUNT; ++v) prev[v] = -1;
+    prev[from] = from; queue[tail++] = from;
+
+    while (head < tail && prev[to] < 0) {
+        int v = queue[head++];
+        for (size_t e = 0; e < NEDGES; ++e)
+            if ((int)edges[e].from == v && prev[edges[e].to] < 0) { prev[edges[e].to] = v; queue[tail++] = edges[e].to; }
+    }
+    if (prev[to] < 0) return -1;
+
+    int n = 0;
+    for (int v = to; v != (int)from; v = prev[v]) ++n;
+    for (int v = to, k = n; k >= 0; v = prev[v], --k) path[k] = (cv_model_t)v;
+    return n;
+}
+
+static size_t find_edge(cv_model_t from, cv_model_t to) {
+    size_t e = 0;
+    while (e < NEDGES && (edges[e].from != from || edges[e].to != to)) ++e;
+    return e;
+}
+
+// minimum number of colors before the blocks of convert_f32 are spread over threads
+#define CONVERT_PAR_MIN 16384
+
+long convert_f32(cv_model_t from, cv_model_t to, const float *const *in, size_t n, gamut_t mode, float *const *out) {
+    cv_model_t path[CVM_COUNT];
+    size_t     route[CVM_COUNT];
+    int        steps = convert_route(from, to, path);
+    if (steps < 0) return -1;
+    for (int s = 0; s < steps; ++s) route[s] = find_edge(path[s], path[s + 1]);
+
+    size_t cnt = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:cnt) if (n >= CONVERT_PAR_MIN)
+    for (size_t i0 = 0; i0 < n; i0 += CONVERT_BLOCK) {
+        size_t m = MIN((size_t)CONVERT_BLOCK, n - i0);
+
+        // intermediate models alternate between two block buffers, the last edge writes the output directly
+        float        buf[2][4][CONVERT_BLOCK];
+        const float *src[4];
+        float       *dst[4];
+        for (int c = 0; c < cv_model_channels(from); ++c) src[c] = in[c] + i0;
+
+        if (steps == 0) {
+            for (int c = 0; c < cv_model_channels(to); ++c) if (out[c] != in[c]) memmove(out[c] + i0, src[c], m * sizeof(float));
+            continue;
+        }
+        for (int s = 0; s < steps; ++s) {
+            for (int c = 0; c < 4; ++c) dst[c] = (s + 1 == steps) ? ((c < cv_model_channels(to)) ? out[c] + i0 : NULL) : buf[s & 1][c];
+            if (edges[route[s]].gamut_fn) cnt += edges[route[s]].gamut_fn(src, dst, m, mode);
+            else                          edges[route[s]].fn(src, dst, m);
+            for (int c = 0; c < 4; ++c) src[c] = dst[c];
+        }
+    }
+    return (long)cnt;
+}
@@ -0,0 +1,209 @@
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "converter.h"
+#include "cube.h"
+#include "cvd.h"
+#include "parser.h"
+#include "printer.h"
+#include "utility.h"
+
+// longest .cube line read at once, longer ones (titles) are skipped past
+#define CUBE_LINE 256
+
+// does line start with keyword followed by whitespace? *rest is set to the text after it
+static bool cube_keyword(const char *line, const char *keyword, const char **rest) {
+    size_t len = strlen(keyword);
+    if (strncmp(line, keyword, len) != 0 || !isspace((unsigned char)line[len])) return false;
+    *rest = line + len;
+    return true;
+}
+
+// parse exactly n floats followed by nothing but whitespace
+static bool cube_floats(const char *s, int n, float *out) {
+    for (int i = 0; i < n; ++i) {
+        char *end = NULL;
+        out[i] = strtof(s, &end);
+        if (end == s || !isfinite(out[i])) return false;
+        s = end;
+    }
+    while (isspace((unsigned char)*s)) ++s;
+    return *s == '\0';
+}
+
+bool cube_load(FILE *f, cube_t *c, size_t *bad_line) {
+    c->size = 0; c->data = NULL;
+    for (int k = 0; k < 3; ++k) { c->dmin[k] = 0.0f; c->dmax[k] = 1.0f; }
+
+    char   line[CUBE_LINE];
+    size_t lineno = 0, count = 0, total = 0;
+    while (fgets(line, sizeof(line), f)) {
+        ++lineno;
+
+        // skip the rest of overlong lines, only titles and comments may be that long
+        size_t len = strlen(line);
+        bool   cut = len == sizeof(line) - 1 && line[len - 1] != '\n';
+        if (cut) { int ch; while ((ch = fgetc(f)) != EOF && ch != '\n'); }
+
+        const char *p = line, *rest;
+        while (isspace((unsigned char)*p)) ++p;
+        if (*p == '\0' || *p == '#') continue;
+        if (cube_keyword(p, "TITLE", &rest)) continue;
+        if (cut) goto bad;
+
+        if (cube_keyword(p, "LUT_3D_SIZE", &rest)) {
+            char *end = NULL;
+            long  n   = strtol(rest, &end, 10);
+            while (isspace((unsigned char)*end)) ++end;
+            if (c->data || *end || n < 2 || n > CUBE_MAX_SIZE) goto bad;
+
+            c->size = (size_t)n;
+            total   = c->size * c->size * c->size;
+            c->data = malloc(3 * total * sizeof(float));
+            if (!c->data) { *bad_line = 0; return false; }
+        }
+        else if (cube_keyword(p, "DOMAIN_MIN", &rest)) { if (!cube_floats(rest, 3, c->dmin)) goto bad; }
+        else if (cube_keyword(p, "DOMAIN_MAX", &rest)) { if (!cube_floats(rest, 3, c->dmax)) goto bad; }
+        else if (cube_keyword(p, "LUT_3D_INPUT_RANGE", &rest)) {
+            float r[2];
+            if (!cube_floats(rest, 2, r)) goto bad;
+            for (int k = 0; k < 3; ++k) { c->dmin[k] = r[0]; c->dmax[k] = r[1]; }
+        }
+        else {
+            // node data, only after the size and never more than size^3 entries
+            if (!c->data || count == total || !cube_floats(p, 3, &c->data[3 * count])) goto bad;
+            ++count;
+        }
+    }
+
+    ++lineno;
+    if (!c->data || count != total) goto bad;
+    for (int k = 0; k < 3; ++k) if (!(c->dmax[k] > c->dmin[k])) goto bad;
+    return true;
+
+bad:
+    cube_free(c);
+    *bad_line = lineno;
+    return false;
+}
+
+void cube_free(cube_t *c) {
+    free(c->data);
+    c->data = NULL;
+    c->size = 0;
+}
+
+void cube_write(FILE *f, const cube_t *c, const char *title) {
+    if (title) fprintf(f, "TITLE \"%s\"\n", title);
+    fprintf(f, "LUT_3D_SIZE %zu\n", c->size);
+    fprintf(f, "DOMAIN_MIN %.6f %.6f %.6f\n", c->dmin[0], c->dmin[1], c->dmin[2]);
+    fprintf(f, "DOMAIN_MAX %.6f %.6f %.6f\n", c->dmax[0], c->dmax[1], c->dmax[2]);
+
+    size_t total = c->size * c->size * c->size;
+    for (size_t i = 0; i < total; ++i) fprintf(f, "%.6f %.6f %.6f\n", c->data[3 * i], c->data[3 * i + 1], c->data[3 * i + 2]);
+}
+
+// palette color closest to an 8-bit color
+static rgb_t snap_rgb(snap_t snap, const rgb_t *rgb) {
+    switch (snap) {
+        case SNAP_NAMED:   return hex_to_rgb(closest_named(rgb).hex);
+        case SNAP_ANSI16:  return ansi16_idx_to_rgb(rgb_to_ansi16_idx(rgb));
+        case SNAP_ANSI256: return ansi256_idx_to_rgb(rgb_to_ansi256_idx(rgb));
+        default:           return *rgb;
+    }
+}
+
+bool cube_generate(const prog_opts_t *opts, size_t size, cube_t *c) {
+    c->size = size;
+    for (int k = 0; k < 3; ++k) { c->dmin[k] = 0.0f; c->dmax[k] = 1.0f; }
+    c->data = malloc(3 * size * size * size * sizeof(float));
+    if (!c->data) return false;
+
+    // out-of-gamut results are gamut mapped unless clipping was asked for, as in image mode
+    gamut_t mode = opts->gamutset ? opts->gamut : GAMUT_MAP;
+    double  m[9];
+    cvd_matrix(opts->cvd, opts->severity, m);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t b = 0; b < size; ++b)
+        for (size_t g = 0; g < size; ++g)
+            for (size_t r = 0; r < size; ++r) {
+                double in[3] = { (double)r / (size - 1), (double)g / (size - 1), (double)b / (size - 1) }, lin[3], out[3];
+                for (int k = 0; k < 3; ++k) lin[k] = srgb_to_linear(in[k]);
+
+                // the matrix is the identity without --cvd, so only its results can leave the gamut
+                double sim[3] = { m[0] * lin[0] + m[1] * lin[1] + m[2] * lin[2],
+                                  m[3] * lin[0] + m[4] * lin[1] + m[5] * lin[2],
+                                  m[6] * lin[0] + m[7] * lin[1] + m[8] * lin[2] };
+                if (mode == GAMUT_MAP) gamut_map_linear(sim);
+                for (int k = 0; k < 3; ++k) out[k] = CLAMP(linear_to_srgb(sim[k]), 0.0, 1.0);
+
+                if (opts->snap != SNAP_NONE) {
+                    rgb_t q = { .r = (int)round(out[0] * 255.0), .g = (int)round(out[1] * 255.0), .b = (int)round(out[2] * 255.0) };
+                    q = snap_rgb(opts->snap, &q);
+                    out[0] = q.r / 255.0; out[1] = q.g / 255.0; out[2] = q.b / 255.0;
+                }
+
+                float *node = &c->data[3 * ((b * size + g) * size + r)];
+                node[0] = (float)out[0]; node[1] = (float)out[1]; node[2] = (float)out[2];
+            }
+
+    return true;
+}
+
+void cube_prepare(const cube_t *c, lut3d_t *lut) {
+    int32_t n = (int32_t)c->size;
+    lut->data    = c->data;
+    lut->step[0] = 3; lut->step[1] = 3 * n; lut->step[2] = 3 * n * n;
+
+    for (int k = 0; k < 3; ++k)
+        for (int v = 0; v < 256; ++v) {
+            // position on the axis, the lower node stays below the last one so its upper neighbour exists
+            double  t = CLAMP((v / 255.0 - c->dmin[k]) / (c->dmax[k] - c->dmin[k]), 0.0, 1.0) * (n - 1);
+            int32_t i = MIN((int32_t)t, n - 2);
+            lut->idx[k][v]  = i * lut->step[k];
+            lut->frac[k][v] = (float)(t - i);
+        }
+}
+
+void cube_apply(const lut3d_t *lut, bool tetra, const uint32_t *in, size_t n, uint32_t *out) {
+    #pragma omp parallel for schedule(static) if (n > CUBE_CHUNK)
+    for (size_t i = 0; i < n; i += CUBE_CHUNK) rgb8_lut3d(lut, tetra, in + i, MIN((size_t)CUBE_CHUNK, n - i), out + i);
+}
+
+void cube_open(const char *path, cube_t *c, lut3d_t *lut, const char *progname) {
+    FILE *f = (strcmp(path, "-") == 0) ? stdin : fopen(path, "r");
+    if (!f) ERROR_EXIT("could not open lut %s", path);
+
+    size_t bad_line = 0;
+    bool   ok       = cube_load(f, c, &bad_line);
+    if (f != stdin) fclose(f);
+    if (!ok && bad_line) ERROR_EXIT("invalid or missing 3d lut data in %s, line %zu", path, bad_line);
+    if (!ok)             ERROR_EXIT("out of memory while reading %s", path);
+
+    cube_prepare(c, lut);
+}
+
+int run_make_lut(const prog_opts_t *opts, const char *progname) {
+    cube_t c;
+    if (!cube_generate(opts, (size_t)opts->lutsize, &c)) ERROR_EXIT("out of memory for a lut of size %d", opts->lutsize);
+
+    // the title names the transformations that were sampled (gamut handling only matters for --cvd)
+    static const char *snaps[] = { "", "named", "ansi16", "ansi256" };
+    char title[STR_BUFSIZE] = "color";
+    if (opts->cvd != CVD_NONE)   snprintf(title + strlen(title), sizeof(title) - strlen(title), " %s %.2f", cvd_name(opts->cvd), opts->severity);
+    if (opts->cvd != CVD_NONE)   snprintf(title + strlen(title), sizeof(title) - strlen(title), (opts->gamutset && opts->gamut == GAMUT_CLIP) ? " clip" : " gamut-map");
+    if (opts->snap != SNAP_NONE) snprintf(title + strlen(title), sizeof(title) - strlen(title), " snap %s", snaps[opts->snap]);
+
+    FILE *f = (strcmp(opts->makelut, "-") == 0) ? stdout : fopen(opts->makelut, "w");
+    if (!f) ERROR_EXIT("could not open %s for writing", opts->makelut);
+
+    cube_write(f, &c, title);
+    bool ok = !ferror(f);
+    if (f != stdout) ok = (fclose(f) == 0) && ok;
+    cube_free(&c);
+    if (!ok) ERROR_EXIT("could not write %s", opts->makelut);
+    return 0;
+}
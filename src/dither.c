@@ -0,0 +1,383 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "converter.h"
+#include "dither.h"
+#include "kernels.h"
+#include "parser.h"
+#include "utility.h"
+
+static const char *dither_names[] = { "none", "floyd-steinberg", "atkinson", "bayer", "blue-noise" };
+
+const char *dither_name(dither_t method) { return (method >= 0 && method < (int)ARRAY_LENGTH(dither_names)) ? dither_names[method] : NULLSTR; }
+
+bool dither_from_name(const char *name, dither_t *method) {
+    if (strcasecmp_own(name, "fs")) { *method = DITHER_FLOYD_STEINBERG; return true; }
+
+    for (size_t i = 0; i < ARRAY_LENGTH(dither_names); ++i) {
+        if (strcasecmp_own(name, dither_names[i])) { *method = (dither_t)i; return true; }
+    }
+    return false;
+}
+
+// error diffusion taps: offset of the neighbour and its share of the error
+typedef struct { int dx, dy; float w; } tap_t;
+
+static const tap_t fs_taps[] = {
+    {  1, 0, 7.0f / 16.0f },
+    { -1, 1, 3.0f / 16.0f }, { 0, 1, 5.0f / 16.0f }, { 1, 1, 1.0f / 16.0f }
+};
+static const tap_t atkinson_taps[] = {
+    {  1, 0, 1.0f / 8.0f }, { 2, 0, 1.0f / 8.0f },
+    { -1, 1, 1.0f / 8.0f }, { 0, 1, 1.0f / 8.0f }, { 1, 1, 1.0f / 8.0f },
+    {  0, 2, 1.0f / 8.0f }
+};
+
+// 8x8 bayer matrix, the bits of x ^ y and y interleaved in reverse order
+static const float *bayer_mask() {
+    static float       mask[64];
+    static atomic_bool ready = false;
+
+    if (!once_ready(&ready)) {
+        #pragma omp critical(bayer_mask)
+        if (!once_ready(&ready)) {
+            for (unsigned y = 0; y < 8; ++y) {
+                for (unsigned x = 0; x < 8; ++x) {
+                    unsigned v = 0;
+                    for (unsigned k = 0; k < 3; ++k) v |= (((x ^ y) >> k & 1) << (5 - 2 * k)) | ((y >> k & 1) << (4 - 2 * k));
+                    mask[y * 8 + x] = (v + 0.5f) / 64.0f - 0.5f;
+                }
+            }
+            once_done(&ready);
+        }
+    }
+    return mask;
+}
+
+#define BN_SIDE  BLUE_NOISE_SIZE
+#define BN_CELLS (BLUE_NOISE_SIZE * BLUE_NOISE_SIZE)
+#define BN_SIGMA 1.5
+
+// set or clear cell i of a binary pattern and update the energy of every cell (sum of the gaussian kernel over the set
+// cells, on the torus)
+static void bn_toggle(uint8_t *bits, double *energy, const double *kern, size_t i, bool on) {
+    size_t ix = i % BN_SIDE, iy = i / BN_SIDE;
+    double s  = on ? 1.0 : -1.0;
+
+    bits[i] = on;
+    for (size_t y = 0; y < BN_SIDE; ++y) {
+        const double *g = kern + ((y + BN_SIDE - iy) % BN_SIDE) * BN_SIDE;
+        for (size_t x = 0; x < BN_SIDE; ++x) energy[y * BN_SIDE + x] += s * g[(x + BN_SIDE - ix) % BN_SIDE];
+    }
+}
+
+// tightest cluster (set cell of highest energy) or largest void (clear cell of lowest energy), first one on ties
+static size_t bn_extreme(const uint8_t *bits, const double *energy, bool ones) {
+    size_t best  = 0;
+    bool   found = false;
+    for (size_t i = 0; i < BN_CELLS; ++i) {
+        if (bits[i] != ones) continue;
+        if (!found || (ones ? energy[i] > energy[best] : energy[i] < energy[best])) { best = i; found = true; }
+    }
+    return best;
+}
+
+// void-and-cluster (ulichney): a random tenth of the cells is spread out evenly by moving the tightest cluster into the
+// largest void, then these cells are ranked by removing the tightest clusters and the rest by filling the largest voids
+// (with a symmetric kernel, the tightest cluster of the clear cells is the largest void of the set ones)
+static void blue_noise_build(float *mask) {
+    static double   kern[BN_CELLS], e0[BN_CELLS], e[BN_CELLS];
+    static uint8_t  b0[BN_CELLS], b[BN_CELLS];
+    static uint16_t rank[BN_CELLS];
+
+    for (size_t y = 0; y < BN_SIDE; ++y) {
+        for (size_t x = 0; x < BN_SIDE; ++x) {
+            double dx = (double)MIN(x, BN_SIDE - x), dy = (double)MIN(y, BN_SIDE - y);
+            kern[y * BN_SIDE + x] = exp(-(dx * dx + dy * dy) / (2.0 * BN_SIGMA * BN_SIGMA));
+        }
+    }
+
+    memset(b0, 0, sizeof(b0));
+    memset(e0, 0, sizeof(e0));
+    uint32_t seed = 0x626C7565;
+    size_t   ones = 0;
+    while (ones < BN_CELLS / 10) {
+        seed = seed * 1664525u + 1013904223u;
+        size_t i = (seed >> 8) % BN_CELLS;
+        if (!b0[i]) { bn_toggle(b0, e0, kern, i, true); ++ones; }
+    }
+    for (size_t it = 0; it < BN_CELLS; ++it) {
+        size_t c = bn_extreme(b0, e0, true);
+        bn_toggle(b0, e0, kern, c, false);
+        size_t v = bn_extreme(b0, e0, false);
+        bn_toggle(b0, e0, kern, v, true);
+        if (v == c) break;
+    }
+
+    memcpy(b, b0, sizeof(b));
+    memcpy(e, e0, sizeof(e));
+    for (size_t r = ones; r-- > 0;) {
+        size_t c = bn_extreme(b, e, true);
+        bn_toggle(b, e, kern, c, false);
+        rank[c] = (uint16_t)r;
+    }
+
+    memcpy(b, b0, sizeof(b));
+    memcpy(e, e0, sizeof(e));
+    for (size_t r = ones; r < BN_CELLS; ++r) {
+        size_t v = bn_extreme(b, e, false);
+        bn_toggle(b, e, kern, v, true);
+        rank[v] = (uint16_t)r;
+    }
+
+    for (size_t i = 0; i < BN_CELLS; ++i) mask[i] = (rank[i] + 0.5f) / BN_CELLS - 0.5f;
+}
+
+const float *blue_noise_mask() {
+    static float       mask[BN_CELLS];
+    static atomic_bool ready = false;
+
+    if (!once_ready(&ready)) {
+        #pragma omp critical(blue_noise_mask)
+        if (!once_ready(&ready)) { blue_noise_build(mask); once_done(&ready); }
+    }
+    return mask;
+}
+
+// packed colors to the working space
+static void to_working(const ditherer_t *d, const uint32_t *px, size_t n, float *c0, float *c1, float *c2) {
+    if (!d->linear) { rgb8_to_oklab_f32(px, n, c0, c1, c2); return; }
+
+    const float *lin = srgb_to_linear_lut8();
+    for (size_t i = 0; i < n; ++i) {
+        c0[i] = lin[(px[i] >> 16) & 0xFF];
+        c1[i] = lin[(px[i] >> 8) & 0xFF];
+        c2[i] = lin[px[i] & 0xFF];
+    }
+}
+
+// candidates of every grid cell: the palette colors that may be closest to some point of the cell, i.e. whose shortest
+// distance to the cell is at most the smallest longest distance of any color to it (cells grown by a little against
+// rounding), false if out of memory
+static bool grid_build(ditherer_t *d) {
+    size_t cells = (size_t)DITHER_GRID * DITHER_GRID * DITHER_GRID;
+    float  step[3];
+
+    for (int k = 0; k < 3; ++k) {
+        d->glo[k]  = d->lo[k] - d->spread;
+        step[k]    = (d->hi[k] + d->spread - d->glo[k]) / DITHER_GRID;
+        step[k]    = MAX(step[k], 1e-6f);
+        d->ginv[k] = 1.0f / step[k];
+    }
+
+    d->goff = malloc((cells + 1) * sizeof(uint32_t));
+    if (!d->goff) return false;
+
+    for (int pass = 0; pass < 2; ++pass) {
+        size_t total = 0;
+        for (size_t c = 0; c < cells; ++c) {
+            size_t cell[3] = { c % DITHER_GRID, c / DITHER_GRID % DITHER_GRID, c / (DITHER_GRID * DITHER_GRID) };
+            float  a[3], b[3];
+            for (int k = 0; k < 3; ++k) {
+                a[k] = d->glo[k] + cell[k] * step[k] - 1e-3f * step[k];
+                b[k] = a[k] + 1.002f * step[k];
+            }
+
+            float bound = INFINITY;
+            for (size_t i = 0; i < d->n; ++i) {
+                float far = 0.0f;
+                for (int k = 0; k < 3; ++k) { float u = MAX(fabsf(d->pal[k][i] - a[k]), fabsf(d->pal[k][i] - b[k])); far += u * u; }
+                bound = MIN(bound, far);
+            }
+
+            if (pass == 1) d->goff[c] = (uint32_t)total;
+            for (size_t i = 0; i < d->n; ++i) {
+                float near = 0.0f;
+                for (int k = 0; k < 3; ++k) {
+                    float p = d->pal[k][i], u = (p < a[k]) ? a[k] - p : (p > b[k]) ? p - b[k] : 0.0f;
+                    near += u * u;
+                }
+                if (near > bound) continue;
+                if (pass == 1) d->gidx[total] = (uint16_t)i;
+                ++total;
+            }
+        }
+
+        if (pass == 0 && !(d->gidx = malloc(total * sizeof(uint16_t)))) return false;
+        if (pass == 1) d->goff[cells] = (uint32_t)total;
+    }
+    return true;
+}
+
+// closest palette color (first one on ties) through the grid, points outside of it scan the whole palette
+static inline size_t grid_nearest(const ditherer_t *d, float x, float y, float z) {
+    float u = (x - d->glo[0]) * d->ginv[0], v = (y - d->glo[1]) * d->ginv[1], w = (z - d->glo[2]) * d->ginv[2];
+    if (!(u >= 0.0f && u < DITHER_GRID && v >= 0.0f && v < DITHER_GRID && w >= 0.0f && w < DITHER_GRID)) {
+        return nearest3_f32(d->pal[0], d->pal[1], d->pal[2], d->n, x, y, z, NULL);
+    }
+
+    size_t c    = ((size_t)w * DITHER_GRID + (size_t)v) * DITHER_GRID + (size_t)u;
+    size_t best = 0;
+    float  bd   = INFINITY;
+    for (uint32_t j = d->goff[c]; j < d->goff[c + 1]; ++j) {
+        size_t i  = d->gidx[j];
+        float  dx = d->pal[0][i] - x, dy = d->pal[1][i] - y, dz = d->pal[2][i] - z;
+        float  dd = dx * dx + dy * dy + dz * dz;
+        if (dd < bd) { bd = dd; best = i; }
+    }
+    return best;
+}
+
+void dither_free(ditherer_t *d) {
+    free(d->hex);
+    free(d->done);
+    free(d->goff);
+    free(d->gidx);
+    for (int k = 0; k < 3; ++k) { free(d->pal[k]); free(d->c[k]); free(d->carry[k]); }
+    memset(d, 0, sizeof(*d));
+}
+
+bool dither_init(ditherer_t *d, snap_t snap, dither_t method, bool linear, size_t w, size_t rows) {
+    memset(d, 0, sizeof(*d));
+
+    const named_table_t *names = get_current_named_table();
+    size_t n = (snap == SNAP_ANSI16) ? 16 : (snap == SNAP_ANSI256) ? 256 : (snap == SNAP_NAMED) ? names->size : 0;
+    if (n == 0) return false;
+
+    d->method = method; d->linear = linear;
+    d->w      = w;      d->rows   = rows;   d->n = n;
+
+    d->hex  = malloc(n * sizeof(uint32_t));
+    d->done = malloc(rows * sizeof(size_t));
+    bool ok = d->hex && d->done;
+    for (int k = 0; k < 3; ++k) {
+        d->pal[k]   = malloc(n * sizeof(float));
+        d->c[k]     = malloc((rows + DITHER_CARRY) * w * sizeof(float));
+        d->carry[k] = calloc(DITHER_CARRY * w, sizeof(float));
+        ok = ok && d->pal[k] && d->c[k] && d->carry[k];
+    }
+    if (!ok) { dither_free(d); return false; }
+
+    for (size_t i = 0; i < n; ++i) {
+        rgb_t c = (snap == SNAP_ANSI16) ? ansi16_idx_to_rgb((int)i) : (snap == SNAP_ANSI256) ? ansi256_idx_to_rgb((int)i) : hex_to_rgb(names->hex[i]);
+        d->hex[i] = rgb_to_hex(&c);
+    }
+    to_working(d, d->hex, n, d->pal[0], d->pal[1], d->pal[2]);
+
+    for (int k = 0; k < 3; ++k) {
+        d->lo[k] = d->hi[k] = d->pal[k][0];
+        for (size_t i = 1; i < n; ++i) { d->lo[k] = MIN(d->lo[k], d->pal[k][i]); d->hi[k] = MAX(d->hi[k], d->pal[k][i]); }
+    }
+
+    // mean distance from every palette color to the closest other one (repeated colors of the name sets skipped)
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        float best = INFINITY;
+        for (size_t j = 0; j < n; ++j) {
+            if (d->hex[j] == d->hex[i]) continue;
+            float dx = d->pal[0][j] - d->pal[0][i], dy = d->pal[1][j] - d->pal[1][i], dz = d->pal[2][j] - d->pal[2][i];
+            best = MIN(best, dx * dx + dy * dy + dz * dz);
+        }
+        if (best < INFINITY) sum += sqrt(best);
+    }
+    d->spread = (float)(sum / n);
+    if (!grid_build(d)) { dither_free(d); return false; }
+
+    if      (method == DITHER_BAYER)      { d->mask = bayer_mask();      d->side = 8; }
+    else if (method == DITHER_BLUE_NOISE) { d->mask = blue_noise_mask(); d->side = BLUE_NOISE_SIZE; }
+    return true;
+}
+
+// ordered dithering (or none): every tile of the band is converted, offset by its thresholds and mapped to the closest
+// palette colors on its own
+static void ordered_band(ditherer_t *d, uint32_t *px, size_t n, uint16_t *idx) {
+    size_t w = d->w, rows = n / w, tiles = (w + DITHER_TILE - 1) / DITHER_TILE;
+
+    #pragma omp parallel for schedule(static) if (n > DITHER_PAR_MIN)
+    for (size_t t = 0; t < tiles; ++t) {
+        size_t x0 = t * DITHER_TILE, len = MIN((size_t)DITHER_TILE, w - x0);
+
+        for (size_t r = 0; r < rows; ++r) {
+            size_t       i  = r * w + x0;
+            float       *c0 = d->c[0] + i, *c1 = d->c[1] + i, *c2 = d->c[2] + i;
+            const float *m  = d->mask ? d->mask + ((d->y + r) % d->side) * d->side : NULL;
+            to_working(d, px + i, len, c0, c1, c2);
+
+            for (size_t x = 0; x < len; ++x) {
+                float o = m ? d->spread * m[(x0 + x) % d->side] : 0.0f;
+                size_t q  = grid_nearest(d, c0[x] + o, d->linear ? c1[x] + o : c1[x], d->linear ? c2[x] + o : c2[x]);
+                px[i + x] = d->hex[q];
+                if (idx) idx[i + x] = (uint16_t)q;
+            }
+        }
+    }
+}
+
+// quantize pixel x of row r and spread its error over the taps (out of the image it is dropped)
+static inline void diffuse_pixel(ditherer_t *d, const tap_t *taps, size_t ntaps, size_t r, size_t x, uint32_t *px, uint16_t *idx) {
+    size_t w = d->w, i = r * w + x;
+    float  v[3], e[3];
+
+    for (int k = 0; k < 3; ++k) v[k] = CLAMP(d->c[k][i], d->lo[k], d->hi[k]);
+    size_t q = grid_nearest(d, v[0], v[1], v[2]);
+    px[i] = d->hex[q];
+    if (idx) idx[i] = (uint16_t)q;
+
+    for (int k = 0; k < 3; ++k) e[k] = v[k] - d->pal[k][q];
+    for (size_t t = 0; t < ntaps; ++t) {
+        long tx = (long)x + taps[t].dx;
+        if (tx < 0 || tx >= (long)w) continue;
+
+        size_t j = (r + taps[t].dy) * w + (size_t)tx;
+        for (int k = 0; k < 3; ++k) d->c[k][j] += taps[t].w * e[k];
+    }
+}
+
+// error diffusion as a wavefront: rows go to the threads in turn and each one waits until the row above is DITHER_LAG
+// pixels ahead, so every pixel sees exactly the error of a serial scan (in the same order)
+static void diffuse_band(ditherer_t *d, uint32_t *px, size_t n, uint16_t *idx) {
+    size_t       w     = d->w, rows = n / w;
+    const tap_t *taps  = (d->method == DITHER_ATKINSON) ? atkinson_taps : fs_taps;
+    size_t       ntaps = (d->method == DITHER_ATKINSON) ? ARRAY_LENGTH(atkinson_taps) : ARRAY_LENGTH(fs_taps);
+
+    // working values, plus the error the previous band left for the first rows
+    #pragma omp parallel for schedule(static) if (n > DITHER_PAR_MIN)
+    for (size_t r = 0; r < rows; ++r) {
+        size_t i = r * w;
+        to_working(d, px + i, w, d->c[0] + i, d->c[1] + i, d->c[2] + i);
+        if (r < DITHER_CARRY) {
+            for (int k = 0; k < 3; ++k) for (size_t x = 0; x < w; ++x) d->c[k][i + x] += d->carry[k][i + x];
+        }
+    }
+    for (int k = 0; k < 3; ++k) memset(d->c[k] + n, 0, DITHER_CARRY * w * sizeof(float));
+    for (size_t r = 0; r < rows; ++r) d->done[r] = 0;
+
+    #pragma omp parallel for schedule(static, 1) if (n > DITHER_PAR_MIN)
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t x0 = 0; x0 < w; x0 += DITHER_STEP) {
+            size_t x1 = MIN(w, x0 + DITHER_STEP);
+
+            if (r > 0) {
+                size_t need = MIN(w, x1 - 1 + DITHER_LAG), got;
+                do {
+                    #pragma omp atomic read seq_cst
+                    got = d->done[r - 1];
+                } while (got < need);
+            }
+
+            for (size_t x = x0; x < x1; ++x) diffuse_pixel(d, taps, ntaps, r, x, px, idx);
+
+            #pragma omp atomic write seq_cst
+            d->done[r] = x1;
+        }
+    }
+
+    for (int k = 0; k < 3; ++k) memcpy(d->carry[k], d->c[k] + n, DITHER_CARRY * w * sizeof(float));
+}
+
+void dither_band(ditherer_t *d, uint32_t *px, size_t n, uint16_t *idx) {
+    if (d->method == DITHER_FLOYD_STEINBERG || d->method == DITHER_ATKINSON) diffuse_band(d, px, n, idx);
+    else                                                                     ordered_band(d, px, n, idx);
+    d->y += n / d->w;
+}
@@ -0,0 +1,158 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include "batch.h"
+#include "converter.h"
+#include "gradient.h"
+#include "parser.h"
+#include "printer.h"
+
+// below this oklch chroma a stop counts as achromatic and its hue is ignored
+#define GRAD_ACHROMATIC 1e-4
+
+// adjust the hues of a segment so that plain linear interpolation follows the requested arc
+// (https://www.w3.org/TR/css-color-4/#hue-interpolation)
+static void fix_hues(double *h0, double *h1, hue_interp_t mode) {
+    double d = *h1 - *h0;
+    switch (mode) {
+        case HUE_SHORTER:    if      (d > 180.0)              *h0 += 360.0;
+                             else if (d < -180.0)             *h1 += 360.0;
+                             break;
+        case HUE_LONGER:     if      (d > 0.0 && d < 180.0)   *h0 += 360.0;
+                             else if (d > -180.0 && d <= 0.0) *h1 += 360.0;
+                             break;
+        case HUE_INCREASING: if      (d < 0.0)                *h1 += 360.0;
+                             break;
+        case HUE_DECREASING: if      (d > 0.0)                *h0 += 360.0;
+                             break;
+    }
+}
+
+// interpolate the steps into three float columns of the interpolation space: srgb (0..1), oklab or oklch
+static void grad_interp(const color_t *stops, size_t nstops, size_t steps, grad_space_t space, hue_interp_t hue, float *x, float *y, float *z) {
+    // steps [first, last) belong to segment s, i.e. step i lies at position i * (nstops - 1) / (steps - 1) in stop units
+    // lerps are written as (1 - u) * x0 + u * x1, which gives the stops exactly at u = 0 and u = 1
+    size_t segs = nstops - 1;
+    for (size_t s = 0; s < segs; ++s) {
+        size_t first = (s * (steps - 1) + segs - 1) / segs;
+        size_t last  = (s + 1 == segs) ? steps : ((s + 1) * (steps - 1) + segs - 1) / segs;
+        float  span  = (float)(steps - 1);
+        const color_t *c0 = &stops[s], *c1 = &stops[s + 1];
+
+        float x0, y0, z0, x1, y1, z1;
+        if (space == GRAD_RGB) {
+            x0 = c0->rgb.r / 255.0f; y0 = c0->rgb.g / 255.0f; z0 = c0->rgb.b / 255.0f;
+            x1 = c1->rgb.r / 255.0f; y1 = c1->rgb.g / 255.0f; z1 = c1->rgb.b / 255.0f;
+        }
+        else if (space == GRAD_OKLAB) {
+            x0 = c0->oklab.L; y0 = c0->oklab.a; z0 = c0->oklab.b;
+            x1 = c1->oklab.L; y1 = c1->oklab.a; z1 = c1->oklab.b;
+        }
+        else {
+            double h0 = c0->oklch.h, h1 = c1->oklch.h;
+            if (c0->oklch.c < GRAD_ACHROMATIC) h0 = h1;
+            if (c1->oklch.c < GRAD_ACHROMATIC) h1 = h0;
+            fix_hues(&h0, &h1, hue);
+
+            x0 = c0->oklch.L; y0 = c0->oklch.c; z0 = h0;
+            x1 = c1->oklch.L; y1 = c1->oklch.c; z1 = h1;
+        }
+
+        #pragma omp simd
+        for (size_t i = first; i < last; ++i) {
+            float u = (float)(i * segs - s * (steps - 1)) / span;
+            x[i] = (1.0f - u) * x0 + u * x1; y[i] = (1.0f - u) * y0 + u * y1; z[i] = (1.0f - u) * z0 + u * z1;
+        }
+    }
+}
+
+// conversion graph node of each interpolation space
+static const cv_model_t grad_model[] = { CVM_OKLAB, CVM_OKLCH, CVM_SRGB };
+
+long gradient_fill(const color_t *stops, size_t nstops, size_t steps, grad_space_t space, hue_interp_t hue, gamut_t mode, uint32_t *rgb) {
+    if (nstops < 2 || steps < 2) return -1;
+
+    if (space == GRAD_RGB) {
+        // 8-bit stops in, 8-bit steps out: rounded straight from the 0..255 lerp
+        size_t segs = nstops - 1;
+        for (size_t s = 0; s < segs; ++s) {
+            size_t first = (s * (steps - 1) + segs - 1) / segs;
+            size_t last  = (s + 1 == segs) ? steps : ((s + 1) * (steps - 1) + segs - 1) / segs;
+            float  span  = (float)(steps - 1);
+            float  r0 = stops[s].rgb.r, g0 = stops[s].rgb.g, b0 = stops[s].rgb.b, r1 = stops[s + 1].rgb.r, g1 = stops[s + 1].rgb.g, b1 = stops[s + 1].rgb.b;
+
+            #pragma omp simd
+            for (size_t i = first; i < last; ++i) {
+                float u = (float)(i * segs - s * (steps - 1)) / span;
+                uint32_t r = (uint32_t)lrintf((1.0f - u) * r0 + u * r1), g = (uint32_t)lrintf((1.0f - u) * g0 + u * g1), bl = (uint32_t)lrintf((1.0f - u) * b0 + u * b1);
+                rgb[i] = (r << 16) | (g << 8) | bl;
+            }
+        }
+        return 0;
+    }
+
+    float *col = malloc(3 * steps * sizeof(float));
+    if (!col) return -1;
+    float *x = col, *y = x + steps, *z = y + steps;
+    grad_interp(stops, nstops, steps, space, hue, x, y, z);
+
+    // oklab / oklch -> srgb in one pass over the graph, gamut handling happens on the way through linear rgb
+    long out = convert_f32(grad_model[space], CVM_SRGB, (const float *const[]){ x, y, z }, steps, mode, (float *const[]){ x, y, z });
+    srgb_to_rgb8_f32(x, y, z, steps, rgb);
+    free(col);
+    return out;
+}
+
+long gradient_fill_f32(const color_t *stops, size_t nstops, size_t steps, grad_space_t space, hue_interp_t hue, gamut_t mode, cv_model_t to, float *const *out) {
+    if (nstops < 2 || steps < 2) return -1;
+
+    float *col = malloc(3 * steps * sizeof(float));
+    if (!col) return -1;
+    float *x = col, *y = x + steps, *z = y + steps;
+    grad_interp(stops, nstops, steps, space, hue, x, y, z);
+
+    // every step passes linear rgb for gamut handling, even when the target is oklab / oklch again
+    float *const cols[] = { x, y, z };
+    long oog = convert_f32(grad_model[space], CVM_LINEAR, (const float *const *)cols, steps, mode, cols);
+    if (oog >= 0) oog = (convert_f32(CVM_LINEAR, to, (const float *const *)cols, steps, mode, out) < 0) ? -1 : oog;
+    free(col);
+    return oog;
+}
+
+int run_gradient(const prog_opts_t *opts, const char *progname) {
+    // gradients are gamut mapped unless clipping was asked for, stops in rgb space are mapped while parsing
+    gamut_t mode = opts->gamutset ? opts->gamut : GAMUT_MAP;
+    set_gamut(mode);
+
+    color_t  *stops = malloc(opts->gradient_n * sizeof(color_t));
+    uint32_t *rgb   = malloc(opts->steps * sizeof(uint32_t));
+    if (!stops || !rgb) ERROR_EXIT("out of memory while generating %d colors", opts->steps);
+
+    for (int i = 0; i < opts->gradient_n; ++i) if (!parse_color(opts->gradient[i], &stops[i])) ERROR_EXIT("could not parse gradient color %s", opts->gradient[i]);
+
+    // numeric models in lines or json are converted from the interpolation space directly, everything else prints 8-bit rgb
+    cv_model_t m;
+    bool       direct = (opts->format == FORMAT_TEXT || opts->format == FORMAT_JSON) && conversion_model(opts->conversion, &m);
+
+    long out;
+    if (direct) {
+        float *col = malloc(4 * (size_t)opts->steps * sizeof(float));
+        if (!col) ERROR_EXIT("out of memory while generating %d colors", opts->steps);
+        float *const cols[] = { col, col + opts->steps, col + 2 * (size_t)opts->steps, col + 3 * (size_t)opts->steps };
+
+        out = gradient_fill_f32(stops, opts->gradient_n, opts->steps, (grad_space_t)opts->space, (hue_interp_t)opts->hue, mode, m, cols);
+        if (out < 0) ERROR_EXIT("out of memory while generating %d colors", opts->steps);
+        batch_print_f32(m, (const float *const *)cols, opts->steps, opts);
+        free(col);
+    }
+    else {
+        out = gradient_fill(stops, opts->gradient_n, opts->steps, (grad_space_t)opts->space, (hue_interp_t)opts->hue, mode, rgb);
+        if (out < 0) ERROR_EXIT("out of memory while generating %d colors", opts->steps);
+        batch_print(rgb, opts->steps, opts);
+    }
+    print_gamut_warning(stderr, (opts->space == GRAD_RGB) ? gamut_count() : (unsigned long)out, mode);
+
+    free(stops);
+    free(rgb);
+    return 0;
+}
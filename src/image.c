@@ -0,0 +1,238 @@
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "colorspace.h"
+#include "composite.h"
+#include "cube.h"
+#include "cvd.h"
+#include "dither.h"
+#include "image.h"
+#include "printer.h"
+#include "render.h"
+
+// next header number, skipping whitespace and comments, -1 if there is none
+static long ppm_number(FILE *f) {
+    int c = fgetc(f);
+    for (;;) {
+        if (c == '#') while (c != EOF && c != '\n') c = fgetc(f);
+        else if (isspace(c)) c = fgetc(f);
+        else break;
+    }
+    if (!isdigit(c)) return -1;
+
+    long v = 0;
+    while (isdigit(c)) {
+        v = 10 * v + (c - '0');
+        if (v > (1L << 24)) return -1;
+        c = fgetc(f);
+    }
+    // exactly one whitespace character ends the number (and, after maxval, the header)
+    if (!isspace(c)) return -1;
+    return v;
+}
+
+// size and maxval of a ppm after its magic number
+static bool ppm_dims(FILE *f, size_t *w, size_t *h, unsigned *maxval) {
+    long width = ppm_number(f), height = ppm_number(f), max = ppm_number(f);
+    if (width <= 0 || height <= 0 || max <= 0 || max > 65535) return false;
+
+    *w      = (size_t)width;
+    *h      = (size_t)height;
+    *maxval = (unsigned)max;
+    return true;
+}
+
+bool ppm_read_header(FILE *f, size_t *w, size_t *h, unsigned *maxval) {
+    if (fgetc(f) != 'P' || fgetc(f) != '6') return false;
+    return ppm_dims(f, w, h, maxval);
+}
+
+// next header word of a pam, skipping whitespace and comments, false at the end of the file or if it does not fit
+static bool pam_word(FILE *f, char *word, size_t size) {
+    int c = fgetc(f);
+    for (;;) {
+        if (c == '#') while (c != EOF && c != '\n') c = fgetc(f);
+        else if (isspace(c)) c = fgetc(f);
+        else break;
+    }
+
+    // the whitespace character after the word is consumed aswell (after ENDHDR, the one that ends the header)
+    size_t len = 0;
+    while (c != EOF && !isspace(c)) {
+        if (len + 1 >= size) return false;
+        word[len++] = (char)c;
+        c = fgetc(f);
+    }
+    word[len] = '\0';
+    return len > 0;
+}
+
+// header value of a pam, -1 if it is not a number
+static long pam_number(FILE *f) {
+    char word[16], *end = NULL;
+    if (!pam_word(f, word, sizeof(word))) return -1;
+
+    long v = strtol(word, &end, 10);
+    return (*end || v < 0 || v > (1L << 24)) ? -1 : v;
+}
+
+bool pam_read_header(FILE *f, size_t *w, size_t *h, unsigned *maxval, bool *alpha) {
+    if (fgetc(f) != 'P') return false;
+
+    int magic = fgetc(f);
+    if (magic == '6') { *alpha = false; return ppm_dims(f, w, h, maxval); }
+    if (magic != '7') return false;
+
+    long width = -1, height = -1, depth = -1, max = -1;
+    char word[32], tuple[32] = "";
+    for (;;) {
+        if (!pam_word(f, word, sizeof(word))) return false;
+
+        if      (strcmp(word, "ENDHDR") == 0)   break;
+        else if (strcmp(word, "WIDTH") == 0)    width  = pam_number(f);
+        else if (strcmp(word, "HEIGHT") == 0)   height = pam_number(f);
+        else if (strcmp(word, "DEPTH") == 0)    depth  = pam_number(f);
+        else if (strcmp(word, "MAXVAL") == 0)   max    = pam_number(f);
+        else if (strcmp(word, "TUPLTYPE") == 0) { if (!pam_word(f, tuple, sizeof(tuple))) return false; }
+        else    return false;
+    }
+
+    // rgb with or without alpha, the tuple type may be left out
+    if (width <= 0 || height <= 0 || max != 255 || (depth != 3 && depth != 4)) return false;
+    if (*tuple && strcmp(tuple, (depth == 4) ? "RGB_ALPHA" : "RGB") != 0)    return false;
+
+    *w      = (size_t)width;
+    *h      = (size_t)height;
+    *maxval = 255;
+    *alpha  = depth == 4;
+    return true;
+}
+
+void ppm_write_header(FILE *f, size_t w, size_t h) { fprintf(f, "P6\n%zu %zu\n255\n", w, h); }
+
+bool ppm_read_pixels(FILE *f, uint8_t *buf, uint32_t *px, size_t n) {
+    if (fread(buf, 3, n, f) != n) return false;
+    for (size_t i = 0; i < n; ++i) px[i] = ((uint32_t)buf[3 * i] << 16) | ((uint32_t)buf[3 * i + 1] << 8) | buf[3 * i + 2];
+    return true;
+}
+
+bool pam_read_pixels(FILE *f, uint8_t *buf, uint32_t *px, uint8_t *alpha, size_t n) {
+    if (fread(buf, 4, n, f) != n) return false;
+    for (size_t i = 0; i < n; ++i) {
+        px[i]    = ((uint32_t)buf[4 * i] << 16) | ((uint32_t)buf[4 * i + 1] << 8) | buf[4 * i + 2];
+        alpha[i] = buf[4 * i + 3];
+    }
+    return true;
+}
+
+bool ppm_read_samples(FILE *f, uint8_t *buf, uint16_t *s, size_t n, unsigned maxval) {
+    size_t bytes = (maxval > 255) ? 2 : 1;
+    if (fread(buf, 3 * bytes, n, f) != n) return false;
+    for (size_t i = 0; i < 3 * n; ++i) {
+        unsigned v = (bytes == 2) ? ((unsigned)buf[2 * i] << 8) | buf[2 * i + 1] : buf[i];
+        s[i] = (uint16_t)MIN(v, maxval);
+    }
+    return true;
+}
+
+void ppm_write_pixels(FILE *f, uint8_t *buf, const uint32_t *px, size_t n) {
+    for (size_t i = 0; i < n; ++i) { buf[3 * i] = (px[i] >> 16) & 0xFF; buf[3 * i + 1] = (px[i] >> 8) & 0xFF; buf[3 * i + 2] = px[i] & 0xFF; }
+    fwrite(buf, 3, n, f);
+}
+
+void image_open(image_reader_t *r, const char *path, const prog_opts_t *opts, const char *progname) {
+    *r = (image_reader_t){ .path = path, .opts = opts };
+
+    r->f = (strcmp(path, "-") == 0) ? stdin : fopen(path, "rb");
+    if (!r->f) ERROR_EXIT("could not open image %s", path);
+    if (!pam_read_header(r->f, &r->w, &r->h, &r->maxval, &r->alpha)) ERROR_EXIT("%s is not a binary ppm (P6) or an 8-bit rgb pam (P7)", path);
+
+    // wide-gamut input is gamut mapped unless clipping was asked for
+    r->mode = opts->gamutset ? opts->gamut : GAMUT_MAP;
+
+    // one band of packed pixels plus its bytes, and the samples of deeper images / the opacities
+    bool   deep = r->maxval != 255;
+    size_t band = IMAGE_BAND_ROWS * r->w;
+    r->px  = malloc(band * sizeof(uint32_t));
+    r->buf = malloc((deep ? 6 : r->alpha ? 4 : 3) * band);
+    r->smp = deep ? malloc(3 * band * sizeof(uint16_t)) : NULL;
+    r->opa = r->alpha ? malloc(band) : NULL;
+    if (!r->px || !r->buf || (deep && !r->smp) || (r->alpha && !r->opa)) ERROR_EXIT("out of memory for an image of width %zu", r->w);
+}
+
+size_t image_read_band(image_reader_t *r, const char *progname) {
+    if (r->y >= r->h) return 0;
+
+    const prog_opts_t *opts = r->opts;
+    bool   deep = r->maxval != 255;
+    size_t n    = MIN((size_t)IMAGE_BAND_ROWS, r->h - r->y) * r->w;
+    bool   read = deep ? ppm_read_samples(r->f, r->buf, r->smp, n, r->maxval) : r->alpha ? pam_read_pixels(r->f, r->buf, r->px, r->opa, n) : ppm_read_pixels(r->f, r->buf, r->px, n);
+    if (!read) ERROR_EXIT("%s ends before row %zu of %zu", r->path, r->y, r->h);
+
+    // deeper images are brought to 8-bit srgb in the same pass
+    if (deep)                             r->oog += rgbspace_rgb16_to_srgb8(opts->from, r->mode, r->maxval, r->smp, n, r->px);
+    else if (opts->from != RGBSPACE_SRGB) r->oog += rgbspace_rgb8_to_srgb8(opts->from, r->mode, r->px, n, r->px);
+    if (r->alpha)                         composite_rgb8(r->px, r->opa, &opts->over, 0, n, opts->blend, opts->blendlinear, r->px);
+
+    r->y += IMAGE_BAND_ROWS;
+    return n;
+}
+
+void image_close(image_reader_t *r) {
+    if (r->f != stdin) fclose(r->f);
+    free(r->px);
+    free(r->buf);
+    free(r->smp);
+    free(r->opa);
+    print_gamut_warning(stderr, r->oog, r->mode);
+}
+
+int run_image(const prog_opts_t *opts, const char *progname) {
+    image_reader_t r;
+    image_open(&r, opts->image, opts, progname);
+
+    // images with alpha are at least flattened onto the backdrop and deeper ones brought to 8 bits, as is other rgb input
+    // to srgb (--from), rendering to the terminal needs nothing else either
+    if (opts->dither != DITHER_NONE && opts->snap == SNAP_NONE) ERROR_EXIT("--dither needs a palette (--snap named|ansi16|ansi256)");
+    if (!r.alpha && r.maxval == 255 && opts->cvd == CVD_NONE && !opts->lut && opts->from == RGBSPACE_SRGB && opts->snap == SNAP_NONE && opts->render == RENDER_PPM) ERROR_EXIT("--image needs a transformation (--from, --lut, --cvd or --snap)");
+
+    cube_t   cube;
+    lut3d_t *lut = NULL;
+    if (opts->lut) {
+        if (!(lut = malloc(sizeof(lut3d_t)))) ERROR_EXIT("out of memory while reading %s", opts->lut);
+        cube_open(opts->lut, &cube, lut, progname);
+    }
+
+    // sixel takes palette indices, of the ansi 256 colors unless --snap says otherwise
+    bool       sixel   = opts->render == RENDER_SIXEL;
+    snap_t     palette = (sixel && opts->snap == SNAP_NONE) ? SNAP_ANSI256 : opts->snap;
+    bool       snap    = palette != SNAP_NONE;
+    ditherer_t dith;
+    uint16_t  *idx = NULL;
+    if (snap && !dither_init(&dith, palette, opts->dither, opts->ditherlin, r.w, IMAGE_BAND_ROWS)) ERROR_EXIT("out of memory for dithering an image of width %zu", r.w);
+    if (sixel && dith.n > SIXEL_COLORS) ERROR_EXIT("sixel output takes at most %d colors, not %zu (-x --snap named)", SIXEL_COLORS, dith.n);
+    if (sixel && !(idx = malloc(IMAGE_BAND_ROWS * r.w * sizeof(uint16_t)))) ERROR_EXIT("out of memory for an image of width %zu", r.w);
+
+    // the byte buffer of the band is reused for ppm output
+    renderer_t rend;
+    bool       render = opts->render != RENDER_PPM;
+    if (!render) ppm_write_header(stdout, r.w, r.h);
+    else if (!render_open(&rend, stdout, opts->render, r.w, r.h, snap ? dith.hex : NULL, snap ? dith.n : 0)) ERROR_EXIT("out of memory for rendering an image of width %zu", r.w);
+
+    for (size_t n; (n = image_read_band(&r, progname)) > 0;) {
+        if (lut)                   cube_apply(lut, opts->tetra, r.px, n, r.px);
+        if (opts->cvd != CVD_NONE) cvd_rgb8(opts->cvd, opts->severity, r.px, n, r.px);
+        if (snap)                  dither_band(&dith, r.px, n, idx);
+
+        if (render) render_rows(&rend, r.px, idx, n);
+        else        ppm_write_pixels(stdout, r.buf, r.px, n);
+    }
+    if (render) render_close(&rend);
+
+    if (lut)  { cube_free(&cube); free(lut); }
+    if (snap) dither_free(&dith);
+    free(idx);
+    image_close(&r);
+    return 0;
+}
@@ -0,0 +1,465 @@
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "converter.h"
+#include "kernels.h"
+#include "types.h"
+#include "utility.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// helpers shared by every isa level
+// always_inline makes them pick up the target options of the kernel they are inlined into
+#define KINLINE static inline __attribute__((always_inline))
+
+// cube root for positive and negative inputs without libm, so the conversion loops stay vectorizable
+// bit-level initial guess (~5% error) refined by three newton steps, relative error below 1e-7
+KINLINE float cbrt_f32(float x) {
+    union { float f; uint32_t u; } v = { .f = fabsf(x) };
+    v.u = v.u / 3 + 709921077u; // divides the exponent by 3, keeping the bias intact
+    float y = v.f, ax = fabsf(x);
+    for (int i = 0; i < 3; ++i) y = y - (y * y * y - ax) / (3.0f * y * y);
+    return (x < 0.0f) ? -y : (x == 0.0f ? 0.0f : y);
+}
+
+// nearest integer (ties to even) for |x| < 2^22 by adding and removing 1.5 * 2^23
+// plain arithmetic, roundf / floorf are libm calls below sse4.1 and block if-conversion above
+KINLINE float round_f32(float x) {
+    return (x + 12582912.0f) - 12582912.0f;
+}
+
+// atan2 in degrees, branch-free: reduction to t in [0,1] by octant and to |u| <= tan(pi/8) around 1,
+// odd series up to u^15 (truncation below 2e-8 rad)
+KINLINE float atan2_deg_f32(float y, float x) {
+    float ax = fabsf(x), ay = fabsf(y);
+    float mx = MAX(ax, ay), mn = MIN(ax, ay);
+    float t  = mn / ((mx > 0.0f) ? mx : 1.0f);
+    bool  hi = t > 0.41421356f;
+    float u  = hi ? (t - 1.0f) / (t + 1.0f) : t, u2 = u * u;
+    float p  = u + u * u2 * (-1.0f / 3.0f + u2 * (1.0f / 5.0f + u2 * (-1.0f / 7.0f + u2 * (1.0f / 9.0f + u2 * (-1.0f / 11.0f + u2 * (1.0f / 13.0f + u2 * (-1.0f / 15.0f)))))));
+    float at = (hi ? (float)(M_PI / 4.0) : 0.0f) + p;
+
+    at = (ay > ax)   ? (float)(M_PI / 2.0) - at : at;
+    at = (x < 0.0f)  ? (float)M_PI - at         : at;
+    return ((y < 0.0f) ? -at : at) * (float)(180.0 / M_PI);
+}
+
+// sine and cosine of an angle in degrees (|deg| < 2^22), reduced by quadrant to [-45,45] degrees,
+// series up to r^9 / r^10 (truncation below 2e-9)
+KINLINE void sincos_deg_f32(float deg, float *s, float *c) {
+    float qf = round_f32(deg * (1.0f / 90.0f));
+    int   q  = (int)qf;
+    float r  = (deg - 90.0f * qf) * (float)(M_PI / 180.0), r2 = r * r;
+    float sr = r + r * r2 * (-1.0f / 6.0f + r2 * (1.0f / 120.0f + r2 * (-1.0f / 5040.0f + r2 * (1.0f / 362880.0f))));
+    float cr = 1.0f + r2 * (-1.0f / 2.0f + r2 * (1.0f / 24.0f + r2 * (-1.0f / 720.0f + r2 * (1.0f / 40320.0f + r2 * (-1.0f / 3628800.0f)))));
+
+    int k = q & 3;
+    float ss = (k & 1) ? cr : sr, cc = (k & 1) ? sr : cr;
+    *s = (k == 2 || k == 3) ? -ss : ss;
+    *c = (k == 1 || k == 2) ? -cc : cc;
+}
+
+// e^x for x <= 88 (results below the float range flush to 0): 2^n by exponent bits times a series for e^g, |g| <= ln(2) / 2
+// the range check is a final select, a clamp of x up front gets split into a separate path by the optimizer
+KINLINE float exp_f32(float x) {
+    float t  = x * (float)M_LOG2E;
+    float nf = round_f32(t);
+    int   n  = (int)nf;
+    float g  = x - nf * (float)M_LN2;
+    float p  = 1.0f + g * (1.0f + g * (1.0f / 2.0f + g * (1.0f / 6.0f + g * (1.0f / 24.0f + g * (1.0f / 120.0f + g * (1.0f / 720.0f + g * (1.0f / 5040.0f)))))));
+
+    union { float f; uint32_t u; } v = { .u = (uint32_t)(n + 127) << 23 };
+    return (x < -87.0f) ? 0.0f : p * v.f;
+}
+
+// model math shared with the converters (see src/convert_impl.h)
+#define CV_REAL              float
+#define CV_SFX               f32
+#define CV_C(_x)             _x##f
+#define CV_M(_fn)            _fn##f
+#define CV_ZERO              1e-6f
+#define CV_CBRT(_x)          cbrt_f32(_x)
+#define CV_ATAN2_DEG(_y, _x) atan2_deg_f32(_y, _x)
+#define CV_SINCOS_DEG(_d, _s, _c) sincos_deg_f32(_d, _s, _c)
+#define CV_EXP(_x)           exp_f32(_x)
+#define CV_INLINE            KINLINE
+#include "convert_impl.h"
+
+// linear light (clipped to [0,1], nan to 0) to an 8-bit srgb code through the bucket table of linear_to_srgb8_lut
+KINLINE uint32_t srgb8_encode(const srgb8_enc_t *enc, float v) {
+    v = (v > 0.0f) ? v : 0.0f;
+    v = (v < 1.0f) ? v : 1.0f;
+    uint32_t k = enc->lo[(int)(v * (float)SRGB8_ENC_BUCKETS)];
+    return k + (v >= enc->mid[k]);
+}
+
+// value in [0,1] (nan to 0) to an 8-bit code, rounded half up
+KINLINE uint32_t unorm8_encode(float v) {
+    v = (v > 0.0f) ? v : 0.0f;
+    v = (v < 1.0f) ? v : 1.0f;
+    return (uint32_t)(v * 255.0f + 0.5f);
+}
+
+// trilinear interpolation of one output channel between the 8 nodes of the cell at d (strides sr, sg, sb)
+KINLINE float lut3d_trilinear(const float *d, int32_t sr, int32_t sg, int32_t sb, float fr, float fg, float fb) {
+    float c00 = d[0]       + fr * (d[sr]           - d[0]);
+    float c10 = d[sg]      + fr * (d[sg + sr]      - d[sg]);
+    float c01 = d[sb]      + fr * (d[sb + sr]      - d[sb]);
+    float c11 = d[sb + sg] + fr * (d[sb + sg + sr] - d[sb + sg]);
+    float c0  = c00 + fg * (c10 - c00), c1 = c01 + fg * (c11 - c01);
+    return c0 + fb * (c1 - c0);
+}
+
+// tetrahedral interpolation of one output channel: the path from the lower to the upper node of the cell along the axes
+// in order of decreasing fraction (nodes i0..i3 of d) with weights f1 >= f2 >= f3
+// the node indices are full int32 offsets, a sum of two varying offsets would not map to a vector gather
+KINLINE float lut3d_tetrahedral(const float *d, int32_t i0, int32_t i1, int32_t i2, int32_t i3, float f1, float f2, float f3) {
+    return d[i0] + f1 * (d[i1] - d[i0]) + f2 * (d[i2] - d[i1]) + f3 * (d[i3] - d[i2]);
+}
+
+// same result as rgb_to_ansi256_idx_scan (including ties), without the inner searches
+KINLINE int ansi256_closest(int r, int g, int b) {
+    int best = 0, best_d = INT_MAX;
+    for (int i = 0; i < 16; ++i) {
+        int dr = r - ansi16_rgb[i].r, dg = g - ansi16_rgb[i].g, db = b - ansi16_rgb[i].b;
+        int d  = dr * dr + dg * dg + db * db;
+        if (d < best_d) { best_d = d; best = i; }
+    }
+
+    // cube levels 0, 95, 135, 175, 215, 255, a channel exactly between two levels takes the lower one
+    #define CUBE_IDX(_c) ((_c) < 48 ? 0 : (_c) < 116 ? 1 : 2 + ((_c) - 116) / 40)
+    #define CUBE_LVL(_i) ((_i) == 0 ? 0 : 55 + 40 * (_i))
+    int ri = CUBE_IDX(r), gi = CUBE_IDX(g), bi = CUBE_IDX(b);
+    int dr = r - CUBE_LVL(ri), dg = g - CUBE_LVL(gi), db = b - CUBE_LVL(bi);
+    int cd = dr * dr + dg * dg + db * db;
+    if (cd < best_d) { best_d = cd; best = 16 + 36 * ri + 6 * gi + bi; }
+    #undef CUBE_IDX
+    #undef CUBE_LVL
+
+    // grayscale levels 8 + 10i: the distance is a parabola around the channel mean, only the two levels around it matter
+    int s  = r + g + b;
+    int g0 = CLAMP((s - 24) / 30, 0, 23);
+    for (int k = g0; k <= MIN(g0 + 1, 23); ++k) {
+        int v = 8 + 10 * k, er = r - v, eg = g - v, eb = b - v;
+        int d = er * er + eg * eg + eb * eb;
+        if (d < best_d) { best_d = d; best = 232 + k; }
+    }
+
+    return best;
+}
+
+// fixed-point value with YUV_FIX fractional bits (rounding bias included) to an 8-bit code, clamped
+#define YUV_FIX 16
+KINLINE uint32_t yuv_clamp8(int32_t v) {
+    v >>= YUV_FIX;
+    return (uint32_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+// v / 255 rounded to nearest for v in [0, 255 * 255], without a division
+KINLINE uint32_t div255_round(uint32_t v) {
+    v += 128;
+    return (v + (v >> 8)) >> 8;
+}
+
+// fixed-point division by small divisors
+//
+// floor(n / d) == (n * fix_div_m[d]) >> fix_div_s[d] for every n < 2^FIX_DIV_NBITS and d in [1,FIX_DIV_MAX]:
+// with s = FIX_DIV_NBITS + ceil(log2 d) and m = ceil(2^s / d), the error e = m * d - 2^s < d keeps n * e < 2^s
+// integer division doesn't vectorize on x86, 32x32 -> 64 bit multiplies and per-lane shifts do
+#define FIX_DIV_NBITS 27
+#define FIX_DIV_MAX   1530 // 6 * 255 (hue divisor)
+static uint32_t fix_div_m[FIX_DIV_MAX + 1];
+static uint8_t  fix_div_s[FIX_DIV_MAX + 1];
+
+static void fix_div_init() {
+    for (uint32_t d = 1; d <= FIX_DIV_MAX; ++d) {
+        uint32_t lg = 0;
+        while ((1u << lg) < d) ++lg;
+        fix_div_s[d] = (uint8_t)(FIX_DIV_NBITS + lg);
+        fix_div_m[d] = (uint32_t)(((1ull << fix_div_s[d]) + d - 1) / d);
+    }
+}
+
+KINLINE uint32_t fix_div(uint32_t n, uint32_t d) { return (uint32_t)(((uint64_t)n * fix_div_m[d]) >> fix_div_s[d]); }
+
+// round(FIX_ONE * a / b) for a <= b <= 255 (rounding half up, like round() on positive values)
+// b may only be 0 if a is, which gives 0 without a branch
+KINLINE uint32_t fix_ratio16(uint32_t a, uint32_t b) { b = MAX(b, 1); return fix_div(2 * FIX_ONE * a + b, 2 * b); }
+
+// hue of an 8-bit color in 1/65536 turns (wrapping 65536 to 0), same sector choice as rgb_to_hsl / rgb_to_hsv
+// achromatic colors (delta = 0) give 0
+KINLINE uint16_t fix_hue16(int32_t r, int32_t g, int32_t b, int32_t cmax, int32_t delta) {
+    int32_t t  = (cmax == r) ? g - b : (cmax == g) ? b - r + 2 * delta : r - g + 4 * delta;
+    uint32_t d = (uint32_t)MAX(delta, 1);
+    t += (t < 0) ? 6 * delta : 0;
+    return (uint16_t)fix_div(65536u * (uint32_t)t + 3 * d, 6 * d);
+}
+
+// round a channel numerator v in units of 1 / (65535^2 * 2^shift) to 8 bits
+// 255 / 65535 = 1 / 257, so this is round(v / (257 * 65535 * 2^shift)), half up (division by a constant becomes a multiply)
+#define FIX_INV_DIV (257u * FIX_ONE)
+KINLINE uint32_t fix_round8(uint64_t v, int shift) {
+    return (uint32_t)(((2 * v + ((uint64_t)FIX_INV_DIV << shift)) >> (shift + 1)) / FIX_INV_DIV);
+}
+
+// place the chroma / intermediate / zero channels by hue sextant (same table as hsl_to_rgb / hsv_to_rgb)
+KINLINE uint32_t fix_sector_rgb8(uint32_t hue, uint64_t vc, uint64_t vx, uint64_t v0, int shift) {
+    uint32_t c = fix_round8(vc, shift), x = fix_round8(vx, shift), z = fix_round8(v0, shift);
+    uint32_t sector = (6 * hue) >> 16;
+    uint32_t r = (sector == 0 || sector == 5) ? c : (sector == 1 || sector == 4) ? x : z;
+    uint32_t g = (sector == 1 || sector == 2) ? c : (sector == 0 || sector == 3) ? x : z;
+    uint32_t b = (sector == 3 || sector == 4) ? c : (sector == 2 || sector == 5) ? x : z;
+    return (r << 16) | (g << 8) | b;
+}
+
+// intermediate weight of a hue in 1/65536: rising in even sextants, falling in odd ones
+KINLINE uint32_t fix_hue_weight(uint32_t hue) {
+    uint32_t h6 = 6 * hue, f = h6 & 0xFFFF;
+    return ((h6 >> 16) & 1) ? 65536 - f : f;
+}
+
+// the kernels are instantiated once per isa level from src/kernels_impl.h
+// on x86-64 with gcc / clang these are baseline x86-64, x86-64-v2 and x86-64-v3 (avx2 / fma), elsewhere only the baseline exists
+#if defined(__x86_64__) && defined(__GNUC__)
+#define KERNELS_MULTIVERSION 1
+#else
+#define KERNELS_MULTIVERSION 0
+#endif
+
+#define KFN_CAT(_name, _isa)   _name##_##_isa
+#define KFN_ISA(_name, _isa)   KFN_CAT(_name, _isa)
+#define KFN(_name)             KFN_ISA(_name, KISA)
+
+#define KISA base
+#include "kernels_impl.h"
+#undef KISA
+
+#if KERNELS_MULTIVERSION
+#pragma GCC push_options
+#pragma GCC target("sse3,ssse3,sse4.1,sse4.2,popcnt")
+#define KISA v2
+#include "kernels_impl.h"
+#undef KISA
+#pragma GCC pop_options
+
+// generic tuning never emits avx2 gathers, table lookups (decode tables, 3d luts) would go through scalar inserts
+#pragma GCC push_options
+#pragma GCC target("sse3,ssse3,sse4.1,sse4.2,popcnt,avx,avx2,bmi,bmi2,f16c,fma,lzcnt,movbe,tune=haswell")
+#define KISA v3
+#include "kernels_impl.h"
+#undef KISA
+#pragma GCC pop_options
+#endif
+
+// one entry per isa level, selected once on first use
+typedef struct {
+    size_t (*nearest3_i32)(const int32_t *, const int32_t *, const int32_t *, size_t, int32_t, int32_t, int32_t, int32_t, int32_t, int32_t, int32_t *);
+    size_t (*nearest3_f32)(const float *, const float *, const float *, size_t, float, float, float, float *);
+    void   (*dist2_3_f32)(const float *, const float *, const float *, size_t, float, float, float, float *);
+    void   (*assign3_f32)(const float *, const float *, const float *, size_t, const float *, const float *, const float *, size_t, uint16_t *, float *);
+    void   (*wdist2_block_f32)(const float *, const float *, const float *, size_t, const float *, const float *, const float *, size_t, float, float, float, float *, size_t);
+    void   (*rgb8_to_oklab_f32)(const uint32_t *, size_t, float *, float *, float *);
+    void   (*oklab_to_oklch_f32)(const float *, const float *, size_t, float *, float *);
+    void   (*rgb8_to_lab_f32)(const uint32_t *, size_t, float *, float *, float *);
+    void   (*delta_e_f32)(cdiff_t, const float *, const float *, const float *, size_t, float, float, float, float *);
+    size_t (*nearest_delta_e_f32)(cdiff_t, const float *, const float *, const float *, size_t, float, float, float, float *);
+    void   (*rgb8_to_ansi256_idx)(const uint32_t *, size_t, uint8_t *);
+    void   (*rgb8_mat3_linear)(const float *, const uint32_t *, size_t, uint32_t *);
+    size_t (*rgb8_mat3_gamut)(const float *, const float *, const uint32_t *, size_t, uint32_t *, uint8_t *);
+    size_t (*rgb16_mat3_gamut)(const float *, const float *, const uint16_t *, size_t, uint32_t *, uint8_t *);
+    void   (*rgb8_lut3d)(const lut3d_t *, bool, const uint32_t *, size_t, uint32_t *);
+    void   (*rgb8_to_y8)(const yuv_coef_t *, const uint32_t *, size_t, uint8_t *);
+    void   (*rgb8_to_cbcr420)(const yuv_coef_t *, const uint32_t *, const uint32_t *, size_t, uint8_t *, uint8_t *, size_t);
+    void   (*yuv420_to_rgb8)(const yuv_coef_t *, const uint8_t *, const uint8_t *, const uint8_t *, size_t, size_t, uint32_t *);
+    void   (*rgba8_over_rgb8)(const uint32_t *, const uint8_t *, const uint32_t *, size_t, size_t, bool, uint32_t *);
+    void   (*rgb8_to_hsl16)(const uint32_t *, size_t, uint16_t *, uint16_t *, uint16_t *);
+    void   (*rgb8_to_hsv16)(const uint32_t *, size_t, uint16_t *, uint16_t *, uint16_t *);
+    void   (*rgb8_to_cmyk16)(const uint32_t *, size_t, uint16_t *, uint16_t *, uint16_t *, uint16_t *);
+    void   (*hsl16_to_rgb8)(const uint16_t *, const uint16_t *, const uint16_t *, size_t, uint32_t *);
+    void   (*hsv16_to_rgb8)(const uint16_t *, const uint16_t *, const uint16_t *, size_t, uint32_t *);
+    void   (*cmyk16_to_rgb8)(const uint16_t *, const uint16_t *, const uint16_t *, const uint16_t *, size_t, uint32_t *);
+} kernel_table_t;
+
+#define KERNEL_TABLE(_isa) {                \
+    KFN_ISA(nearest3_i32,        _isa),     \
+    KFN_ISA(nearest3_f32,        _isa),     \
+    KFN_ISA(dist2_3_f32,         _isa),     \
+    KFN_ISA(assign3_f32,         _isa),     \
+    KFN_ISA(wdist2_block_f32,    _isa),     \
+    KFN_ISA(rgb8_to_oklab_f32,   _isa),     \
+    KFN_ISA(oklab_to_oklch_f32,  _isa),     \
+    KFN_ISA(rgb8_to_lab_f32,     _isa),     \
+    KFN_ISA(delta_e_f32,         _isa),     \
+    KFN_ISA(nearest_delta_e_f32, _isa),     \
+    KFN_ISA(rgb8_to_ansi256_idx, _isa),     \
+    KFN_ISA(rgb8_mat3_linear,    _isa),     \
+    KFN_ISA(rgb8_mat3_gamut,     _isa),     \
+    KFN_ISA(rgb16_mat3_gamut,    _isa),     \
+    KFN_ISA(rgb8_lut3d,          _isa),     \
+    KFN_ISA(rgb8_to_y8,          _isa),     \
+    KFN_ISA(rgb8_to_cbcr420,     _isa),     \
+    KFN_ISA(yuv420_to_rgb8,      _isa),     \
+    KFN_ISA(rgba8_over_rgb8,     _isa),     \
+    KFN_ISA(rgb8_to_hsl16,       _isa),     \
+    KFN_ISA(rgb8_to_hsv16,       _isa),     \
+    KFN_ISA(rgb8_to_cmyk16,      _isa),     \
+    KFN_ISA(hsl16_to_rgb8,       _isa),     \
+    KFN_ISA(hsv16_to_rgb8,       _isa),     \
+    KFN_ISA(cmyk16_to_rgb8,      _isa)      \
+}
+
+static const kernel_table_t kernel_tables[] = {
+    KERNEL_TABLE(base),
+#if KERNELS_MULTIVERSION
+    KERNEL_TABLE(v2),
+    KERNEL_TABLE(v3),
+#endif
+};
+
+static const char *kernel_names[] = {
+    "nearest3_i32", "nearest3_f32", "dist2_3_f32", "assign3_f32", "wdist2_block_f32", "rgb8_to_oklab_f32", "oklab_to_oklch_f32",
+    "rgb8_to_lab_f32", "delta_e_f32", "nearest_delta_e_f32", "rgb8_to_ansi256_idx", "rgb8_mat3_linear",
+    "rgb8_mat3_gamut", "rgb16_mat3_gamut", "rgb8_lut3d", "rgb8_to_y8", "rgb8_to_cbcr420", "yuv420_to_rgb8",
+    "rgba8_over_rgb8", "rgb8_to_hsl16", "rgb8_to_hsv16", "rgb8_to_cmyk16", "hsl16_to_rgb8", "hsv16_to_rgb8", "cmyk16_to_rgb8"
+};
+
+static const char *isa_names[] = { "x86-64", "x86-64-v2", "x86-64-v3" };
+
+static struct {
+    atomic_bool           ready;
+    isa_level_t           detected;  // best level this cpu supports (and which was compiled in)
+    isa_level_t           active;    // level in use, lower if forced through COLOR_CPU_LEVEL
+    bool                  forced;
+    const kernel_table_t *table;
+} dispatch;
+
+static isa_level_t detect_isa() {
+#if KERNELS_MULTIVERSION
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("bmi2")) return ISA_V3;
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))                             return ISA_V2;
+#endif
+    return ISA_BASE;
+}
+
+// parse a level name ("base", "v2", "x86-64-v3", ...), returns false if unknown
+static bool parse_isa(const char *s, isa_level_t *isa) {
+    if      (strcasecmp_own(s, "base") || strcasecmp_own(s, "x86-64"))    *isa = ISA_BASE;
+    else if (strcasecmp_own(s, "v2")   || strcasecmp_own(s, "x86-64-v2")) *isa = ISA_V2;
+    else if (strcasecmp_own(s, "v3")   || strcasecmp_own(s, "x86-64-v3")) *isa = ISA_V3;
+    else    return false;
+    return true;
+}
+
+static void kernels_init() {
+    fix_div_init();
+
+    dispatch.detected = detect_isa();
+    dispatch.active   = dispatch.detected;
+
+    // a lower level can be forced for testing / benchmarking, never a higher one
+    const char *env = getenv("COLOR_CPU_LEVEL");
+    isa_level_t isa;
+    if (env && *env) {
+        if (!parse_isa(env, &isa))         fprintf(stderr, "warning: unknown COLOR_CPU_LEVEL \"%s\", ignoring\n", env);
+        else if (isa > dispatch.detected)  fprintf(stderr, "warning: COLOR_CPU_LEVEL \"%s\" is not supported on this cpu, ignoring\n", env);
+        else dispatch.active = isa;
+    }
+
+    dispatch.forced = dispatch.active != dispatch.detected;
+    dispatch.table  = &kernel_tables[dispatch.active];
+}
+
+static inline const kernel_table_t *kernels() {
+    if (!once_ready(&dispatch.ready)) {
+        #pragma omp critical(kernels_init)
+        if (!once_ready(&dispatch.ready)) { kernels_init(); once_done(&dispatch.ready); }
+    }
+    return dispatch.table;
+}
+
+isa_level_t kernels_isa() { kernels(); return dispatch.active; }
+
+bool kernels_force_isa(isa_level_t isa) {
+    kernels();
+    if (isa > dispatch.detected) return false;
+
+    dispatch.active = isa;
+    dispatch.forced = isa != dispatch.detected;
+    dispatch.table  = &kernel_tables[isa];
+    return true;
+}
+
+const char *isa_level_name(isa_level_t isa) { return isa_names[isa]; }
+
+void kernels_print_info(FILE *f) {
+    kernels();
+    fprintf(f, "cpu:    %s%s\n", isa_level_name(dispatch.detected), KERNELS_MULTIVERSION ? "" : " (no other levels compiled in)");
+    fprintf(f, "level:  %s%s\n", isa_level_name(dispatch.active), dispatch.forced ? " (forced by COLOR_CPU_LEVEL)" : "");
+    fprintf(f, "kernels:");
+    for (size_t i = 0; i < ARRAY_LENGTH(kernel_names); ++i) fprintf(f, " %s", kernel_names[i]);
+    fprintf(f, "\n");
+}
+
+size_t nearest3_i32(const int32_t *x, const int32_t *y, const int32_t *z, size_t n,
+                    int32_t qx, int32_t qy, int32_t qz,
+                    int32_t wx, int32_t wy, int32_t wz, int32_t *dist) {
+    return kernels()->nearest3_i32(x, y, z, n, qx, qy, qz, wx, wy, wz, dist);
+}
+
+size_t nearest3_f32(const float *x, const float *y, const float *z, size_t n,
+                    float qx, float qy, float qz, float *dist) {
+    return kernels()->nearest3_f32(x, y, z, n, qx, qy, qz, dist);
+}
+
+void dist2_3_f32(const float *x, const float *y, const float *z, size_t n,
+                 float qx, float qy, float qz, float *out) {
+    kernels()->dist2_3_f32(x, y, z, n, qx, qy, qz, out);
+}
+
+void assign3_f32(const float *x, const float *y, const float *z, size_t n,
+                 const float *cx, const float *cy, const float *cz, size_t k, uint16_t *idx, float *dist) {
+    kernels()->assign3_f32(x, y, z, n, cx, cy, cz, k, idx, dist);
+}
+
+void wdist2_block_f32(const float *qx, const float *qy, const float *qz, size_t nq,
+                      const float *x, const float *y, const float *z, size_t n,
+                      float wx, float wy, float wz, float *out, size_t stride) {
+    kernels()->wdist2_block_f32(qx, qy, qz, nq, x, y, z, n, wx, wy, wz, out, stride);
+}
+
+void rgb8_to_oklab_f32(const uint32_t *rgb, size_t n, float *L, float *a, float *b) { kernels()->rgb8_to_oklab_f32(rgb, n, L, a, b); }
+void oklab_to_oklch_f32(const float *a, const float *b, size_t n, float *C, float *h) { kernels()->oklab_to_oklch_f32(a, b, n, C, h); }
+void rgb8_to_ansi256_idx(const uint32_t *rgb, size_t n, uint8_t *out)               { kernels()->rgb8_to_ansi256_idx(rgb, n, out); }
+void rgb8_to_lab_f32(const uint32_t *rgb, size_t n, float *L, float *a, float *b)     { kernels()->rgb8_to_lab_f32(rgb, n, L, a, b); }
+void rgb8_mat3_linear(const float m[9], const uint32_t *in, size_t n, uint32_t *out) { kernels()->rgb8_mat3_linear(m, in, n, out); }
+size_t rgb8_mat3_gamut(const float dec[256], const float m[9], const uint32_t *in, size_t n, uint32_t *out, uint8_t *oog) { return kernels()->rgb8_mat3_gamut(dec, m, in, n, out, oog); }
+size_t rgb16_mat3_gamut(const float *dec, const float m[9], const uint16_t *in, size_t n, uint32_t *out, uint8_t *oog) { return kernels()->rgb16_mat3_gamut(dec, m, in, n, out, oog); }
+
+void rgb8_lut3d(const lut3d_t *lut, bool tetra, const uint32_t *in, size_t n, uint32_t *out) { kernels()->rgb8_lut3d(lut, tetra, in, n, out); }
+void rgb8_to_y8(const yuv_coef_t *c, const uint32_t *rgb, size_t n, uint8_t *y) { kernels()->rgb8_to_y8(c, rgb, n, y); }
+void rgb8_to_cbcr420(const yuv_coef_t *c, const uint32_t *row0, const uint32_t *row1, size_t w, uint8_t *cb, uint8_t *cr, size_t step) { kernels()->rgb8_to_cbcr420(c, row0, row1, w, cb, cr, step); }
+void yuv420_to_rgb8(const yuv_coef_t *c, const uint8_t *y, const uint8_t *cb, const uint8_t *cr, size_t step, size_t w, uint32_t *rgb) { kernels()->yuv420_to_rgb8(c, y, cb, cr, step, w, rgb); }
+void rgba8_over_rgb8(const uint32_t *rgb, const uint8_t *alpha, const uint32_t *bg, size_t bgstep, size_t n, bool linear, uint32_t *out) { kernels()->rgba8_over_rgb8(rgb, alpha, bg, bgstep, n, linear, out); }
+
+void delta_e_f32(cdiff_t metric, const float *L, const float *a, const float *b, size_t n,
+                 float qL, float qa, float qb, float *out) {
+    kernels()->delta_e_f32(metric, L, a, b, n, qL, qa, qb, out);
+}
+
+size_t nearest_delta_e_f32(cdiff_t metric, const float *L, const float *a, const float *b, size_t n,
+                           float qL, float qa, float qb, float *dist) {
+    return kernels()->nearest_delta_e_f32(metric, L, a, b, n, qL, qa, qb, dist);
+}
+
+void rgb8_to_hsl16(const uint32_t *rgb, size_t n, uint16_t *h, uint16_t *s, uint16_t *l)              { kernels()->rgb8_to_hsl16(rgb, n, h, s, l); }
+void rgb8_to_hsv16(const uint32_t *rgb, size_t n, uint16_t *h, uint16_t *s, uint16_t *v)              { kernels()->rgb8_to_hsv16(rgb, n, h, s, v); }
+void rgb8_to_cmyk16(const uint32_t *rgb, size_t n, uint16_t *c, uint16_t *m, uint16_t *y, uint16_t *k) { kernels()->rgb8_to_cmyk16(rgb, n, c, m, y, k); }
+void hsl16_to_rgb8(const uint16_t *h, const uint16_t *s, const uint16_t *l, size_t n, uint32_t *rgb)  { kernels()->hsl16_to_rgb8(h, s, l, n, rgb); }
+void hsv16_to_rgb8(const uint16_t *h, const uint16_t *s, const uint16_t *v, size_t n, uint32_t *rgb)  { kernels()->hsv16_to_rgb8(h, s, v, n, rgb); }
+void cmyk16_to_rgb8(const uint16_t *c, const uint16_t *m, const uint16_t *y, const uint16_t *k, size_t n, uint32_t *rgb) { kernels()->cmyk16_to_rgb8(c, m, y, k, n, rgb); }
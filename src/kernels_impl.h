@@ -0,0 +1,426 @@
+// kernel bodies, included once per isa level by src/kernels.c
+//
+// KFN(name) expands to the isa-specific function name, no include guard on purpose
+// every kernel defined here must also be added to kernel_table_t and KERNEL_TABLE in src/kernels.c
+
+static size_t KFN(nearest3_i32)(const int32_t *x, const int32_t *y, const int32_t *z, size_t n,
+                                int32_t qx, int32_t qy, int32_t qz,
+                                int32_t wx, int32_t wy, int32_t wz, int32_t *dist) {
+    size_t  best_i = 0;
+    int32_t best_d = INT32_MAX;
+    size_t  i      = 0;
+
+    for (; i + KERNEL_BLOCK <= n; i += KERNEL_BLOCK) {
+        int32_t d[KERNEL_BLOCK];
+        #pragma omp simd
+        for (int k = 0; k < KERNEL_BLOCK; ++k) {
+            int32_t dx = x[i + k] - qx, dy = y[i + k] - qy, dz = z[i + k] - qz;
+            d[k] = wx * dx * dx + wy * dy * dy + wz * dz * dz;
+        }
+
+        int32_t m = d[0];
+        #pragma omp simd reduction(min:m)
+        for (int k = 1; k < KERNEL_BLOCK; ++k) m = MIN(m, d[k]);
+
+        // only blocks that improve on the running best need their first minimum located
+        if (m < best_d) { int k = 0; while (d[k] != m) ++k; best_d = m; best_i = i + k; }
+    }
+
+    // remainder
+    for (; i < n; ++i) {
+        int32_t dx = x[i] - qx, dy = y[i] - qy, dz = z[i] - qz;
+        int32_t d  = wx * dx * dx + wy * dy * dy + wz * dz * dz;
+        if (d < best_d) { best_d = d; best_i = i; }
+    }
+
+    if (dist) *dist = best_d;
+    return best_i;
+}
+
+static size_t KFN(nearest3_f32)(const float *x, const float *y, const float *z, size_t n,
+                                float qx, float qy, float qz, float *dist) {
+    size_t best_i = 0;
+    float  best_d = INFINITY;
+    size_t i      = 0;
+
+    for (; i + KERNEL_BLOCK <= n; i += KERNEL_BLOCK) {
+        float d[KERNEL_BLOCK];
+        #pragma omp simd
+        for (int k = 0; k < KERNEL_BLOCK; ++k) {
+            float dx = x[i + k] - qx, dy = y[i + k] - qy, dz = z[i + k] - qz;
+            d[k] = dx * dx + dy * dy + dz * dz;
+        }
+
+        float m = d[0];
+        #pragma omp simd reduction(min:m)
+        for (int k = 1; k < KERNEL_BLOCK; ++k) m = MIN(m, d[k]);
+
+        // only blocks that improve on the running best need their first minimum located
+        if (m < best_d) { int k = 0; while (d[k] != m) ++k; best_d = m; best_i = i + k; }
+    }
+
+    // remainder
+    for (; i < n; ++i) {
+        float dx = x[i] - qx, dy = y[i] - qy, dz = z[i] - qz;
+        float d  = dx * dx + dy * dy + dz * dz;
+        if (d < best_d) { best_d = d; best_i = i; }
+    }
+
+    if (dist) *dist = best_d;
+    return best_i;
+}
+
+static void KFN(rgb8_to_oklab_f32)(const uint32_t *rgb, size_t n, float *L, float *a, float *b) {
+    const float *lin = srgb_to_linear_lut8();
+
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        float r = lin[(rgb[i] >> 16) & 0xFF], g = lin[(rgb[i] >> 8) & 0xFF], bl = lin[rgb[i] & 0xFF];
+        cv_linear_to_oklab_f32(r, g, bl, &L[i], &a[i], &b[i]);
+    }
+}
+
+static void KFN(rgb8_to_lab_f32)(const uint32_t *rgb, size_t n, float *L, float *a, float *b) {
+    const float *lin = srgb_to_linear_lut8();
+
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        float r = lin[(rgb[i] >> 16) & 0xFF], g = lin[(rgb[i] >> 8) & 0xFF], bl = lin[rgb[i] & 0xFF];
+        cv_linear_to_lab_f32(r, g, bl, &L[i], &a[i], &b[i]);
+    }
+}
+
+// one loop per metric, so the branches on the metric stay outside of the vectorized loops
+#define KERNEL_DE_LOOP(_expr)                                                   \
+    do {                                                                        \
+        _Pragma("omp simd")                                                     \
+        for (size_t i = 0; i < n; ++i) out[i] = (_expr);                        \
+    } while (0)
+
+static void KFN(delta_e_f32)(cdiff_t metric, const float *L, const float *a, const float *b, size_t n,
+                             float qL, float qa, float qb, float *out) {
+    switch (metric) {
+        case CDIFF_DE94:   KERNEL_DE_LOOP(cv_delta_e94_f32(qL, qa, qb, L[i], a[i], b[i]));               break;
+        case CDIFF_DE2000: KERNEL_DE_LOOP(cv_delta_e2000_f32(qL, qa, qb, L[i], a[i], b[i]));             break;
+        case CDIFF_CMC:    KERNEL_DE_LOOP(cv_delta_e_cmc_f32(qL, qa, qb, L[i], a[i], b[i], 2.0f, 1.0f)); break;
+        default:           KERNEL_DE_LOOP(cv_delta_e76_f32(qL, qa, qb, L[i], a[i], b[i]));               break;
+    }
+}
+
+#undef KERNEL_DE_LOOP
+
+static size_t KFN(nearest_delta_e_f32)(cdiff_t metric, const float *L, const float *a, const float *b, size_t n,
+                                       float qL, float qa, float qb, float *dist) {
+    size_t best_i = 0;
+    float  best_d = INFINITY;
+
+    // the differences are too expensive for the min reduction to matter, blocks only bound the scratch space
+    for (size_t i = 0; i < n; i += KERNEL_BLOCK) {
+        float  d[KERNEL_BLOCK];
+        size_t m = MIN((size_t)KERNEL_BLOCK, n - i);
+        KFN(delta_e_f32)(metric, L + i, a + i, b + i, m, qL, qa, qb, d);
+        for (size_t k = 0; k < m; ++k) if (d[k] < best_d) { best_d = d[k]; best_i = i + k; }
+    }
+
+    if (dist) *dist = best_d;
+    return best_i;
+}
+
+static void KFN(oklab_to_oklch_f32)(const float *a, const float *b, size_t n, float *C, float *h) {
+    for (size_t i = 0; i < n; ++i) cv_oklab_to_oklch_f32(a[i], b[i], &C[i], &h[i]);
+}
+
+static void KFN(dist2_3_f32)(const float *x, const float *y, const float *z, size_t n,
+                             float qx, float qy, float qz, float *out) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        float dx = x[i] - qx, dy = y[i] - qy, dz = z[i] - qz;
+        out[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+static void KFN(assign3_f32)(const float *x, const float *y, const float *z, size_t n,
+                             const float *cx, const float *cy, const float *cz, size_t k, uint16_t *idx, float *dist) {
+    size_t i = 0;
+
+    // centers outer, entries inner: every lane keeps the best center of its own entry
+    for (; i + KERNEL_BLOCK <= n; i += KERNEL_BLOCK) {
+        float   best[KERNEL_BLOCK];
+        int32_t bi[KERNEL_BLOCK];
+        for (int l = 0; l < KERNEL_BLOCK; ++l) { best[l] = INFINITY; bi[l] = 0; }
+
+        for (size_t c = 0; c < k; ++c) {
+            float qx = cx[c], qy = cy[c], qz = cz[c];
+            #pragma omp simd
+            for (int l = 0; l < KERNEL_BLOCK; ++l) {
+                float dx = x[i + l] - qx, dy = y[i + l] - qy, dz = z[i + l] - qz;
+                float d  = dx * dx + dy * dy + dz * dz;
+                bool  lt = d < best[l];
+                best[l]  = lt ? d : best[l];
+                bi[l]    = lt ? (int32_t)c : bi[l];
+            }
+        }
+
+        for (int l = 0; l < KERNEL_BLOCK; ++l) idx[i + l] = (uint16_t)bi[l];
+        if (dist) for (int l = 0; l < KERNEL_BLOCK; ++l) dist[i + l] = best[l];
+    }
+
+    // remainder
+    for (; i < n; ++i) {
+        float  best = INFINITY;
+        size_t bc   = 0;
+        for (size_t c = 0; c < k; ++c) {
+            float dx = x[i] - cx[c], dy = y[i] - cy[c], dz = z[i] - cz[c];
+            float d  = dx * dx + dy * dy + dz * dz;
+            if (d < best) { best = d; bc = c; }
+        }
+        idx[i] = (uint16_t)bc;
+        if (dist) dist[i] = best;
+    }
+}
+
+static void KFN(wdist2_block_f32)(const float *qx, const float *qy, const float *qz, size_t nq,
+                                  const float *x, const float *y, const float *z, size_t n,
+                                  float wx, float wy, float wz, float *out, size_t stride) {
+    for (size_t q = 0; q < nq; ++q) {
+        float  px = qx[q], py = qy[q], pz = qz[q];
+        float *row = out + q * stride;
+
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            float dx = x[i] - px, dy = y[i] - py, dz = z[i] - pz;
+            row[i] = wx * dx * dx + wy * dy * dy + wz * dz * dz;
+        }
+    }
+}
+
+static void KFN(rgb8_to_ansi256_idx)(const uint32_t *rgb, size_t n, uint8_t *out) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        int r = (rgb[i] >> 16) & 0xFF, g = (rgb[i] >> 8) & 0xFF, b = rgb[i] & 0xFF;
+        out[i] = (uint8_t)ansi256_closest(r, g, b);
+    }
+}
+
+static void KFN(rgb8_mat3_linear)(const float *m, const uint32_t *in, size_t n, uint32_t *out) {
+    const float       *lin = srgb_to_linear_lut8();
+    const srgb8_enc_t *enc = linear_to_srgb8_lut();
+    float m0 = m[0], m1 = m[1], m2 = m[2], m3 = m[3], m4 = m[4], m5 = m[5], m6 = m[6], m7 = m[7], m8 = m[8];
+
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        float r = lin[(in[i] >> 16) & 0xFF], g = lin[(in[i] >> 8) & 0xFF], b = lin[in[i] & 0xFF];
+        out[i] = (srgb8_encode(enc, m0 * r + m1 * g + m2 * b) << 16)
+               | (srgb8_encode(enc, m3 * r + m4 * g + m5 * b) << 8)
+               |  srgb8_encode(enc, m6 * r + m7 * g + m8 * b);
+    }
+}
+
+static size_t KFN(rgb8_mat3_gamut)(const float *dec, const float *m, const uint32_t *in, size_t n, uint32_t *out, uint8_t *oog) {
+    const srgb8_enc_t *enc = linear_to_srgb8_lut();
+    float m0 = m[0], m1 = m[1], m2 = m[2], m3 = m[3], m4 = m[4], m5 = m[5], m6 = m[6], m7 = m[7], m8 = m[8];
+    size_t cnt = 0;
+
+    #pragma omp simd reduction(+:cnt)
+    for (size_t i = 0; i < n; ++i) {
+        float r  = dec[(in[i] >> 16) & 0xFF], g = dec[(in[i] >> 8) & 0xFF], b = dec[in[i] & 0xFF];
+        float rl = m0 * r + m1 * g + m2 * b, gl = m3 * r + m4 * g + m5 * b, bl = m6 * r + m7 * g + m8 * b;
+        bool  o  = !cv_in_gamut_linear_f32(rl, gl, bl);
+        oog[i]   = o;
+        cnt     += o;
+        out[i]   = (srgb8_encode(enc, rl) << 16) | (srgb8_encode(enc, gl) << 8) | srgb8_encode(enc, bl);
+    }
+    return cnt;
+}
+
+static size_t KFN(rgb16_mat3_gamut)(const float *dec, const float *m, const uint16_t *in, size_t n, uint32_t *out, uint8_t *oog) {
+    const srgb8_enc_t *enc = linear_to_srgb8_lut();
+    float m0 = m[0], m1 = m[1], m2 = m[2], m3 = m[3], m4 = m[4], m5 = m[5], m6 = m[6], m7 = m[7], m8 = m[8];
+    size_t cnt = 0;
+
+    #pragma omp simd reduction(+:cnt)
+    for (size_t i = 0; i < n; ++i) {
+        float r  = dec[in[3 * i]], g = dec[in[3 * i + 1]], b = dec[in[3 * i + 2]];
+        float rl = m0 * r + m1 * g + m2 * b, gl = m3 * r + m4 * g + m5 * b, bl = m6 * r + m7 * g + m8 * b;
+        bool  o  = !cv_in_gamut_linear_f32(rl, gl, bl);
+        oog[i]   = o;
+        cnt     += o;
+        out[i]   = (srgb8_encode(enc, rl) << 16) | (srgb8_encode(enc, gl) << 8) | srgb8_encode(enc, bl);
+    }
+    return cnt;
+}
+
+static void KFN(rgb8_lut3d)(const lut3d_t *lut, bool tetra, const uint32_t *in, size_t n, uint32_t *out) {
+    const float *d  = lut->data;
+    int32_t      sr = lut->step[0], sg = lut->step[1], sb = lut->step[2], s3 = sr + sg + sb;
+
+    if (!tetra) {
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t r = (in[i] >> 16) & 0xFF, g = (in[i] >> 8) & 0xFF, b = in[i] & 0xFF;
+            int32_t  o = lut->idx[0][r] + lut->idx[1][g] + lut->idx[2][b];
+            float    fr = lut->frac[0][r], fg = lut->frac[1][g], fb = lut->frac[2][b];
+            out[i] = (unorm8_encode(lut3d_trilinear(d + o,     sr, sg, sb, fr, fg, fb)) << 16)
+                   | (unorm8_encode(lut3d_trilinear(d + o + 1, sr, sg, sb, fr, fg, fb)) << 8)
+                   |  unorm8_encode(lut3d_trilinear(d + o + 2, sr, sg, sb, fr, fg, fb));
+        }
+        return;
+    }
+
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t r = (in[i] >> 16) & 0xFF, g = (in[i] >> 8) & 0xFF, b = in[i] & 0xFF;
+        int32_t  o = lut->idx[0][r] + lut->idx[1][g] + lut->idx[2][b];
+        float    fr = lut->frac[0][r], fg = lut->frac[1][g], fb = lut->frac[2][b];
+
+        // axis with the largest fraction first, the one with the smallest last (distinct even when fractions tie)
+        int32_t smax = (fr >= fg) ? ((fr >= fb) ? sr : sb) : ((fg >= fb) ? sg : sb);
+        int32_t smin = (fr >= fg) ? ((fg >= fb) ? sb : sg) : ((fr >= fb) ? sb : sr);
+        float   fmax = MAX(MAX(fr, fg), fb), fmin = MIN(MIN(fr, fg), fb);
+        float   fmid = MAX(MIN(fr, fg), MIN(MAX(fr, fg), fb));
+        int32_t i1 = o + smax, i2 = o + s3 - smin, i3 = o + s3;
+
+        out[i] = (unorm8_encode(lut3d_tetrahedral(d,     o, i1, i2, i3, fmax, fmid, fmin)) << 16)
+               | (unorm8_encode(lut3d_tetrahedral(d + 1, o, i1, i2, i3, fmax, fmid, fmin)) << 8)
+               |  unorm8_encode(lut3d_tetrahedral(d + 2, o, i1, i2, i3, fmax, fmid, fmin));
+    }
+}
+
+static void KFN(rgb8_to_y8)(const yuv_coef_t *c, const uint32_t *rgb, size_t n, uint8_t *y) {
+    int32_t wr = c->y[0], wg = c->y[1], wb = c->y[2], off = (c->ylo << YUV_FIX) + (1 << (YUV_FIX - 1));
+
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        int32_t r = (rgb[i] >> 16) & 0xFF, g = (rgb[i] >> 8) & 0xFF, b = rgb[i] & 0xFF;
+        y[i] = (uint8_t)yuv_clamp8(wr * r + wg * g + wb * b + off);
+    }
+}
+
+static void KFN(rgb8_to_cbcr420)(const yuv_coef_t *c, const uint32_t *row0, const uint32_t *row1, size_t w, uint8_t *cb, uint8_t *cr, size_t step) {
+    // 2x2 sums carry 2 more fractional bits, which the >> 2 of the weights takes back before rounding
+    int32_t br = c->cb[0], bg = c->cb[1], bb = c->cb[2], rr = c->cr[0], rg = c->cr[1], rb = c->cr[2];
+    int32_t off = (128 << (YUV_FIX + 2)) + (1 << (YUV_FIX + 1));
+    size_t  cw  = (w + 1) / 2;
+
+    #pragma omp simd
+    for (size_t i = 0; i < cw; ++i) {
+        size_t   x0 = 2 * i, x1 = MIN(x0 + 1, w - 1);
+        uint32_t p0 = row0[x0], p1 = row0[x1], p2 = row1[x0], p3 = row1[x1];
+        int32_t  r  = ((p0 >> 16) & 0xFF) + ((p1 >> 16) & 0xFF) + ((p2 >> 16) & 0xFF) + ((p3 >> 16) & 0xFF);
+        int32_t  g  = ((p0 >> 8) & 0xFF)  + ((p1 >> 8) & 0xFF)  + ((p2 >> 8) & 0xFF)  + ((p3 >> 8) & 0xFF);
+        int32_t  b  = (p0 & 0xFF)         + (p1 & 0xFF)         + (p2 & 0xFF)         + (p3 & 0xFF);
+        cb[i * step] = (uint8_t)yuv_clamp8((br * r + bg * g + bb * b + off) >> 2);
+        cr[i * step] = (uint8_t)yuv_clamp8((rr * r + rg * g + rb * b + off) >> 2);
+    }
+}
+
+static void KFN(yuv420_to_rgb8)(const yuv_coef_t *c, const uint8_t *y, const uint8_t *cb, const uint8_t *cr, size_t step, size_t w, uint32_t *rgb) {
+    int32_t ys = c->ys, ylo = c->ylo, rcr = c->rcr, gcb = c->gcb, gcr = c->gcr, bcb = c->bcb, half = 1 << (YUV_FIX - 1);
+
+    #pragma omp simd
+    for (size_t i = 0; i < w; ++i) {
+        size_t  k  = (i >> 1) * step;
+        int32_t l  = ((int32_t)y[i] - ylo) * ys + half, u = (int32_t)cb[k] - 128, v = (int32_t)cr[k] - 128;
+        rgb[i] = (yuv_clamp8(l + rcr * v) << 16) | (yuv_clamp8(l - gcb * u - gcr * v) << 8) | yuv_clamp8(l + bcb * u);
+    }
+}
+
+static void KFN(rgba8_over_rgb8)(const uint32_t *rgb, const uint8_t *alpha, const uint32_t *bg, size_t bgstep, size_t n, bool linear, uint32_t *out) {
+    if (!linear) {
+        // exact in integers: (s * a + b * (255 - a)) / 255, rounded
+        #pragma omp simd
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t s = rgb[i], b = bg[i * bgstep], a = alpha[i], na = 255 - a;
+            out[i] = (div255_round(((s >> 16) & 0xFF) * a + ((b >> 16) & 0xFF) * na) << 16)
+                   | (div255_round(((s >> 8) & 0xFF) * a  + ((b >> 8) & 0xFF) * na) << 8)
+                   |  div255_round((s & 0xFF) * a         + (b & 0xFF) * na);
+        }
+        return;
+    }
+
+    const float       *lin = srgb_to_linear_lut8();
+    const srgb8_enc_t *enc = linear_to_srgb8_lut();
+
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t s  = rgb[i], b = bg[i * bgstep];
+        float    a  = alpha[i] * (1.0f / 255.0f);
+        float    br = lin[(b >> 16) & 0xFF], bgr = lin[(b >> 8) & 0xFF], bb = lin[b & 0xFF];
+        out[i] = (srgb8_encode(enc, br  + (lin[(s >> 16) & 0xFF] - br)  * a) << 16)
+               | (srgb8_encode(enc, bgr + (lin[(s >> 8) & 0xFF]  - bgr) * a) << 8)
+               |  srgb8_encode(enc, bb  + (lin[s & 0xFF]         - bb)  * a);
+    }
+}
+
+static void KFN(rgb8_to_hsl16)(const uint32_t *rgb, size_t n, uint16_t *h, uint16_t *s, uint16_t *l) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        int32_t r = (rgb[i] >> 16) & 0xFF, g = (rgb[i] >> 8) & 0xFF, b = rgb[i] & 0xFF;
+        int32_t cmax = MAX(MAX(r, g), b), cmin = MIN(MIN(r, g), b), delta = cmax - cmin, sum = cmax + cmin;
+
+        // l = sum / 510, s = delta / (1 - |2l - 1|) = delta / min(sum, 510 - sum)
+        l[i] = (uint16_t)((257 * (uint32_t)sum + 1) >> 1);
+        s[i] = (uint16_t)fix_ratio16(delta, MIN(sum, 510 - sum));
+        h[i] = fix_hue16(r, g, b, cmax, delta);
+    }
+}
+
+static void KFN(rgb8_to_hsv16)(const uint32_t *rgb, size_t n, uint16_t *h, uint16_t *s, uint16_t *v) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        int32_t r = (rgb[i] >> 16) & 0xFF, g = (rgb[i] >> 8) & 0xFF, b = rgb[i] & 0xFF;
+        int32_t cmax = MAX(MAX(r, g), b), cmin = MIN(MIN(r, g), b), delta = cmax - cmin;
+
+        v[i] = (uint16_t)(257 * cmax);
+        s[i] = (uint16_t)fix_ratio16(delta, cmax);
+        h[i] = fix_hue16(r, g, b, cmax, delta);
+    }
+}
+
+static void KFN(rgb8_to_cmyk16)(const uint32_t *rgb, size_t n, uint16_t *c, uint16_t *m, uint16_t *y, uint16_t *k) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        int32_t r = (rgb[i] >> 16) & 0xFF, g = (rgb[i] >> 8) & 0xFF, b = rgb[i] & 0xFF;
+        int32_t cmax = MAX(MAX(r, g), b);
+
+        // c = (1 - r - k) / (1 - k) = (cmax - r) / cmax, black has c = m = y = 0
+        k[i] = (uint16_t)(257 * (255 - cmax));
+        c[i] = (uint16_t)fix_ratio16(cmax - r, cmax);
+        m[i] = (uint16_t)fix_ratio16(cmax - g, cmax);
+        y[i] = (uint16_t)fix_ratio16(cmax - b, cmax);
+    }
+}
+
+// channel numerators below are in units of 1 / (65535^2 * 65536) (hsv) or 1 / (2 * 65535^2 * 65536) (hsl)
+static void KFN(hsl16_to_rgb8)(const uint16_t *h, const uint16_t *s, const uint16_t *l, size_t n, uint32_t *rgb) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        // chroma (1 - |2l - 1|) * s and m = l - chroma / 2
+        uint32_t L    = l[i];
+        uint32_t cs   = (FIX_ONE - (2 * L > FIX_ONE ? 2 * L - FIX_ONE : FIX_ONE - 2 * L)) * (uint32_t)s[i];
+        uint64_t base = ((uint64_t)(2 * L) * FIX_ONE - cs) << 16;
+        rgb[i] = fix_sector_rgb8(h[i], base + ((uint64_t)cs << 17), base + 2 * ((uint64_t)cs * fix_hue_weight(h[i])), base, 17);
+    }
+}
+
+static void KFN(hsv16_to_rgb8)(const uint16_t *h, const uint16_t *s, const uint16_t *v, size_t n, uint32_t *rgb) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        // chroma v * s and m = v - chroma
+        uint32_t cs   = (uint32_t)v[i] * s[i];
+        uint64_t base = ((uint64_t)v[i] * FIX_ONE - cs) << 16;
+        rgb[i] = fix_sector_rgb8(h[i], base + ((uint64_t)cs << 16), base + (uint64_t)cs * fix_hue_weight(h[i]), base, 16);
+    }
+}
+
+static void KFN(cmyk16_to_rgb8)(const uint16_t *c, const uint16_t *m, const uint16_t *y, const uint16_t *k, size_t n, uint32_t *rgb) {
+    #pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        // 255 * (1 - c) * (1 - k) = (65535 - c) * (65535 - k) / (257 * 65535)
+        uint32_t kk = FIX_ONE - k[i];
+        uint32_t r  = fix_round8((uint64_t)(FIX_ONE - c[i]) * kk, 0);
+        uint32_t g  = fix_round8((uint64_t)(FIX_ONE - m[i]) * kk, 0);
+        uint32_t b  = fix_round8((uint64_t)(FIX_ONE - y[i]) * kk, 0);
+        rgb[i] = (r << 16) | (g << 8) | b;
+    }
+}
@@ -0,0 +1,295 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "converter.h"
+#include "kernels.h"
+#include "lut.h"
+#include "parser.h"
+#include "utility.h"
+
+#define LUT_MAGIC    "CLRLUT\0\0"
+#define LUT_ENTRIES  (1u << 24)
+#define LUT_HDR_SIZE 4096 // keep tables page-aligned inside the file
+
+// file layout: header (padded to LUT_HDR_SIZE), css u16[], xkcd u16[], ansi256 u8[], ansi16 u8[]
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t entries;
+    uint64_t signature; // hash over everything the tables were built from
+} lut_header_t;
+
+#define LUT_OFF_CSS     ((size_t)LUT_HDR_SIZE)
+#define LUT_OFF_XKCD    (LUT_OFF_CSS     + (size_t)LUT_ENTRIES * sizeof(uint16_t))
+#define LUT_OFF_ANSI256 (LUT_OFF_XKCD    + (size_t)LUT_ENTRIES * sizeof(uint16_t))
+#define LUT_OFF_ANSI16  (LUT_OFF_ANSI256 + (size_t)LUT_ENTRIES)
+#define LUT_FILE_SIZE   (LUT_OFF_ANSI16  + (size_t)LUT_ENTRIES)
+
+// mapped tables (NULL if unavailable), ready once the file was tried
+static struct {
+    atomic_bool     ready;
+    const uint8_t  *base;
+    const uint16_t *css;
+    const uint16_t *xkcd;
+    const uint8_t  *ansi256;
+    const uint8_t  *ansi16;
+} lut = { 0 };
+
+// fnv-1a, used to detect caches built from different name tables or weights
+static uint64_t fnv1a(uint64_t h, const void *data, size_t len) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < len; ++i) { h ^= p[i]; h *= 0x100000001b3ULL; }
+    return h;
+}
+
+static uint64_t lut_signature() {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    const double weights[3] = { W_R, W_G, W_B };
+    h = fnv1a(h, weights, sizeof(weights));
+    for (int x = 0; x < 2; ++x) {
+        const named_table_t *tbl = get_named_table(x);
+        h = fnv1a(h, tbl->hex, tbl->size * sizeof(hex_t));
+        h = fnv1a(h, &tbl->size, sizeof(tbl->size));
+    }
+    for (int i = 0; i < 256; ++i) { rgb_t p = ansi256_idx_to_rgb(i); h = fnv1a(h, &p, sizeof(p)); }
+    return h;
+}
+
+// check header and size of a mapped file
+static bool lut_valid(const uint8_t *base, size_t size) {
+    if (size != LUT_FILE_SIZE) return false;
+    const lut_header_t *hdr = (const lut_header_t *)base;
+    return memcmp(hdr->magic, LUT_MAGIC, sizeof(hdr->magic)) == 0
+        && hdr->version   == LUT_VERSION
+        && hdr->entries   == LUT_ENTRIES
+        && hdr->signature == lut_signature();
+}
+
+// map the cache file; on any failure, lookups simply miss
+static void lut_open() {
+    char path[STR_BUFSIZE * 4];
+    if (!lut_default_path(path, sizeof(path))) return;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != LUT_FILE_SIZE) { close(fd); return; }
+
+    void *m = mmap(NULL, LUT_FILE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) return;
+
+    if (!lut_valid(m, LUT_FILE_SIZE)) { munmap(m, LUT_FILE_SIZE); return; }
+
+    // lookups are random access all over the file; huge pages cut tlb misses where the kernel supports them for file mappings
+#ifdef MADV_HUGEPAGE
+    madvise(m, LUT_FILE_SIZE, MADV_HUGEPAGE);
+#endif
+    madvise(m, LUT_FILE_SIZE, MADV_RANDOM);
+
+    lut.base    = m;
+    lut.css     = (const uint16_t *)(lut.base + LUT_OFF_CSS);
+    lut.xkcd    = (const uint16_t *)(lut.base + LUT_OFF_XKCD);
+    lut.ansi256 = lut.base + LUT_OFF_ANSI256;
+    lut.ansi16  = lut.base + LUT_OFF_ANSI16;
+}
+
+static inline bool lut_ready() {
+    if (!once_ready(&lut.ready)) {
+        #pragma omp critical(lut_open)
+        if (!once_ready(&lut.ready)) { lut_open(); once_done(&lut.ready); }
+    }
+    return lut.base != NULL;
+}
+
+// forget the mapped tables, the next lookup maps the file again
+static void lut_close() {
+    if (lut.base) munmap((void *)lut.base, LUT_FILE_SIZE);
+    lut.base = NULL; lut.css = lut.xkcd = NULL; lut.ansi256 = lut.ansi16 = NULL;
+    atomic_store(&lut.ready, false);
+}
+
+int lut_named_idx(lut_names_t set, hex_t hex) {
+    if (!lut_ready()) return -1;
+    return (set == LUT_XKCD) ? lut.xkcd[hex & 0xFFFFFF] : lut.css[hex & 0xFFFFFF];
+}
+
+int lut_ansi256_idx(hex_t hex) { return lut_ready() ? lut.ansi256[hex & 0xFFFFFF] : -1; }
+int lut_ansi16_idx(hex_t hex)  { return lut_ready() ? lut.ansi16[hex & 0xFFFFFF]  : -1; }
+
+bool lut_default_path(char *buf, size_t bufsz) {
+    const char *env = getenv("COLOR_LUT");
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    int n;
+
+    if      (env && *env)   n = snprintf(buf, bufsz, "%s", env);
+    else if (xdg && *xdg)   n = snprintf(buf, bufsz, "%s/color/nearest.lut", xdg);
+    else if (home && *home) n = snprintf(buf, bufsz, "%s/.cache/color/nearest.lut", home);
+    else                    return false;
+
+    return n >= 0 && (size_t)n < bufsz;
+}
+
+// fill the closest name indices for all 256 blue values of one (r,g) row
+//
+// gives exactly the result of closest_named_index_scan, but instead of scanning every entry for every b,
+// the row is cut into segments of LUT_SEG blue values and each segment only scans the entries that could possibly win in it:
+// any entry gives an upper bound for the best distance in the segment (its distance to the farthest b in the segment),
+// and an entry whose distance to the nearest b in the segment exceeds the smallest such bound can never win or tie there
+//
+// candidates are kept in index order, so strict < still resolves ties to the lowest index
+#define LUT_SEG 32
+static void fill_named_row(const int *cr, const int *cg, const int *cb, size_t n, int r, int g,
+                           int *drg, uint16_t *cand, uint16_t *out) {
+    for (size_t i = 0; i < n; ++i) {
+        int dr = r - cr[i], dg = g - cg[i];
+        drg[i] = W_R_I * dr * dr + W_G_I * dg * dg;
+    }
+
+    for (int lo = 0; lo < 256; lo += LUT_SEG) {
+        int hi = lo + LUT_SEG - 1;
+
+        int bound = INT_MAX;
+        for (size_t i = 0; i < n; ++i) {
+            int far = MAX(abs(cb[i] - lo), abs(cb[i] - hi));
+            int d   = drg[i] + W_B_I * far * far;
+            if (d < bound) bound = d;
+        }
+
+        size_t nc = 0;
+        for (size_t i = 0; i < n; ++i) {
+            int near = (cb[i] < lo) ? lo - cb[i] : (cb[i] > hi) ? cb[i] - hi : 0;
+            if (drg[i] + W_B_I * near * near <= bound) cand[nc++] = (uint16_t)i;
+        }
+
+        for (int b = lo; b <= hi; ++b) {
+            int      best = INT_MAX;
+            uint16_t bi   = 0;
+            for (size_t k = 0; k < nc; ++k) {
+                int db = b - cb[cand[k]];
+                int d  = drg[cand[k]] + W_B_I * db * db;
+                if (d < best) { best = d; bi = cand[k]; }
+            }
+            out[b] = bi;
+        }
+    }
+}
+
+// create all missing parent directories of path
+static void mkdir_parents(const char *path) {
+    char tmp[STR_BUFSIZE * 4];
+    snprintf(tmp, sizeof(tmp), "%s", path);
+    for (char *p = tmp + 1; *p; ++p) {
+        if (*p != '/') continue;
+        *p = '\0';
+        mkdir(tmp, 0755);
+        *p = '/';
+    }
+}
+
+// channel arrays of both name tables
+static void free_channels(int *chan[2][3]) {
+    for (int t = 0; t < 2; ++t) for (int c = 0; c < 3; ++c) free(chan[t][c]);
+}
+
+int lut_build() {
+    char path[STR_BUFSIZE * 4];
+    if (!lut_default_path(path, sizeof(path))) { fprintf(stderr, "error: could not determine lut cache path (set COLOR_LUT)\n"); errno = ENOENT; return -1; }
+
+    // split both name tables into channel arrays once
+    const named_table_t *tbls[2] = { get_named_table(false), get_named_table(true) };
+    int                 *chan[2][3] = { { NULL } };
+    for (int t = 0; t < 2; ++t) {
+        for (int c = 0; c < 3; ++c) {
+            chan[t][c] = malloc(tbls[t]->size * sizeof(int));
+            if (!chan[t][c]) { fprintf(stderr, "error: out of memory\n"); free_channels(chan); errno = ENOMEM; return -1; }
+        }
+        for (size_t i = 0; i < tbls[t]->size; ++i) {
+            chan[t][0][i] = (tbls[t]->hex[i] >> 16) & 0xFF;
+            chan[t][1][i] = (tbls[t]->hex[i] >>  8) & 0xFF;
+            chan[t][2][i] =  tbls[t]->hex[i]        & 0xFF;
+        }
+    }
+    size_t maxn = MAX(tbls[0]->size, tbls[1]->size);
+
+    // the new file is picked up by the next lookup
+    lut_close();
+
+    char tmppath[STR_BUFSIZE * 4 + 16];
+    snprintf(tmppath, sizeof(tmppath), "%s.%ld.tmp", path, (long)getpid());
+    mkdir_parents(path);
+
+    int fd = open(tmppath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) { fprintf(stderr, "error: could not create %s: %s\n", tmppath, strerror(errno)); free_channels(chan); return -1; }
+
+    // allocate every block up front: stores into a hole of a sparse file would fault (SIGBUS) once the disk is full
+    int rc = posix_fallocate(fd, 0, LUT_FILE_SIZE);
+    if (rc != 0) { fprintf(stderr, "error: could not allocate %s: %s\n", tmppath, strerror(rc)); close(fd); unlink(tmppath); free_channels(chan); errno = rc; return -1; }
+
+    uint8_t *m = mmap(NULL, LUT_FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) { fprintf(stderr, "error: could not map %s: %s\n", tmppath, strerror(errno)); unlink(tmppath); free_channels(chan); return -1; }
+
+    uint16_t *css     = (uint16_t *)(m + LUT_OFF_CSS);
+    uint16_t *xkcd    = (uint16_t *)(m + LUT_OFF_XKCD);
+    uint8_t  *ansi256 = m + LUT_OFF_ANSI256;
+    uint8_t  *ansi16  = m + LUT_OFF_ANSI16;
+
+    uint16_t *outs[2] = { css, xkcd };
+
+    // one row per (r,g) pair, rows are independent
+    bool oom = false;
+    #pragma omp parallel
+    {
+        int      *drg  = malloc(maxn * sizeof(int));
+        uint16_t *cand = malloc(maxn * sizeof(uint16_t));
+        uint32_t  row[256];
+        if (!drg || !cand) {
+            #pragma omp atomic write
+            oom = true;
+        }
+
+        #pragma omp for schedule(dynamic, 64)
+        for (int rg = 0; rg < 65536; ++rg) {
+            if (!drg || !cand) continue;
+            int r = rg >> 8, g = rg & 0xFF;
+            for (int t = 0; t < 2; ++t) fill_named_row(chan[t][0], chan[t][1], chan[t][2], tbls[t]->size, r, g, drg, cand, outs[t] + ((size_t)rg << 8));
+            for (int b = 0; b < 256; ++b) {
+                rgb_t rgb = { r, g, b };
+                row[b]    = ((uint32_t)rg << 8) | (uint32_t)b;
+                ansi16[((size_t)rg << 8) | (size_t)b] = (uint8_t)rgb_to_ansi16_idx_scan(&rgb);
+            }
+            rgb8_to_ansi256_idx(row, 256, ansi256 + ((size_t)rg << 8));
+        }
+
+        free(drg);
+        free(cand);
+    }
+    free_channels(chan);
+    if (oom) { fprintf(stderr, "error: out of memory\n"); munmap(m, LUT_FILE_SIZE); unlink(tmppath); errno = ENOMEM; return -1; }
+
+    // header last, so a crash mid-build leaves an invalid file behind
+    lut_header_t hdr = { .version = LUT_VERSION, .entries = LUT_ENTRIES, .signature = lut_signature() };
+    memcpy(hdr.magic, LUT_MAGIC, sizeof(hdr.magic));
+    memcpy(m, &hdr, sizeof(hdr));
+
+    rc = msync(m, LUT_FILE_SIZE, MS_SYNC);
+    munmap(m, LUT_FILE_SIZE);
+    if (rc != 0 || rename(tmppath, path) != 0) { fprintf(stderr, "error: could not write %s: %s\n", path, strerror(errno)); unlink(tmppath); return -1; }
+
+    return 0;
+}
+
+void lut_print_info(FILE *stream) {
+    char path[STR_BUFSIZE * 4];
+    if (!lut_default_path(path, sizeof(path))) { fprintf(stream, "lut:    no cache path\n"); return; }
+    fprintf(stream, "lut:    %s (%s)\n", path, lut_ready() ? "loaded" : "missing or stale");
+}
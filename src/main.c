@@ -5,11 +5,20 @@
 #include <string.h>
 #include <time.h>
 
+#include "batch.h"
 #include "cli.h"
+#include "composite.h"
+#include "contrast.h"
 #include "converter.h"
+#include "cube.h"
+#include "gradient.h"
+#include "image.h"
+#include "matrix.h"
+#include "palette.h"
 #include "parser.h"
 #include "printer.h"
 #include "utility.h"
+#include "yuv.h"
 
 const char* pangrams[] = {
     "Sphinx of black quartz, judge my vow",
@@ -33,6 +42,17 @@ int main(int argc, char **argv) {
 
     parse_cli_args(argc, argv, progname, &opts, &color, &colorD, &colorC, &color_set);
 
+    // modes which don't work on a single color
+    if (opts.batch)                return run_batch(&opts, progname);
+    if (opts.gradient)             return run_gradient(&opts, progname);
+    if (opts.matrix)               return run_matrix(&opts, progname);
+    if (opts.fix || opts.fixbatch) return run_fix_contrast(&opts, progname);
+    if (opts.cmatrix)              return run_contrast_matrix(&opts, progname);
+    if (opts.image)                return run_image(&opts, progname);
+    if (opts.makelut)              return run_make_lut(&opts, progname);
+    if (opts.yuv || opts.toyuv)    return run_yuv(&opts, progname);
+    if (opts.extract)              return run_extract(&opts, progname);
+
     // require a main color unless it was already provided
     if (!color_set) ERROR_EXIT("invalid syntax, color must be specified");
 
@@ -79,64 +99,94 @@ int main(int argc, char **argv) {
     
     // compute and show color difference
     if (opts.distance) {
-        double d_rgb2   = (opts.cdiff == CDIFF_RGB   || opts.cdiff == CDIFF_ALL) ? dist2_rgb(&color.rgb, &colorD.rgb)                         : 0.0;
-        double d_wrgb2  = (opts.cdiff == CDIFF_WRGB  || opts.cdiff == CDIFF_ALL) ? weighted_dist2_rgb(&color.rgb, &colorD.rgb, W_R, W_G, W_B) : 0.0;
-        double d_oklab2 = (opts.cdiff == CDIFF_OKLAB || opts.cdiff == CDIFF_ALL) ? dist2_oklab(&color.oklab, &colorD.oklab)                   : 0.0;
+        lab_t lab  = rgb_to_lab(&color.rgb);
+        lab_t labD = rgb_to_lab(&colorD.rgb);
+
+        // every metric with its label, squared distances first, then the cielab color differences
+        struct { cdiff_t metric; const char *label; double d; } dists[] = {
+            { CDIFF_RGB,    "RGB (Squared) ", dist2_rgb(&color.rgb, &colorD.rgb)                         },
+            { CDIFF_WRGB,   "RGB (Weighted)", weighted_dist2_rgb(&color.rgb, &colorD.rgb, W_R, W_G, W_B) },
+            { CDIFF_OKLAB,  "Oklab         ", dist2_oklab(&color.oklab, &colorD.oklab)                   },
+            { CDIFF_DE76,   "CIE76         ", delta_e(CDIFF_DE76,   &lab, &labD)                         },
+            { CDIFF_DE94,   "CIE94         ", delta_e(CDIFF_DE94,   &lab, &labD)                         },
+            { CDIFF_DE2000, "CIEDE2000     ", delta_e(CDIFF_DE2000, &lab, &labD)                         },
+            { CDIFF_CMC,    "CMC (2:1)     ", delta_e(CDIFF_CMC,    &lab, &labD)                         },
+        };
 
         if (opts.json) {
             printf("  \"distance\": { ");
-            if      (opts.cdiff == CDIFF_RGB)   { printf("\"rgb2\": %.*f ", opts.dplaces, d_rgb2); }
-            else if (opts.cdiff == CDIFF_WRGB)  { printf("\"wrgb2\": %.*f ", opts.dplaces, d_wrgb2); }
-            else if (opts.cdiff == CDIFF_OKLAB) { printf("\"oklab2\": %.*f ", opts.dplaces, d_oklab2); }
-            else                                { printf("\"rgb2\": %.*f, \"wrgb2\": %.*f, \"oklab2\": %.*f ", opts.dplaces, d_rgb2, opts.dplaces, d_wrgb2, opts.dplaces, d_oklab2); }
-            printf("}%s\n", (opts.contrast ? "," : ""));
+            bool first = true;
+            for (size_t i = 0; i < sizeof(dists) / sizeof(dists[0]); ++i) {
+                if (opts.cdiff != CDIFF_ALL && opts.cdiff != dists[i].metric) continue;
+                printf("%s\"%s\": %.*f", first ? "" : ", ", cdiff_key(dists[i].metric), opts.dplaces, dists[i].d);
+                first = false;
+            }
+            printf(" }%s\n", (opts.contrast ? "," : ""));
         } else {
             const char *reset_tail = (opts.mapping == TC_NONE) ? "" : reset_default;
             printf("\nDistance between %s %s %s%06x%s and %s %s %s%06x%s:\n",
                    bgbuf,  reset_tail, fgbuf,  color.hex,  reset_tail,
                    bgbufD, reset_tail, fgbufD, colorD.hex, reset_tail);
 
-            if (opts.cdiff == CDIFF_RGB   || opts.cdiff == CDIFF_ALL) { printf("RGB (Squared) : %.*f\n", opts.dplaces, d_rgb2); }
-            if (opts.cdiff == CDIFF_WRGB  || opts.cdiff == CDIFF_ALL) { printf("RGB (Weighted): %.*f\n", opts.dplaces, d_wrgb2); }
-            if (opts.cdiff == CDIFF_OKLAB || opts.cdiff == CDIFF_ALL) { printf("Oklab         : %.*f\n", opts.dplaces, d_oklab2); }
+            for (size_t i = 0; i < sizeof(dists) / sizeof(dists[0]); ++i) {
+                if (opts.cdiff == CDIFF_ALL || opts.cdiff == dists[i].metric) printf("%s: %.*f\n", dists[i].label, opts.dplaces, dists[i].d);
+            }
         }
     }
 
     // compute and show contrast between two colors, alternating as foreground and background colors
     if (opts.contrast) {
-        double LA = relative_luminance_rgb(&color.rgb);
-        double LB = relative_luminance_rgb(&colorC.rgb);
-        double lighter = (LA > LB) ? LA : LB;
-        double darker  = (LA > LB) ? LB : LA;
-        double ratio   = (lighter + 0.05) / (darker + 0.05);
+        // translucent colors are measured as seen: the main color is the background (composited over --over, white by
+        // default), the contrast color the text on it (composited over that background)
+        bool  flat = color.alpha < 1.0 || colorC.alpha < 1.0;
+        rgb_t back = color.rgb, text = colorC.rgb;
+        if (color.alpha < 1.0)  { rgb_t over = hex_to_rgb(opts.over); back = composite_over(&color.rgb, color.alpha, &over, opts.blend, opts.blendlinear); }
+        if (colorC.alpha < 1.0) text = composite_over(&colorC.rgb, colorC.alpha, &back, opts.blend, opts.blendlinear);
+
+        double LA = relative_luminance_rgb(&back);
+        double LB = relative_luminance_rgb(&text);
+        double ratio = contrast_ratio(LA, LB);
+
+        // apca depends on polarity: the contrast color as text on the main color (first preview line) and the reverse
+        double lc     = apca_contrast(&text, &back);
+        double lc_rev = apca_contrast(&back, &text);
 
-        bool pass_AA       = (ratio >= 4.5);
-        bool pass_AA_large = (ratio >= 3.0);
-        bool pass_AAA      = (ratio >= 7.0);
+        bool pass_AA       = (ratio >= WCAG_AA);
+        bool pass_AA_large = (ratio >= WCAG_AA_LARGE);
+        bool pass_AAA      = (ratio >= WCAG_AAA);
 
         srand(time(NULL)); // random pangram
         int rn = rand() % pangrams_size;
 
         if (opts.json) {
-            printf("  \"contrast\": { \"ratio\": %.*f, \"AA\": %s, \"AA_large\": %s, \"AAA\": %s }\n", opts.dplaces, ratio, pass_AA ? "true" : "false", pass_AA_large ? "true" : "false", pass_AAA ? "true" : "false");
+            printf("  \"contrast\": { \"ratio\": %.*f, \"AA\": %s, \"AA_large\": %s, \"AAA\": %s, \"apca\": { \"Lc\": %.*f, \"Lc_reverse\": %.*f }", opts.dplaces, ratio, pass_AA ? "true" : "false", pass_AA_large ? "true" : "false", pass_AAA ? "true" : "false", opts.dplaces, lc, opts.dplaces, lc_rev);
+            if (flat) printf(", \"composited\": { \"fg\": \"#%06x\", \"bg\": \"#%06x\" }", rgb_to_hex(&text), rgb_to_hex(&back));
+            printf(" }\n");
         } else {
             const char *reset_tail = (opts.mapping == TC_NONE) ? "" : reset_default;
             printf("\nContrast between %s %s %s%06x%s and %s %s %s%06x%s:\n",
                    bgbuf,  reset_tail, fgbuf,  color.hex,  reset_tail,
                    bgbufC, reset_tail, fgbufC, colorC.hex, reset_tail);
 
+            // the samples show the composited colors
             if (opts.mapping != TC_NONE) {
-                printf("%s%s  %s  %s\n", bgbuf, fgbufC, pangrams[rn], reset_default);
-                printf("%s%s  %s  %s\n", bgbufC, fgbuf, pangrams[rn], reset_default);
+                char backbg[C_STR_BUFSIZE], backfg[C_STR_BUFSIZE], textbg[C_STR_BUFSIZE], textfg[C_STR_BUFSIZE];
+                map_rgb_to_sgr_strings(opts.mapping, &back, backbg, sizeof(backbg), backfg, sizeof(backfg));
+                map_rgb_to_sgr_strings(opts.mapping, &text, textbg, sizeof(textbg), textfg, sizeof(textfg));
+                printf("%s%s  %s  %s\n", backbg, textfg, pangrams[rn], reset_default);
+                printf("%s%s  %s  %s\n", textbg, backfg, pangrams[rn], reset_default);
             }
+            if (flat) printf("Composited      : #%06x on #%06x (%s, %s)\n", rgb_to_hex(&text), rgb_to_hex(&back), blend_name(opts.blend), opts.blendlinear ? "linear" : "gamma");
             printf("Contrast ratio: %.*f\n", opts.dplaces, ratio);
             printf("WCAG AA (normal): %s\n", pass_AA ? "PASS" : "FAIL");
             printf("WCAG AA (large) : %s\n", pass_AA_large ? "PASS" : "FAIL");
             printf("WCAG AAA        : %s\n", pass_AAA ? "PASS" : "FAIL");
+            printf("APCA Lc         : %.*f (reversed: %.*f)\n", opts.dplaces, lc, opts.dplaces, lc_rev);
         }
     }
 
     if (opts.json) printf("}\n");
 
+    print_gamut_warning(stderr, gamut_count(), get_gamut());
     return 0;
 }
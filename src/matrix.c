@@ -0,0 +1,192 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "cvd.h"
+#include "kernels.h"
+#include "matrix.h"
+#include "printer.h"
+#include "store.h"
+
+// tile size: 32 query rows against 2048 columns (3 * 8 KiB of column data plus 32 * 8 KiB of output, l2-sized)
+#define MATRIX_TILE_ROWS 32
+#define MATRIX_TILE_COLS 2048
+
+static bool is_delta_e(cdiff_t metric) {
+    return metric == CDIFF_DE76 || metric == CDIFF_DE94 || metric == CDIFF_DE2000 || metric == CDIFF_CMC;
+}
+
+// rows i0..i1-1 against the columns j0..j1-1, row i written to out + (i - r0) * n
+static void matrix_tile(cdiff_t metric, const float *x, const float *y, const float *z, size_t n,
+                        size_t i0, size_t i1, size_t j0, size_t j1, size_t r0, float *out) {
+    if (is_delta_e(metric)) {
+        for (size_t i = i0; i < i1; ++i) delta_e_f32(metric, x + j0, y + j0, z + j0, j1 - j0, x[i], y[i], z[i], out + (i - r0) * n + j0);
+        return;
+    }
+
+    float wx = 1.0f, wy = 1.0f, wz = 1.0f;
+    if (metric == CDIFF_WRGB) { wx = (float)W_R; wy = (float)W_G; wz = (float)W_B; }
+    wdist2_block_f32(x + i0, y + i0, z + i0, i1 - i0, x + j0, y + j0, z + j0, j1 - j0, wx, wy, wz, out + (i0 - r0) * n + j0, n);
+}
+
+void matrix_rows(cdiff_t metric, const float *x, const float *y, const float *z, size_t n,
+                 size_t r0, size_t r1, bool upper, float *out) {
+    size_t nrt = (r1 - r0 + MATRIX_TILE_ROWS - 1) / MATRIX_TILE_ROWS;
+    size_t nct = (n + MATRIX_TILE_COLS - 1) / MATRIX_TILE_COLS;
+
+    #pragma omp parallel for collapse(2) schedule(dynamic)
+    for (size_t rt = 0; rt < nrt; ++rt) {
+        for (size_t ct = 0; ct < nct; ++ct) {
+            size_t i0 = r0 + rt * MATRIX_TILE_ROWS, i1 = MIN(i0 + MATRIX_TILE_ROWS, r1);
+            size_t j0 = ct * MATRIX_TILE_COLS,      j1 = MIN(j0 + MATRIX_TILE_COLS, n);
+
+            if (!upper) { matrix_tile(metric, x, y, z, n, i0, i1, j0, j1, r0, out); continue; }
+
+            // upper triangle: tiles left of the diagonal are skipped, tiles crossing it start every row right after it
+            if (j1 <= i0 + 1) continue;
+            for (size_t i = i0; i < i1; ++i) {
+                size_t js = MAX(j0, i + 1);
+                if (js < j1) matrix_tile(metric, x, y, z, n, i, i + 1, js, j1, r0, out);
+            }
+        }
+    }
+}
+
+// dense output of one band, first / last mark the start and end of the whole matrix
+static void print_dense_band(const float *band, size_t n, size_t r0, size_t r1, const prog_opts_t *opts, bool first, bool last) {
+    if (first && opts->format == FORMAT_C) {
+        if (opts->upper) printf("static const float distances[%zu] = {\n", n * (n - 1) / 2);
+        else             printf("static const float distances[%zu][%zu] = {\n", n, n);
+    }
+    if (first && opts->format == FORMAT_JSON) printf("[\n");
+
+    for (size_t i = r0; i < r1; ++i) {
+        const float *row = band + (i - r0) * n;
+        size_t       j0  = opts->upper ? i + 1 : 0;
+
+        if (opts->format == FORMAT_BIN) { fwrite(row + j0, sizeof(float), n - j0, stdout); continue; }
+        if (opts->upper && j0 == n) continue; // last row of the triangle is empty
+
+        const char *open  = (opts->format == FORMAT_JSON) ? "  [ " : (opts->format == FORMAT_C && !opts->upper) ? "    { " : (opts->format == FORMAT_C) ? "    " : "";
+        const char *close = (opts->format == FORMAT_JSON) ? " ]"   : (opts->format == FORMAT_C && !opts->upper) ? " }"   : "";
+        const char *sep   = (opts->format == FORMAT_TEXT || opts->format == FORMAT_CSV) ? "," : ", ";
+
+        printf("%s", open);
+        for (size_t j = j0; j < n; ++j) printf("%s%.*f%s", (j > j0) ? sep : "", opts->dplaces, row[j], (opts->format == FORMAT_C) ? "f" : "");
+
+        bool more = i + 1 < (opts->upper ? n - 1 : n);
+        printf("%s%s\n", close, (more && (opts->format == FORMAT_JSON || opts->format == FORMAT_C)) ? "," : "");
+    }
+
+    if (last && opts->format == FORMAT_C)    printf("};\n");
+    if (last && opts->format == FORMAT_JSON) printf("]\n");
+}
+
+// sparse output: pairs i < j of one band closer than eps, *count is the number of pairs printed so far
+// with orig (the band of the unsimulated colors under --cvd) only pairs at least eps apart there are kept, and both distances printed
+static void print_sparse_band(const float *band, const float *orig, const uint32_t *rgb, size_t n, size_t r0, size_t r1, const prog_opts_t *opts, bool first, bool last, size_t *count) {
+    if (first && opts->format == FORMAT_JSON) printf("[");
+    if (first && opts->format == FORMAT_C)    printf("static const struct { unsigned i, j; float d%s; } pairs[] = {\n", orig ? ", d_orig" : "");
+    if (first && (opts->format == FORMAT_TEXT || opts->format == FORMAT_CSV)) printf("i,j,hex_i,hex_j,dist%s\n", orig ? ",dist_orig" : "");
+
+    float eps = (float)opts->epsilon;
+    for (size_t i = r0; i < r1; ++i) {
+        const float *row  = band + (i - r0) * n;
+        const float *orow = orig ? orig + (i - r0) * n : NULL;
+        for (size_t j = i + 1; j < n; ++j) {
+            if (!(row[j] < eps) || (orow && orow[j] < eps)) continue;
+
+            if (opts->format == FORMAT_BIN) {
+                struct { uint32_t i, j; float d, d_orig; } rec = { (uint32_t)i, (uint32_t)j, row[j], orow ? orow[j] : 0.0f };
+                fwrite(&rec, orig ? sizeof(rec) : sizeof(rec) - sizeof(float), 1, stdout); // d_orig only with --cvd
+            }
+            else if (opts->format == FORMAT_JSON) {
+                printf("%s\n  { \"i\": %zu, \"j\": %zu, \"dist\": %.*f", *count ? "," : "", i, j, opts->dplaces, row[j]);
+                if (orow) printf(", \"dist_orig\": %.*f", opts->dplaces, orow[j]);
+                printf(" }");
+            }
+            else if (opts->format == FORMAT_C) {
+                printf("    { %zu, %zu, %.*ff", i, j, opts->dplaces, row[j]);
+                if (orow) printf(", %.*ff", opts->dplaces, orow[j]);
+                printf(" },\n");
+            }
+            else {
+                printf("%zu,%zu,#%06x,#%06x,%.*f", i, j, rgb[i], rgb[j], opts->dplaces, row[j]);
+                if (orow) printf(",%.*f", opts->dplaces, orow[j]);
+                printf("\n");
+            }
+            ++*count;
+        }
+    }
+
+    if (last && opts->format == FORMAT_JSON) printf("%s]\n", *count ? "\n" : "");
+    if (last && opts->format == FORMAT_C)    printf("};\n");
+}
+
+// three float columns of the metric (rgb, cielab or oklab) for n packed colors
+static void matrix_columns(cdiff_t metric, const uint32_t *rgb, size_t n, float *x, float *y, float *z) {
+    if      (metric == CDIFF_OKLAB) rgb8_to_oklab_f32(rgb, n, x, y, z);
+    else if (is_delta_e(metric))    rgb8_to_lab_f32(rgb, n, x, y, z);
+    else for (size_t i = 0; i < n; ++i) { x[i] = (rgb[i] >> 16) & 0xFF; y[i] = (rgb[i] >> 8) & 0xFF; z[i] = rgb[i] & 0xFF; }
+}
+
+int run_matrix(const prog_opts_t *opts, const char *progname) {
+    // de94 and cmc weigh the difference by the chroma / hue of the reference (row i), d(i, j) and d(j, i) differ and a
+    // triangle would only hold one of them
+    bool asym = opts->cdiff == CDIFF_DE94 || opts->cdiff == CDIFF_CMC;
+    if (asym && (opts->upper || opts->epsilon >= 0.0)) ERROR_EXIT("--upper and --epsilon need a symmetric -D metric, de94 and cmc only give the full matrix");
+
+    FILE *f = (strcmp(opts->matrix, "-") == 0) ? stdin : fopen(opts->matrix, "r");
+    if (!f) ERROR_EXIT("could not open matrix input %s", opts->matrix);
+
+    color_store_t store;
+    store_init(&store);
+
+    size_t bad_line = 0;
+    long   n        = store_load(&store, f, &bad_line);
+    if (f != stdin) fclose(f);
+    if (n < 0 && bad_line) ERROR_EXIT("could not parse color in %s, line %zu", opts->matrix, bad_line);
+    if (n < 0)             ERROR_EXIT("out of memory while reading %s", opts->matrix);
+    store_flatten(&store, opts->over, opts->blend, opts->blendlinear);
+
+    // float columns of the chosen metric (rgb, cielab or oklab), "all" means oklab here
+    // with --cvd the matrix is that of the simulated colors, the sparse list also needs the original columns
+    size_t  sz     = store.size;
+    cdiff_t metric = (opts->cdiff == CDIFF_ALL) ? CDIFF_OKLAB : opts->cdiff;
+    bool    sparse = opts->epsilon >= 0.0;
+    bool    cvd    = opts->cvd != CVD_NONE;
+    size_t  nsets  = (cvd && sparse) ? 2 : 1;
+
+    // c has no zero-length arrays, the triangle needs two colors and the full matrix one
+    size_t cmin = opts->upper ? 2 : 1;
+    if (opts->format == FORMAT_C && !sparse && sz < cmin) ERROR_EXIT("c output %sneeds at least %zu color(s), %s has %zu", opts->upper ? "with --upper " : "", cmin, opts->matrix, sz);
+
+    float    *cols = malloc(3 * nsets * (sz ? sz : 1) * sizeof(float));
+    uint32_t *sim  = cvd ? malloc((sz ? sz : 1) * sizeof(uint32_t)) : NULL;
+    if (!cols || (cvd && !sim)) ERROR_EXIT("out of memory while reading %s", opts->matrix);
+    float *x = cols, *y = x + sz, *z = y + sz;
+    if (cvd) cvd_rgb8(opts->cvd, opts->severity, store.rgb, sz, sim);
+    matrix_columns(metric, cvd ? sim : store.rgb, sz, x, y, z);
+    if (nsets == 2) matrix_columns(metric, store.rgb, sz, z + sz, z + 2 * sz, z + 3 * sz);
+
+    // bands of rows are computed in parallel tiles and written before the next one, so memory stays bounded
+    float *band = malloc(nsets * MATRIX_BAND_ROWS * (sz ? sz : 1) * sizeof(float));
+    if (!band) ERROR_EXIT("out of memory for %zu colors", sz);
+    float *orig = (nsets == 2) ? band + MATRIX_BAND_ROWS * sz : NULL;
+
+    size_t count = 0;
+    for (size_t r0 = 0; r0 < sz || r0 == 0; r0 += MATRIX_BAND_ROWS) {
+        size_t r1 = MIN(r0 + MATRIX_BAND_ROWS, sz);
+        matrix_rows(metric, x, y, z, sz, r0, r1, sparse || opts->upper, band);
+        if (orig) matrix_rows(metric, z + sz, z + 2 * sz, z + 3 * sz, sz, r0, r1, true, orig);
+
+        if (sparse) print_sparse_band(band, orig, store.rgb, sz, r0, r1, opts, r0 == 0, r1 == sz, &count);
+        else        print_dense_band(band, sz, r0, r1, opts, r0 == 0, r1 == sz);
+        if (sz == 0) break;
+    }
+
+    free(band);
+    free(sim);
+    free(cols);
+    store_free(&store);
+    return 0;
+}
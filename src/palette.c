@@ -0,0 +1,574 @@
+#include <math.h>
+#include <omp.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "batch.h"
+#include "converter.h"
+#include "image.h"
+#include "kernels.h"
+#include "palette.h"
+#include "parser.h"
+#include "printer.h"
+#include "utility.h"
+
+static const char *extract_names[] = { "kmeans", "median-cut", "octree" };
+
+const char *extract_name(extract_t method) { return (method >= 0 && method < (int)ARRAY_LENGTH(extract_names)) ? extract_names[method] : NULLSTR; }
+
+bool extract_from_name(const char *name, extract_t *method) {
+    for (size_t i = 0; i < ARRAY_LENGTH(extract_names); ++i) {
+        if (strcasecmp_own(name, extract_names[i])) { *method = (extract_t)i; return true; }
+    }
+    return false;
+}
+
+// splitmix64, uniform in [0,1)
+static double next_uniform(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (double)((z ^ (z >> 31)) >> 11) * 0x1.0p-53;
+}
+
+// index i drawn with probability w[i] * d[i] / total (w[i] / total without d)
+static size_t pick_weighted(const double *w, const float *d, size_t n, double total, double u) {
+    double t = u * total, acc = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        acc += d ? w[i] * d[i] : w[i];
+        if (acc > t) return i;
+    }
+
+    // rounding may leave t just above the last sum
+    for (size_t i = n; i-- > 0;) if ((d ? w[i] * d[i] : w[i]) > 0.0) return i;
+    return 0;
+}
+
+// d[i] = min(d[i], squared distance to (cL, ca, cb)) with tmp as scratch, returns the weighted sum of d
+static double nearest_update(const float *L, const float *a, const float *b, const double *w, size_t n,
+                             float cL, float ca, float cb, float *d, float *tmp) {
+    double sum = 0.0;
+
+    #pragma omp parallel for schedule(static) reduction(+:sum) if (n > PALETTE_CHUNK)
+    for (size_t i = 0; i < n; i += PALETTE_CHUNK) {
+        size_t len = MIN((size_t)PALETTE_CHUNK, n - i);
+        dist2_3_f32(L + i, a + i, b + i, len, cL, ca, cb, tmp + i);
+        for (size_t j = i; j < i + len; ++j) { d[j] = MIN(d[j], tmp[j]); sum += w[j] * d[j]; }
+    }
+    return sum;
+}
+
+// move the colors with weight to the front, returns their number
+static size_t palette_compact(float *pL, float *pa, float *pb, double *pw, size_t k) {
+    size_t m = 0;
+    for (size_t c = 0; c < k; ++c) {
+        if (pw[c] <= 0.0) continue;
+        pL[m] = pL[c]; pa[m] = pa[c]; pb[m] = pb[c]; pw[m] = pw[c];
+        ++m;
+    }
+    return m;
+}
+
+size_t palette_kmeans(const float *L, const float *a, const float *b, const double *w, size_t n, size_t k,
+                      float *pL, float *pa, float *pb, double *pw) {
+    k = MIN(k, n);
+    if (k == 0) return 0;
+
+    float    *d   = malloc(n * sizeof(float));
+    float    *tmp = malloc(n * sizeof(float));
+    uint16_t *idx = malloc(n * sizeof(uint16_t));
+    double   *acc = malloc(4 * k * sizeof(double));
+    if (!d || !tmp || !idx || !acc) { free(d); free(tmp); free(idx); free(acc); return 0; }
+
+    // k-means++: the first center by weight, every further one by weight times the squared distance to the closest center
+    uint64_t rng   = 0x636F6C6F72ull;
+    double   total = 0.0;
+    for (size_t i = 0; i < n; ++i) { total += w[i]; d[i] = INFINITY; }
+
+    size_t first = pick_weighted(w, NULL, n, total, next_uniform(&rng)), m = 1;
+    pL[0] = L[first]; pa[0] = a[first]; pb[0] = b[first];
+    double dsum = nearest_update(L, a, b, w, n, pL[0], pa[0], pb[0], d, tmp);
+
+    // all points sit on a center once the sum is 0, there are fewer distinct points than k then
+    for (; m < k && dsum > 0.0; ++m) {
+        size_t next = pick_weighted(w, d, n, dsum, next_uniform(&rng));
+        pL[m] = L[next]; pa[m] = a[next]; pb[m] = b[next];
+        dsum = nearest_update(L, a, b, w, n, pL[m], pa[m], pb[m], d, tmp);
+    }
+    k = m;
+
+    // lloyd iterations, each thread sums weight and weighted oklab of its points per center into a private copy of acc
+    for (int iter = 0; iter < KMEANS_MAX_ITER; ++iter) {
+        memset(acc, 0, 4 * k * sizeof(double));
+
+        #pragma omp parallel for schedule(static) reduction(+:acc[:4 * k]) if (n > PALETTE_CHUNK)
+        for (size_t i = 0; i < n; i += PALETTE_CHUNK) {
+            size_t len = MIN((size_t)PALETTE_CHUNK, n - i);
+            assign3_f32(L + i, a + i, b + i, len, pL, pa, pb, k, idx + i, NULL);
+            for (size_t j = i; j < i + len; ++j) {
+                double *c = acc + 4 * idx[j];
+                c[0] += w[j]; c[1] += w[j] * L[j]; c[2] += w[j] * a[j]; c[3] += w[j] * b[j];
+            }
+        }
+
+        // empty clusters keep their center and are dropped at the end
+        double moved = 0.0;
+        for (size_t c = 0; c < k; ++c) {
+            pw[c] = acc[4 * c];
+            if (pw[c] <= 0.0) continue;
+
+            float nL = (float)(acc[4 * c + 1] / pw[c]), na = (float)(acc[4 * c + 2] / pw[c]), nb = (float)(acc[4 * c + 3] / pw[c]);
+            float dL = nL - pL[c], da = na - pa[c], db = nb - pb[c];
+            moved = MAX(moved, (double)(dL * dL + da * da + db * db));
+            pL[c] = nL; pa[c] = na; pb[c] = nb;
+        }
+        if (moved < KMEANS_EPS * KMEANS_EPS) break;
+    }
+
+    free(d);
+    free(tmp);
+    free(idx);
+    free(acc);
+    return palette_compact(pL, pa, pb, pw, k);
+}
+
+// median cut works on an array of points that is reordered in place, key is the coordinate a range is sorted by
+typedef struct { float v[3], key; double w; } mc_point_t;
+typedef struct { size_t lo, hi; double w, err, mean[3]; int axis; } mc_box_t;
+
+static int cmp_mc_point(const void *x, const void *y) {
+    float u = ((const mc_point_t *)x)->key, v = ((const mc_point_t *)y)->key;
+    return (u > v) - (u < v);
+}
+
+// weight, mean, weighted squared error and the axis of largest variance of the points in [lo, hi)
+static void mc_stats(const mc_point_t *p, mc_box_t *box) {
+    double s[3] = { 0.0 }, q[3] = { 0.0 }, w = 0.0;
+    for (size_t i = box->lo; i < box->hi; ++i) {
+        w += p[i].w;
+        for (int k = 0; k < 3; ++k) { s[k] += p[i].w * p[i].v[k]; q[k] += p[i].w * p[i].v[k] * p[i].v[k]; }
+    }
+
+    box->w    = w;
+    box->err  = 0.0;
+    box->axis = 0;
+    double best = -1.0;
+    for (int k = 0; k < 3; ++k) {
+        double var = (w > 0.0) ? MAX(q[k] - s[k] * s[k] / w, 0.0) : 0.0;
+        box->mean[k] = (w > 0.0) ? s[k] / w : 0.0;
+        box->err    += var;
+        if (var > best) { best = var; box->axis = k; }
+    }
+}
+
+size_t palette_median_cut(const float *L, const float *a, const float *b, const double *w, size_t n, size_t k,
+                          float *pL, float *pa, float *pb, double *pw) {
+    k = MIN(k, n);
+    if (k == 0) return 0;
+
+    mc_point_t *p   = malloc(n * sizeof(mc_point_t));
+    mc_box_t   *box = malloc(k * sizeof(mc_box_t));
+    if (!p || !box) { free(p); free(box); return 0; }
+
+    for (size_t i = 0; i < n; ++i) p[i] = (mc_point_t){ .v = { L[i], a[i], b[i] }, .w = w[i] };
+    box[0] = (mc_box_t){ .lo = 0, .hi = n };
+    mc_stats(p, &box[0]);
+
+    size_t m = 1;
+    while (m < k) {
+        // the box with the largest error that can still be split
+        size_t s   = m;
+        double err = 0.0;
+        for (size_t i = 0; i < m; ++i) if (box[i].hi - box[i].lo >= 2 && box[i].err > err) { err = box[i].err; s = i; }
+        if (s == m) break;
+
+        mc_box_t *bx = &box[s];
+        for (size_t i = bx->lo; i < bx->hi; ++i) p[i].key = p[i].v[bx->axis];
+        qsort(p + bx->lo, bx->hi - bx->lo, sizeof(mc_point_t), cmp_mc_point);
+
+        // first point past half of the weight, both halves keep at least one point
+        size_t cut  = bx->lo;
+        double half = 0.5 * bx->w, acc = 0.0;
+        while (cut < bx->hi && acc + p[cut].w <= half) acc += p[cut++].w;
+        cut = CLAMP(cut, bx->lo + 1, bx->hi - 1);
+
+        box[m] = (mc_box_t){ .lo = cut, .hi = bx->hi };
+        bx->hi = cut;
+        mc_stats(p, bx);
+        mc_stats(p, &box[m]);
+        ++m;
+    }
+
+    for (size_t i = 0; i < m; ++i) {
+        pL[i] = (float)box[i].mean[0]; pa[i] = (float)box[i].mean[1]; pb[i] = (float)box[i].mean[2];
+        pw[i] = box[i].w;
+    }
+
+    free(p);
+    free(box);
+    return palette_compact(pL, pa, pb, pw, m);
+}
+
+// octree nodes live in a fixed pool, freed ones are linked into a free list
+typedef struct {
+    double   sum[3];   // oklab sums of the pixels of a leaf
+    uint64_t n;        // pixels of a leaf
+    int32_t  child[8]; // -1 if absent
+    int32_t  next;     // next free node
+    bool     leaf;
+} octnode_t;
+
+typedef struct { double cost; int32_t node; } octcand_t;
+
+struct octree {
+    octnode_t *node;
+    octcand_t *cand;            // scratch of octree_reduce
+    int32_t   *stack;           // scratch of the tree walks
+    int32_t   *cell;            // leaf of every cell of the deepest level, -1 if not looked up since the last reduction
+    int32_t    cap, used, free; // pool size, nodes handed out so far, head of the free list (-1 if empty)
+    size_t     leaves;
+};
+
+// cells per axis, and the oklab box they divide: lightness 0..1, a and b within +-OCTREE_AB (beyond srgb and display p3)
+#define OCTREE_SIDE (1 << OCTREE_DEPTH)
+#define OCTREE_AB   0.4f
+
+static int32_t octree_node(octree_t *t, int level) {
+    int32_t i = (t->free >= 0) ? t->free : t->used++;
+    if (t->free >= 0) t->free = t->node[i].next;
+
+    t->node[i] = (octnode_t){ .child = { -1, -1, -1, -1, -1, -1, -1, -1 }, .next = -1, .leaf = level == OCTREE_DEPTH };
+    t->leaves += t->node[i].leaf;
+    return i;
+}
+
+octree_t *octree_new() {
+    octree_t *t = calloc(1, sizeof(octree_t));
+    if (!t) return NULL;
+
+    // every leaf has at most one inner node per level above it, streaming exceeds the budget by one leaf at most
+    t->cap   = (OCTREE_LEAVES + 1) * (OCTREE_DEPTH + 1) + 1;
+    t->node  = malloc(t->cap * sizeof(octnode_t));
+    t->cand  = malloc(t->cap * sizeof(octcand_t));
+    t->stack = malloc(t->cap * sizeof(int32_t));
+    t->cell  = malloc((size_t)OCTREE_SIDE * OCTREE_SIDE * OCTREE_SIDE * sizeof(int32_t));
+    if (!t->node || !t->cand || !t->stack || !t->cell) { octree_free(t); return NULL; }
+
+    t->free = -1;
+    memset(t->cell, 0xFF, (size_t)OCTREE_SIDE * OCTREE_SIDE * OCTREE_SIDE * sizeof(int32_t));
+    octree_node(t, 0);
+    return t;
+}
+
+void octree_free(octree_t *t) {
+    if (!t) return;
+    free(t->node);
+    free(t->cand);
+    free(t->stack);
+    free(t->cell);
+    free(t);
+}
+
+// cell of an oklab color, OCTREE_DEPTH bits per axis (l, a, b from high to low)
+static uint32_t octree_cell(float L, float a, float b) {
+    int qL = (int)(L * OCTREE_SIDE), qa = (int)((a + OCTREE_AB) * (OCTREE_SIDE / (2.0f * OCTREE_AB))), qb = (int)((b + OCTREE_AB) * (OCTREE_SIDE / (2.0f * OCTREE_AB)));
+    return ((uint32_t)CLAMP(qL, 0, OCTREE_SIDE - 1) << (2 * OCTREE_DEPTH)) | ((uint32_t)CLAMP(qa, 0, OCTREE_SIDE - 1) << OCTREE_DEPTH) | (uint32_t)CLAMP(qb, 0, OCTREE_SIDE - 1);
+}
+
+// leaf of a cell, created on the way if needed
+static int32_t octree_leaf(octree_t *t, uint32_t cell) {
+    if (t->cell[cell] >= 0) return t->cell[cell];
+
+    int32_t cur = 0;
+    for (int l = 0; !t->node[cur].leaf; ++l) {
+        int sh = OCTREE_DEPTH - 1 - l;
+        int c  = (((cell >> (2 * OCTREE_DEPTH + sh)) & 1) << 2) | (((cell >> (OCTREE_DEPTH + sh)) & 1) << 1) | ((cell >> sh) & 1);
+        if (t->node[cur].child[c] < 0) { int32_t nx = octree_node(t, l + 1); t->node[cur].child[c] = nx; }
+        cur = t->node[cur].child[c];
+    }
+    return t->cell[cell] = cur;
+}
+
+static int cmp_octcand(const void *x, const void *y) {
+    const octcand_t *u = x, *v = y;
+    if (u->cost != v->cost) return (u->cost > v->cost) - (u->cost < v->cost);
+    return (u->node > v->node) - (u->node < v->node);
+}
+
+// merge leaves until at most target are left: every round collects the inner nodes whose children are all leaves, and
+// merges the cheaper half of them by the squared error the merge adds (ward), cheapest first
+// parents that only become mergeable on the way wait for the next round
+static void octree_reduce(octree_t *t, size_t target) {
+    while (t->leaves > target) {
+        size_t nc = 0, top = 0;
+        t->stack[top++] = 0;
+        while (top > 0) {
+            int32_t    i  = t->stack[--top];
+            octnode_t *nd = &t->node[i];
+            if (nd->leaf) continue;
+
+            bool     frontier = true;
+            double   s[3] = { 0.0 }, sq = 0.0;
+            uint64_t n = 0;
+            for (int c = 0; c < 8; ++c) {
+                int32_t ch = nd->child[c];
+                if (ch < 0) continue;
+                if (!t->node[ch].leaf) { frontier = false; t->stack[top++] = ch; continue; }
+
+                const octnode_t *l = &t->node[ch];
+                if (l->n) sq += (l->sum[0] * l->sum[0] + l->sum[1] * l->sum[1] + l->sum[2] * l->sum[2]) / l->n;
+                for (int k = 0; k < 3; ++k) s[k] += l->sum[k];
+                n += l->n;
+            }
+            if (frontier) t->cand[nc++] = (octcand_t){ .cost = n ? sq - (s[0] * s[0] + s[1] * s[1] + s[2] * s[2]) / n : 0.0, .node = i };
+        }
+        if (nc == 0) break; // the root is the only leaf
+        qsort(t->cand, nc, sizeof(octcand_t), cmp_octcand);
+
+        for (size_t r = 0; r < MAX(nc / 2, (size_t)1) && t->leaves > target; ++r) {
+            octnode_t *nd = &t->node[t->cand[r].node];
+            for (int c = 0; c < 8; ++c) {
+                int32_t ch = nd->child[c];
+                if (ch < 0) continue;
+                for (int k = 0; k < 3; ++k) nd->sum[k] += t->node[ch].sum[k];
+                nd->n            += t->node[ch].n;
+                t->node[ch].next  = t->free;
+                t->free           = ch;
+                nd->child[c]      = -1;
+                --t->leaves;
+            }
+            nd->leaf = true;
+            ++t->leaves;
+        }
+        memset(t->cell, 0xFF, (size_t)OCTREE_SIDE * OCTREE_SIDE * OCTREE_SIDE * sizeof(int32_t));
+    }
+}
+
+void octree_add(octree_t *t, const float *L, const float *a, const float *b, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        octnode_t *nd = &t->node[octree_leaf(t, octree_cell(L[i], a[i], b[i]))];
+        nd->sum[0] += L[i]; nd->sum[1] += a[i]; nd->sum[2] += b[i];
+        ++nd->n;
+
+        if (t->leaves > OCTREE_LEAVES) octree_reduce(t, OCTREE_LEAVES / 2);
+    }
+}
+
+// ward cost of merging two weighted means: the squared error the merge adds
+static double ward_cost(const float *L, const float *a, const float *b, const double *w, size_t i, size_t j) {
+    double dL = L[i] - L[j], da = a[i] - a[j], db = b[i] - b[j];
+    return w[i] * w[j] / (w[i] + w[j]) * (dL * dL + da * da + db * db);
+}
+
+// closest partner of i by ward cost
+static void ward_partner(const float *L, const float *a, const float *b, const double *w, size_t m, size_t i, size_t *nn, double *nc) {
+    nc[i] = INFINITY;
+    for (size_t j = 0; j < m; ++j) {
+        if (j == i) continue;
+        double c = ward_cost(L, a, b, w, i, j);
+        if (c < nc[i]) { nc[i] = c; nn[i] = j; }
+    }
+}
+
+// merge the cheapest pair of m weighted means until k are left, keeping the closest partner of every mean
+// only the means whose partner took part in a merge need a full search afterwards
+static size_t ward_merge(float *L, float *a, float *b, double *w, size_t m, size_t k) {
+    size_t *nn = malloc(m * sizeof(size_t));
+    double *nc = malloc(m * sizeof(double));
+    if (!nn || !nc) { free(nn); free(nc); return MIN(m, k); }
+
+    for (size_t i = 0; i < m; ++i) ward_partner(L, a, b, w, m, i, nn, nc);
+    while (m > MAX(k, (size_t)1)) {
+        size_t p = 0;
+        for (size_t i = 1; i < m; ++i) if (nc[i] < nc[p]) p = i;
+        size_t u = MIN(p, nn[p]), v = MAX(p, nn[p]), last = m - 1;
+
+        // v goes into u, the last mean takes the place of v
+        double ws = w[u] + w[v];
+        L[u] = (float)((w[u] * L[u] + w[v] * L[v]) / ws); a[u] = (float)((w[u] * a[u] + w[v] * a[v]) / ws); b[u] = (float)((w[u] * b[u] + w[v] * b[v]) / ws);
+        w[u] = ws;
+        L[v] = L[last]; a[v] = a[last]; b[v] = b[last]; w[v] = w[last]; nn[v] = nn[last]; nc[v] = nc[last];
+        --m;
+
+        for (size_t i = 0; i < m; ++i) {
+            if (nn[i] == last) nn[i] = v;
+            if (i == u || nn[i] == u || (nn[i] == v && last != v)) { ward_partner(L, a, b, w, m, i, nn, nc); continue; }
+
+            // the merged mean may now be closer than the old partner
+            double c = ward_cost(L, a, b, w, i, u);
+            if (c < nc[i]) { nc[i] = c; nn[i] = u; }
+        }
+    }
+
+    free(nn);
+    free(nc);
+    return m;
+}
+
+size_t octree_palette(octree_t *t, size_t k, float *pL, float *pa, float *pb, double *pw) {
+    k = MAX(k, (size_t)1);
+    octree_reduce(t, MIN(OCTREE_MERGE * k, (size_t)OCTREE_LEAVES));
+
+    size_t  cnt = MAX(t->leaves, (size_t)1);
+    float  *col = malloc(3 * cnt * sizeof(float));
+    double *w   = malloc(cnt * sizeof(double));
+    if (!col || !w) { free(col); free(w); return 0; }
+    float *L = col, *a = col + cnt, *b = col + 2 * cnt;
+
+    // depth-first walk over the leaves
+    size_t m = 0, top = 0;
+    t->stack[top++] = 0;
+    while (top > 0) {
+        octnode_t *nd = &t->node[t->stack[--top]];
+        if (!nd->leaf) { for (int c = 7; c >= 0; --c) if (nd->child[c] >= 0) t->stack[top++] = nd->child[c]; continue; }
+        if (nd->n == 0) continue;
+
+        L[m] = (float)(nd->sum[0] / nd->n); a[m] = (float)(nd->sum[1] / nd->n); b[m] = (float)(nd->sum[2] / nd->n);
+        w[m] = (double)nd->n;
+        ++m;
+    }
+
+    m = ward_merge(L, a, b, w, m, k);
+    memcpy(pL, L, m * sizeof(float)); memcpy(pa, a, m * sizeof(float)); memcpy(pb, b, m * sizeof(float));
+    memcpy(pw, w, m * sizeof(double));
+
+    free(col);
+    free(w);
+    return m;
+}
+
+// histogram bin of a packed color
+#define PALETTE_BINS (1u << (3 * PALETTE_BITS))
+static inline uint32_t palette_bin(uint32_t p) {
+    const int s = 8 - PALETTE_BITS;
+    return ((((p >> 16) & 0xFF) >> s) << (2 * PALETTE_BITS)) | ((((p >> 8) & 0xFF) >> s) << PALETTE_BITS) | ((p & 0xFF) >> s);
+}
+
+// one line / object / row per color
+static void extract_print(const uint32_t *rgb, const double *pw, size_t m, double total, const prog_opts_t *opts) {
+    if (opts->format == FORMAT_BIN || opts->format == FORMAT_C) { batch_print(rgb, m, opts); return; }
+
+    prog_opts_t o = *opts;
+    if (!o.conversion) o.conversion = "hex";
+
+    named_t names[PALETTE_MAX];
+    int     width = 0;
+    for (size_t i = 0; i < m; ++i) {
+        rgb_t c  = hex_to_rgb(rgb[i]);
+        names[i] = closest_named_weighted_rgb(&c);
+        width    = MAX(width, (int)strlen(names[i].name));
+    }
+
+    bool json = o.format == FORMAT_JSON, csv = o.format == FORMAT_CSV;
+    if (json) printf("[\n");
+    if (csv)  printf("index,hex,r,g,b,share,pixels,name\n");
+    for (size_t i = 0; i < m; ++i) {
+        rgb_t   c     = hex_to_rgb(rgb[i]);
+        double  share = (total > 0.0) ? pw[i] / total : 0.0;
+        color_t clr;
+        color_from_rgb(&c, &clr);
+
+        if (csv)       printf("%zu,#%06x,%d,%d,%d,%.*f,%.0f,%s\n", i, rgb[i], c.r, c.g, c.b, o.dplaces + 2, share, pw[i], names[i].name);
+        else if (json) {
+            printf("  { ");
+            print_conversion_json(&clr, &o);
+            printf(", \"share\": %.*f, \"pixels\": %.0f, \"name\": \"%s\" }%s\n", o.dplaces + 2, share, pw[i], names[i].name, (i + 1 < m) ? "," : "");
+        }
+        else { printf("%*.*f%%  %-*s  ", o.dplaces + 4, o.dplaces, 100.0 * share, width, names[i].name); print_conversion(&clr, &o); }
+    }
+    if (json) printf("]\n");
+}
+
+int run_extract(const prog_opts_t *opts, const char *progname) {
+    image_reader_t r;
+    image_open(&r, opts->extract, opts, progname);
+
+    size_t band = IMAGE_BAND_ROWS * r.w, k = (size_t)opts->ncolors, m = 0;
+    float  pL[PALETTE_MAX], pa[PALETTE_MAX], pb[PALETTE_MAX];
+    double pw[PALETTE_MAX];
+
+    if (opts->method == EXTRACT_OCTREE) {
+        // every band in oklab, converted in chunks over threads, then streamed into the tree
+        octree_t *t   = octree_new();
+        float    *lab = malloc(3 * band * sizeof(float));
+        if (!t || !lab) ERROR_EXIT("out of memory for an image of width %zu", r.w);
+
+        for (size_t n; (n = image_read_band(&r, progname)) > 0;) {
+            #pragma omp parallel for schedule(static) if (n > PALETTE_CHUNK)
+            for (size_t i = 0; i < n; i += PALETTE_CHUNK) rgb8_to_oklab_f32(r.px + i, MIN((size_t)PALETTE_CHUNK, n - i), lab + i, lab + band + i, lab + 2 * band + i);
+            octree_add(t, lab, lab + band, lab + 2 * band, n);
+        }
+        m = octree_palette(t, k, pL, pa, pb, pw);
+
+        octree_free(t);
+        free(lab);
+    }
+    else {
+        // pixel count and channel sums per bin, every thread sums its slice of a band into its own histogram (the
+        // updates land all over the table, so a shared one would need atomics), the first one takes the sum of all
+        size_t    parts = CLAMP((size_t)omp_get_max_threads(), 1, PALETTE_HISTS), hsz = 4 * (size_t)PALETTE_BINS;
+        uint64_t *hist  = calloc(parts * hsz, sizeof(uint64_t));
+        if (!hist) ERROR_EXIT("out of memory for the histogram of %s", opts->extract);
+
+        for (size_t n; (n = image_read_band(&r, progname)) > 0;) {
+            #pragma omp parallel for schedule(static) num_threads(parts) if (n > PALETTE_CHUNK)
+            for (size_t t = 0; t < parts; ++t) {
+                uint64_t *ht = hist + t * hsz;
+                for (size_t i = n * t / parts; i < n * (t + 1) / parts; ++i) {
+                    uint32_t  p = r.px[i];
+                    uint64_t *h = ht + 4 * (size_t)palette_bin(p);
+                    h[0] += 1; h[1] += (p >> 16) & 0xFF; h[2] += (p >> 8) & 0xFF; h[3] += p & 0xFF;
+                }
+            }
+        }
+
+        #pragma omp parallel for schedule(static) if (parts > 1)
+        for (size_t i = 0; i < hsz; ++i)
+            for (size_t t = 1; t < parts; ++t) hist[i] += hist[t * hsz + i];
+
+        // the occupied bins as points at the mean color of their pixels
+        size_t    n   = 0;
+        for (size_t i = 0; i < PALETTE_BINS; ++i) n += hist[4 * i] > 0;
+        uint32_t *rgb = malloc((n ? n : 1) * sizeof(uint32_t));
+        double   *w   = malloc((n ? n : 1) * sizeof(double));
+        float    *col = malloc(3 * (n ? n : 1) * sizeof(float));
+        if (!rgb || !w || !col) ERROR_EXIT("out of memory for the histogram of %s", opts->extract);
+
+        n = 0;
+        for (size_t i = 0; i < PALETTE_BINS; ++i) {
+            const uint64_t *h = hist + 4 * i;
+            if (!h[0]) continue;
+            uint32_t cr = (uint32_t)((h[1] + h[0] / 2) / h[0]), cg = (uint32_t)((h[2] + h[0] / 2) / h[0]), cb = (uint32_t)((h[3] + h[0] / 2) / h[0]);
+            rgb[n] = (cr << 16) | (cg << 8) | cb;
+            w[n++] = (double)h[0];
+        }
+        rgb8_to_oklab_f32(rgb, n, col, col + n, col + 2 * n);
+
+        if (opts->method == EXTRACT_MEDIAN_CUT) m = palette_median_cut(col, col + n, col + 2 * n, w, n, k, pL, pa, pb, pw);
+        else                                    m = palette_kmeans(col, col + n, col + 2 * n, w, n, k, pL, pa, pb, pw);
+        if (n > 0 && m == 0) ERROR_EXIT("out of memory while clustering %zu colors", n);
+
+        free(hist);
+        free(rgb);
+        free(w);
+        free(col);
+    }
+    image_close(&r);
+
+    // by decreasing share (insertion sort, stable), out-of-gamut means are clipped
+    for (size_t i = 1; i < m; ++i) {
+        float  l = pL[i], x = pa[i], y = pb[i];
+        double v = pw[i];
+        size_t j = i;
+        for (; j > 0 && pw[j - 1] < v; --j) { pL[j] = pL[j - 1]; pa[j] = pa[j - 1]; pb[j] = pb[j - 1]; pw[j] = pw[j - 1]; }
+        pL[j] = l; pa[j] = x; pb[j] = y; pw[j] = v;
+    }
+
+    uint32_t rgb[PALETTE_MAX];
+    double   total = 0.0;
+    oklab_to_rgb8_f32(pL, pa, pb, m, GAMUT_CLIP, rgb);
+    for (size_t i = 0; i < m; ++i) total += pw[i];
+
+    extract_print(rgb, pw, m, total, opts);
+    return 0;
+}
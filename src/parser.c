@@ -1,20 +1,62 @@
 #include <ctype.h>
+#include <limits.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "colorspace.h"
 #include "converter.h"
+#include "cvd.h"
+#include "kernels.h"
+#include "lut.h"
 #include "parser.h"
 #include "tables.h"
 #include "utility.h"
+#include "yuv.h"
 
 #define COPY_OR_RETURN(_dst,_src) do { int n = snprintf(_dst, sizeof(_dst), "%s", _src); if (n < 0) return 0; if ((size_t)n >= sizeof(_dst)) return 0; } while (0)
 #define IS_CONV(X)                ((conv) && strcasecmp_own(conv, (X)))
 
-// internal name array selection
-static const named_t *names    = css_colors;
-static       size_t names_size = css_colors_size;
+// internal name table selection
+static const named_table_t *names = &css_colors;
+
+// metric used to find the closest named color (CDIFF_ALL: weighted rgb)
+static cdiff_t named_metric = CDIFF_ALL;
+
+// structure-of-arrays copies of a name table for the search kernels, built on first use
+typedef struct {
+    atomic_bool ready;
+    int32_t    *r, *g, *b;    // 8-bit channels
+    float      *L, *A, *B;    // oklab
+    float      *cL, *cA, *cB; // cielab
+} name_soa_t;
+
+static name_soa_t css_soa, xkcd_soa;
+
+static const name_soa_t *get_soa(const named_table_t *tbl) {
+    name_soa_t *soa = (tbl == &xkcd_colors) ? &xkcd_soa : &css_soa;
+    if (once_ready(&soa->ready)) return soa;
+
+    #pragma omp critical(name_soa)
+    if (!once_ready(&soa->ready)) {
+        size_t n = tbl->size;
+        soa->r = malloc(n * sizeof(int32_t)); soa->g = malloc(n * sizeof(int32_t)); soa->b = malloc(n * sizeof(int32_t));
+        soa->L = malloc(n * sizeof(float));   soa->A = malloc(n * sizeof(float));   soa->B = malloc(n * sizeof(float));
+        soa->cL = malloc(n * sizeof(float));  soa->cA = malloc(n * sizeof(float));  soa->cB = malloc(n * sizeof(float));
+        if (!soa->r || !soa->g || !soa->b || !soa->L || !soa->A || !soa->B || !soa->cL || !soa->cA || !soa->cB) { fprintf(stderr, "error: out of memory\n"); exit(EXIT_FAILURE); }
+
+        for (size_t i = 0; i < n; ++i) {
+            rgb_t   rgb = hex_to_rgb(tbl->hex[i]);
+            oklab_t lab = rgb_to_oklab(&rgb);
+            soa->r[i] = rgb.r;        soa->g[i] = rgb.g;        soa->b[i] = rgb.b;
+            soa->L[i] = (float)lab.L; soa->A[i] = (float)lab.a; soa->B[i] = (float)lab.b;
+        }
+        rgb8_to_lab_f32(tbl->hex, n, soa->cL, soa->cA, soa->cB);
+        once_done(&soa->ready);
+    }
+    return soa;
+}
 
 // helper function to normalize string in-place by removing whitespaces and converting upper- to lowercase
 // the result is guaranteed to be shorter or equal in length to the input
@@ -35,58 +77,45 @@ static inline bool all_hexdigits(const char *ptr, size_t len) {
     return true;
 }
 
-// internal parsers: return 1 on success and set the out parameters out->{r,g,b}
+// internal parsers: return 1 on success and set the out parameters out->{r,g,b} and the other models, except out->named
+//                   (parse_color adds it, the closest named search being the costly part of parsing)
 //                   return 0 on failure
 // destructive!      parsers destroy input string, watch out!
 
 // NAMED: any valid named color (either css or xkcd)
 //
-// note: the "named" struct of the out parameter will still be the best approximation based on the current choice of colors
+// note: the "named" struct parse_color fills in will still be the best approximation based on the current choice of colors
 //       so, if we use css colors but input an xkcd color, we will still get the closest approximation to a named css color
 static inline int parse_named(char *s, color_t *out) {
     if (!s || !*s) return 0;
 
-    const named_t *other_names       = (names == css_colors) ? xkcd_colors      : css_colors;
-    size_t         other_names_size  = (names == css_colors) ? xkcd_colors_size : css_colors_size;
-    size_t         i;
-
-    // iterate through chosen color list first...
-    for(i = 0; i < names_size; ++i) {
-        if (strcmp(s, names[i].name) == 0) {
-            hex_t v    = names[i].hex;
-            out->hex   = v;
-            out->rgb   = hex_to_rgb(v);
-            out->cmyk  = rgb_to_cmyk(&out->rgb);
-            out->hsl   = rgb_to_hsl(&out->rgb);
-            out->hsv   = rgb_to_hsv(&out->rgb);
-            out->oklch = rgb_to_oklch(&out->rgb);
-            out->oklab = oklch_to_oklab(&out->oklch);
-            out->named = closest_named_weighted_rgb(&out->rgb);
-            return 1;
-        } 
-    }
-
-    // ...then check the next one...
-    for (i = 0; i < other_names_size; ++i) {
-        if (strcmp(s, other_names[i].name) == 0) {
-            hex_t v    = other_names[i].hex;
-            out->hex   = v;
-            out->rgb   = hex_to_rgb(v);
-            out->cmyk  = rgb_to_cmyk(&out->rgb);
-            out->hsl   = rgb_to_hsl(&out->rgb);
-            out->hsv   = rgb_to_hsv(&out->rgb);
-            out->oklch = rgb_to_oklch(&out->rgb);
-            out->oklab = oklch_to_oklab(&out->oklch);
-            out->named = closest_named_weighted_rgb(&out->rgb);
-            return 1;
+    // check chosen color list first, then the other one
+    const named_table_t *tables[2] = { names, (names == &css_colors) ? &xkcd_colors : &css_colors };
+
+    for (size_t t = 0; t < 2; ++t) {
+        const named_table_t *tbl = tables[t];
+        for (size_t i = 0; i < tbl->size; ++i) {
+            if (strcmp(s, tbl->pool + tbl->offs[i]) == 0) {
+                hex_t v    = tbl->hex[i];
+                out->hex   = v;
+                out->rgb   = hex_to_rgb(v);
+                out->cmyk  = rgb_to_cmyk(&out->rgb);
+                out->hsl   = rgb_to_hsl(&out->rgb);
+                out->hsv   = rgb_to_hsv(&out->rgb);
+                out->oklch = rgb_to_oklch(&out->rgb);
+                out->oklab = oklch_to_oklab(&out->oklch);
+                out->xyz   = rgb_to_xyz(&out->rgb);
+                return 1;
+            }
         }
     }
 
-    // ...then we REALLY haven't found anything
+    // we REALLY haven't found anything
     return 0;
 }
 
-// HEX: "#rrggbb", "0xrrggbb", "xrrggbb", "rrggbb", "hex(...)" incl. shorthand variants
+// HEX: "#rrggbb", "0xrrggbb", "xrrggbb", "rrggbb", "hex(...)" incl. shorthand variants, the css ones with "#" also with an
+// alpha digit pair (or digit for the shorthand): "#rrggbbaa", "#rgba"
 static inline int parse_hex(char *s, color_t *out) {
     char *p = s;
 
@@ -97,12 +126,22 @@ static inline int parse_hex(char *s, color_t *out) {
         else return 0;
     }
 
+    bool hash = *p == '#';
     if (*p == '#') ++p;                           // #rrggbb or #rgb
     else if (p[0] == '0' && p[1] == 'x') p += 2;  // 0xrrggbb or 0xrgb
     else if (*p == 'x') ++p;                      // xrrggbb or xrgb
 
+    // #rgba / #rrggbbaa: the last digit(s) are the opacity
     size_t len = strlen(p);
-    unsigned v = 0;
+    unsigned v = 0, a = 255;
+
+    if (hash && (len == 4 || len == 8)) {
+        size_t d = len / 4;
+        if (!all_hexdigits(p + len - d, d)) return 0;
+        char buf[3] = { p[len - d], p[len - 1], '\0' };
+        if (sscanf(buf, "%2x", &a) != 1) return 0;
+        p[len -= d] = '\0';
+    }
 
     if (len == 3) {
         // expand shorthand
@@ -120,6 +159,7 @@ static inline int parse_hex(char *s, color_t *out) {
         if (sscanf(p, "%6x", &v) != 1) return 0;
     } else return 0; // invalid length
 
+    if (a != 255) out->alpha = a / 255.0;
     out->hex   = v;
     out->rgb   = hex_to_rgb(v);
     out->cmyk  = rgb_to_cmyk(&out->rgb);
@@ -127,7 +167,7 @@ static inline int parse_hex(char *s, color_t *out) {
     out->hsv   = rgb_to_hsv(&out->rgb);
     out->oklch = rgb_to_oklch(&out->rgb);
     out->oklab = oklch_to_oklab(&out->oklch);
-    out->named = closest_named_weighted_rgb(&out->rgb);
+    out->xyz   = rgb_to_xyz(&out->rgb);
     return 1;
 }
 
@@ -158,7 +198,7 @@ static inline int parse_rgb(char *s, color_t *out) {
             out->hsv   = rgb_to_hsv(&out->rgb);
             out->oklch = rgb_to_oklch(&out->rgb);
             out->oklab = oklch_to_oklab(&out->oklch);
-            out->named = closest_named_weighted_rgb(&out->rgb);
+            out->xyz   = rgb_to_xyz(&out->rgb);
             return 1;
         }
     } else if (sscanf(p, "%lf,%lf,%lf%n", &fa, &fb, &fc, &n) == 3 && p[n] == '\0') {
@@ -174,7 +214,7 @@ static inline int parse_rgb(char *s, color_t *out) {
             out->hsv   = rgb_to_hsv(&out->rgb);
             out->oklch = rgb_to_oklch(&out->rgb);
             out->oklab = oklch_to_oklab(&out->oklch);
-            out->named = closest_named_weighted_rgb(&out->rgb);
+            out->xyz   = rgb_to_xyz(&out->rgb);
             return 1;
         }
     }
@@ -222,7 +262,7 @@ static inline int parse_cmyk(char *s, color_t *out) {
     out->hsv   = rgb_to_hsv(&out->rgb);
     out->oklch = rgb_to_oklch(&out->rgb);
     out->oklab = oklch_to_oklab(&out->oklch);
-    out->named = closest_named_weighted_rgb(&out->rgb);
+    out->xyz   = rgb_to_xyz(&out->rgb);
     return 1;
 }
 
@@ -267,7 +307,7 @@ static inline int parse_hsl(char *s, color_t *out)  {
     out->hsv   = rgb_to_hsv(&out->rgb);
     out->oklch = rgb_to_oklch(&out->rgb);
     out->oklab = oklch_to_oklab(&out->oklch);
-    out->named = closest_named_weighted_rgb(&out->rgb);
+    out->xyz   = rgb_to_xyz(&out->rgb);
     return 1;
 }
 
@@ -323,7 +363,7 @@ static inline int parse_hsv(char *s, color_t *out) {
     out->hsl   = rgb_to_hsl(&out->rgb);
     out->oklch = rgb_to_oklch(&out->rgb);
     out->oklab = oklch_to_oklab(&out->oklch);
-    out->named = closest_named_weighted_rgb(&out->rgb);
+    out->xyz   = rgb_to_xyz(&out->rgb);
     return 1;
 }
 
@@ -363,7 +403,7 @@ static inline int parse_oklab(char *s, color_t *out) {
     out->cmyk  = rgb_to_cmyk(&out->rgb);
     out->hsl   = rgb_to_hsl(&out->rgb);
     out->hsv   = rgb_to_hsv(&out->rgb);
-    out->named = closest_named_weighted_rgb(&out->rgb);
+    out->xyz   = oklab_to_xyz(&out->oklab);
     return 1;
 }
 
@@ -414,48 +454,332 @@ static inline int parse_oklch(char *s, color_t *out) {
     out->cmyk  = rgb_to_cmyk(&out->rgb);
     out->hsl   = rgb_to_hsl(&out->rgb);
     out->hsv   = rgb_to_hsv(&out->rgb);
-    out->named = closest_named_weighted_rgb(&out->rgb);
+    out->xyz   = oklab_to_xyz(&out->oklab);
+    return 1;
+}
+
+// helper function for the css color 4 functions: exactly n comma separated numbers, each with an optional '%'
+// that stands for pct[i] (100% = pct[i]), a pct[i] of 0 means no percentage is allowed
+static inline bool parse_numbers(const char *p, int n, const double *pct, double *v) {
+    for (int i = 0; i < n; ++i) {
+        char *end = NULL;
+        v[i] = strtod(p, &end);
+        if (end == p || !isfinite(v[i])) return false;
+        p = end;
+
+        if (*p == '%') { if (pct[i] == 0.0) return false; v[i] *= pct[i] / 100.0; ++p; }
+        if (i + 1 < n && *p++ != ',') return false;
+    }
+    return *p == '\0';
+}
+
+// shared tail of the xyz based parsers: every model follows from the unclipped oklab, gamut handling in oklab_to_rgb
+static inline int set_from_xyz(const xyz_t *xyz, color_t *out) {
+    out->xyz   = *xyz;
+    out->oklab = xyz_to_oklab(xyz);
+    out->oklch = oklab_to_oklch(&out->oklab);
+    out->rgb   = oklab_to_rgb(&out->oklab);
+    out->hex   = rgb_to_hex(&out->rgb);
+    out->cmyk  = rgb_to_cmyk(&out->rgb);
+    out->hsl   = rgb_to_hsl(&out->rgb);
+    out->hsv   = rgb_to_hsv(&out->rgb);
+    return 1;
+}
+
+// COLOR: "color(space,c1,c2,c3)" (css spaces also work, see css_separators) with space one of srgb, srgb-linear,
+// display-p3, rec2020, rec2100-pq, rec2100-hlg, xyz / xyz-d65 or xyz-d50, components nominally 0..1 or percentages
+static inline int parse_color_fn(char *s, color_t *out) {
+    if (strncmp(s, "color(", 6) != 0) return 0;
+
+    char  *p  = s + 6;
+    size_t Ls = strlen(p);
+    if (Ls == 0 || p[Ls - 1] != ')') return 0;
+    p[Ls - 1] = '\0';
+
+    char *comma = strchr(p, ',');
+    if (!comma) return 0;
+    *comma = '\0';
+
+    static const double pct[3] = { 1.0, 1.0, 1.0 };
+    double v[3];
+    if (!parse_numbers(comma + 1, 3, pct, v)) return 0;
+
+    xyz_t      xyz;
+    rgbspace_t space;
+    bool       alias = strcmp(p, "p3") == 0 || strcmp(p, "pq") == 0 || strcmp(p, "hlg") == 0; // --from shorthands only
+    if      (strcmp(p, "xyz") == 0 || strcmp(p, "xyz-d65") == 0) xyz = (xyz_t){ .x = v[0], .y = v[1], .z = v[2] };
+    else if (strcmp(p, "xyz-d50") == 0)                           { xyz_t d = { .x = v[0], .y = v[1], .z = v[2] }; xyz = xyz_d50_to_d65(&d); }
+    else if (!alias && rgbspace_from_name(p, &space))              xyz = rgbspace_to_xyz(space, v);
+    else    return 0;
+
+    return set_from_xyz(&xyz, out);
+}
+
+// LAB: "lab(L,a,b)" cielab relative to d50 like css, L 0..100 (or %), a / b where 100% = 125
+static inline int parse_lab(char *s, color_t *out) {
+    if (strncmp(s, "lab(", 4) != 0) return 0;
+
+    char  *p  = s + 4;
+    size_t Ls = strlen(p);
+    if (Ls == 0 || p[Ls - 1] != ')') return 0;
+    p[Ls - 1] = '\0';
+
+    static const double pct[3] = { 100.0, 125.0, 125.0 };
+    double v[3];
+    if (!parse_numbers(p, 3, pct, v)) return 0;
+    if (v[0] < 0.0 || v[0] > 100.0) return 0;
+
+    lab_t lab = { .L = v[0], .a = v[1], .b = v[2] };
+    xyz_t xyz = lab_d50_to_xyz(&lab);
+    return set_from_xyz(&xyz, out);
+}
+
+// LCH: "lch(L,c,h)" cielab (d50) in polar form like css, L 0..100 (or %), c where 100% = 150, h in degrees
+static inline int parse_lch(char *s, color_t *out) {
+    if (strncmp(s, "lch(", 4) != 0) return 0;
+
+    char  *p  = s + 4;
+    size_t Ls = strlen(p);
+    if (Ls == 0 || p[Ls - 1] != ')') return 0;
+    p[Ls - 1] = '\0';
+
+    static const double pct[3] = { 100.0, 150.0, 0.0 };
+    double v[3];
+    if (!parse_numbers(p, 3, pct, v)) return 0;
+    if (v[0] < 0.0 || v[0] > 100.0 || v[1] < 0.0) return 0;
+
+    double hp = fmod(v[2], 360.0);
+    if (hp < 0.0) hp += 360.0;
+
+    lch_t lch = { .L = v[0], .c = v[1], .h = hp };
+    lab_t lab = lch_to_lab(&lch);
+    xyz_t xyz = lab_d50_to_xyz(&lab);
+    return set_from_xyz(&xyz, out);
+}
+
+// YCBCR: "ycbcr(Y,Cb,Cr)" 8-bit code values of the current --ycbcr standard and --range (see yuv.h), clamped to srgb
+static inline int parse_ycbcr(char *s, color_t *out) {
+    if (strncmp(s, "ycbcr(", 6) != 0) return 0;
+
+    char  *p  = s + 6;
+    size_t Ls = strlen(p);
+    if (Ls == 0 || p[Ls - 1] != ')') return 0;
+    p[Ls - 1] = '\0';
+
+    static const double pct[3] = { 0.0, 0.0, 0.0 };
+    double v[3];
+    if (!parse_numbers(p, 3, pct, v)) return 0;
+    if (v[0] < 0.0 || v[0] > 255.0 || v[1] < 0.0 || v[1] > 255.0 || v[2] < 0.0 || v[2] > 255.0) return 0;
+
+    ycbcr_t ycc = { .y = v[0], .cb = v[1], .cr = v[2] };
+    out->rgb   = ycbcr_to_rgb(&ycc);
+    out->hex   = rgb_to_hex(&out->rgb);
+    out->cmyk  = rgb_to_cmyk(&out->rgb);
+    out->hsl   = rgb_to_hsl(&out->rgb);
+    out->hsv   = rgb_to_hsv(&out->rgb);
+    out->oklch = rgb_to_oklch(&out->rgb);
+    out->oklab = oklch_to_oklab(&out->oklch);
+    out->xyz   = rgb_to_xyz(&out->rgb);
     return 1;
 }
 
 // list of parser functions to iterate through
 static parse_fn parsers[] = {
-    parse_named, parse_hex,  parse_rgb, 
-    parse_cmyk,  parse_hsl,  parse_hsv,
-    parse_oklab, parse_oklch
+    parse_named, parse_hex,      parse_rgb, 
+    parse_cmyk,  parse_hsl,      parse_hsv,
+    parse_oklab, parse_oklch,    parse_color_fn,
+    parse_lab,   parse_lch,      parse_ycbcr
 };
 
+// css color 4 separates the arguments of its functions (and ycbcr() / hsv() here) by whitespace: turn those separators into
+// the commas the parsers expect, before norm drops all whitespace (other input is left alone), the "/" of an alpha stays
+static void css_separators(char *s) {
+    static const char *fns[] = { "color(", "lab(", "lch(", "ycbcr(", "rgb(", "rgba(", "hsl(", "hsla(", "hsv(", "hsva(", "oklab(", "oklch(" };
+
+    char *p = s;
+    while (isspace((unsigned char)*p)) ++p;
+
+    bool match = false;
+    for (size_t f = 0; f < sizeof(fns) / sizeof(fns[0]) && !match; ++f) {
+        size_t i = 0;
+        while (fns[f][i] && tolower((unsigned char)p[i]) == fns[f][i]) ++i;
+        match = fns[f][i] == '\0';
+    }
+    if (!match) return;
+
+    // whitespace runs between two arguments become one comma, the ones next to parentheses or commas go away
+    char *dst = p, prev = '\0';
+    for (char *src = p; *src; ) {
+        if (!isspace((unsigned char)*src)) { prev = *dst++ = *src++; continue; }
+
+        while (isspace((unsigned char)*src)) ++src;
+        if (prev && prev != '(' && prev != ',' && prev != '/' && *src && *src != ')' && *src != ',' && *src != '/') prev = *dst++ = ',';
+    }
+    *dst = '\0';
+}
+
+// opacity of len characters at p: a number in 0..1 or a percentage, clamped like css does
+static bool parse_alpha(const char *p, size_t len, double *alpha) {
+    char  *end = NULL;
+    double a   = strtod(p, &end);
+    if (end == p || !isfinite(a)) return false;
+    if (end < p + len && *end == '%') { a /= 100.0; ++end; }
+    if (end != p + len) return false;
+
+    *alpha = CLAMP(a, 0.0, 1.0);
+    return true;
+}
+
+// take the opacity off a normalized input, so the parsers only ever see the color itself
+// "<color>/a" works for every format (the css "/ a" of the space separated syntax), the legacy functions also take a fourth
+// argument ("rgb(r,g,b,a)", "hsl(h,s,l,a)", ...) and their "rgba(", "hsla(" and "hsva(" spellings
+//
+// returns false if an opacity is present but not valid, *alpha is left alone if there is none
+static bool split_alpha(char *s, double *alpha) {
+    static const char *fns[] = { "rgb(", "hsl(", "hsv(", "oklab(", "oklch(", "lab(", "lch(", "ycbcr(" };
+
+    // the aliases take either syntax ("rgba(r,g,b,a)", "rgba(r g b / a)")
+    size_t L = strlen(s);
+    if (strncmp(s, "rgba(", 5) == 0 || strncmp(s, "hsla(", 5) == 0 || strncmp(s, "hsva(", 5) == 0) memmove(s + 3, s + 4, L-- - 3);
+
+    bool  paren = L && s[L - 1] == ')';
+    char *slash = strrchr(s, '/');
+    if (slash) {
+        size_t len = (size_t)(s + L - paren - (slash + 1));
+        if (!parse_alpha(slash + 1, len, alpha)) return false;
+        if (paren) *slash++ = ')';
+        *slash = '\0';
+        return true;
+    }
+
+    for (size_t f = 0; f < sizeof(fns) / sizeof(fns[0]); ++f) {
+        if (strncmp(s, fns[f], strlen(fns[f])) != 0 || !paren) continue;
+
+        // only a fourth argument is an opacity
+        int commas = 0;
+        for (const char *p = s; *p; ++p) commas += *p == ',';
+        if (commas != 3) return true;
+
+        char *comma = strrchr(s, ',');
+        if (!parse_alpha(comma + 1, (size_t)(s + L - 1 - (comma + 1)), alpha)) return false;
+        comma[0] = ')';
+        comma[1] = '\0';
+        return true;
+    }
+    return true;
+}
+
 // public api
-named_t closest_named_weighted_rgb(const rgb_t *in) {
-    double best_score = 1e300;
+size_t closest_named_index_scan(const named_table_t *tbl, const rgb_t *in, double *diff) {
+    int    best_score = INT_MAX;
     size_t best_idx   = 0;
 
-    for (size_t i = 0; i < names_size; ++i) {
-        rgb_t named = hex_to_rgb(names[i].hex);
-        double d = weighted_dist2_rgb(in, &named, W_R, W_G, W_B);
+    // integer weights keep the comparison exact, so ties always resolve to the lowest index
+    const hex_t *hex = tbl->hex;
+    for (size_t i = 0; i < tbl->size; ++i) {
+        int dr = in->r - (int)((hex[i] >> 16) & 0xFF);
+        int dg = in->g - (int)((hex[i] >>  8) & 0xFF);
+        int db = in->b - (int)( hex[i]        & 0xFF);
+        int d  = W_R_I * dr * dr + W_G_I * dg * dg + W_B_I * db * db;
         if (d < best_score) {
             best_score = d;
             best_idx = i;
         }
     }
 
-    named_t closest = names[best_idx];
-    closest.diff = best_score;
-    return closest;
+    if (diff) { rgb_t named = hex_to_rgb(hex[best_idx]); *diff = weighted_dist2_rgb(in, &named, W_R, W_G, W_B); }
+    return best_idx;
 }
 
-int parse_color(const char *in, color_t *out) {
+named_t closest_named_weighted_rgb(const rgb_t *in) {
+    // precomputed tables if available, search kernel otherwise
+    int idx = lut_named_idx((names == &xkcd_colors) ? LUT_XKCD : LUT_CSS, rgb_to_hex(in));
+    if (idx < 0) {
+        const name_soa_t *soa = get_soa(names);
+        idx = (int)nearest3_i32(soa->r, soa->g, soa->b, names->size, in->r, in->g, in->b, W_R_I, W_G_I, W_B_I, NULL);
+    }
+
+    rgb_t named = hex_to_rgb(names->hex[idx]);
+    return (named_t){ .name = names->pool + names->offs[idx], .hex = names->hex[idx], .diff = weighted_dist2_rgb(in, &named, W_R, W_G, W_B), .metric = CDIFF_WRGB };
+}
+
+named_t closest_named(const rgb_t *in) {
+    const name_soa_t *soa = NULL;
+    size_t  idx;
+    double  diff;
+    rgb_t   named;
+
+    switch (named_metric) {
+        case CDIFF_RGB:
+            soa   = get_soa(names);
+            idx   = nearest3_i32(soa->r, soa->g, soa->b, names->size, in->r, in->g, in->b, 1, 1, 1, NULL);
+            named = hex_to_rgb(names->hex[idx]);
+            diff  = dist2_rgb(in, &named);
+            break;
+        case CDIFF_OKLAB: {
+            soa = get_soa(names);
+            oklab_t q = rgb_to_oklab(in);
+            idx   = nearest3_f32(soa->L, soa->A, soa->B, names->size, (float)q.L, (float)q.a, (float)q.b, NULL);
+            named = hex_to_rgb(names->hex[idx]);
+            oklab_t nl = rgb_to_oklab(&named);
+            diff  = dist2_oklab(&q, &nl);
+            break;
+        }
+        case CDIFF_DE76:
+        case CDIFF_DE94:
+        case CDIFF_DE2000:
+        case CDIFF_CMC: {
+            // the input color is the reference of the (asymmetric) difference
+            soa = get_soa(names);
+            lab_t q = rgb_to_lab(in);
+            idx   = nearest_delta_e_f32(named_metric, soa->cL, soa->cA, soa->cB, names->size, (float)q.L, (float)q.a, (float)q.b, NULL);
+            named = hex_to_rgb(names->hex[idx]);
+            lab_t nl = rgb_to_lab(&named);
+            diff  = delta_e(named_metric, &q, &nl);
+            break;
+        }
+        default:
+            return closest_named_weighted_rgb(in);
+    }
+
+    return (named_t){ .name = names->pool + names->offs[idx], .hex = names->hex[idx], .diff = diff, .metric = named_metric };
+}
+
+void set_named_metric(cdiff_t metric) { named_metric = metric; }
+
+void color_from_rgb(const rgb_t *rgb, color_t *out) {
+    out->rgb   = *rgb;
+    out->hex   = rgb_to_hex(rgb);
+    out->cmyk  = rgb_to_cmyk(rgb);
+    out->hsl   = rgb_to_hsl(rgb);
+    out->hsv   = rgb_to_hsv(rgb);
+    out->oklch = rgb_to_oklch(rgb);
+    out->oklab = oklch_to_oklab(&out->oklch);
+    out->xyz   = rgb_to_xyz(rgb);
+    out->named = closest_named(rgb);
+    out->alpha = 1.0;
+}
+
+const named_table_t *get_named_table(bool xkcd) { return xkcd ? &xkcd_colors : &css_colors; }
+const named_table_t *get_current_named_table()  { return names; }
+
+// run the parsers on a copy of in, everything but out->named is set on success
+static int parse_models(const char *in, color_t *out) {
     if (!in || !out) return 0;
 
     // copy and normalize input
     char s[STR_BUFSIZE];
     snprintf(s, sizeof(s), "%s", in);
+    css_separators(s);
     norm(s);
 
+    double alpha = 1.0;
+    if (!split_alpha(s, &alpha)) return 0;
+
     // check color format by iterating through known parsers
     size_t nparsers = sizeof(parsers) / sizeof(parsers[0]);
     for (size_t i = 0; i < nparsers; ++i) {
-        color_t tmp = { 0 };
+        color_t tmp = { .alpha = alpha };
 
         // create new mutable copy to be destroyed by current parser
         char t[STR_BUFSIZE];
@@ -472,6 +796,20 @@ int parse_color(const char *in, color_t *out) {
     return 0;
 }
 
+int parse_color(const char *in, color_t *out) {
+    if (!parse_models(in, out)) return 0;
+    out->named = closest_named(&out->rgb);
+    return 1;
+}
+
+int parse_hex_alpha(const char *in, hex_t *hex, double *alpha) {
+    color_t c;
+    if (!parse_models(in, &c)) return 0;
+    *hex   = c.hex;
+    *alpha = c.alpha;
+    return 1;
+}
+
 int parse_color2(const char *in, color_t *out0, color_t *out1) {
     if (!in || !out0 || !out1) return 0;
 
@@ -567,28 +905,34 @@ int parse_color2(const char *in, color_t *out0, color_t *out1) {
     return parsed;
 }
 
+// listed color, simulated with --cvd
+static rgb_t list_rgb(hex_t hex, const prog_opts_t *opts) {
+    rgb_t rgb = hex_to_rgb(hex);
+    return (opts->cvd != CVD_NONE) ? cvd_simulate(opts->cvd, opts->severity, &rgb) : rgb;
+}
+
 void list_colors(int l, const prog_opts_t *opts) {
     char rgb[C_COL_BUFSIZE],   hex[C_COL_BUFSIZE],   cmyk[C_COL_BUFSIZE],
          hsl[C_COL_BUFSIZE],   hsv[C_COL_BUFSIZE],
          oklab[C_COL_BUFSIZE], oklch[C_COL_BUFSIZE],
          named[STR_BUFSIZE];
 
-    color_t     clr;
+    color_t     clr      = { .alpha = 1.0 };
     color_cap_t mode     = opts->mapping;
     const char *conv     = opts->conversion;
 
     // json output
     if (opts->json) {
         printf("{\n");
-        for (size_t i = 0; i < names_size; ++i) {
-            clr.rgb   = hex_to_rgb(names[i].hex);
-            clr.hex   = names[i].hex;
+        for (size_t i = 0; i < names->size; ++i) {
+            clr.rgb   = list_rgb(names->hex[i], opts);
+            clr.hex   = rgb_to_hex(&clr.rgb);
             clr.cmyk  = rgb_to_cmyk(&clr.rgb);
             clr.hsl   = rgb_to_hsl(&clr.rgb);
             clr.hsv   = rgb_to_hsv(&clr.rgb);
             clr.oklab = rgb_to_oklab(&clr.rgb);
             clr.oklch = rgb_to_oklch(&clr.rgb);
-            clr.named = closest_named_weighted_rgb(&clr.rgb);
+            clr.named = closest_named(&clr.rgb);
 
             // pre-format strings
             fmt_color_strings(&clr, opts->webfmt, opts->dplaces,
@@ -601,7 +945,7 @@ void list_colors(int l, const prog_opts_t *opts) {
                               oklch, sizeof(oklch),
                               named, sizeof(named));
 
-            printf("  \"%s\": ", names[i].name);
+            printf("  \"%s\": ", names->pool + names->offs[i]);
 
             // should we do conversion? no conv: hex
             // assume input validated beforehand, so no invalid conversions may occur (!)
@@ -612,18 +956,18 @@ void list_colors(int l, const prog_opts_t *opts) {
             else if (IS_CONV("hsv"))          { printf("{ \"h\": %.*f, \"s\": %.*f, \"v\": %.*f }", opts->dplaces, clr.hsv.h, opts->dplaces, clr.hsv.sat, opts->dplaces, clr.hsv.v); }
             else if (IS_CONV("oklab"))        { printf("{ \"L\": %.*f, \"a\": %.*f, \"b\": %.*f }", opts->dplaces, clr.oklab.L, opts->dplaces, clr.oklab.a, opts->dplaces, clr.oklab.b); }
             else if (IS_CONV("oklch"))        { printf("{ \"L\": %.*f, \"c\": %.*f, \"h\": %.*f }", opts->dplaces, clr.oklch.L, opts->dplaces, clr.oklch.c, opts->dplaces, clr.oklch.h); }
-            else if (IS_CONV("named"))        { printf("{ \"name\": \"%s\", \"hex\": \"#%06x\", \"wsqrdist\": %.*f }", clr.named.name, clr.named.hex, opts->dplaces, clr.named.diff); }
-            printf("%s\n", (i == names_size - 1) ? "" : ",");
+            else if (IS_CONV("named"))        { printf("{ \"name\": \"%s\", \"hex\": \"#%06x\", \"%s\": %.*f }", clr.named.name, clr.named.hex, named_dist_key(&clr.named), opts->dplaces, clr.named.diff); }
+            printf("%s\n", (i == names->size - 1) ? "" : ",");
         }
         printf("}\n");
         return;
     }
 
     // non-json (standard / csv)
-    for (size_t i = 0; i < names_size; ++i) {
-        clr.rgb   = hex_to_rgb(names[i].hex); clr.hex   = names[i].hex;                         clr.cmyk  = rgb_to_cmyk(&clr.rgb);
+    for (size_t i = 0; i < names->size; ++i) {
+        clr.rgb   = list_rgb(names->hex[i], opts); clr.hex = rgb_to_hex(&clr.rgb);               clr.cmyk  = rgb_to_cmyk(&clr.rgb);
         clr.hsl   = rgb_to_hsl(&clr.rgb);     clr.hsv   = rgb_to_hsv(&clr.rgb);                 clr.oklab = rgb_to_oklab(&clr.rgb);
-        clr.oklch = rgb_to_oklch(&clr.rgb);   clr.named = closest_named_weighted_rgb(&clr.rgb);
+        clr.oklch = rgb_to_oklch(&clr.rgb);   clr.named = closest_named(&clr.rgb);
 
         fmt_color_strings(&clr, opts->webfmt, opts->dplaces,
                           rgb,   sizeof(rgb),
@@ -647,14 +991,15 @@ void list_colors(int l, const prog_opts_t *opts) {
         else if (IS_CONV("oklch"))        value = oklch;
         else if (IS_CONV("named"))        value = named;
 
-        // csv; truecolor
-        if ((l == 1) || (mode != TC_TRUECOLOR)) { printf("%s,\"%s\"\n", names[i].name, value); }
-        else                                    { printf("\033[48;2;%d;%d;%dm    \x1b[0m %-21s%s\n", clr.rgb.r, clr.rgb.g, clr.rgb.b, names[i].name, value);
+        // csv; truecolor (with --cvd the original sample precedes the simulated one)
+        if ((l == 1) || (mode != TC_TRUECOLOR)) { printf("%s,\"%s\"\n", names->pool + names->offs[i], value); }
+        else {
+            if (opts->cvd != CVD_NONE) { rgb_t o = hex_to_rgb(names->hex[i]); printf("\033[48;2;%d;%d;%dm    \x1b[0m ", o.r, o.g, o.b); }
+            printf("\033[48;2;%d;%d;%dm    \x1b[0m %-21s%s\n", clr.rgb.r, clr.rgb.g, clr.rgb.b, names->pool + names->offs[i], value);
         }
     }
 }
 
 void use_xkcd() {
-    names      = xkcd_colors;
-    names_size = xkcd_colors_size;
+    names = &xkcd_colors;
 }
\ No newline at end of file
@@ -1,18 +1,28 @@
 #include <stdarg.h>
+#include "colorspace.h"
 #include "converter.h"
+#include "cvd.h"
+#include "parser.h"
 #include "printer.h"
 #include "utility.h"
+#include "yuv.h"
 
-void print_usage(FILE* stream, const char *progname) { fprintf(stream, "usage: %s [-c <model>] [-C <color>] [-d <color>] [-D <cdiff>] [-f <n>] [-h] [-j] [-l [0|1]] [-m <map>] [-p] [-w <n>] [-W] [-x] <color>\nsee readme or help for a list of valid formats\n", progname); }
+void print_usage(FILE* stream, const char *progname) { fprintf(stream, "usage: %s [-c <model>] [-C <color>] [-d <color>] [-D <cdiff>] [-f <n>] [-h] [-j] [-l [0|1]] [-m <map>] [-p] [-w <n>] [-W] [-x] [--<mode> ...] <color>\nsee readme or help for the modes and a list of valid formats\n", progname); }
 
 void print_help(const char* progname) {
     printf("color - a color printing (and conversion) tool for true color terminals\n\n");
     print_usage(stdout, progname);
     printf("\noptions:\n"
            "  -c <model>: only show the conversion of the chosen color to the specified model, then exit\n"
-           "  -C <color>: choose a color to compute the contrast against\n"
+           "              (rgb | hex | cmyk | hsl | hsv | oklab | oklch | ycbcr | named, or unclipped p3 | rec2020 | pq | hlg | xyz (d65) | lab | lch (d50))\n"
+           "  -C <color>: choose a color to compute the contrast against (wcag 2 ratio and apca Lc of the -C color as text and reversed),\n"
+           "              translucent colors are composited first (the color over --over, the -C color over the result)\n"
            "  -d <color>: choose a color to compute the difference with\n"
-           "  -D <cdiff>: choose color difference method: rgb | wrgb / weighted | oklab | all (default: all)\n"
+           "  -D <cdiff>: choose color difference method: rgb | wrgb / weighted | oklab | de76 | de94 | de2000 | cmc | all (default: all)\n"
+           "              rgb and oklab distances are squared, the cielab (d65) color differences are not, de94 and cmc (2:1)\n"
+           "              use the first color as the reference\n"
+           "              also used to find the closest named color (all: weighted rgb), json keys its distance like -d\n"
+           "              (\"wsqrdist\" for weighted rgb)\n"
            "  -f <0..5> : choose the maximum amount of decimal places to print (default: 2)\n"
            "              0 rounds the numbers to the nearest integer\n"
            "  -h        : show this help text and exit\n"
@@ -27,7 +37,71 @@ void print_help(const char* progname) {
            "              0 disabled the color preview\n"
            "  -W        : print colors in web format (css) (default: false)\n"
            "  -x        : use xkcd color names instead of css (default: false)\n"
-           "              this option must be set if you want to parse an xkcd color name\n");
+           "              this option must be set if you want to parse an xkcd color name\n"
+           "  --batch <file>    : read colors (one per line, \"-\" for stdin) and print each converted to -c <model> (default: hex)\n"
+           "    --unique        : drop repeated colors\n"
+           "    --sort <key>    : sort by hex | L | c | h (oklch)\n"
+           "    --reverse       : sort in descending order\n"
+           "    --format <f>    : text (-c <model> per line) | json | csv | bin (raw rgb bytes) | c (c array) (default: text)\n"
+           "  --gradient <c1> <c2> [...]: print colors interpolated between the given colors (first and last included) in --format\n"
+           "    --steps <n>     : number of colors (default: 16)\n"
+           "    --space <s>     : oklab | oklch | rgb (default: oklab)\n"
+           "    --hue <h>       : oklch hue path: shorter | longer | increasing | decreasing (default: shorter)\n"
+           "                      every color is gamut mapped unless --gamut clip is given\n"
+           "  --matrix <file>   : read colors like --batch and print the -D distance of every pair (same units as -d) in --format\n"
+           "    --upper         : only the upper triangle (pairs i < j, row by row)\n"
+           "    --epsilon <e>   : list the pairs i < j with a distance below e instead (-D all means oklab here)\n"
+           "                      neither works with de94 and cmc, which depend on the reference (row i of the full matrix)\n"
+           "  --fix-contrast <fg> <bg>: print the color closest to fg (in oklab) with at least --target contrast against bg\n"
+           "                      (-c <model> prints only the color, -j as json)\n"
+           "    --target <r>    : wcag contrast ratio to reach, 1..21, or apca |Lc|, 0..108 (default: 4.5 / 75)\n"
+           "                      only the oklch lightness of fg changes, chroma is reduced to stay in srgb unless --gamut clip is given\n"
+           "  --fix-contrast-batch <file>: the same for every \"fg bg\" line of file (\"-\" for stdin), fixed colors printed in --format\n"
+           "                      (json / csv also list fg, bg, ratio, deltaEOK and whether the target was met)\n"
+           "  --contrast-matrix <file>: read colors like --batch and list every pair with a wcag contrast of at least 3 (aa large)\n"
+           "                      and which of aa large / aa / aaa it meets, then the number of such partners per color and level\n"
+           "                      (--format text / csv: two csv tables separated by an empty line, json: \"pairs\" and \"colors\")\n"
+           "  --contrast-metric <m>: wcag (2.x ratio) | apca (wcag 3 draft Lc, fg as text) for --fix-contrast and --contrast-matrix\n"
+           "                      (default: wcag), apca matrix levels are |Lc| 60 / 75 / 90 and pairs are listed in both orders\n"
+           "  --cvd <t>         : simulate protan | deutan | tritan color vision deficiency (machado et al. 2009) for the color,\n"
+           "                      -l, --batch (before --unique / --sort) and --matrix (--epsilon: pairs that collapse, both distances)\n"
+           "    --severity <s>  : 0 (normal vision) .. 1 (dichromacy) (default: 1)\n"
+           "  --image <file.ppm>: write the binary ppm (P6, up to 16 bits, written as 8 bits) or 8-bit rgb / rgb_alpha pam (P7) file (\"-\" for stdin) through --from, --lut, --cvd and / or --snap to stdout (as ppm unless --render)\n"
+           "  --from <space>    : --image pixels and --batch colors are encoded in display-p3 (p3) | rec2020 | rec2100-pq (pq) | rec2100-hlg (hlg)\n"
+           "                      | srgb-linear | srgb, converted to srgb first, out-of-gamut ones gamut mapped unless --gamut clip (default: srgb)\n"
+           "  --sdr-white <nits>: luminance in cd/m2 srgb white maps to in pq and hlg, whose hdr reference white is 203 (default: 203)\n"
+           "  --yuv <file.yuv>  : convert raw 4:2:0 frames (\"-\" for stdin) to binary ppm images (P6, one after the other) on stdout\n"
+           "    --size <w>x<h>  : frame size of the --yuv input (required)\n"
+           "  --to-yuv <file.ppm>: convert binary ppm images of one size (\"-\" for stdin) to raw 4:2:0 frames on stdout\n"
+           "  --layout <l>      : i420 (y, cb and cr planes) | nv12 (y plane, then interleaved cb / cr) for --yuv and --to-yuv (default: i420)\n"
+           "  --ycbcr <std>     : 601 | 709 | 2020 matrix of -c ycbcr, ycbcr(...) and the raw frames (default: 709)\n"
+           "  --range <r>       : limited (y 16..235, cb / cr 16..240) | full (0..255) ycbcr range (default: limited)\n"
+           "  --over <color>    : opaque backdrop translucent colors of -C, --batch, --matrix, --contrast-matrix and rgb_alpha --image\n"
+           "                      pixels are composited over (default: white)\n"
+           "    --blend <mode>  : normal | multiply | screen | overlay | darken | lighten | color-dodge | color-burn | hard-light\n"
+           "                      | soft-light | difference | exclusion | hue | saturation | color | luminosity (default: normal)\n"
+           "    --blend-space <s>: gamma (on encoded srgb like css) | linear (in linear light) (default: gamma)\n"
+           "  --extract <n> <file.ppm>: print the n (1..256) dominant colors of an image (\"-\" for stdin, --from applies) by\n"
+           "                      decreasing share with the closest named color, in --format\n"
+           "    --method <m>    : kmeans (k-means++ in oklab) | median-cut | octree (streaming, fixed memory) (default: kmeans)\n"
+           "  --lut <file.cube>: apply a 3d lut (.cube) to --image pixels and --batch colors (before --cvd)\n"
+           "    --interp <i>    : tetrahedral | trilinear (default: tetrahedral)\n"
+           "  --make-lut <file.cube>: write a 3d lut (\"-\" for stdout) of --cvd (out-of-gamut results gamut mapped unless\n"
+           "                      --gamut clip, like --image) and --snap\n"
+           "    --lut-size <n>  : nodes per axis, 2..256 (default: 33)\n"
+           "    --snap <p>      : snap the output (and --image pixels) to the closest named (-x for xkcd) | ansi16 | ansi256 color\n"
+           "  --dither <d>      : dithering of --image pixels snapped to a palette: none | floyd-steinberg (fs) | atkinson (error\n"
+           "                      diffusion) | bayer | blue-noise (ordered) (default: none)\n"
+           "    --dither-space <s>: oklab | linear (light), where the error is diffused and the closest colors are found (default: oklab)\n"
+           "  --render <r>      : --image output: ppm | sixel (palette of --snap, ansi256 if none) | kitty (graphics protocol, rgb)\n"
+           "  --precision <p>   : math used for oklab / oklch conversions: exact (libm) or fast (polynomial approximations,\n"
+           "                      same printed output at every -f setting) (default: exact)\n"
+           "  --gamut <g>       : oklab / oklch colors outside srgb: clip (clamp channels) or map (css color 4 gamut mapping,\n"
+           "                      reduces chroma but keeps lightness and hue) (default: clip)\n"
+           "  --build-lut       : precompute nearest named / ansi colors for all 2^24 rgb values and exit\n"
+           "                      (written to $COLOR_LUT, $XDG_CACHE_HOME/color/nearest.lut or ~/.cache/color/nearest.lut)\n"
+           "  --cpu-info        : print the instruction set level used by the batch kernels and the lookup table status, then exit\n"
+           "                      (set COLOR_CPU_LEVEL=base|v2|v3 to force a lower level)\n");
     printf("\nvalid color formats (case-insensitive):\n"
            "  named: any valid named css / xkcd color (e.g. forestgreen, mediumblue...)\n"
            "  rgb:   rgb(r,g,b)\n"
@@ -51,7 +125,9 @@ void print_help(const char* progname) {
            "  oklch: oklch(L,c,h)\n"
            "         L%%,c,h\n"
            "         L%%,c%%,h\n"
-           "         optional percent sign for L or c for oklch(...)\n");
+           "         optional percent sign for L or c for oklch(...)\n"
+           "  alpha: #rrggbbaa, #rgba, rgba(r,g,b,a), hsla(h,s,l,a), hsva(h,s,v,a)\n"
+           "         any format followed by / a (0..1 or a percentage, e.g. oklch(70%%,0.1,200 / 50%%))\n");
 #if defined(GIT_HASH) && defined(GIT_BRANCH) && defined(COMPILE_TIME)
     printf("\nhash:   " GIT_HASH
            "\nbranch: " GIT_BRANCH
@@ -59,6 +135,13 @@ void print_help(const char* progname) {
 #endif
 }
 
+void print_gamut_warning(FILE *stream, unsigned long n, gamut_t mode) {
+    if (n == 0) return;
+    fflush(stdout); // after the colors it refers to
+    if (mode == GAMUT_MAP) fprintf(stream, "warning: %lu color(s) out-of-gamut in rgb, gamut mapping was applied\n", n);
+    else                   fprintf(stream, "warning: %lu color(s) out-of-gamut in rgb, clamping was applied (--gamut map keeps hue and lightness)\n", n);
+}
+
 void print_color_line(print_ctx_t *ctx, const char *label, const char *fmt, ...) {
     const char *left_bg = (ctx->cheight > 0) ? ctx->bgbufptr : ""; ctx->cheight--;
 
@@ -77,6 +160,103 @@ void print_color_line_empty(print_ctx_t *ctx) {
     printf("%s%*s%s\n", left_bg, ctx->cwidth, ctx->cwidth > 0 ? " " : "", ctx->reset);
 }
 
+// wide-gamut conversion targets, computed from the unclipped xyz of a color
+// (space is the rgb space of the rgb targets, RGBSPACE_COUNT for the others)
+typedef struct { const char *conv, *css, *keys[3]; rgbspace_t space; } wide_target_t;
+
+static const wide_target_t wide_targets[] = {
+    { "p3",      "color(display-p3 ",  { "r", "g", "b" }, RGBSPACE_DISPLAY_P3  },
+    { "rec2020", "color(rec2020 ",     { "r", "g", "b" }, RGBSPACE_REC2020     },
+    { "pq",      "color(rec2100-pq ",  { "r", "g", "b" }, RGBSPACE_REC2100_PQ  },
+    { "hlg",     "color(rec2100-hlg ", { "r", "g", "b" }, RGBSPACE_REC2100_HLG },
+    { "xyz",     "color(xyz-d65 ",     { "x", "y", "z" }, RGBSPACE_COUNT       },
+    { "lab",     "lab(",               { "L", "a", "b" }, RGBSPACE_COUNT       },
+    { "lch",     "lch(",               { "L", "c", "h" }, RGBSPACE_COUNT       },
+};
+
+// target of conv and the values of the color in it, NULL if conv is not a wide-gamut target
+static const wide_target_t *wide_values(const char *conv, const color_t *colorptr, double v[3]) {
+    if      (strcasecmp_own(conv, "display-p3"))  conv = "p3";
+    else if (strcasecmp_own(conv, "rec2100-pq"))  conv = "pq";
+    else if (strcasecmp_own(conv, "rec2100-hlg")) conv = "hlg";
+
+    for (size_t i = 0; i < sizeof(wide_targets) / sizeof(wide_targets[0]); ++i) {
+        const wide_target_t *w = &wide_targets[i];
+        if (!strcasecmp_own(conv, w->conv)) continue;
+
+        const xyz_t *xyz = &colorptr->xyz;
+        if      (w->space != RGBSPACE_COUNT) xyz_to_rgbspace(w->space, xyz, v);
+        else if (w->keys[0][0] == 'x')       { v[0] = xyz->x; v[1] = xyz->y; v[2] = xyz->z; }
+        else {
+            lab_t lab = xyz_to_lab_d50(xyz);
+            if (w->keys[1][0] == 'a') { v[0] = lab.L; v[1] = lab.a; v[2] = lab.b; }
+            else                      { lch_t lch = lab_to_lch(&lab); v[0] = lch.L; v[1] = lch.c; v[2] = lch.h; }
+        }
+        return w;
+    }
+    return NULL;
+}
+
+void print_conversion(const color_t *colorptr, const prog_opts_t *opts) {
+    // the css functions of the wide-gamut models only have the space separated syntax
+    // translucent colors end in " / a" (inside the parentheses in web format)
+    char alpha[C_COL_BUFSIZE] = "";
+    if (colorptr->alpha < 1.0) snprintf(alpha, sizeof(alpha), " / %.*f", ALPHA_PLACES(opts->dplaces), colorptr->alpha);
+
+    double v[3];
+    const wide_target_t *w = wide_values(opts->conversion, colorptr, v);
+    if (w && opts->webfmt) { printf("%s%.*f %.*f %.*f%s)\n", w->css, opts->dplaces, v[0], opts->dplaces, v[1], opts->dplaces, v[2], alpha); return; }
+    if (w)                 { printf("%.*f,%.*f,%.*f%s\n",    opts->dplaces, v[0], opts->dplaces, v[1], opts->dplaces, v[2], alpha);          return; }
+
+    // ycbcr code values of the current --ycbcr standard and --range
+    if (strcasecmp_own(opts->conversion, "ycbcr")) {
+        ycbcr_t y = rgb_to_ycbcr(&colorptr->rgb);
+        printf(opts->webfmt ? "ycbcr(%.*f, %.*f, %.*f%s)\n" : "%.*f,%.*f,%.*f%s\n", opts->dplaces, y.y, opts->dplaces, y.cb, opts->dplaces, y.cr, alpha);
+        return;
+    }
+
+    // populate only the needed buffer
+    char rgb[C_COL_BUFSIZE],   hex[C_COL_BUFSIZE],   cmyk[C_COL_BUFSIZE],
+         hsl[C_COL_BUFSIZE],   hsv[C_COL_BUFSIZE],
+         oklab[C_COL_BUFSIZE], oklch[C_COL_BUFSIZE],
+         named[STR_BUFSIZE];
+
+    if      (strcasecmp_own(opts->conversion, "rgb"))   { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, rgb, sizeof(rgb), NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0);     printf("%s\n", rgb); }
+    else if (strcasecmp_own(opts->conversion, "hex"))   { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, hex, sizeof(hex), NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0);     printf("%s\n", hex); }
+    else if (strcasecmp_own(opts->conversion, "cmyk"))  { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, cmyk, sizeof(cmyk), NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0);   printf("%s\n", cmyk); }
+    else if (strcasecmp_own(opts->conversion, "hsl"))   { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, hsl, sizeof(hsl), NULL, 0, NULL, 0, NULL, 0, NULL, 0);     printf("%s\n", hsl); }
+    else if (strcasecmp_own(opts->conversion, "hsv"))   { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, NULL, 0, hsv, sizeof(hsv), NULL, 0, NULL, 0, NULL, 0);     printf("%s\n", hsv); }
+    else if (strcasecmp_own(opts->conversion, "oklab")) { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, oklab, sizeof(oklab), NULL, 0, NULL, 0); printf("%s\n", oklab); }
+    else if (strcasecmp_own(opts->conversion, "oklch")) { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, oklch, sizeof(oklch), NULL, 0); printf("%s\n", oklch); }
+    else if (strcasecmp_own(opts->conversion, "named")) { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, named, sizeof(named)); printf("%s\n", named); }
+}
+
+// the model of -c as a json key-value pair
+static void print_model_json(const color_t *colorptr, const prog_opts_t *opts) {
+    double v[3];
+    const wide_target_t *w = wide_values(opts->conversion, colorptr, v);
+    if (w) { printf("\"%s\": { \"%s\": %.*f, \"%s\": %.*f, \"%s\": %.*f }", w->conv, w->keys[0], opts->dplaces, v[0], w->keys[1], opts->dplaces, v[1], w->keys[2], opts->dplaces, v[2]); return; }
+    if (strcasecmp_own(opts->conversion, "ycbcr")) {
+        ycbcr_t y = rgb_to_ycbcr(&colorptr->rgb);
+        printf("\"ycbcr\": { \"y\": %.*f, \"cb\": %.*f, \"cr\": %.*f }", opts->dplaces, y.y, opts->dplaces, y.cb, opts->dplaces, y.cr);
+        return;
+    }
+
+    if      (strcasecmp_own(opts->conversion, "rgb"))   printf("\"rgb\": { \"r\": %d, \"g\": %d, \"b\": %d }",                            colorptr->rgb.r, colorptr->rgb.g, colorptr->rgb.b);
+    else if (strcasecmp_own(opts->conversion, "hex"))   printf("\"hex\": \"#%06x\"",                                                      colorptr->hex);
+    else if (strcasecmp_own(opts->conversion, "cmyk"))  printf("\"cmyk\": { \"c\": %.*f, \"m\": %.*f, \"y\": %.*f, \"k\": %.*f }",        opts->dplaces, colorptr->cmyk.c, opts->dplaces, colorptr->cmyk.m, opts->dplaces, colorptr->cmyk.y, opts->dplaces, colorptr->cmyk.k);
+    else if (strcasecmp_own(opts->conversion, "hsl"))   printf("\"hsl\": { \"h\": %.*f, \"s\": %.*f, \"l\": %.*f }",                      opts->dplaces, colorptr->hsl.h, opts->dplaces, colorptr->hsl.sat, opts->dplaces, colorptr->hsl.l);
+    else if (strcasecmp_own(opts->conversion, "hsv"))   printf("\"hsv\": { \"h\": %.*f, \"s\": %.*f, \"v\": %.*f }",                      opts->dplaces, colorptr->hsv.h, opts->dplaces, colorptr->hsv.sat, opts->dplaces, colorptr->hsv.v);
+    else if (strcasecmp_own(opts->conversion, "oklab")) printf("\"oklab\": { \"L\": %.*f, \"a\": %.*f, \"b\": %.*f }",                    opts->dplaces, colorptr->oklab.L, opts->dplaces, colorptr->oklab.a, opts->dplaces, colorptr->oklab.b);
+    else if (strcasecmp_own(opts->conversion, "oklch")) printf("\"oklch\": { \"L\": %.*f, \"c\": %.*f, \"h\": %.*f }",                    opts->dplaces, colorptr->oklch.L, opts->dplaces, colorptr->oklch.c, opts->dplaces, colorptr->oklch.h);
+    else if (strcasecmp_own(opts->conversion, "named")) printf("\"named\": { \"name\": \"%s\", \"hex\": \"#%06x\", \"%s\": %.*f }",       colorptr->named.name, colorptr->named.hex, named_dist_key(&colorptr->named), opts->dplaces, colorptr->named.diff);
+}
+
+void print_conversion_json(const color_t *colorptr, const prog_opts_t *opts) {
+    print_model_json(colorptr, opts);
+    if (colorptr->alpha < 1.0) printf(", \"alpha\": %.*f", ALPHA_PLACES(opts->dplaces), colorptr->alpha);
+}
+
 bool print_color(const color_t *colorptr, const prog_opts_t *opts,
                  const char *json_label, bool json_add_comma,
                  char *bgbufptr, char *fgbufptr,
@@ -96,28 +276,20 @@ bool print_color(const color_t *colorptr, const prog_opts_t *opts,
          named[STR_BUFSIZE];
 
 
-    // populate only needed buffers in conversion-only mode
-    // json mode: buffers not needed
+    // conversion-only mode, converts the simulated color with --cvd
     if (opts->conversion) {
-        if (!opts->json) {
-            if      (strcasecmp_own(opts->conversion, "rgb"))   { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, rgb, sizeof(rgb), NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0);     printf("%s\n", rgb); }
-            else if (strcasecmp_own(opts->conversion, "hex"))   { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, hex, sizeof(hex), NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0);     printf("%s\n", hex); }
-            else if (strcasecmp_own(opts->conversion, "cmyk"))  { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, cmyk, sizeof(cmyk), NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0);   printf("%s\n", cmyk); }
-            else if (strcasecmp_own(opts->conversion, "hsl"))   { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, hsl, sizeof(hsl), NULL, 0, NULL, 0, NULL, 0, NULL, 0);     printf("%s\n", hsl); }
-            else if (strcasecmp_own(opts->conversion, "hsv"))   { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, NULL, 0, hsv, sizeof(hsv), NULL, 0, NULL, 0, NULL, 0);     printf("%s\n", hsv); }
-            else if (strcasecmp_own(opts->conversion, "oklab")) { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, oklab, sizeof(oklab), NULL, 0, NULL, 0); printf("%s\n", oklab); }
-            else if (strcasecmp_own(opts->conversion, "oklch")) { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, oklch, sizeof(oklch), NULL, 0); printf("%s\n", oklch); }
-            else if (strcasecmp_own(opts->conversion, "named")) { fmt_color_strings(colorptr, opts->webfmt, opts->dplaces, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, named, sizeof(named)); printf("%s\n", named); }
-        } else {
+        color_t sim;
+        if (opts->cvd != CVD_NONE) {
+            rgb_t s = cvd_simulate(opts->cvd, opts->severity, &colorptr->rgb);
+            color_from_rgb(&s, &sim);
+            sim.alpha = colorptr->alpha;
+            colorptr  = &sim;
+        }
+
+        if (!opts->json) print_conversion(colorptr, opts);
+        else {
             printf("  \"%s\" : { ", json_label);
-            if      (strcasecmp_own(opts->conversion, "rgb"))   printf("\"rgb\": { \"r\": %d, \"g\": %d, \"b\": %d }",                            colorptr->rgb.r, colorptr->rgb.g, colorptr->rgb.b);
-            else if (strcasecmp_own(opts->conversion, "hex"))   printf("\"hex\": \"#%06x\"",                                                      colorptr->hex);
-            else if (strcasecmp_own(opts->conversion, "cmyk"))  printf("\"cmyk\": { \"c\": %.*f, \"m\": %.*f, \"y\": %.*f, \"k\": %.*f }",        opts->dplaces, colorptr->cmyk.c, opts->dplaces, colorptr->cmyk.m, opts->dplaces, colorptr->cmyk.y, opts->dplaces, colorptr->cmyk.k);
-            else if (strcasecmp_own(opts->conversion, "hsl"))   printf("\"hsl\": { \"h\": %.*f, \"s\": %.*f, \"l\": %.*f }",                      opts->dplaces, colorptr->hsl.h, opts->dplaces, colorptr->hsl.sat, opts->dplaces, colorptr->hsl.l);
-            else if (strcasecmp_own(opts->conversion, "hsv"))   printf("\"hsv\": { \"h\": %.*f, \"s\": %.*f, \"v\": %.*f }",                      opts->dplaces, colorptr->hsv.h, opts->dplaces, colorptr->hsv.sat, opts->dplaces, colorptr->hsv.v);
-            else if (strcasecmp_own(opts->conversion, "oklab")) printf("\"oklab\": { \"L\": %.*f, \"a\": %.*f, \"b\": %.*f }",                    opts->dplaces, colorptr->oklab.L, opts->dplaces, colorptr->oklab.a, opts->dplaces, colorptr->oklab.b);
-            else if (strcasecmp_own(opts->conversion, "oklch")) printf("\"oklch\": { \"L\": %.*f, \"c\": %.*f, \"h\": %.*f }",                    opts->dplaces, colorptr->oklch.L, opts->dplaces, colorptr->oklch.c, opts->dplaces, colorptr->oklch.h);
-            else if (strcasecmp_own(opts->conversion, "named")) printf("\"named\": { \"name\": \"%s\", \"hex\": \"#%06x\", \"wsqrdist\": %.*f }", colorptr->named.name, colorptr->named.hex, opts->dplaces, colorptr->named.diff);
+            print_conversion_json(colorptr, opts);
             printf(" }%s\n", (json_add_comma ? "," : ""));
         }
         return true;
@@ -146,8 +318,7 @@ bool print_color(const color_t *colorptr, const prog_opts_t *opts,
                "    \"hsv\": { \"h\": %.*f, \"s\": %.*f, \"v\": %.*f },\n"
                "    \"oklab\": { \"L\": %.*f, \"a\": %.*f, \"b\": %.*f },\n"
                "    \"oklch\": { \"L\": %.*f, \"c\": %.*f, \"h\": %.*f },\n"
-               "    \"named\": { \"name\": \"%s\", \"hex\": \"#%06x\", \"wsqrdist\": %.*f }\n"
-               "  }%s\n",
+               "    \"named\": { \"name\": \"%s\", \"hex\": \"#%06x\", \"%s\": %.*f }",
                json_label,
                colorptr->rgb.r, colorptr->rgb.g, colorptr->rgb.b,
                colorptr->hex,
@@ -156,7 +327,14 @@ bool print_color(const color_t *colorptr, const prog_opts_t *opts,
                opts->dplaces, colorptr->hsv.h, opts->dplaces, colorptr->hsv.sat, opts->dplaces, colorptr->hsv.v,
                opts->dplaces, colorptr->oklab.L, opts->dplaces, colorptr->oklab.a, opts->dplaces, colorptr->oklab.b,
                opts->dplaces, colorptr->oklch.L, opts->dplaces, colorptr->oklch.c, opts->dplaces, colorptr->oklch.h,
-               colorptr->named.name, colorptr->named.hex, opts->dplaces, colorptr->named.diff, (json_add_comma ? "," : ""));
+               colorptr->named.name, colorptr->named.hex, named_dist_key(&colorptr->named), opts->dplaces, colorptr->named.diff);
+
+        if (colorptr->alpha < 1.0) printf(",\n    \"alpha\": %.*f", ALPHA_PLACES(opts->dplaces), colorptr->alpha);
+        if (opts->cvd != CVD_NONE) {
+            rgb_t sim = cvd_simulate(opts->cvd, opts->severity, &colorptr->rgb);
+            printf(",\n    \"cvd\": { \"type\": \"%s\", \"severity\": %.*f, \"hex\": \"#%06x\" }", cvd_name(opts->cvd), opts->dplaces, opts->severity, rgb_to_hex(&sim));
+        }
+        printf("\n  }%s\n", (json_add_comma ? "," : ""));
         return false;
     } // end normal json mode
 
@@ -176,6 +354,18 @@ bool print_color(const color_t *colorptr, const prog_opts_t *opts,
     print_color_line_empty(&ctx);
     print_color_line(&ctx, "Named:", "%s", named);
 
+    // simulated color, with a sample of its own when previews are shown
+    if (opts->cvd != CVD_NONE) {
+        rgb_t sim = cvd_simulate(opts->cvd, opts->severity, &colorptr->rgb);
+        char  simbg[C_STR_BUFSIZE] = "", simfg[C_STR_BUFSIZE], sample[STR_BUFSIZE] = "";
+        if (opts->mapping != TC_NONE) {
+            map_rgb_to_sgr_strings(opts->mapping, &sim, simbg, sizeof(simbg), simfg, sizeof(simfg));
+            snprintf(sample, sizeof(sample), "%s    %s%s ", simbg, reset, opts->txtclr ? fgbufptr : "");
+        }
+        print_color_line(&ctx, "CVD  :", "%s%s%06x (%s, severity %.*f)", sample, opts->webfmt ? "#" : "", rgb_to_hex(&sim),
+                         cvd_name(opts->cvd), opts->dplaces, opts->severity);
+    }
+
     // print whether or not the color corresponds exactly to a valid 16- or 256-color mapping
     if (opts->mapping == TC_16) {
         rgb_t mapped = ansi16_idx_to_rgb(ansiidx);  bool match = cmp_rgb(&colorptr->rgb, &mapped);
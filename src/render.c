@@ -0,0 +1,182 @@
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "render.h"
+#include "utility.h"
+
+static const char *render_names[] = { "ppm", "sixel", "kitty" };
+
+const char *render_name(render_t mode) { return (mode >= 0 && mode < (int)ARRAY_LENGTH(render_names)) ? render_names[mode] : NULLSTR; }
+
+bool render_from_name(const char *name, render_t *mode) {
+    for (size_t i = 0; i < ARRAY_LENGTH(render_names); ++i) {
+        if (strcasecmp_own(name, render_names[i])) { *mode = (render_t)i; return true; }
+    }
+    return false;
+}
+
+static void render_flush(renderer_t *r) {
+    if (r->len) fwrite(r->out, 1, r->len, r->f);
+    r->len = 0;
+}
+
+// room for len more bytes in the output buffer
+static inline char *render_reserve(renderer_t *r, size_t len) {
+    if (r->len + len > RENDER_BUFSIZE) render_flush(r);
+    return r->out + r->len;
+}
+
+static inline void render_put(renderer_t *r, const char *s, size_t len) {
+    memcpy(render_reserve(r, len), s, len);
+    r->len += len;
+}
+
+// formatted output of short tokens (escape sequences, color registers)
+static void render_printf(renderer_t *r, const char *fmt, ...) {
+    char    buf[STR_BUFSIZE];
+    va_list ap;
+    va_start(ap, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (len > 0) render_put(r, buf, MIN((size_t)len, sizeof(buf) - 1));
+}
+
+bool render_open(renderer_t *r, FILE *f, render_t mode, size_t w, size_t h, const uint32_t *pal, size_t n) {
+    memset(r, 0, sizeof(*r));
+    r->f    = f;
+    r->mode = mode;
+    r->w    = w;
+    r->h    = h;
+    r->pal  = pal;
+    r->n    = MIN(n, (size_t)SIXEL_COLORS);
+
+    r->out  = malloc(RENDER_BUFSIZE);
+    r->rows = (mode == RENDER_SIXEL) ? malloc(SIXEL_ROWS * w * sizeof(uint16_t)) : NULL;
+    r->raw  = (mode == RENDER_KITTY) ? malloc(KITTY_RAW) : NULL;
+    if (!r->out || (mode == RENDER_SIXEL && !r->rows) || (mode == RENDER_KITTY && !r->raw)) {
+        free(r->out); free(r->rows); free(r->raw);
+        return false;
+    }
+
+    // sixel: dcs with pixels left out kept as they are, then the raster attributes (square pixels, size)
+    if (mode == RENDER_SIXEL) render_printf(r, "\x1bP0;1q\"1;1;%zu;%zu", w, h);
+    return true;
+}
+
+// run of one sixel character
+static void sixel_run(renderer_t *r, int ch, size_t run) {
+    if (run == 0) return;
+    if (run >= SIXEL_RUN) { render_printf(r, "!%zu%c", run, ch); return; }
+
+    char *s = render_reserve(r, run);
+    memset(s, ch, run);
+    r->len += run;
+}
+
+// one band of up to SIXEL_ROWS rows: every color in it (ascending) is set, then its sixels from the left edge up to its
+// last column, colors separated by a graphics carriage return ($) and bands by a graphics new line (-)
+static void sixel_band(renderer_t *r) {
+    size_t w = r->w, rows = r->nrows;
+    size_t lo[SIXEL_COLORS], hi[SIXEL_COLORS];
+    bool   used[SIXEL_COLORS] = { false };
+
+    for (size_t i = 0; i < rows * w; ++i) {
+        size_t c = r->rows[i], x = i % w;
+        if (c >= r->n) continue;
+        if (!used[c]) { used[c] = true; lo[c] = hi[c] = x; }
+        else          { lo[c] = MIN(lo[c], x); hi[c] = MAX(hi[c], x); }
+    }
+
+    if (r->band > 0) render_put(r, "-", 1);
+
+    bool first = true;
+    for (size_t c = 0; c < r->n; ++c) {
+        if (!used[c]) continue;
+        if (!first) render_put(r, "$", 1);
+        first = false;
+
+        // registers take percentages
+        if (!r->defined[c]) {
+            uint32_t p = r->pal[c];
+            render_printf(r, "#%zu;2;%u;%u;%u", c, (((p >> 16) & 0xFF) * 100 + 127) / 255, (((p >> 8) & 0xFF) * 100 + 127) / 255, ((p & 0xFF) * 100 + 127) / 255);
+            r->defined[c] = true;
+        }
+        else render_printf(r, "#%zu", c);
+
+        int    run_ch = -1;
+        size_t run    = 0;
+        for (size_t x = 0; x <= hi[c]; ++x) {
+            int bits = 0;
+            if (x >= lo[c]) for (size_t k = 0; k < rows; ++k) bits |= (r->rows[k * w + x] == c) << k;
+
+            int ch = '?' + bits;
+            if (ch == run_ch) { ++run; continue; }
+            sixel_run(r, run_ch, run);
+            run_ch = ch;
+            run    = 1;
+        }
+        sixel_run(r, run_ch, run);
+    }
+
+    ++r->band;
+    r->nrows = 0;
+}
+
+// one kitty chunk of the raw bytes collected so far, the first one carries the keys (transmit and display, 24-bit rgb,
+// size, no replies), m=1 on every chunk but the last
+static void kitty_chunk(renderer_t *r) {
+    static const char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    int more = r->sent + r->nraw < 3 * r->w * r->h;
+    if (r->sent == 0) render_printf(r, "\x1b_Ga=T,f=24,s=%zu,v=%zu,q=2,m=%d;", r->w, r->h, more);
+    else              render_printf(r, "\x1b_Gm=%d;", more);
+
+    char *s = render_reserve(r, 4 * ((r->nraw + 2) / 3));
+    for (size_t i = 0; i < r->nraw; i += 3) {
+        uint32_t v = (uint32_t)r->raw[i] << 16;
+        if (i + 1 < r->nraw) v |= (uint32_t)r->raw[i + 1] << 8;
+        if (i + 2 < r->nraw) v |= r->raw[i + 2];
+
+        *s++ = b64[v >> 18];
+        *s++ = b64[(v >> 12) & 0x3F];
+        *s++ = (i + 1 < r->nraw) ? b64[(v >> 6) & 0x3F] : '=';
+        *s++ = (i + 2 < r->nraw) ? b64[v & 0x3F] : '=';
+    }
+    r->len += 4 * ((r->nraw + 2) / 3);
+    render_put(r, "\x1b\\", 2);
+
+    r->sent += r->nraw;
+    r->nraw  = 0;
+}
+
+void render_rows(renderer_t *r, const uint32_t *px, const uint16_t *idx, size_t n) {
+    if (r->mode == RENDER_SIXEL) {
+        for (size_t i = 0; i < n; i += r->w) {
+            memcpy(r->rows + r->nrows * r->w, idx + i, r->w * sizeof(uint16_t));
+            if (++r->nrows == SIXEL_ROWS) sixel_band(r);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        r->raw[r->nraw++] = (px[i] >> 16) & 0xFF;
+        r->raw[r->nraw++] = (px[i] >> 8) & 0xFF;
+        r->raw[r->nraw++] = px[i] & 0xFF;
+        if (r->nraw == KITTY_RAW) kitty_chunk(r);
+    }
+}
+
+void render_close(renderer_t *r) {
+    if (r->mode == RENDER_SIXEL) {
+        if (r->nrows > 0) sixel_band(r);
+        render_put(r, "\x1b\\", 2);
+    }
+    else if (r->nraw > 0) kitty_chunk(r);
+
+    render_flush(r);
+    free(r->out);
+    free(r->rows);
+    free(r->raw);
+    memset(r, 0, sizeof(*r));
+}
@@ -0,0 +1,201 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "composite.h"
+#include "kernels.h"
+#include "parser.h"
+#include "store.h"
+
+// grow every allocated column to hold at least n colors
+static bool store_reserve(color_store_t *s, size_t n) {
+    if (n <= s->cap) return true;
+
+    size_t cap = s->cap ? s->cap : 256;
+    while (cap < n) cap *= 2;
+
+    uint32_t *rgb = realloc(s->rgb, cap * sizeof(uint32_t));
+    if (!rgb) return false;
+    s->rgb = rgb;
+
+    if (s->alpha) {
+        uint8_t *alpha = realloc(s->alpha, cap);
+        if (!alpha) return false;
+        s->alpha = alpha;
+    }
+
+    float **cols[] = { &s->L, &s->a, &s->b, &s->C, &s->h };
+    for (size_t c = 0; c < ARRAY_LENGTH(cols); ++c) {
+        if (!*cols[c]) continue;
+        float *p = realloc(*cols[c], cap * sizeof(float));
+        if (!p) return false;
+        *cols[c] = p;
+    }
+
+    s->cap = cap;
+    return true;
+}
+
+void store_init(color_store_t *s) { memset(s, 0, sizeof(*s)); }
+
+void store_free(color_store_t *s) {
+    free(s->rgb); free(s->alpha); free(s->L); free(s->a); free(s->b); free(s->C); free(s->h);
+    store_init(s);
+}
+
+bool store_push(color_store_t *s, hex_t hex) {
+    if (!store_reserve(s, s->size + 1)) return false;
+
+    size_t i = s->size++;
+    s->rgb[i] = hex & 0xFFFFFF;
+    if (s->alpha) s->alpha[i] = 255;
+    if (s->L) rgb8_to_oklab_f32(&s->rgb[i], 1, &s->L[i], &s->a[i], &s->b[i]);
+    if (s->C) oklab_to_oklch_f32(&s->a[i], &s->b[i], 1, &s->C[i], &s->h[i]);
+    return true;
+}
+
+long store_load(color_store_t *s, FILE *f, size_t *bad_line) {
+    char   line[STR_BUFSIZE];
+    size_t lineno = 0;
+    long   n      = 0;
+
+    while (fgets(line, sizeof(line), f)) {
+        ++lineno;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        // skip blank lines
+        const char *p = line;
+        while (*p == ' ' || *p == '\t') ++p;
+        if (!*p) continue;
+
+        hex_t  hex;
+        double alpha;
+        if (!parse_hex_alpha(line, &hex, &alpha)) { if (bad_line) *bad_line = lineno; return -1; }
+        if (!store_push(s, hex)) return -1;
+        if (alpha < 1.0) {
+            // the first translucent color brings the column, everything before it was opaque
+            if (!s->alpha) {
+                if (!(s->alpha = malloc(s->cap))) return -1;
+                memset(s->alpha, 255, s->size);
+            }
+            s->alpha[s->size - 1] = (uint8_t)lround(alpha * 255.0);
+        }
+        ++n;
+    }
+    return n;
+}
+
+bool store_need_oklab(color_store_t *s) {
+    if (s->L) return true;
+
+    size_t cap = s->cap ? s->cap : 1;
+    s->L = malloc(cap * sizeof(float)); s->a = malloc(cap * sizeof(float)); s->b = malloc(cap * sizeof(float));
+    if (!s->L || !s->a || !s->b) { free(s->L); free(s->a); free(s->b); s->L = s->a = s->b = NULL; return false; }
+
+    rgb8_to_oklab_f32(s->rgb, s->size, s->L, s->a, s->b);
+    return true;
+}
+
+bool store_need_oklch(color_store_t *s) {
+    if (s->C) return true;
+    if (!store_need_oklab(s)) return false;
+
+    size_t cap = s->cap ? s->cap : 1;
+    s->C = malloc(cap * sizeof(float)); s->h = malloc(cap * sizeof(float));
+    if (!s->C || !s->h) { free(s->C); free(s->h); s->C = s->h = NULL; return false; }
+
+    oklab_to_oklch_f32(s->a, s->b, s->size, s->C, s->h);
+    return true;
+}
+
+// move color src to position dst in every column
+static inline void store_move(color_store_t *s, size_t dst, size_t src) {
+    s->rgb[dst] = s->rgb[src];
+    if (s->alpha) s->alpha[dst] = s->alpha[src];
+    if (s->L) { s->L[dst] = s->L[src]; s->a[dst] = s->a[src]; s->b[dst] = s->b[src]; }
+    if (s->C) { s->C[dst] = s->C[src]; s->h[dst] = s->h[src]; }
+}
+
+bool store_dedupe(color_store_t *s) {
+    // one bit per possible 24-bit color (2 MiB), cheaper than hashing for large stores
+    uint8_t *seen = calloc((1u << 24) / 8, 1);
+    if (!seen) return false;
+
+    size_t n = 0;
+    for (size_t i = 0; i < s->size; ++i) {
+        uint32_t v = s->rgb[i];
+        if (seen[v >> 3] & (1u << (v & 7))) continue;
+        seen[v >> 3] |= (uint8_t)(1u << (v & 7));
+        store_move(s, n++, i);
+    }
+
+    free(seen);
+    s->size = n;
+    return true;
+}
+
+// sort record, the index breaks ties to keep the sort stable
+typedef struct { float key; uint32_t idx; } store_sortrec_t;
+
+static int cmp_sortrec(const void *pa, const void *pb) {
+    const store_sortrec_t *a = pa, *b = pb;
+    if (a->key < b->key) return -1;
+    if (a->key > b->key) return  1;
+    return (a->idx > b->idx) - (a->idx < b->idx);
+}
+
+// reorder a column according to the sorted records
+static void permute_u32(uint32_t *col, const store_sortrec_t *rec, size_t n, uint32_t *tmp) {
+    for (size_t i = 0; i < n; ++i) tmp[i] = col[rec[i].idx];
+    memcpy(col, tmp, n * sizeof(uint32_t));
+}
+
+static void permute_u8(uint8_t *col, const store_sortrec_t *rec, size_t n, uint8_t *tmp) {
+    if (!col) return;
+    for (size_t i = 0; i < n; ++i) tmp[i] = col[rec[i].idx];
+    memcpy(col, tmp, n);
+}
+
+static void permute_f32(float *col, const store_sortrec_t *rec, size_t n, float *tmp) {
+    if (!col) return;
+    for (size_t i = 0; i < n; ++i) tmp[i] = col[rec[i].idx];
+    memcpy(col, tmp, n * sizeof(float));
+}
+
+bool store_sort(color_store_t *s, store_key_t key, bool descending) {
+    if (key == STORE_KEY_L && !store_need_oklab(s)) return false;
+    if ((key == STORE_KEY_C || key == STORE_KEY_H) && !store_need_oklch(s)) return false;
+
+    size_t           n   = s->size;
+    store_sortrec_t *rec = malloc((n ? n : 1) * sizeof(store_sortrec_t));
+    float           *tmp = malloc((n ? n : 1) * sizeof(float)); // also used for the rgb column (same size)
+    if (!rec || !tmp) { free(rec); free(tmp); return false; }
+
+    for (size_t i = 0; i < n; ++i) {
+        // 24-bit values are exact in a float
+        float k = (key == STORE_KEY_L) ? s->L[i] : (key == STORE_KEY_C) ? s->C[i] : (key == STORE_KEY_H) ? s->h[i] : (float)s->rgb[i];
+        rec[i]  = (store_sortrec_t){ .key = descending ? -k : k, .idx = (uint32_t)i };
+    }
+    qsort(rec, n, sizeof(store_sortrec_t), cmp_sortrec);
+
+    permute_u32(s->rgb, rec, n, (uint32_t *)tmp);
+    permute_u8(s->alpha, rec, n, (uint8_t *)tmp);
+    permute_f32(s->L, rec, n, tmp); permute_f32(s->a, rec, n, tmp); permute_f32(s->b, rec, n, tmp);
+    permute_f32(s->C, rec, n, tmp); permute_f32(s->h, rec, n, tmp);
+
+    free(rec);
+    free(tmp);
+    return true;
+}
+
+void store_flatten(color_store_t *s, hex_t bg, blend_t mode, bool linear) {
+    if (!s->alpha) return;
+
+    // derived columns were computed from the translucent colors, rebuild them from the flattened ones
+    composite_rgb8(s->rgb, s->alpha, &bg, 0, s->size, mode, linear, s->rgb);
+    if (s->L) rgb8_to_oklab_f32(s->rgb, s->size, s->L, s->a, s->b);
+    if (s->C) oklab_to_oklch_f32(s->a, s->b, s->size, s->C, s->h);
+
+    free(s->alpha);
+    s->alpha = NULL;
+}
@@ -10,14 +10,92 @@
 #include "utility.h"
 #include "printer.h"
 
-double srgb_to_linear(double c) {
-    if (c <= 0.04045) return c / 12.92;
-    return pow((c + 0.055) / 1.055, 2.4);
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// model math shared with src/converter.c and src/converter_f32.c
+#define CV_REAL   double
+#define CV_SFX    f64
+#define CV_C(_x)  _x
+#define CV_M(_fn) _fn
+#define CV_ZERO   ZERO_THRESH
+#include "convert_impl.h"
+
+double srgb_to_linear(double c) { return cv_srgb_to_linear_f64(c); }
+double linear_to_srgb(double c) { return cv_linear_to_srgb_f64(c); }
+
+double pq_to_nits(double e)     { return PQ_MAX_NITS * cv_pq_to_linear_f64(CLAMP(e, 0.0, 1.0)); }
+double nits_to_pq(double nits)  { return cv_linear_to_pq_f64(CLAMP(nits / PQ_MAX_NITS, 0.0, 1.0)); }
+double hlg_to_scene(double e)   { return cv_hlg_to_linear_f64(CLAMP(e, 0.0, 1.0)); }
+double scene_to_hlg(double l)   { return cv_linear_to_hlg_f64(CLAMP(l, 0.0, 1.0)); }
+double hlg_to_nits(double e)    { return HLG_PEAK_NITS * pow(hlg_to_scene(e), HLG_GAMMA); }
+double nits_to_hlg(double nits) { return scene_to_hlg(pow(MAX(nits, 0.0) / HLG_PEAK_NITS, 1.0 / HLG_GAMMA)); }
+
+// bt.2020 luminance, scene light (ootf) or display light (inverse)
+static inline double hlg_luminance(const double rgb[3]) { return 0.2627 * rgb[0] + 0.6780 * rgb[1] + 0.0593 * rgb[2]; }
+
+void hlg_ootf(double rgb[3]) {
+    double ys   = hlg_luminance(rgb);
+    double gain = (ys > 0.0) ? HLG_PEAK_NITS * pow(ys, HLG_GAMMA - 1.0) : 0.0;
+    for (int k = 0; k < 3; ++k) rgb[k] *= gain;
 }
 
-double linear_to_srgb(double c) {
-    if (c <= 0.0031308) return 12.92 * c;
-    return 1.055 * pow(c, 1.0 / 2.4) - 0.055;
+// Yd = Lw * Ys^gamma, so the scene light is the display light times Ys / Yd
+void hlg_inverse_ootf(double rgb[3]) {
+    double yd   = hlg_luminance(rgb);
+    double gain = (yd > 0.0) ? pow(yd / HLG_PEAK_NITS, 1.0 / HLG_GAMMA) / yd : 0.0;
+    for (int k = 0; k < 3; ++k) rgb[k] *= gain;
+}
+
+const float *srgb_to_linear_lut8() {
+    static float       lut[256];
+    static atomic_bool ready = false;
+
+    if (!once_ready(&ready)) {
+        #pragma omp critical(srgb_lut8)
+        if (!once_ready(&ready)) {
+            for (int i = 0; i < 256; ++i) lut[i] = (float)srgb_to_linear(i / 255.0);
+            once_done(&ready);
+        }
+    }
+    return lut;
+}
+
+const double *srgb_to_linear_lut8d() {
+    static double      lut[256];
+    static atomic_bool ready = false;
+
+    if (!once_ready(&ready)) {
+        #pragma omp critical(srgb_lut8d)
+        if (!once_ready(&ready)) {
+            for (int i = 0; i < 256; ++i) lut[i] = srgb_to_linear(i / 255.0);
+            once_done(&ready);
+        }
+    }
+    return lut;
+}
+
+const srgb8_enc_t *linear_to_srgb8_lut() {
+    static srgb8_enc_t enc;
+    static atomic_bool ready = false;
+
+    if (!once_ready(&ready)) {
+        #pragma omp critical(srgb8_enc)
+        if (!once_ready(&ready)) {
+            for (int k = 0; k < 255; ++k) enc.mid[k] = (float)srgb_to_linear((k + 0.5) / 255.0);
+            enc.mid[255] = INFINITY;
+
+            int code = 0;
+            for (int i = 0; i <= SRGB8_ENC_BUCKETS; ++i) {
+                float v = (float)i / SRGB8_ENC_BUCKETS;
+                while (v >= enc.mid[code]) ++code;
+                enc.lo[i] = code;
+            }
+            once_done(&ready);
+        }
+    }
+    return &enc;
 }
 
 double relative_luminance_rgb(const rgb_t *rgb) {
@@ -26,29 +104,36 @@ double relative_luminance_rgb(const rgb_t *rgb) {
     double r = srgb_to_linear(rgb->r / 255.0);
     double g = srgb_to_linear(rgb->g / 255.0);
     double b = srgb_to_linear(rgb->b / 255.0);
-    return 0.2126 * r + 0.7152 * g + 0.0722 * b;
+    return cv_luminance_f64(r, g, b);
 }
 
 double dist2_rgb(const rgb_t *a, const rgb_t *b) {
-    double dr = (double)a->r - (double)b->r;
-    double dg = (double)a->g - (double)b->g;
-    double db = (double)a->b - (double)b->b;
-    return dr * dr + dg * dg + db * db;
+    return cv_wdist2_3_f64(a->r, a->g, a->b, b->r, b->g, b->b, 1.0, 1.0, 1.0);
 }
 
 double weighted_dist2_rgb(const rgb_t *a, const rgb_t *b, double wr, double wg, double wb) {
-    double dr = (double)a->r - (double)b->r;
-    double dg = (double)a->g - (double)b->g;
-    double db = (double)a->b - (double)b->b;
-    return wr * dr * dr + wg * dg * dg + wb * db * db;
+    return cv_wdist2_3_f64(a->r, a->g, a->b, b->r, b->g, b->b, wr, wg, wb);
 }
 
 double dist2_oklab(const oklab_t *a, const oklab_t *b) {
-    return (a->L - b->L) * (a->L - b->L)
-         + (a->a - b->a) * (a->a - b->a)
-         + (a->b - b->b) * (a->b - b->b);
+    return cv_dist2_3_f64(a->L, a->a, a->b, b->L, b->a, b->b);
 }
 
+double delta_e(cdiff_t metric, const lab_t *ref, const lab_t *sample) {
+    switch (metric) {
+        case CDIFF_DE94:   return cv_delta_e94_f64(ref->L, ref->a, ref->b, sample->L, sample->a, sample->b);
+        case CDIFF_DE2000: return cv_delta_e2000_f64(ref->L, ref->a, ref->b, sample->L, sample->a, sample->b);
+        case CDIFF_CMC:    return cv_delta_e_cmc_f64(ref->L, ref->a, ref->b, sample->L, sample->a, sample->b, 2.0, 1.0);
+        default:           return cv_delta_e76_f64(ref->L, ref->a, ref->b, sample->L, sample->a, sample->b);
+    }
+}
+
+static const char *cdiff_keys[] = { "rgb2", "wrgb2", "oklab2", "de76", "de94", "de2000", "cmc" };
+
+const char *cdiff_key(cdiff_t metric) { return (metric >= 0 && metric < (int)ARRAY_LENGTH(cdiff_keys)) ? cdiff_keys[metric] : NULLSTR; }
+
+const char *named_dist_key(const named_t *named) { return (named->metric == CDIFF_WRGB) ? "wsqrdist" : cdiff_key(named->metric); }
+
 const char *tcolor_tostr(color_cap_t c) {
     switch (c) {
         case TC_NONE:      return "none";
@@ -124,7 +209,7 @@ void fmt_color_strings(const color_t *colorptr, bool webfmt, int dplaces,
         if (hsv && hsv_s)     snprintf(hsv,   hsv_s,   "hsv(%.*f,%.*f%%,%.*f%%)",           dplaces, colorptr->hsv.h, dplaces, colorptr->hsv.sat * 100.0, dplaces, colorptr->hsv.v * 100.0);
         if (oklab && oklab_s) snprintf(oklab, oklab_s, "oklab(%.*f%%,%.*f,%.*f)",           dplaces, colorptr->oklab.L * 100.0, dplaces, colorptr->oklab.a, dplaces, colorptr->oklab.b);
         if (oklch && oklch_s) snprintf(oklch, oklch_s, "oklch(%.*f%%,%.*f%%,%.*f)",         dplaces, colorptr->oklch.L * 100.0, dplaces, colorptr->oklch.c * 100.0, dplaces, colorptr->oklch.h);
-        if (named && named_s) snprintf(named, named_s, "%s (#%06x) (dist² %.*f)",           colorptr->named.name, colorptr->named.hex, dplaces, colorptr->named.diff);
+        if (named && named_s) snprintf(named, named_s, "%s (#%06x) (%s %.*f)",              colorptr->named.name, colorptr->named.hex, (colorptr->named.metric >= CDIFF_DE76) ? "ΔE" : "dist²", dplaces, colorptr->named.diff);
     } else {
         if (rgb && rgb_s)     snprintf(rgb,   rgb_s,   "%d,%d,%d",                          colorptr->rgb.r, colorptr->rgb.g, colorptr->rgb.b);
         if (hex && hex_s)     snprintf(hex,   hex_s,   "%06x",                              colorptr->hex);
@@ -133,8 +218,28 @@ void fmt_color_strings(const color_t *colorptr, bool webfmt, int dplaces,
         if (hsv && hsv_s)     snprintf(hsv,   hsv_s,   "%.*f,%.*f%%,%.*f%%",                dplaces, colorptr->hsv.h, dplaces, colorptr->hsv.sat * 100.0, dplaces, colorptr->hsv.v * 100.0);
         if (oklab && oklab_s) snprintf(oklab, oklab_s, "%.*f%%,%.*f,%.*f",                  dplaces, colorptr->oklab.L * 100.0, dplaces, colorptr->oklab.a, dplaces, colorptr->oklab.b);
         if (oklch && oklch_s) snprintf(oklch, oklch_s, "%.*f%%,%.*f%%,%.*f",                dplaces, colorptr->oklch.L * 100.0, dplaces, colorptr->oklch.c * 100.0, dplaces, colorptr->oklch.h);
-        if (named && named_s) snprintf(named, named_s, "%s (%06x) (dist² %.*f)",            colorptr->named.name, colorptr->named.hex, dplaces, colorptr->named.diff);
+        if (named && named_s) snprintf(named, named_s, "%s (%06x) (%s %.*f)",               colorptr->named.name, colorptr->named.hex, (colorptr->named.metric >= CDIFF_DE76) ? "ΔE" : "dist²", dplaces, colorptr->named.diff);
+    }
+
+    // translucent colors carry their opacity: "rrggbbaa" ("#rrggbbaa" in web format), the legacy "rgba(..., a)" forms where
+    // css has them, a trailing " / a" everywhere else (the name is the one of the color itself)
+    if (!(colorptr->alpha < 1.0)) return;
+
+    int    ap      = ALPHA_PLACES(dplaces);
+    char  *bufs[]  = { rgb,   hsl,   hsv,   oklab,   oklch,   cmyk   };
+    size_t sizes[] = { rgb_s, hsl_s, hsv_s, oklab_s, oklch_s, cmyk_s };
+    for (size_t i = 0; i < ARRAY_LENGTH(bufs); ++i) {
+        if (!bufs[i] || !sizes[i]) continue;
+
+        size_t len = strlen(bufs[i]);
+        bool   fn  = webfmt && len && bufs[i][len - 1] == ')';
+        if (fn) bufs[i][--len] = '\0';
+
+        // rgb, hsl and hsv become rgba(), hsla() and hsva() in web format (hsv has no css function, same spelling)
+        if (webfmt && i < 3 && len + 1 < sizes[i]) { memmove(bufs[i] + 4, bufs[i] + 3, len - 2); bufs[i][3] = 'a'; ++len; }
+        snprintf(bufs[i] + len, sizes[i] - len, (webfmt && i < 3) ? ",%.*f%s" : " / %.*f%s", ap, colorptr->alpha, fn ? ")" : "");
     }
+    if (hex && hex_s) snprintf(hex, hex_s, webfmt ? "#%06x%02x" : "%06x%02x", colorptr->hex, (unsigned)lround(colorptr->alpha * 255.0));
 }
 
 
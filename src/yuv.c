@@ -0,0 +1,192 @@
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "colorspace.h"
+#include "image.h"
+#include "printer.h"
+#include "yuv.h"
+
+// luma weights of red and blue per standard (green is the rest)
+static const double ycbcr_k[3][2] = {
+    { W_R,    W_B    }, // bt.601
+    { 0.2126, 0.0722 }, // bt.709
+    { 0.2627, 0.0593 }, // bt.2020
+};
+
+static ycbcr_std_t ycbcr_std  = YCBCR_BT709;
+static bool        ycbcr_full = false;
+
+void set_ycbcr(ycbcr_std_t std, bool full) { ycbcr_std = std; ycbcr_full = full; }
+
+// code value span of luma and chroma for the current range
+static inline double yspan() { return ycbcr_full ? 255.0 : 219.0; }
+static inline double cspan() { return ycbcr_full ? 255.0 : 224.0; }
+static inline double ylo()   { return ycbcr_full ? 0.0 : 16.0; }
+
+ycbcr_t rgb_to_ycbcr(const rgb_t *rgb) {
+    double kr = ycbcr_k[ycbcr_std][0], kb = ycbcr_k[ycbcr_std][1], kg = 1.0 - kr - kb;
+    double r  = rgb->r / 255.0, g = rgb->g / 255.0, b = rgb->b / 255.0;
+    double y  = kr * r + kg * g + kb * b;
+
+    return (ycbcr_t){ .y  = ylo() + yspan() * y,
+                      .cb = 128.0 + cspan() * (b - y) / (2.0 * (1.0 - kb)),
+                      .cr = 128.0 + cspan() * (r - y) / (2.0 * (1.0 - kr)) };
+}
+
+rgb_t ycbcr_to_rgb(const ycbcr_t *ycc) {
+    double kr = ycbcr_k[ycbcr_std][0], kb = ycbcr_k[ycbcr_std][1], kg = 1.0 - kr - kb;
+    double y  = (ycc->y - ylo()) / yspan(), pb = (ycc->cb - 128.0) / cspan(), pr = (ycc->cr - 128.0) / cspan();
+
+    double r = y + 2.0 * (1.0 - kr) * pr;
+    double b = y + 2.0 * (1.0 - kb) * pb;
+    double g = (y - kr * r - kb * b) / kg;
+    return (rgb_t){ .r = (int)round(CLAMP(r, 0.0, 1.0) * 255.0),
+                    .g = (int)round(CLAMP(g, 0.0, 1.0) * 255.0),
+                    .b = (int)round(CLAMP(b, 0.0, 1.0) * 255.0) };
+}
+
+void yuv_coefficients(yuv_coef_t *c) {
+    double kr = ycbcr_k[ycbcr_std][0], kb = ycbcr_k[ycbcr_std][1], kg = 1.0 - kr - kb;
+    double ys = yspan() / 255.0, cs = cspan() / 255.0, one = 65536.0;
+
+    // the weights of each row are rounded so they still sum to exactly the scale (grays stay gray, white stays white)
+    c->y[0]  = (int32_t)round(kr * ys * one);
+    c->y[2]  = (int32_t)round(kb * ys * one);
+    c->y[1]  = (int32_t)round(ys * one) - c->y[0] - c->y[2];
+    c->cb[0] = (int32_t)round(-kr / (2.0 * (1.0 - kb)) * cs * one);
+    c->cb[2] = (int32_t)round(0.5 * cs * one);
+    c->cb[1] = -c->cb[0] - c->cb[2];
+    c->cr[0] = (int32_t)round(0.5 * cs * one);
+    c->cr[2] = (int32_t)round(-kb / (2.0 * (1.0 - kr)) * cs * one);
+    c->cr[1] = -c->cr[0] - c->cr[2];
+
+    c->ylo = (int32_t)ylo();
+    c->ys  = (int32_t)round(one / ys);
+    c->rcr = (int32_t)round(2.0 * (1.0 - kr) / cs * one);
+    c->bcb = (int32_t)round(2.0 * (1.0 - kb) / cs * one);
+    c->gcb = (int32_t)round(2.0 * kb * (1.0 - kb) / kg / cs * one);
+    c->gcr = (int32_t)round(2.0 * kr * (1.0 - kr) / kg / cs * one);
+}
+
+size_t yuv_frame_size(size_t w, size_t h) { return w * h + 2 * ((w + 1) / 2) * ((h + 1) / 2); }
+
+// chroma planes of a frame: offset of the first cb / cr sample, bytes between samples and between rows
+static void yuv_chroma(int layout, size_t w, size_t h, size_t *cb, size_t *cr, size_t *step, size_t *stride) {
+    size_t cw = (w + 1) / 2, ch = (h + 1) / 2;
+
+    if (layout == YUV_NV12) { *cb = w * h; *cr = w * h + 1;       *step = 2; *stride = 2 * cw; }
+    else                    { *cb = w * h; *cr = w * h + cw * ch; *step = 1; *stride = cw; }
+}
+
+void yuv_frame_encode(const yuv_coef_t *c, int layout, const uint32_t *rgb, size_t w, size_t h, uint8_t *frame) {
+    size_t cb, cr, step, stride, ch = (h + 1) / 2;
+    yuv_chroma(layout, w, h, &cb, &cr, &step, &stride);
+
+    #pragma omp parallel for schedule(static) if (w * h > YUV_PAR_MIN)
+    for (size_t j = 0; j < ch; ++j) {
+        size_t r0 = 2 * j, r1 = MIN(r0 + 1, h - 1);
+        rgb8_to_y8(c, rgb + r0 * w, w, frame + r0 * w);
+        if (r1 != r0) rgb8_to_y8(c, rgb + r1 * w, w, frame + r1 * w);
+        rgb8_to_cbcr420(c, rgb + r0 * w, rgb + r1 * w, w, frame + cb + j * stride, frame + cr + j * stride, step);
+    }
+}
+
+void yuv_frame_decode(const yuv_coef_t *c, int layout, const uint8_t *frame, size_t w, size_t h, uint32_t *rgb) {
+    size_t cb, cr, step, stride;
+    yuv_chroma(layout, w, h, &cb, &cr, &step, &stride);
+
+    #pragma omp parallel for schedule(static) if (w * h > YUV_PAR_MIN)
+    for (size_t y = 0; y < h; ++y) {
+        size_t j = y / 2;
+        yuv420_to_rgb8(c, frame + y * w, frame + cb + j * stride, frame + cr + j * stride, step, w, rgb + y * w);
+    }
+}
+
+// raw frames -> ppm images
+static int yuv_to_ppm(const prog_opts_t *opts, const yuv_coef_t *c, const char *progname) {
+    size_t w = opts->yuvw, h = opts->yuvh, size = yuv_frame_size(w, h);
+
+    FILE *f = (strcmp(opts->yuv, "-") == 0) ? stdin : fopen(opts->yuv, "rb");
+    if (!f) ERROR_EXIT("could not open %s", opts->yuv);
+
+    uint8_t  *frame = malloc(size);
+    uint32_t *px    = malloc(w * h * sizeof(uint32_t));
+    uint8_t  *buf   = malloc(3 * w * h);
+    if (!frame || !px || !buf) ERROR_EXIT("out of memory for frames of %zux%zu", w, h);
+
+    size_t frames = 0;
+    for (;; ++frames) {
+        size_t got = fread(frame, 1, size, f);
+        if (got == 0)    break;
+        if (got != size) ERROR_EXIT("%s ends within frame %zu (%zu of %zu bytes)", opts->yuv, frames, got, size);
+
+        yuv_frame_decode(c, opts->layout, frame, w, h, px);
+        ppm_write_header(stdout, w, h);
+        ppm_write_pixels(stdout, buf, px, w * h);
+    }
+    if (frames == 0) ERROR_EXIT("%s holds no frame of %zux%zu", opts->yuv, w, h);
+
+    if (f != stdin) fclose(f);
+    free(frame);
+    free(px);
+    free(buf);
+    return 0;
+}
+
+// ppm images -> raw frames
+static int ppm_to_yuv(const prog_opts_t *opts, const yuv_coef_t *c, const char *progname) {
+    FILE *f = (strcmp(opts->toyuv, "-") == 0) ? stdin : fopen(opts->toyuv, "rb");
+    if (!f) ERROR_EXIT("could not open image %s", opts->toyuv);
+
+    size_t    w = 0, h = 0, frames = 0;
+    uint8_t  *frame = NULL, *buf = NULL;
+    uint16_t *smp   = NULL;
+    uint32_t *px    = NULL;
+
+    for (;; ++frames) {
+        // images follow each other, possibly separated by whitespace
+        int ch;
+        while ((ch = fgetc(f)) != EOF && isspace(ch)) {}
+        if (ch == EOF) break;
+        ungetc(ch, f);
+
+        size_t   iw, ih;
+        unsigned maxval;
+        if (!ppm_read_header(f, &iw, &ih, &maxval)) ERROR_EXIT("image %zu of %s is not a binary ppm (P6)", frames, opts->toyuv);
+        if (frames == 0) {
+            w = iw; h = ih;
+            frame = malloc(yuv_frame_size(w, h));
+            px    = malloc(w * h * sizeof(uint32_t));
+            buf   = malloc(6 * w * h);
+            smp   = malloc(3 * w * h * sizeof(uint16_t));
+            if (!frame || !px || !buf || !smp) ERROR_EXIT("out of memory for an image of %zux%zu", w, h);
+        }
+        else if (iw != w || ih != h) ERROR_EXIT("image %zu of %s is %zux%zu, not %zux%zu like the first", frames, opts->toyuv, iw, ih, w, h);
+
+        bool read = (maxval == 255) ? ppm_read_pixels(f, buf, px, w * h) : ppm_read_samples(f, buf, smp, w * h, maxval);
+        if (!read) ERROR_EXIT("image %zu of %s ends early", frames, opts->toyuv);
+        if (maxval != 255) rgbspace_rgb16_to_srgb8(RGBSPACE_SRGB, GAMUT_CLIP, maxval, smp, w * h, px);
+
+        yuv_frame_encode(c, opts->layout, px, w, h, frame);
+        fwrite(frame, 1, yuv_frame_size(w, h), stdout);
+    }
+    if (frames == 0) ERROR_EXIT("%s holds no image", opts->toyuv);
+
+    if (f != stdin) fclose(f);
+    free(frame);
+    free(px);
+    free(buf);
+    free(smp);
+    return 0;
+}
+
+int run_yuv(const prog_opts_t *opts, const char *progname) {
+    yuv_coef_t c;
+    yuv_coefficients(&c);
+
+    if (opts->toyuv) return ppm_to_yuv(opts, &c, progname);
+    if (!opts->yuvw) ERROR_EXIT("--yuv needs the frame size (--size <w>x<h>)");
+    return yuv_to_ppm(opts, &c, progname);
+}
@@ -1,10 +1,30 @@
 // test_color.c
 #include <errno.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <unistd.h>
 
+#include "colorspace.h"
+#include "composite.h"
+#include "contrast.h"
+#include "converter.h"
+#include "cube.h"
+#include "cvd.h"
+#include "dither.h"
+#include "gradient.h"
+#include "kernels.h"
+#include "lut.h"
+#include "matrix.h"
+#include "palette.h"
 #include "parser.h"
+#include "render.h"
+#include "store.h"
+#include "utility.h"
+#include "yuv.h"
 
 // terminal output: column widths
 #define TEST_W_STATUS 6
@@ -16,6 +36,11 @@
 // tolerance for floating point comparisons (CMYK/HSL/HSV)
 #define EPS 1e-6
 
+// reference output files, the makefile passes their absolute path so the tests run from any directory
+#ifndef GOLDEN_DIR
+#define GOLDEN_DIR "tests/golden"
+#endif
+
 // struct containing test case information
 typedef struct test_case_t {
     const char *id;       // test name
@@ -160,6 +185,1285 @@ static void print_result_row(const test_case_t *t, bool passed, int rc, const co
     printf(C_RESET " \n");
 }
 
+// result row for checks that are not parse tests
+static void print_check_row(const char *id, const char *input, const char *expected, const char *actual, bool passed) {
+    if (passed) printf(C_GREEN "%-*s " C_RESET, TEST_W_STATUS, "PASS");
+    else        printf(C_RED   "%-*s " C_RESET, TEST_W_STATUS, "FAIL");
+
+    printf("%s%-*s ", passed ? C_LGREEN : C_LRED, TEST_W_ID, id);
+    printf(passed ? C_GREEN : C_RED);   print_col(input, TEST_W_INPUT);     printf(C_RESET " ");
+    printf(passed ? C_LGREEN : C_LRED); print_col(expected, TEST_W_EXPECT); printf(C_RESET " ");
+    printf(passed ? C_GREEN : C_RED);   print_col(actual, TEST_W_ACTUAL);   printf(C_RESET " \n");
+}
+
+// result row of a check with the actual value formatted from fmt, returns passed
+static bool report_check(const char *id, const char *input, const char *expected, bool passed, const char *fmt, ...) {
+    char    actual[STR_BUFSIZE];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(actual, sizeof(actual), fmt, ap);
+    va_end(ap);
+    print_check_row(id, input, expected, actual, passed);
+    return passed;
+}
+
+// test data: the next 24 bits of a linear congruential generator
+static inline uint32_t lcg_next(uint32_t *seed) {
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed >> 8;
+}
+
+// n pseudo-random packed 0xrrggbb colors, returns the seed to continue with
+static uint32_t fill_random_rgb(uint32_t seed, uint32_t *buf, size_t n) {
+    for (size_t i = 0; i < n; ++i) buf[i] = lcg_next(&seed);
+    return seed;
+}
+
+// n pseudo-random floats in [0, 1), returns the seed to continue with
+static uint32_t fill_random_f32(uint32_t seed, float *buf, size_t n) {
+    for (size_t i = 0; i < n; ++i) buf[i] = lcg_next(&seed) / 16777216.0f;
+    return seed;
+}
+
+// lookups through a freshly built cache must give what the scans they replace give, on a strided sample of the rgb cube
+// only run with COLOR_TEST_LUT set: building the cache takes a while and writes ~96 MiB to the temp directory
+static bool run_lut_check() {
+    char path[STR_BUFSIZE];
+    snprintf(path, sizeof(path), "%s/color_test_%ld.lut", P_tmpdir, (long)getpid());
+    setenv("COLOR_LUT", path, 1);
+
+    bool built   = lut_build() == 0;
+    long checked = 0, miss = 0;
+    for (hex_t v = 0; built && v < (1u << 24); v += 97, ++checked) {
+        rgb_t rgb = hex_to_rgb(v);
+        miss += lut_named_idx(LUT_CSS, v)  != (int)closest_named_index_scan(get_named_table(false), &rgb, NULL);
+        miss += lut_named_idx(LUT_XKCD, v) != (int)closest_named_index_scan(get_named_table(true), &rgb, NULL);
+        miss += lut_ansi256_idx(v) != rgb_to_ansi256_idx_scan(&rgb);
+        miss += lut_ansi16_idx(v)  != rgb_to_ansi16_idx_scan(&rgb);
+    }
+    unlink(path);
+    unsetenv("COLOR_LUT");
+
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%ld colors, 4 tables", checked);
+    return report_check("lut-vs-scan", input, "built, 0 misses", built && miss == 0, "%s, %ld misses", built ? "built" : "not built", miss);
+}
+
+// the closest name of every -D metric against a double scan of the table: exact for the integer rgb metrics, within
+// float rounding of the best distance for the float kernels, with the json key of its metric
+static bool run_named_check() {
+    enum { N = 2048 };
+    static uint32_t rgb[N];
+    static const cdiff_t metrics[] = { CDIFF_ALL, CDIFF_RGB, CDIFF_OKLAB, CDIFF_DE76, CDIFF_DE94, CDIFF_DE2000, CDIFF_CMC };
+    static const char   *keys[]    = { "wsqrdist", "rgb2", "oklab2", "de76", "de94", "de2000", "cmc" };
+    fill_random_rgb(99, rgb, N);
+
+    const named_table_t *tbl = get_named_table(false);
+    long   miss = 0, badkey = 0;
+    double maxerr = 0.0;
+    for (size_t m = 0; m < ARRAY_LENGTH(metrics); ++m) {
+        set_named_metric(metrics[m]);
+        for (size_t i = 0; i < N; ++i) {
+            rgb_t   in  = hex_to_rgb(rgb[i]);
+            named_t got = closest_named(&in);
+            oklab_t qo  = rgb_to_oklab(&in);
+            lab_t   ql  = rgb_to_lab(&in);
+
+            double best = INFINITY;
+            size_t bi   = 0;
+            for (size_t j = 0; j < tbl->size; ++j) {
+                rgb_t  c = hex_to_rgb(tbl->hex[j]);
+                double d;
+                switch (metrics[m]) {
+                    case CDIFF_ALL:   d = weighted_dist2_rgb(&in, &c, W_R, W_G, W_B);          break;
+                    case CDIFF_RGB:   d = dist2_rgb(&in, &c);                                  break;
+                    case CDIFF_OKLAB: { oklab_t o = rgb_to_oklab(&c); d = dist2_oklab(&qo, &o); break; }
+                    default:          { lab_t l = rgb_to_lab(&c); d = delta_e(metrics[m], &ql, &l); break; }
+                }
+                if (d < best) { best = d; bi = j; }
+            }
+
+            if (metrics[m] == CDIFF_ALL || metrics[m] == CDIFF_RGB) miss += strcmp(got.name, tbl->pool + tbl->offs[bi]) != 0;
+            else                                                    maxerr = fmax(maxerr, got.diff - best);
+            badkey += strcmp(named_dist_key(&got), keys[m]) != 0;
+        }
+    }
+    set_named_metric(CDIFF_ALL);
+
+    bool pass = miss == 0 && maxerr < 1e-4 && badkey == 0;
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%d colors, %zu metrics", N, ARRAY_LENGTH(metrics));
+    return report_check("closest-named-scan", input, "0 miss, err < 1e-4, 0 keys", pass, "%ld miss, err %.1e, %ld keys", miss, maxerr, badkey);
+}
+
+// batch input: blank lines skipped, opacities kept, the line of a parse error, every sort key in both directions (stable,
+// all columns moved together) and dedupe keeping first occurrences
+static bool run_store_check() {
+    static const char *lines = "#ff0000\n\n  \nrgb(0, 0, 255)\n#00ff0080\nnavy\n#ff0000cc\n#000000\n";
+    static const uint32_t load_rgb[]   = { 0xff0000, 0x0000ff, 0x00ff00, 0x000080, 0xff0000, 0x000000 };
+    static const uint8_t  load_alpha[] = { 255, 255, 128, 255, 204, 255 };
+    static const uint32_t hex_asc[]    = { 0x000000, 0x000080, 0x0000ff, 0x00ff00, 0xff0000, 0xff0000 };
+    static const uint32_t L_desc[]     = { 0x00ff00, 0xff0000, 0xff0000, 0x0000ff, 0x000080, 0x000000 };
+    static const uint32_t uniq[]       = { 0xff0000, 0x0000ff, 0x00ff00, 0x000080, 0x000000 };
+    static const uint8_t  uniq_alpha[] = { 255, 255, 128, 255, 255 };
+    enum { N = ARRAY_LENGTH(load_rgb) };
+
+    FILE *f = tmpfile(), *bad = tmpfile();
+    if (!f || !bad) return report_check("store-load-sort-dedupe", "6 colors", "loaded", false, "no temporary file");
+    fputs(lines, f);
+    fputs("#fff\nnotacolor\n", bad);
+    rewind(bad);
+
+    color_store_t s;
+    store_init(&s);
+    size_t bad_line = 0;
+    bool   load     = store_load(&s, bad, &bad_line) == -1 && bad_line == 2;
+    store_free(&s);
+
+    rewind(f);
+    load = load && store_load(&s, f, NULL) == N && s.alpha;
+    for (size_t i = 0; load && i < N; ++i) load = s.rgb[i] == load_rgb[i] && s.alpha[i] == load_alpha[i];
+
+    // every key both ways: keys ordered, colors and opacities still paired, the oklab lightness of each color still its own,
+    // the two reds (equal keys) in input order
+    bool sort = load;
+    for (int key = STORE_KEY_HEX; sort && key <= STORE_KEY_H; ++key) {
+        for (int desc = 0; sort && desc < 2; ++desc) {
+            sort = store_sort(&s, (store_key_t)key, desc);
+
+            long red = -1;
+            for (size_t i = 0; sort && i < N; ++i) {
+                float k = (key == STORE_KEY_L) ? s.L[i] : (key == STORE_KEY_C) ? s.C[i] : (key == STORE_KEY_H) ? s.h[i] : (float)s.rgb[i];
+                float p = (i == 0) ? k : (key == STORE_KEY_L) ? s.L[i - 1] : (key == STORE_KEY_C) ? s.C[i - 1] : (key == STORE_KEY_H) ? s.h[i - 1] : (float)s.rgb[i - 1];
+                sort = desc ? k <= p : k >= p;
+
+                size_t j = 0;
+                while (j < N && !(load_rgb[j] == s.rgb[i] && load_alpha[j] == s.alpha[i])) ++j;
+                sort = sort && j < N;
+                if (sort && s.rgb[i] == 0xff0000) { sort = (red == -1) == (s.alpha[i] == 255); red = (long)i; }
+
+                rgb_t rgb = hex_to_rgb(s.rgb[i]);
+                if (sort && s.L) sort = fabs(s.L[i] - rgb_to_oklab(&rgb).L) < 1e-4;
+            }
+            for (size_t i = 0; sort && key == STORE_KEY_HEX && !desc && i < N; ++i) sort = s.rgb[i] == hex_asc[i];
+            for (size_t i = 0; sort && key == STORE_KEY_L && desc && i < N; ++i)   sort = s.rgb[i] == L_desc[i];
+        }
+    }
+    store_free(&s);
+
+    rewind(f);
+    bool dedupe = store_load(&s, f, NULL) == N && store_dedupe(&s) && s.size == ARRAY_LENGTH(uniq);
+    for (size_t i = 0; dedupe && i < s.size; ++i) dedupe = s.rgb[i] == uniq[i] && s.alpha[i] == uniq_alpha[i];
+    store_free(&s);
+    fclose(f);
+    fclose(bad);
+
+    bool pass = load && sort && dedupe;
+    return report_check("store-load-sort-dedupe", "6 colors, 4 keys x 2", "load, sort, dedupe ok", pass, "load %s, sort %s, dedupe %s", load ? "ok" : "wrong", sort ? "ok" : "wrong", dedupe ? "ok" : "wrong");
+}
+
+// dispatched kernels (see kernels.h)
+enum { ISA_KERNELS = 25 };
+
+// 64-bit fnv-1a over len bytes, continuing from h (FNV_OFFSET to start)
+#define FNV_OFFSET 14695981039346656037ull
+
+static uint64_t fnv1a64(uint64_t h, const void *p, size_t len) {
+    const uint8_t *b = p;
+    for (size_t i = 0; i < len; ++i) h = (h ^ b[i]) * 1099511628211ull;
+    return h;
+}
+
+// every dispatched kernel on fixed pseudo-random data at the active isa level, one hash of its outputs per kernel
+static void isa_kernel_hashes(uint64_t hash[ISA_KERNELS]) {
+    enum { N = 4099, K = 37, W = 64 };
+    static const cdiff_t metrics[] = { CDIFF_DE76, CDIFF_DE94, CDIFF_DE2000, CDIFF_CMC };
+    static const float   mat[9]    = { 1.2f, -0.15f, -0.05f, -0.1f, 1.15f, -0.05f, 0.02f, -0.12f, 1.1f };
+    static uint32_t rgb[N], bg[N], out[N];
+    static int32_t  ix[N], iy[N], iz[N], ires[2 * K];
+    static float    x[N], y[N], z[N], L[N], a[N], b[N], f0[N], f1[N], f2[N], fres[2 * K], block[K * N], dec[1024];
+    static uint16_t u16[3 * N], h[N], sat[N], l[N], k[N], idx[N];
+    static uint8_t  u8[N], alpha[N], oog[N];
+
+    uint32_t seed = fill_random_rgb(4242, rgb, N);
+    seed = fill_random_rgb(seed, bg, N);
+    seed = fill_random_f32(seed, x, N);
+    seed = fill_random_f32(seed, y, N);
+    seed = fill_random_f32(seed, z, N);
+    for (size_t i = 0; i < N; ++i) {
+        ix[i] = (rgb[i] >> 16) & 0xFF; iy[i] = (rgb[i] >> 8) & 0xFF; iz[i] = rgb[i] & 0xFF;
+        L[i]  = 100.0f * x[i]; a[i] = 200.0f * y[i] - 100.0f; b[i] = 200.0f * z[i] - 100.0f;
+        alpha[i] = (uint8_t)(lcg_next(&seed) >> 16);
+        u16[3 * i] = (uint16_t)(lcg_next(&seed) & 1023); u16[3 * i + 1] = (uint16_t)(lcg_next(&seed) & 1023); u16[3 * i + 2] = (uint16_t)(lcg_next(&seed) & 1023);
+    }
+    for (size_t i = 0; i < 1024; ++i) dec[i] = powf(i / 1023.0f, 2.2f);
+
+    int e = 0;
+    for (size_t q = 0; q < K; ++q) ires[2 * q] = (int32_t)nearest3_i32(ix, iy, iz, N, ix[q + 1], iz[q], iy[q], 2, 4, 3, &ires[2 * q + 1]);
+    hash[e++] = fnv1a64(FNV_OFFSET, ires, sizeof(ires));
+    for (size_t q = 0; q < K; ++q) fres[2 * q] = (float)nearest3_f32(x, y, z, N, y[q], z[q], x[q], &fres[2 * q + 1]);
+    hash[e++] = fnv1a64(FNV_OFFSET, fres, sizeof(fres));
+    dist2_3_f32(x, y, z, N, 0.3f, 0.6f, 0.1f, f0);
+    hash[e++] = fnv1a64(FNV_OFFSET, f0, sizeof(f0));
+    assign3_f32(x, y, z, N, z, x, y, K, idx, f0);
+    hash[e++] = fnv1a64(fnv1a64(FNV_OFFSET, idx, sizeof(idx)), f0, sizeof(f0));
+    wdist2_block_f32(x, y, z, K, z, y, x, N, 1.0f, 2.0f, 0.5f, block, N);
+    hash[e++] = fnv1a64(FNV_OFFSET, block, sizeof(block));
+
+    rgb8_to_oklab_f32(rgb, N, f0, f1, f2);
+    hash[e++] = fnv1a64(fnv1a64(fnv1a64(FNV_OFFSET, f0, sizeof(f0)), f1, sizeof(f1)), f2, sizeof(f2));
+    for (size_t i = 0; i < N; ++i) { f1[i] = y[i] - 0.5f; f2[i] = z[i] - 0.5f; }
+    oklab_to_oklch_f32(f1, f2, N, f0, x);
+    hash[e++] = fnv1a64(fnv1a64(FNV_OFFSET, f0, sizeof(f0)), x, sizeof(x));
+    rgb8_to_lab_f32(rgb, N, f0, f1, f2);
+    hash[e++] = fnv1a64(fnv1a64(fnv1a64(FNV_OFFSET, f0, sizeof(f0)), f1, sizeof(f1)), f2, sizeof(f2));
+
+    hash[e] = hash[e + 1] = FNV_OFFSET;
+    for (size_t m = 0; m < ARRAY_LENGTH(metrics); ++m) {
+        delta_e_f32(metrics[m], L, a, b, N, L[m], a[m + 1], b[m + 2], f0);
+        hash[e] = fnv1a64(hash[e], f0, sizeof(f0));
+        for (size_t q = 0; q < K; ++q) fres[2 * q] = (float)nearest_delta_e_f32(metrics[m], L, a, b, N, L[q], b[q], a[q], &fres[2 * q + 1]);
+        hash[e + 1] = fnv1a64(hash[e + 1], fres, sizeof(fres));
+    }
+    e += 2;
+
+    rgb8_to_ansi256_idx(rgb, N, u8);
+    hash[e++] = fnv1a64(FNV_OFFSET, u8, sizeof(u8));
+    rgb8_mat3_linear(mat, rgb, N, out);
+    hash[e++] = fnv1a64(FNV_OFFSET, out, sizeof(out));
+    size_t noog = rgb8_mat3_gamut(dec, mat, rgb, N, out, oog);
+    hash[e++] = fnv1a64(fnv1a64(fnv1a64(FNV_OFFSET, out, sizeof(out)), oog, sizeof(oog)), &noog, sizeof(noog));
+    noog = rgb16_mat3_gamut(dec, mat, u16, N, out, oog);
+    hash[e++] = fnv1a64(fnv1a64(fnv1a64(FNV_OFFSET, out, sizeof(out)), oog, sizeof(oog)), &noog, sizeof(noog));
+
+    cube_t  c = { .size = 5, .dmin = { 0.0f, 0.0f, 0.0f }, .dmax = { 1.0f, 1.0f, 1.0f }, .data = block };
+    lut3d_t lut;
+    fill_random_f32(seed, block, 3 * 5 * 5 * 5);
+    cube_prepare(&c, &lut);
+    hash[e] = FNV_OFFSET;
+    for (int t = 0; t < 2; ++t) { rgb8_lut3d(&lut, t, rgb, N, out); hash[e] = fnv1a64(hash[e], out, sizeof(out)); }
+    ++e;
+
+    yuv_coef_t yc;
+    set_ycbcr(YCBCR_BT709, false);
+    yuv_coefficients(&yc);
+    rgb8_to_y8(&yc, rgb, N, u8);
+    hash[e++] = fnv1a64(FNV_OFFSET, u8, sizeof(u8));
+    uint8_t cb[W], cr[W];
+    rgb8_to_cbcr420(&yc, rgb, rgb + W, W, cb, cr, 1);
+    hash[e++] = fnv1a64(fnv1a64(FNV_OFFSET, cb, W / 2), cr, W / 2);
+    yuv420_to_rgb8(&yc, u8, u8 + W, u8 + 2 * W, 1, W, out);
+    hash[e++] = fnv1a64(FNV_OFFSET, out, W * sizeof(uint32_t));
+
+    hash[e] = FNV_OFFSET;
+    for (int lin = 0; lin < 2; ++lin) { rgba8_over_rgb8(rgb, alpha, bg, 1, N, lin, out); hash[e] = fnv1a64(hash[e], out, sizeof(out)); }
+    ++e;
+
+    rgb8_to_hsl16(rgb, N, h, sat, l);
+    hash[e++] = fnv1a64(fnv1a64(fnv1a64(FNV_OFFSET, h, sizeof(h)), sat, sizeof(sat)), l, sizeof(l));
+    rgb8_to_hsv16(rgb, N, h, sat, l);
+    hash[e++] = fnv1a64(fnv1a64(fnv1a64(FNV_OFFSET, h, sizeof(h)), sat, sizeof(sat)), l, sizeof(l));
+    rgb8_to_cmyk16(rgb, N, h, sat, l, k);
+    hash[e++] = fnv1a64(fnv1a64(fnv1a64(fnv1a64(FNV_OFFSET, h, sizeof(h)), sat, sizeof(sat)), l, sizeof(l)), k, sizeof(k));
+
+    // fixed-point inputs straight from the generator, not only the ones rgb maps to
+    for (size_t i = 0; i < N; ++i) { h[i] = (uint16_t)(lcg_next(&seed) >> 8); sat[i] = (uint16_t)(lcg_next(&seed) >> 8); l[i] = (uint16_t)(lcg_next(&seed) >> 8); k[i] = (uint16_t)(lcg_next(&seed) >> 8); }
+    hsl16_to_rgb8(h, sat, l, N, out);
+    hash[e++] = fnv1a64(FNV_OFFSET, out, sizeof(out));
+    hsv16_to_rgb8(h, sat, l, N, out);
+    hash[e++] = fnv1a64(FNV_OFFSET, out, sizeof(out));
+    cmyk16_to_rgb8(h, sat, l, k, N, out);
+    hash[e++] = fnv1a64(FNV_OFFSET, out, sizeof(out));
+}
+
+// every isa level the cpu supports (forced like COLOR_CPU_LEVEL does) must give the outputs of the baseline level
+// bit for bit, the kernels are built without fp contraction
+static bool run_isa_check() {
+    uint64_t    base[ISA_KERNELS], cur[ISA_KERNELS];
+    isa_level_t active = kernels_isa();
+    char        levels[STR_BUFSIZE] = "";
+    int         differ = 0;
+
+    kernels_force_isa(ISA_BASE);
+    isa_kernel_hashes(base);
+    for (isa_level_t isa = ISA_BASE; isa <= ISA_V3 && kernels_force_isa(isa); ++isa) {
+        isa_kernel_hashes(cur);
+        for (size_t i = 0; i < ISA_KERNELS; ++i) differ += cur[i] != base[i];
+        snprintf(levels + strlen(levels), sizeof(levels) - strlen(levels), "%s%s", *levels ? ", " : "", isa_level_name(isa));
+    }
+    kernels_force_isa(active);
+
+    return report_check("isa-levels", levels, "0 kernels differ", differ == 0, "%d kernels differ", differ);
+}
+
+// format the oklab / oklch strings of a color converted from rgb and of its oklch converted back, using the current precision
+static void fmt_oklch_paths(const rgb_t *rgb, int dplaces, bool webfmt, char *buf, size_t bufsz) {
+    color_t c = { 0 };
+    c.rgb   = *rgb;
+    c.oklch = rgb_to_oklch(rgb);
+    c.oklab = oklch_to_oklab(&c.oklch);
+
+    char  oklab[C_COL_BUFSIZE], oklch[C_COL_BUFSIZE];
+    rgb_t back = oklch_to_rgb(&c.oklch);
+    fmt_color_strings(&c, webfmt, dplaces, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, oklab, sizeof(oklab), oklch, sizeof(oklch), NULL, 0);
+    snprintf(buf, bufsz, "%s %s %d,%d,%d", oklab, oklch, back.r, back.g, back.b);
+}
+
+// the fast precision tier must print exactly what the exact tier prints, at every dplaces setting
+// checks all grays (hue from rounding noise, most sensitive) and a strided subset of the rgb cube
+static bool run_precision_check() {
+    long checked = 0, mismatches = 0;
+    char exact[STR_BUFSIZE * 2], fast[STR_BUFSIZE * 2];
+
+    for (hex_t v = 0; v < (1u << 24); v = (v < 0x100) ? v + 1 : v + 251) {
+        // first 256 values are mapped to grays
+        rgb_t rgb = (v < 0x100) ? (rgb_t){ v, v, v } : (rgb_t){ (v >> 16) & 0xFF, (v >> 8) & 0xFF, v & 0xFF };
+
+        for (int dp = 0; dp <= 5; ++dp, ++checked) {
+            set_precision(PRECISION_EXACT); fmt_oklch_paths(&rgb, dp, dp & 1, exact, sizeof(exact));
+            set_precision(PRECISION_FAST);  fmt_oklch_paths(&rgb, dp, dp & 1, fast,  sizeof(fast));
+            if (strcmp(exact, fast) != 0) ++mismatches;
+        }
+    }
+    set_precision(PRECISION_EXACT);
+
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%ld outputs, -f 0..5", checked);
+    return report_check("precision-fast-exact", input, "0 mismatches", mismatches == 0, "%ld mismatches", mismatches);
+}
+
+// the float32 bulk api must agree with the double api to float precision and round-trip every 8-bit color
+static bool run_f32_check() {
+    enum { N = 4096 };
+    static uint32_t rgb[N], back[N];
+    static float    x[N], y[N], z[N], w[N];
+
+    long   checked = 0, roundtrip = 0;
+    double maxerr  = 0.0;
+
+    for (uint32_t base = 0; base < (1u << 24); base += N) {
+        for (uint32_t i = 0; i < N; ++i) rgb[i] = base + i;
+
+        rgb8_to_hsl_f32(rgb, N, x, y, z);
+        for (uint32_t i = 0; i < N; ++i) {
+            rgb_t  c  = hex_to_rgb(rgb[i]);
+            hsl_t  h  = rgb_to_hsl(&c);
+            double dh = fabs(h.h - x[i]) / 360.0; // relative to the hue range
+            maxerr = fmax(maxerr, fmax(fmin(dh, 1.0 - dh), fmax(fabs(h.sat - y[i]), fabs(h.l - z[i]))));
+        }
+        hsl_to_rgb8_f32(x, y, z, N, back);
+        for (uint32_t i = 0; i < N; ++i) roundtrip += back[i] != rgb[i];
+
+        rgb8_to_cmyk_f32(rgb, N, x, y, z, w);
+        cmyk_to_rgb8_f32(x, y, z, w, N, back);
+        for (uint32_t i = 0; i < N; ++i) roundtrip += back[i] != rgb[i];
+
+        rgb8_to_oklab_f32(rgb, N, x, y, z);
+        for (uint32_t i = 0; i < N; ++i) {
+            rgb_t   c = hex_to_rgb(rgb[i]);
+            oklab_t o = rgb_to_oklab(&c);
+            maxerr = fmax(maxerr, fmax(fabs(o.L - x[i]), fmax(fabs(o.a - y[i]), fabs(o.b - z[i]))));
+        }
+        oklab_to_rgb8_f32(x, y, z, N, GAMUT_CLIP, back);
+        for (uint32_t i = 0; i < N; ++i) roundtrip += back[i] != rgb[i];
+
+        checked += N;
+    }
+
+    bool pass = maxerr < 1e-5 && roundtrip == 0;
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%ld colors", checked);
+    return report_check("f32-vs-f64", input, "err < 1e-5, 0 round-trip", pass, "err %.1e, %ld round-trip", maxerr, roundtrip);
+}
+
+// fixed-point kernels over the whole rgb cube: every result within half a step of the double value, and exact round trips
+static bool run_fixed16_check() {
+    enum { N = 4096 };
+    static uint32_t rgb[N], back[N];
+    static uint16_t x[N], y[N], z[N], w[N];
+
+    long   checked = 0, roundtrip = 0;
+    double maxerr  = 0.0; // in fixed-point steps
+
+    for (uint32_t base = 0; base < (1u << 24); base += N) {
+        for (uint32_t i = 0; i < N; ++i) rgb[i] = base + i;
+
+        rgb8_to_hsl16(rgb, N, x, y, z);
+        for (uint32_t i = 0; i < N; ++i) {
+            rgb_t  c  = hex_to_rgb(rgb[i]);
+            hsl_t  h  = rgb_to_hsl(&c);
+            double dh = fabs(h.h * FIX_TURN / 360.0 - x[i]);
+            maxerr = fmax(maxerr, fmax(fmin(dh, FIX_TURN - dh), fmax(fabs(h.sat * FIX_ONE - y[i]), fabs(h.l * FIX_ONE - z[i]))));
+        }
+        hsl16_to_rgb8(x, y, z, N, back);
+        for (uint32_t i = 0; i < N; ++i) roundtrip += back[i] != rgb[i];
+
+        rgb8_to_hsv16(rgb, N, x, y, z);
+        for (uint32_t i = 0; i < N; ++i) {
+            rgb_t  c  = hex_to_rgb(rgb[i]);
+            hsv_t  h  = rgb_to_hsv(&c);
+            double dh = fabs(h.h * FIX_TURN / 360.0 - x[i]);
+            maxerr = fmax(maxerr, fmax(fmin(dh, FIX_TURN - dh), fmax(fabs(h.sat * FIX_ONE - y[i]), fabs(h.v * FIX_ONE - z[i]))));
+        }
+        hsv16_to_rgb8(x, y, z, N, back);
+        for (uint32_t i = 0; i < N; ++i) roundtrip += back[i] != rgb[i];
+
+        rgb8_to_cmyk16(rgb, N, x, y, z, w);
+        for (uint32_t i = 0; i < N; ++i) {
+            rgb_t  c = hex_to_rgb(rgb[i]);
+            cmyk_t k = rgb_to_cmyk(&c);
+            maxerr = fmax(maxerr, fmax(fmax(fabs(k.c * FIX_ONE - x[i]), fabs(k.m * FIX_ONE - y[i])),
+                                       fmax(fabs(k.y * FIX_ONE - z[i]), fabs(k.k * FIX_ONE - w[i]))));
+        }
+        cmyk16_to_rgb8(x, y, z, w, N, back);
+        for (uint32_t i = 0; i < N; ++i) roundtrip += back[i] != rgb[i];
+
+        checked += N;
+    }
+
+    // exact ties may land on either side of .5 in double
+    bool pass = maxerr <= 0.5 + 1e-6 && roundtrip == 0;
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%ld colors", checked);
+    return report_check("fixed16-vs-f64", input, "err <= 0.5, 0 round-trip", pass, "err %.3f, %ld round-trip", maxerr, roundtrip);
+}
+
+// in-gamut colors must not be counted as out of gamut, and gamut mapped colors must stay within the jnd (plus one 8-bit step)
+// of the chroma-reduced original (same lightness and hue), with the float32 batch path giving the same rgb
+static bool run_gamut_check() {
+    enum { N = 19 * 8 * 36 };
+    static float    L[N], a[N], b[N];
+    static uint32_t ref[N], batch[N];
+
+    // 8-bit round trips
+    gamut_count_reset();
+    for (hex_t v = 0; v < (1u << 24); v += 997) {
+        rgb_t   rgb = hex_to_rgb(v);
+        oklch_t ch  = rgb_to_oklch(&rgb);
+        oklch_to_rgb(&ch);
+    }
+    unsigned long false_out = gamut_count();
+
+    // oklch grid, mostly out of gamut
+    set_gamut(GAMUT_MAP);
+    gamut_count_reset();
+    size_t n       = 0;
+    double maxdist = 0.0;
+    for (int li = 1; li < 20; ++li) for (int ci = 1; ci <= 8; ++ci) for (int hi = 0; hi < 36; ++hi, ++n) {
+        oklch_t ch  = { li * 0.05, ci * 0.05, hi * 10.0 };
+        oklab_t lab = oklch_to_oklab(&ch);
+        rgb_t   rgb = oklab_to_rgb(&lab);
+        oklab_t got = rgb_to_oklab(&rgb);
+
+        // distance to the segment from (L,0,0) to the original color
+        double ua = lab.a / ch.c, ub = lab.b / ch.c;
+        double along = got.a * ua + got.b * ub, across = got.a * ub - got.b * ua;
+        double d     = sqrt((got.L - lab.L) * (got.L - lab.L) + across * across + (along > ch.c ? (along - ch.c) * (along - ch.c) : 0.0));
+        maxdist = fmax(maxdist, d);
+
+        L[n] = (float)lab.L; a[n] = (float)lab.a; b[n] = (float)lab.b; ref[n] = rgb_to_hex(&rgb);
+    }
+    unsigned long out = gamut_count();
+    size_t batch_out  = oklab_to_rgb8_f32(L, a, b, N, GAMUT_MAP, batch);
+    set_gamut(GAMUT_CLIP);
+    gamut_count_reset();
+
+    int maxch = 0;
+    for (size_t i = 0; i < N; ++i) for (int sh = 0; sh < 24; sh += 8) maxch = MAX(maxch, abs((int)((ref[i] >> sh) & 0xFF) - (int)((batch[i] >> sh) & 0xFF)));
+
+    bool pass = false_out == 0 && out > 0 && batch_out == out && maxdist < 0.025 && maxch <= 1;
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%d oklch, %lu out", N, out);
+    return report_check("gamut-map", input, "0 in-gamut, dE < 0.025, f32 <= 1", pass, "%lu in-gamut, dE %.4f, f32 %d", false_out, maxdist, maxch);
+}
+
+// the bulk gradient must hit its stops exactly and agree with a double oklch interpolation through oklab_to_rgb
+static bool run_gradient_check() {
+    enum { N = 4097 };
+    static uint32_t rgb[N];
+
+    const char *names[3] = { "red", "lime", "blue" };
+    color_t     stops[3];
+    for (int i = 0; i < 3; ++i) parse_color(names[i], &stops[i]);
+
+    long out  = gradient_fill(stops, 3, N, GRAD_OKLCH, HUE_SHORTER, GAMUT_MAP, rgb);
+    bool hits = rgb[0] == 0xff0000 && rgb[N / 2] == 0x00ff00 && rgb[N - 1] == 0x0000ff;
+
+    set_gamut(GAMUT_MAP);
+    int maxch = 0;
+    for (size_t i = 0; i < N; ++i) {
+        const color_t *c0 = &stops[i < N / 2 ? 0 : 1], *c1 = &stops[i < N / 2 ? 1 : 2];
+        double u  = (i < N / 2) ? i / (double)(N / 2) : (i - N / 2) / (double)(N / 2);
+        double h0 = c0->oklch.h, h1 = c1->oklch.h;
+        if      (h1 - h0 > 180.0)  h0 += 360.0;
+        else if (h1 - h0 < -180.0) h1 += 360.0;
+
+        oklch_t ch  = { (1 - u) * c0->oklch.L + u * c1->oklch.L, (1 - u) * c0->oklch.c + u * c1->oklch.c, (1 - u) * h0 + u * h1 };
+        rgb_t   ref = oklch_to_rgb(&ch);
+        maxch = MAX(maxch, MAX(abs(ref.r - (int)((rgb[i] >> 16) & 0xFF)), MAX(abs(ref.g - (int)((rgb[i] >> 8) & 0xFF)), abs(ref.b - (int)(rgb[i] & 0xFF)))));
+    }
+    set_gamut(GAMUT_CLIP);
+    gamut_count_reset();
+
+    bool pass = out >= 0 && hits && maxch <= 1;
+    return report_check("gradient-oklch", "red lime blue, 4097", "stops exact, max diff <= 1", pass, "stops %s, max diff %d", hits ? "exact" : "off", maxch);
+}
+
+// routes over the conversion graph must agree with the direct edges without 8-bit steps: oklch -> hsl (four edges)
+// and hsl -> hsv (one) against srgb -> hsl / hsv, for colors off the 8-bit grid
+static bool run_convgraph_check() {
+    enum { N = 1000 };
+    static float r[N], g[N], b[N], L[N], C[N], h[N], h1[N], s1[N], l1[N], hh[N], hs[N], hl[N], h2[N], s2[N], v2[N], h3[N], s3[N], v3[N];
+
+    fill_random_f32(fill_random_f32(fill_random_f32(4242, r, N), g, N), b, N);
+
+    cv_model_t path[CVM_COUNT];
+    bool routes = convert_route(CVM_OKLCH, CVM_HSL, path) == 4 && convert_route(CVM_HSL, CVM_HSV, path) == 1 && convert_route(CVM_LAB, CVM_SRGB, path) < 0;
+
+    const float *const srgb[] = { r, g, b };
+    convert_f32(CVM_SRGB,  CVM_OKLCH, srgb,                                 N, GAMUT_CLIP, (float *const[]){ L, C, h });
+    convert_f32(CVM_OKLCH, CVM_HSL,   (const float *const[]){ L, C, h },    N, GAMUT_CLIP, (float *const[]){ h1, s1, l1 });
+    convert_f32(CVM_SRGB,  CVM_HSL,   srgb,                                 N, GAMUT_CLIP, (float *const[]){ hh, hs, hl });
+    convert_f32(CVM_HSL,   CVM_HSV,   (const float *const[]){ hh, hs, hl }, N, GAMUT_CLIP, (float *const[]){ h2, s2, v2 });
+    convert_f32(CVM_SRGB,  CVM_HSV,   srgb,                                 N, GAMUT_CLIP, (float *const[]){ h3, s3, v3 });
+
+    // oklch -> hsl against srgb -> hsl, hsl -> hsv against srgb -> hsv, hues only count where they are well defined
+    double maxsl = 0.0, maxh = 0.0;
+    for (size_t i = 0; i < N; ++i) {
+        maxsl = MAX(maxsl, MAX(fabs(s1[i] - hs[i]), fabs(l1[i] - hl[i])));
+        maxsl = MAX(maxsl, MAX(fabs(s2[i] - s3[i]), fabs(v2[i] - v3[i])));
+        if (hs[i] > 0.05f) { double d = fabs(h1[i] - hh[i]); maxh = MAX(maxh, MIN(d, 360.0 - d)); }
+    }
+
+    bool pass = routes && maxsl < 1e-3 && maxh < 0.05;
+    return report_check("conversion-graph", "1000 srgb floats", "routes ok, < 1e-3, h < 0.05", pass, "routes %s, s/l/v %.1e, h %.1e", routes ? "ok" : "off", maxsl, maxh);
+}
+
+// wide gamut parsing and the bulk p3 -> srgb path against the per-color double conversion
+static bool run_colorspace_check() {
+    enum { N = 2000 };
+    static uint32_t in[N], clip[N], map[N];
+
+    color_t p3, lab;
+    bool parsed = parse_color("color(display-p3 1 0 0)", &p3) && parse_color("lab(54.29 80.8 69.89)", &lab);
+    lab_t l = xyz_to_lab_d50(&p3.xyz);
+    bool values = parsed && fabs(l.L - 56.21) < 0.01 && fabs(l.a - 94.46) < 0.01 && fabs(l.b - 98.89) < 0.01
+               && lab.rgb.r == 255 && lab.rgb.g == 0 && lab.rgb.b == 0;
+
+    xyz_t  w = { 0.3, 0.4, 0.5 }, d50 = xyz_d65_to_d50(&w), back = xyz_d50_to_d65(&d50);
+    double trip  = MAX(fabs(back.x - w.x), MAX(fabs(back.y - w.y), fabs(back.z - w.z)));
+
+    fill_random_rgb(777, in, N);
+    size_t oog = rgbspace_rgb8_to_srgb8(RGBSPACE_DISPLAY_P3, GAMUT_CLIP, in, N, clip);
+    rgbspace_rgb8_to_srgb8(RGBSPACE_DISPLAY_P3, GAMUT_MAP, in, N, map);
+
+    // clipped channels within one step of the double reference, mapped colors must stay close in oklab
+    int    maxdiff = 0;
+    double maxde   = 0.0;
+    for (size_t i = 0; i < N; ++i) {
+        double c[3] = { ((in[i] >> 16) & 0xFF) / 255.0, ((in[i] >> 8) & 0xFF) / 255.0, (in[i] & 0xFF) / 255.0 }, s[3];
+        xyz_t  x = rgbspace_to_xyz(RGBSPACE_DISPLAY_P3, c);
+        xyz_to_rgbspace(RGBSPACE_SRGB, &x, s);
+        for (int k = 0; k < 3; ++k) {
+            int ref = (int)round(CLAMP(s[k], 0.0, 1.0) * 255.0);
+            maxdiff = MAX(maxdiff, abs(ref - (int)((clip[i] >> (16 - 8 * k)) & 0xFF)));
+        }
+        rgb_t   m  = { (map[i] >> 16) & 0xFF, (map[i] >> 8) & 0xFF, map[i] & 0xFF };
+        oklab_t om = rgb_to_oklab(&m), ox = xyz_to_oklab(&x);
+        maxde = MAX(maxde, sqrt((om.L - ox.L) * (om.L - ox.L) + (om.a - ox.a) * (om.a - ox.a) + (om.b - ox.b) * (om.b - ox.b)));
+    }
+
+    bool pass = values && trip < 1e-9 && oog > 0 && maxdiff <= 1 && maxde < 0.15;
+    return report_check("wide-gamut", "p3 / lab, 2000 p3 colors", "ok, clip <= 1, map < 0.15", pass, "%s, %zu oog, clip %d, map %.3f", values ? "ok" : "off", oog, maxdiff, maxde);
+}
+
+// 4:2:0 frames through the integer kernels against the double ycbcr model, on an image of flat 2x2 blocks
+static bool run_yuv_check() {
+    enum { W = 37, H = 23, CW = (W + 1) / 2, CH = (H + 1) / 2 }; // odd sizes: the last block column / row is cut
+    static uint32_t rgb[W * H], back[W * H];
+    static uint8_t  i420[W * H + 2 * CW * CH], nv12[W * H + 2 * CW * CH];
+
+    uint32_t seed = 601;
+    for (size_t j = 0; j < CH; ++j) for (size_t i = 0; i < CW; ++i) {
+        uint32_t v = lcg_next(&seed);
+        for (size_t y = 2 * j; y < MIN(2 * j + 2, (size_t)H); ++y) for (size_t x = 2 * i; x < MIN(2 * i + 2, (size_t)W); ++x) rgb[y * W + x] = v;
+    }
+
+    yuv_coef_t c;
+    set_ycbcr(YCBCR_BT709, false);
+    yuv_coefficients(&c);
+    yuv_frame_encode(&c, YUV_I420, rgb, W, H, i420);
+    yuv_frame_encode(&c, YUV_NV12, rgb, W, H, nv12);
+    yuv_frame_decode(&c, YUV_I420, i420, W, H, back);
+
+    // codes within one step of the rounded double model, decoded colors within one step of its inverse
+    int  maxcode = 0, maxrgb = 0;
+    bool same    = memcmp(i420, nv12, W * H) == 0;
+    for (size_t y = 0; y < H; ++y) for (size_t x = 0; x < W; ++x) {
+        size_t  k  = (y / 2) * CW + x / 2;
+        rgb_t   in = hex_to_rgb(rgb[y * W + x]);
+        ycbcr_t e  = rgb_to_ycbcr(&in), got = { i420[y * W + x], i420[W * H + k], i420[W * H + CW * CH + k] };
+        maxcode = MAX(maxcode, (int)MAX(fabs(got.y - round(e.y)), MAX(fabs(got.cb - round(e.cb)), fabs(got.cr - round(e.cr)))));
+        same   &= nv12[W * H + 2 * k] == got.cb && nv12[W * H + 2 * k + 1] == got.cr;
+
+        rgb_t r = ycbcr_to_rgb(&got), b = hex_to_rgb(back[y * W + x]);
+        maxrgb = MAX(maxrgb, MAX(abs(r.r - b.r), MAX(abs(r.g - b.g), abs(r.b - b.b))));
+    }
+
+    rgb_t   white = { 255, 255, 255 };
+    ycbcr_t wy    = rgb_to_ycbcr(&white);
+    bool    pass  = same && maxcode <= 1 && maxrgb <= 1 && wy.y == 235.0 && wy.cb == 128.0;
+    return report_check("yuv420-frames", "37x23 bt.709 limited", "nv12 = i420, codes <= 1, rgb <= 1", pass, "%s, codes %d, rgb %d", same ? "nv12 = i420" : "nv12 differs", maxcode, maxrgb);
+}
+
+// alpha: css opacity syntaxes parse, the compositing kernel matches the double model in both spaces
+static bool run_composite_check() {
+    enum { N = 4099 };
+    static uint32_t rgb[N], bg[N], gamma[N], linear[N], soft[N];
+    static uint8_t  alpha[N];
+
+    uint32_t seed = fill_random_rgb(fill_random_rgb(2024, rgb, N), bg, N);
+    for (size_t i = 0; i < N; ++i) alpha[i] = (uint8_t)(lcg_next(&seed) >> 16);
+    rgba8_over_rgb8(rgb, alpha, bg, 1, N, false, gamma);
+    rgba8_over_rgb8(rgb, alpha, bg, 1, N, true, linear);
+    composite_rgb8(rgb, alpha, bg, 1, N, BLEND_SOFT_LIGHT, true, soft);
+
+    // gamma-space over is exact, linear light within one step (float tables), other modes go through composite_over
+    long gmiss = 0, smiss = 0;
+    int  maxlin = 0;
+    for (size_t i = 0; i < N; ++i) {
+        rgb_t s = hex_to_rgb(rgb[i]), d = hex_to_rgb(bg[i]);
+        rgb_t g = composite_over(&s, alpha[i] / 255.0, &d, BLEND_NORMAL, false);
+        rgb_t l = composite_over(&s, alpha[i] / 255.0, &d, BLEND_NORMAL, true), k = hex_to_rgb(linear[i]);
+        rgb_t f = composite_over(&s, alpha[i] / 255.0, &d, BLEND_SOFT_LIGHT, true);
+        gmiss  += rgb_to_hex(&g) != gamma[i];
+        smiss  += rgb_to_hex(&f) != soft[i];
+        maxlin  = MAX(maxlin, MAX(abs(l.r - k.r), MAX(abs(l.g - k.g), abs(l.b - k.b))));
+    }
+
+    // "#rrggbbaa", the css / syntax, the legacy 4 argument functions (clamped like css) and the aliases in either syntax,
+    // hex written back with its alpha digits
+    color_t c1, c2, c3, c4, c5, c6;
+    bool parsed = parse_color("#ff000080", &c1) && parse_color("rgb(255 0 0 / 50%)", &c2)
+               && parse_color("hsla(120, 100%, 50%, 0.25)", &c3) && parse_color("rgba(1, 2, 3, 2)", &c4)
+               && parse_color("rgba(255 0 0 / 50%)", &c5) && parse_color("hsla(120 100% 50% / 0.25)", &c6);
+    char hex[STR_BUFSIZE], webhex[STR_BUFSIZE];
+    if (parsed) {
+        fmt_color_strings(&c1, false, 2, NULL, 0, hex,    sizeof(hex),    NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0);
+        fmt_color_strings(&c1, true,  2, NULL, 0, webhex, sizeof(webhex), NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0, NULL, 0);
+    }
+    bool alphas = parsed && c1.hex == 0xff0000 && fabs(c1.alpha - 128.0 / 255.0) < EPS && c2.alpha == 0.5
+               && c3.hex == 0x00ff00 && c3.alpha == 0.25 && c4.alpha == 1.0 && !parse_color("#ff0000/x", &c4)
+               && c5.hex == 0xff0000 && c5.alpha == 0.5 && c6.hex == 0x00ff00 && c6.alpha == 0.25
+               && strcmp(hex, "ff000080") == 0 && strcmp(webhex, "#ff000080") == 0;
+
+    // half black over white, multiply of red over gray
+    rgb_t black = { 0, 0, 0 }, white = { 255, 255, 255 }, red = { 255, 0, 0 }, gray = { 128, 128, 128 };
+    rgb_t half  = composite_over(&black, 0.5, &white, BLEND_NORMAL, false);
+    rgb_t mul   = composite_over(&red, 1.0, &gray, BLEND_MULTIPLY, false);
+    bool  modes = half.r == 128 && mul.r == 128 && mul.g == 0 && mul.b == 0;
+
+    bool pass = gmiss == 0 && smiss == 0 && maxlin <= 1 && alphas && modes;
+    return report_check("composite-over", "4099 rgba over rgb", "miss 0 / 0, linear <= 1", pass, "miss %ld / %ld, linear %d, %s", gmiss, smiss, maxlin, alphas ? "alpha ok" : "alpha wrong");
+}
+
+// the assignment kernel must match a scalar search, and every extraction method must find three separated clusters
+// with their exact weights (a 2 : 1 : 1 split along lightness, so median cut cuts between them aswell)
+static bool run_palette_check() {
+    enum { N = 4099, K = 37, P = 300 };
+    static float    x[N], y[N], z[N], cx[K], cy[K], cz[K], L[P], a[P], b[P];
+    static uint16_t idx[N];
+    static double   w[P];
+
+    uint32_t seed = fill_random_f32(fill_random_f32(fill_random_f32(777, x, N), y, N), z, N);
+    seed = fill_random_f32(fill_random_f32(fill_random_f32(seed, cx, K), cy, K), cz, K);
+    assign3_f32(x, y, z, N, cx, cy, cz, K, idx, NULL);
+
+    long amiss = 0;
+    for (size_t i = 0; i < N; ++i) amiss += nearest3_f32(cx, cy, cz, K, x[i], y[i], z[i], NULL) != idx[i];
+
+    static const float center[3] = { 0.3f, 0.6f, 0.9f };
+    octree_t *t = octree_new();
+    for (size_t i = 0; i < P; ++i) {
+        float j = (lcg_next(&seed) % 1000) / 100000.0f - 0.005f;
+        L[i] = center[i / 100] + j; a[i] = j; b[i] = -j;
+        w[i] = (i < 100) ? 2.0 : 1.0;
+        for (int r = 0; t && r < (int)w[i]; ++r) octree_add(t, &L[i], &a[i], &b[i], 1);
+    }
+
+    // expected means per cluster (equal weights within each)
+    double mean[3][3] = { { 0.0 } };
+    for (size_t i = 0; i < P; ++i) { mean[i / 100][0] += L[i] / 100.0; mean[i / 100][1] += a[i] / 100.0; mean[i / 100][2] += b[i] / 100.0; }
+
+    int found = 0;
+    for (int method = 0; method < 3; ++method) {
+        float  pL[3], pa[3], pb[3];
+        double pw[3];
+        size_t m = (method == 0) ? palette_kmeans(L, a, b, w, P, 3, pL, pa, pb, pw)
+                 : (method == 1) ? palette_median_cut(L, a, b, w, P, 3, pL, pa, pb, pw)
+                 : t ? octree_palette(t, 3, pL, pa, pb, pw) : 0;
+
+        int ok = m == 3;
+        for (size_t c = 0; ok && c < 3; ++c) {
+            size_t  q = nearest3_f32(pL, pa, pb, 3, (float)mean[c][0], (float)mean[c][1], (float)mean[c][2], NULL);
+            double  d = fabs(pL[q] - mean[c][0]) + fabs(pa[q] - mean[c][1]) + fabs(pb[q] - mean[c][2]);
+            ok = d < 1e-4 && pw[q] == ((c == 0) ? 200.0 : 100.0);
+        }
+        found += ok;
+    }
+    octree_free(t);
+
+    bool pass = amiss == 0 && found == 3;
+    return report_check("palette-extract", "4099 x 37 assign, 3 clusters", "miss 0, 3 / 3 methods", pass, "miss %ld, %d / 3 methods", amiss, found);
+}
+
+// undithered snapping must pick the same colors as a full scan (through the candidate grid), error diffusion must keep
+// the mean of a flat image in linear light and give the same result in bands as in one piece, and the blue noise mask
+// must hold every threshold once
+static bool run_dither_check() {
+    enum { W = 61, H = 130, BAND = 64 };
+    static uint32_t px[W * BAND], flat[W * H], whole[W * H];
+    static float    L[W * BAND], a[W * BAND], b[W * BAND];
+
+    ditherer_t d;
+    long snapmiss = -1;
+    if (dither_init(&d, SNAP_ANSI256, DITHER_NONE, false, W, BAND)) {
+        fill_random_rgb(4242, px, W * BAND);
+        rgb8_to_oklab_f32(px, W * BAND, L, a, b);
+        dither_band(&d, px, W * BAND, NULL);
+
+        snapmiss = 0;
+        for (size_t i = 0; i < W * BAND; ++i) snapmiss += px[i] != d.hex[nearest3_f32(d.pal[0], d.pal[1], d.pal[2], d.n, L[i], a[i], b[i], NULL)];
+        dither_free(&d);
+    }
+
+    // #404040 to ansi16 in linear light, the whole image at once and in bands
+    double mean = -1.0;
+    long   bandmiss = -1;
+    if (dither_init(&d, SNAP_ANSI16, DITHER_FLOYD_STEINBERG, true, W, H)) {
+        for (size_t i = 0; i < W * H; ++i) whole[i] = flat[i] = 0x404040;
+        dither_band(&d, whole, W * H, NULL);
+        dither_free(&d);
+
+        const float *lin = srgb_to_linear_lut8();
+        mean = 0.0;
+        for (size_t i = 0; i < W * H; ++i) mean += (lin[whole[i] >> 16] + lin[(whole[i] >> 8) & 0xFF] + lin[whole[i] & 0xFF]) / (3.0 * W * H);
+
+        if (dither_init(&d, SNAP_ANSI16, DITHER_FLOYD_STEINBERG, true, W, BAND)) {
+            for (size_t y = 0; y < H; y += BAND) dither_band(&d, flat + y * W, MIN((size_t)BAND, H - y) * W, NULL);
+            dither_free(&d);
+            bandmiss = 0;
+            for (size_t i = 0; i < W * H; ++i) bandmiss += flat[i] != whole[i];
+        }
+    }
+
+    static bool  seen[BLUE_NOISE_SIZE * BLUE_NOISE_SIZE];
+    const float *mask  = blue_noise_mask();
+    size_t       ranks = 0, cells = BLUE_NOISE_SIZE * BLUE_NOISE_SIZE;
+    for (size_t i = 0; i < cells; ++i) {
+        long r = lround((mask[i] + 0.5) * cells - 0.5);
+        if (r >= 0 && r < (long)cells && !seen[r]) { seen[r] = true; ++ranks; }
+    }
+
+    double want = srgb_to_linear(0x40 / 255.0);
+    bool   pass = snapmiss == 0 && fabs(mean - want) < 0.002 && bandmiss == 0 && ranks == cells;
+    char   expected[STR_BUFSIZE];
+    snprintf(expected, sizeof(expected), "miss 0, %.4f, 0, %zu", want, cells);
+    return report_check("dither", "61x130 ansi16 / 256", expected, pass, "miss %ld, %.4f, %ld, %zu", snapmiss, mean, bandmiss, ranks);
+}
+
+// sixel and kitty output of a 48x25 test card (fed in uneven groups of rows) must match the golden files byte for byte
+static bool render_golden(render_t mode, const char *path) {
+    enum { W = 48, H = 25, SPLIT = 7 };
+    static uint32_t pal[16], px[W * H];
+    static uint16_t idx[W * H];
+
+    for (int i = 0; i < 16; ++i) { rgb_t c = ansi16_idx_to_rgb(i); pal[i] = rgb_to_hex(&c); }
+    for (size_t y = 0; y < H; ++y) {
+        for (size_t x = 0; x < W; ++x) {
+            idx[y * W + x] = (uint16_t)((x < 20) ? (x / 5 + y / 3) % 16 : 15 * (y % 2));
+            px[y * W + x]  = pal[idx[y * W + x]];
+        }
+    }
+
+    FILE      *f = tmpfile();
+    renderer_t r;
+    if (!f || !render_open(&r, f, mode, W, H, pal, 16)) { if (f) fclose(f); return false; }
+    render_rows(&r, px, idx, SPLIT * W);
+    render_rows(&r, px + SPLIT * W, idx + SPLIT * W, (H - SPLIT) * W);
+    render_close(&r);
+
+    FILE *g  = fopen(path, "rb");
+    bool  ok = g != NULL;
+    rewind(f);
+    for (int a, b; ok;) {
+        a  = fgetc(f);
+        b  = fgetc(g);
+        ok = a == b;
+        if (a == EOF) break;
+    }
+    fclose(f);
+    if (g) fclose(g);
+    return ok;
+}
+
+static bool run_render_check() {
+    bool sixel = render_golden(RENDER_SIXEL, GOLDEN_DIR "/render.sixel");
+    bool kitty = render_golden(RENDER_KITTY, GOLDEN_DIR "/render.kitty");
+
+    bool pass = sixel && kitty;
+    return report_check("render-golden", "48x25 ansi16 card", "sixel same, kitty same", pass, "sixel %s, kitty %s", sixel ? "same" : "differs", kitty ? "same" : "differs");
+}
+
+// tiled all-pairs distances must match the pairwise double functions used by -d, full and upper triangle alike
+static bool run_matrix_check() {
+    enum { N = 333 }; // not a multiple of any tile size
+    static float    x[N], y[N], z[N], L[N], a[N], b[N], cL[N], ca[N], cb[N], full[N * N], upper[N * N];
+    static uint32_t rgb[N];
+
+    fill_random_rgb(12345, rgb, N);
+    for (size_t i = 0; i < N; ++i) { x[i] = (rgb[i] >> 16) & 0xFF; y[i] = (rgb[i] >> 8) & 0xFF; z[i] = rgb[i] & 0xFF; }
+    rgb8_to_oklab_f32(rgb, N, L, a, b);
+    rgb8_to_lab_f32(rgb, N, cL, ca, cb);
+
+    // squared metrics are compared relative to max(d, 1), color differences (float kernels) absolutely
+    const cdiff_t metrics[] = { CDIFF_RGB, CDIFF_WRGB, CDIFF_OKLAB, CDIFF_DE2000, CDIFF_CMC };
+    double maxerr = 0.0, maxde = 0.0;
+    long   asym   = 0;
+    for (size_t m = 0; m < sizeof(metrics) / sizeof(metrics[0]); ++m) {
+        cdiff_t metric = metrics[m];
+        bool    de     = metric == CDIFF_DE2000 || metric == CDIFF_CMC;
+        const float *cx = de ? cL : metric == CDIFF_OKLAB ? L : x, *cy = de ? ca : metric == CDIFF_OKLAB ? a : y, *cz = de ? cb : metric == CDIFF_OKLAB ? b : z;
+
+        matrix_rows(metric, cx, cy, cz, N, 0, N, false, full);
+        matrix_rows(metric, cx, cy, cz, N, 0, N, true,  upper);
+        for (size_t i = 0; i < N; ++i) {
+            rgb_t   ci = hex_to_rgb(rgb[i]);
+            oklab_t oi = rgb_to_oklab(&ci);
+            lab_t   li = rgb_to_lab(&ci);
+            for (size_t j = 0; j < N; ++j) {
+                rgb_t   cj = hex_to_rgb(rgb[j]);
+                oklab_t oj = rgb_to_oklab(&cj);
+                lab_t   lj = rgb_to_lab(&cj);
+                double  ref;
+                switch (metric) {
+                    case CDIFF_RGB:   ref = dist2_rgb(&ci, &cj);                           break;
+                    case CDIFF_WRGB:  ref = weighted_dist2_rgb(&ci, &cj, W_R, W_G, W_B);   break;
+                    case CDIFF_OKLAB: ref = dist2_oklab(&oi, &oj);                         break;
+                    default:          ref = delta_e(metric, &li, &lj);                     break;
+                }
+
+                if (de) maxde  = fmax(maxde, fabs(full[i * N + j] - ref));
+                else    maxerr = fmax(maxerr, fabs(full[i * N + j] - ref) / fmax(ref, 1.0));
+                if (j > i && upper[i * N + j] != full[i * N + j])                    ++asym;
+                if (!de && full[i * N + j] != full[j * N + i])                       ++asym;
+            }
+        }
+    }
+
+    bool pass = maxerr < 1e-6 && maxde < 1e-3 && asym == 0;
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%d colors, %zu metrics", N, sizeof(metrics) / sizeof(metrics[0]));
+    return report_check("matrix-vs-pairwise", input, "err < 1e-6 / 1e-3, 0 mismatches", pass, "err %.1e / %.1e, %ld mismatches", maxerr, maxde, asym);
+}
+
+// -C on a hand-checked palette: wcag pairs once (i < j), apca in both polarities, levels per pair and partners per color
+static bool run_contrast_matrix_check() {
+    static const char *expected[] = {
+        "i,j,hex_i,hex_j,ratio,AA_large,AA,AAA\n"
+        "0,1,#000000,#ffffff,21.00,1,1,1\n"
+        "0,2,#000000,#777777,4.69,1,1,0\n"
+        "0,4,#000000,#ffff00,19.56,1,1,1\n"
+        "1,2,#ffffff,#777777,4.48,1,0,0\n"
+        "1,3,#ffffff,#0000ff,8.59,1,1,1\n"
+        "2,4,#777777,#ffff00,4.17,1,0,0\n"
+        "3,4,#0000ff,#ffff00,8.00,1,1,1\n"
+        "\n"
+        "index,hex,AA_large,AA,AAA\n"
+        "0,#000000,3,3,2\n"
+        "1,#ffffff,3,2,2\n"
+        "2,#777777,3,1,0\n"
+        "3,#0000ff,2,2,2\n"
+        "4,#ffff00,3,2,2\n",
+
+        "i,j,hex_i,hex_j,Lc,Lc60,Lc75,Lc90\n"
+        "0,1,#000000,#ffffff,106.04,1,1,1\n"
+        "1,0,#ffffff,#000000,-107.88,1,1,1\n"
+        "0,4,#000000,#ffff00,101.36,1,1,1\n"
+        "4,0,#ffff00,#000000,-102.71,1,1,1\n"
+        "1,2,#ffffff,#777777,-76.58,1,1,0\n"
+        "2,1,#777777,#ffffff,71.11,1,0,0\n"
+        "1,3,#ffffff,#0000ff,-90.65,1,1,1\n"
+        "3,1,#0000ff,#ffffff,85.82,1,1,0\n"
+        "2,4,#777777,#ffff00,66.43,1,0,0\n"
+        "4,2,#ffff00,#777777,-71.41,1,0,0\n"
+        "3,4,#0000ff,#ffff00,81.14,1,1,0\n"
+        "4,3,#ffff00,#0000ff,-85.48,1,1,0\n"
+        "\n"
+        "index,hex,Lc60,Lc75,Lc90\n"
+        "0,#000000,2,2,2\n"
+        "1,#ffffff,3,3,2\n"
+        "2,#777777,2,0,0\n"
+        "3,#0000ff,2,2,0\n"
+        "4,#ffff00,3,2,1\n",
+    };
+
+    char path[STR_BUFSIZE];
+    snprintf(path, sizeof(path), "%s/color_test_%ld.txt", P_tmpdir, (long)getpid());
+    FILE *in = fopen(path, "w");
+    if (in) { fputs("#000000\n#ffffff\n#777777\n#0000ff\n#ffff00\n", in); fclose(in); }
+
+    prog_opts_t opts = { 0 };
+    opts.cmatrix = path; opts.format = FORMAT_CSV; opts.dplaces = 2;
+
+    // stdout goes to a temporary file while -C runs
+    int  matched = 0;
+    for (int m = CONTRAST_WCAG; in && m <= CONTRAST_APCA; ++m) {
+        char  got[2048] = { 0 };
+        FILE *out = tmpfile();
+        int   fd  = dup(STDOUT_FILENO);
+        if (!out || fd < 0) { if (out) fclose(out); break; }
+
+        opts.cmetric = m;
+        fflush(stdout);
+        dup2(fileno(out), STDOUT_FILENO);
+        run_contrast_matrix(&opts, "color_test");
+        fflush(stdout);
+        dup2(fd, STDOUT_FILENO);
+        close(fd);
+
+        rewind(out);
+        size_t len = fread(got, 1, sizeof(got) - 1, out);
+        got[len] = '\0';
+        fclose(out);
+        matched += strcmp(got, expected[m - CONTRAST_WCAG]) == 0;
+    }
+    unlink(path);
+
+    return report_check("contrast-matrix", "5 colors, wcag + apca", "2 / 2 match", matched == 2, "%d / 2 match", matched);
+}
+
+// cvd simulation: float kernel (threaded chunks) against the double reference, every deficiency, full and partial severity
+// the 8-bit encoding table against rounding linear_to_srgb
+static bool run_cvd_check() {
+    enum { N = 1 << 16 };
+    static uint32_t in[N], out[N];
+    fill_random_rgb(12345, in, N);
+
+    static const cvd_t  types[]      = { CVD_PROTAN, CVD_DEUTAN, CVD_TRITAN };
+    static const double severities[] = { 1.0, 0.45 };
+    size_t mismatches = 0;
+    int    maxstep    = 0;
+    for (size_t t = 0; t < 3; ++t)
+        for (size_t s = 0; s < 2; ++s) {
+            cvd_rgb8(types[t], severities[s], in, N, out);
+            for (size_t i = 0; i < N; ++i) {
+                rgb_t c = hex_to_rgb(in[i]), ref = cvd_simulate(types[t], severities[s], &c), got = hex_to_rgb(out[i]);
+                int step = MAX(abs(ref.r - got.r), MAX(abs(ref.g - got.g), abs(ref.b - got.b)));
+                mismatches += step != 0;
+                maxstep     = MAX(maxstep, step);
+            }
+        }
+
+    const srgb8_enc_t *enc = linear_to_srgb8_lut();
+    size_t encbad = 0;
+    for (int i = 0; i <= 100000; ++i) {
+        float v = i / 100000.0f;
+        int   k = enc->lo[(int)(v * SRGB8_ENC_BUCKETS)];
+        k += v >= enc->mid[k];
+        encbad += k != (int)lround(linear_to_srgb(v) * 255.0);
+    }
+
+    bool pass = maxstep <= 1 && mismatches * 1000 < 6 * N && encbad == 0;
+    return report_check("cvd-kernel", "65536 colors x 3 x 2", "<= 1 step, 0 enc", pass, "%zu off by <= %d, %zu enc", mismatches, maxstep, encbad);
+}
+
+// 3d lut: .cube write / load round trip of a generated table, identity table exact with both interpolations,
+// a random table against a double trilinear / tetrahedral reference (6 explicit cases)
+static double cube_ref(const cube_t *c, bool tetra, int ch, const int v[3]) {
+    size_t n = c->size, i[3];
+    double f[3];
+    for (int k = 0; k < 3; ++k) {
+        double t = v[k] / 255.0 * (n - 1);
+        i[k] = MIN((size_t)t, n - 2);
+        f[k] = t - i[k];
+    }
+    #define NODE(_r, _g, _b) ((double)c->data[3 * (((i[2] + (_b)) * n + i[1] + (_g)) * n + i[0] + (_r)) + ch])
+    if (!tetra) {
+        double v0 = (NODE(0,0,0) * (1 - f[0]) + NODE(1,0,0) * f[0]) * (1 - f[1]) + (NODE(0,1,0) * (1 - f[0]) + NODE(1,1,0) * f[0]) * f[1];
+        double v1 = (NODE(0,0,1) * (1 - f[0]) + NODE(1,0,1) * f[0]) * (1 - f[1]) + (NODE(0,1,1) * (1 - f[0]) + NODE(1,1,1) * f[0]) * f[1];
+        return v0 * (1 - f[2]) + v1 * f[2];
+    }
+    double r = f[0], g = f[1], b = f[2], c0 = NODE(0,0,0), c3 = NODE(1,1,1);
+    if      (r >= g && g >= b) return c0 + r * (NODE(1,0,0) - c0) + g * (NODE(1,1,0) - NODE(1,0,0)) + b * (c3 - NODE(1,1,0));
+    else if (r >= b && b >= g) return c0 + r * (NODE(1,0,0) - c0) + b * (NODE(1,0,1) - NODE(1,0,0)) + g * (c3 - NODE(1,0,1));
+    else if (b >= r && r >= g) return c0 + b * (NODE(0,0,1) - c0) + r * (NODE(1,0,1) - NODE(0,0,1)) + g * (c3 - NODE(1,0,1));
+    else if (g >= r && r >= b) return c0 + g * (NODE(0,1,0) - c0) + r * (NODE(1,1,0) - NODE(0,1,0)) + b * (c3 - NODE(1,1,0));
+    else if (g >= b && b >= r) return c0 + g * (NODE(0,1,0) - c0) + b * (NODE(0,1,1) - NODE(0,1,0)) + r * (c3 - NODE(0,1,1));
+    else                       return c0 + b * (NODE(0,0,1) - c0) + g * (NODE(0,1,1) - NODE(0,0,1)) + r * (c3 - NODE(0,1,1));
+    #undef NODE
+}
+
+static bool run_cube_check() {
+    enum { N = 1 << 16 };
+    static uint32_t in[N], out[N];
+    uint32_t seed = fill_random_rgb(777, in, N);
+
+    prog_opts_t opts = { 0 };
+    opts.cvd = CVD_NONE; opts.gamut = GAMUT_CLIP; opts.snap = SNAP_NONE;
+
+    // identity (generated without transformations, written and read back)
+    cube_t  c, back;
+    lut3d_t lut;
+    size_t  bad_line = 0, errors = 0;
+    FILE   *f = tmpfile();
+    bool    ok = f && cube_generate(&opts, 17, &c);
+    if (ok) { cube_write(f, &c, "identity"); rewind(f); ok = cube_load(f, &back, &bad_line); cube_free(&c); }
+    if (f) fclose(f);
+    if (ok) {
+        cube_prepare(&back, &lut);
+        for (int t = 0; t < 2; ++t) {
+            cube_apply(&lut, t, in, N, out);
+            for (size_t i = 0; i < N; ++i) errors += out[i] != in[i];
+        }
+        cube_free(&back);
+    }
+
+    // random nodes against the reference
+    int maxstep = 0;
+    c.size = 9; c.data = malloc(3 * 9 * 9 * 9 * sizeof(float));
+    for (int k = 0; k < 3; ++k) { c.dmin[k] = 0.0f; c.dmax[k] = 1.0f; }
+    ok = ok && c.data;
+    if (ok) {
+        fill_random_f32(seed, c.data, 3 * 9 * 9 * 9);
+        cube_prepare(&c, &lut);
+        for (int t = 0; t < 2; ++t) {
+            cube_apply(&lut, t, in, N, out);
+            for (size_t i = 0; i < N; ++i) {
+                int v[3] = { (in[i] >> 16) & 0xFF, (in[i] >> 8) & 0xFF, in[i] & 0xFF };
+                for (int ch = 0; ch < 3; ++ch) {
+                    int ref = (int)round(cube_ref(&c, t, ch, v) * 255.0), got = (out[i] >> (16 - 8 * ch)) & 0xFF;
+                    maxstep = MAX(maxstep, abs(ref - got));
+                }
+            }
+        }
+    }
+    free(c.data);
+
+    bool pass = ok && errors == 0 && maxstep <= 1;
+    return report_check("cube-lut3d", "65536 colors, both interp", "ok, 0 identity, <= 1", pass, "%s, %zu identity, <= %d", ok ? "ok" : "failed", errors, maxstep);
+}
+
+// ciede2000 against the 34 pairs of Sharma, Wu and Dalal (2005), both orders, double and float kernel
+static bool run_ciede2000_check() {
+    static const double pairs[][7] = {
+        { 50.0000,   2.6772, -79.7751, 50.0000,   0.0000, -82.7485,  2.0425 },
+        { 50.0000,   3.1571, -77.2803, 50.0000,   0.0000, -82.7485,  2.8615 },
+        { 50.0000,   2.8361, -74.0200, 50.0000,   0.0000, -82.7485,  3.4412 },
+        { 50.0000,  -1.3802, -84.2814, 50.0000,   0.0000, -82.7485,  1.0000 },
+        { 50.0000,  -1.1848, -84.8006, 50.0000,   0.0000, -82.7485,  1.0000 },
+        { 50.0000,  -0.9009, -85.5211, 50.0000,   0.0000, -82.7485,  1.0000 },
+        { 50.0000,   0.0000,   0.0000, 50.0000,  -1.0000,   2.0000,  2.3669 },
+        { 50.0000,  -1.0000,   2.0000, 50.0000,   0.0000,   0.0000,  2.3669 },
+        { 50.0000,   2.4900,  -0.0010, 50.0000,  -2.4900,   0.0009,  7.1792 },
+        { 50.0000,   2.4900,  -0.0010, 50.0000,  -2.4900,   0.0010,  7.1792 },
+        { 50.0000,   2.4900,  -0.0010, 50.0000,  -2.4900,   0.0011,  7.2195 },
+        { 50.0000,   2.4900,  -0.0010, 50.0000,  -2.4900,   0.0012,  7.2195 },
+        { 50.0000,  -0.0010,   2.4900, 50.0000,   0.0009,  -2.4900,  4.8045 },
+        { 50.0000,  -0.0010,   2.4900, 50.0000,   0.0010,  -2.4900,  4.8045 },
+        { 50.0000,  -0.0010,   2.4900, 50.0000,   0.0011,  -2.4900,  4.7461 },
+        { 50.0000,   2.5000,   0.0000, 50.0000,   0.0000,  -2.5000,  4.3065 },
+        { 50.0000,   2.5000,   0.0000, 73.0000,  25.0000, -18.0000, 27.1492 },
+        { 50.0000,   2.5000,   0.0000, 61.0000,  -5.0000,  29.0000, 22.8977 },
+        { 50.0000,   2.5000,   0.0000, 56.0000, -27.0000,  -3.0000, 31.9030 },
+        { 50.0000,   2.5000,   0.0000, 58.0000,  24.0000,  15.0000, 19.4535 },
+        { 50.0000,   2.5000,   0.0000, 50.0000,   3.1736,   0.5854,  1.0000 },
+        { 50.0000,   2.5000,   0.0000, 50.0000,   3.2972,   0.0000,  1.0000 },
+        { 50.0000,   2.5000,   0.0000, 50.0000,   1.8634,   0.5757,  1.0000 },
+        { 50.0000,   2.5000,   0.0000, 50.0000,   3.2592,   0.3350,  1.0000 },
+        { 60.2574, -34.0099,  36.2677, 60.4626, -34.1751,  39.4387,  1.2644 },
+        { 63.0109, -31.0961,  -5.8663, 62.8187, -29.7946,  -4.0864,  1.2630 },
+        { 61.2901,   3.7196,  -5.3901, 61.4292,   2.2480,  -4.9620,  1.8731 },
+        { 35.0831, -44.1164,   3.7933, 35.0232, -40.0716,   1.5901,  1.8645 },
+        { 22.7233,  20.0904, -46.6940, 23.0331,  14.9730, -42.5619,  2.0373 },
+        { 36.4612,  47.8580,  18.3852, 36.2715,  50.5065,  21.2231,  1.4146 },
+        { 90.8027,  -2.0831,   1.4410, 91.1528,  -1.6435,   0.0447,  1.4441 },
+        { 90.9257,  -0.5406,  -0.9208, 88.6381,  -0.8985,  -0.7239,  1.5381 },
+        {  6.7747,  -0.2908,  -2.4247,  5.8714,  -0.0985,  -2.2286,  0.6377 },
+        {  2.0776,   0.0795,  -1.1350,  0.9033,  -0.0636,  -0.5514,  0.9082 },
+    };
+    size_t n = sizeof(pairs) / sizeof(pairs[0]);
+
+    double maxerr = 0.0, maxerr_f32 = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double *p = pairs[i];
+        lab_t a = { p[0], p[1], p[2] }, b = { p[3], p[4], p[5] };
+        maxerr = fmax(maxerr, fabs(delta_e(CDIFF_DE2000, &a, &b) - p[6]));
+        maxerr = fmax(maxerr, fabs(delta_e(CDIFF_DE2000, &b, &a) - p[6]));
+
+        float L = (float)p[3], A = (float)p[4], B = (float)p[5], d;
+        delta_e_f32(CDIFF_DE2000, &L, &A, &B, 1, (float)p[0], (float)p[1], (float)p[2], &d);
+        maxerr_f32 = fmax(maxerr_f32, fabs(d - p[6]));
+    }
+
+    // the table is rounded to 4 decimals
+    bool pass = maxerr <= 5e-5 && maxerr_f32 <= 5e-4;
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%zu pairs, both orders", n);
+    return report_check("ciede2000-sharma", input, "err <= 5e-5 / 5e-4 (f32)", pass, "err %.1e / %.1e", maxerr, maxerr_f32);
+}
+
+// cie76, cie94 and cmc (2:1) against values from the published formulas, both orders (cie94 and cmc weight by the chroma
+// and hue of the reference, the first color), double and float kernel
+static bool run_delta_e_check() {
+    // L1 a1 b1 L2 a2 b2, de76, de94 and cmc with the first / second color as the reference
+    static const double pairs[][11] = {
+        { 50.0000,   2.6772, -79.7751, 50.0000,   0.0000, -82.7485,  4.0011,  1.3950,  1.3653,  1.7387,  1.7014 },
+        { 50.0000,   2.5000,   0.0000, 73.0000,  25.0000, -18.0000, 36.8680, 34.6892, 26.1398, 37.9233, 16.8740 },
+        { 50.0000,   2.5000,   0.0000, 61.0000,  -5.0000,  29.0000, 31.9100, 29.4414, 18.3869, 38.4758, 17.5636 },
+        { 60.2574, -34.0099,  36.2677, 60.4626, -34.1751,  39.4387,  3.1819,  1.3910,  1.3576,  1.4205,  1.3934 },
+        { 22.7233,  20.0904, -46.6940, 23.0331,  14.9730, -42.5619,  6.5847,  2.5561,  2.7251,  3.0604,  3.2664 },
+        { 90.8027,  -2.0831,   1.4410, 91.1528,  -1.6435,   0.0447,  1.5051,  1.4195,  1.4478,  1.8891,  1.9994 },
+        {  6.7747,  -0.2908,  -2.4247,  5.8714,  -0.0985,  -2.2286,  0.9441,  0.9385,  0.9390,  0.9528,  0.9546 },
+        { 35.0831, -44.1164,   3.7933, 35.0232, -40.0716,   1.5901,  4.6063,  1.8205,  1.9216,  2.0250,  2.1197 },
+    };
+    static const cdiff_t metrics[] = { CDIFF_DE76, CDIFF_DE94, CDIFF_CMC };
+
+    double maxerr = 0.0, maxerr_f32 = 0.0;
+    for (size_t i = 0; i < ARRAY_LENGTH(pairs); ++i) {
+        const double *p = pairs[i];
+        for (size_t m = 0; m < ARRAY_LENGTH(metrics); ++m) {
+            for (int swap = 0; swap < 2; ++swap) {
+                const double *r = p + 3 * swap, *q = p + 3 * !swap;
+                double want = (m == 0) ? p[6] : p[7 + 2 * (m - 1) + swap];
+                lab_t  ref  = { r[0], r[1], r[2] }, sample = { q[0], q[1], q[2] };
+                maxerr = fmax(maxerr, fabs(delta_e(metrics[m], &ref, &sample) - want));
+
+                float L = (float)q[0], A = (float)q[1], B = (float)q[2], d;
+                delta_e_f32(metrics[m], &L, &A, &B, 1, (float)r[0], (float)r[1], (float)r[2], &d);
+                maxerr_f32 = fmax(maxerr_f32, fabs(d - want));
+            }
+        }
+    }
+
+    // the table is rounded to 4 decimals
+    bool pass = maxerr <= 5e-5 && maxerr_f32 <= 5e-4;
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%zu pairs x 3, both orders", ARRAY_LENGTH(pairs));
+    return report_check("delta-e-76-94-cmc", input, "err <= 5e-5 / 5e-4 (f32)", pass, "err %.1e / %.1e", maxerr, maxerr_f32);
+}
+
+// every fixed pair must reach the target (wcag ratio or apca |Lc|) with the contrast it reports or, where no lightness
+// of its hue does (*unmet, never for wcag 4.5), fall back to black or white, the batch must agree with single calls
+// and pairs already passing are kept; the fix is the perceptually nearest passing color, so a gray on
+// white only loses as much lightness as it has to (hand-checked: 0x767676 is the lightest gray with a ratio >= 4.5 on
+// white, 0x6e6e6e the lightest with Lc >= 75)
+static long fix_contrast_bad(contrast_metric_t metric, const uint32_t *fg, const uint32_t *bg, size_t n, double target, contrast_fix_t *res, long *kept, long *unmet) {
+    fix_contrast_batch(metric, fg, bg, n, target, GAMUT_MAP, res);
+
+    long bad = 0;
+    for (size_t i = 0; i < n; ++i) {
+        rgb_t f = hex_to_rgb(fg[i]), b = hex_to_rgb(bg[i]), r = hex_to_rgb(res[i].hex);
+        contrast_fix_t one = fix_contrast(metric, &f, &b, target, GAMUT_MAP);
+        double before = (metric == CONTRAST_APCA) ? fabs(apca_contrast(&f, &b)) : contrast_ratio(relative_luminance_rgb(&f), relative_luminance_rgb(&b));
+        double after  = (metric == CONTRAST_APCA) ? apca_contrast(&r, &b) : contrast_ratio(relative_luminance_rgb(&r), relative_luminance_rgb(&b));
+
+        if (before >= target) { *kept += res[i].hex == fg[i]; continue; }
+        *unmet += !res[i].met;
+        bad    += (res[i].met ? fabs(after) < target : res[i].hex != 0x000000 && res[i].hex != 0xffffff)
+               || fabs(after - res[i].contrast) > 1e-12 || one.hex != res[i].hex;
+    }
+    return bad;
+}
+
+static bool run_fix_contrast_check() {
+    enum { N = 4096 };
+    static uint32_t       fg[N], bg[N];
+    static contrast_fix_t res[N];
+
+    fill_random_rgb(fill_random_rgb(12345, fg, N), bg, N);
+    long kept = 0, unmet = 0, bad = fix_contrast_bad(CONTRAST_WCAG, fg, bg, N, 4.5, res, &kept, &unmet);
+    long apca_kept = 0, apca_unmet = 0, apca_bad = fix_contrast_bad(CONTRAST_APCA, fg, bg, N, 60.0, res, &apca_kept, &apca_unmet);
+    gamut_count_reset();
+
+    rgb_t gray = hex_to_rgb(0x777777), light = hex_to_rgb(0x888888), white = hex_to_rgb(0xffffff);
+    hex_t wcag = fix_contrast(CONTRAST_WCAG, &gray, &white, 4.5, GAMUT_MAP).hex;
+    hex_t apca = fix_contrast(CONTRAST_APCA, &light, &white, 75.0, GAMUT_MAP).hex;
+
+    bool pass = bad == 0 && unmet == 0 && apca_bad == 0 && kept > 0 && apca_kept > 0 && wcag == 0x767676 && apca == 0x6e6e6e;
+    char input[STR_BUFSIZE];
+    snprintf(input, sizeof(input), "%d pairs, 4.5 / Lc 60", N);
+    return report_check("fix-contrast", input, "0 / 0 bad, 767676 6e6e6e", pass, "%ld / %ld bad, %06x %06x", bad, apca_bad, wcag, apca);
+}
+
+// apca Lc against the reference values of apca-w3 0.0.98G-4g (text, background, Lc)
+static bool run_apca_check() {
+    static const struct { uint32_t txt, bg; double lc; } refs[] = {
+        { 0x888888, 0xffffff,  63.056469930209424 },
+        { 0xffffff, 0x888888, -68.54146436644962  },
+        { 0x000000, 0xaaaaaa,  58.146262578561334 },
+        { 0xaaaaaa, 0x000000, -56.24113336839742  },
+        { 0x112233, 0xddeeff,  91.66830811481631  },
+        { 0xddeeff, 0x112233, -93.06770049484275  },
+        { 0x112233, 0x444444,   8.32326136957393  },
+        { 0x444444, 0x112233,  -7.526878460278154 },
+    };
+
+    double maxerr = 0.0;
+    for (size_t i = 0; i < sizeof(refs) / sizeof(refs[0]); ++i) {
+        rgb_t t = hex_to_rgb(refs[i].txt), b = hex_to_rgb(refs[i].bg);
+        maxerr = MAX(maxerr, fabs(apca_contrast(&t, &b) - refs[i].lc));
+    }
+
+    bool pass = maxerr < 1e-9;
+    return report_check("apca-reference", "8 pairs, both polarities", "max err < 1e-9", pass, "max err %.1e", maxerr);
+}
+
+// hdr transfer functions at known points (hlg grays on a 1000 cd/m2 display per bt.2100 / bt.2408), the hlg ootf
+// both ways, and 10-bit pq / hlg frames through the code value table against the double path
+static bool run_hdr_check() {
+    enum { N = 4000, MAXV = 1023 };
+    static uint16_t in[3 * N];
+    static uint32_t out[N];
+
+    bool curves = fabs(nits_to_pq(203.0) - 0.58069) < 1e-4 && fabs(pq_to_nits(1.0) - 10000.0) < 1e-6
+               && fabs(pq_to_nits(nits_to_pq(100.0)) - 100.0) < 1e-9
+               && fabs(hlg_to_nits(1.0) - 1000.0) < 1e-3 && fabs(hlg_to_nits(0.75) - 203.0) < 0.5
+               && fabs(hlg_to_nits(0.5) - 51.0) < 0.5 && fabs(hlg_to_nits(0.3) - 15.0) < 0.5
+               && fabs(nits_to_hlg(hlg_to_nits(0.3)) - 0.3) < 1e-12;
+
+    // a saturated color keeps its chromaticity and is scaled by the luminance of the scene light
+    double sc[3] = { 0.5, 0.2, 0.1 }, ys = 0.2627 * 0.5 + 0.6780 * 0.2 + 0.0593 * 0.1, d[3] = { 0.5, 0.2, 0.1 };
+    hlg_ootf(d);
+    double gain = 1000.0 * pow(ys, 0.2), ootf = 0.0;
+    for (int k = 0; k < 3; ++k) ootf = MAX(ootf, fabs(d[k] - gain * sc[k]));
+    hlg_inverse_ootf(d);
+    for (int k = 0; k < 3; ++k) ootf = MAX(ootf, fabs(d[k] - sc[k]));
+    curves = curves && ootf < 1e-9;
+
+    int    maxdiff = 0;
+    size_t oog     = 0;
+    uint32_t seed = 2084;
+    for (size_t i = 0; i < 3 * N; ++i) in[i] = lcg_next(&seed) % (MAXV + 1);
+    for (int t = 0; t < 2; ++t) {
+        rgbspace_t space = t ? RGBSPACE_REC2100_HLG : RGBSPACE_REC2100_PQ;
+        oog += rgbspace_rgb16_to_srgb8(space, GAMUT_CLIP, MAXV, in, N, out);
+
+        for (size_t i = 0; i < N; ++i) {
+            double c[3] = { in[3 * i] / (double)MAXV, in[3 * i + 1] / (double)MAXV, in[3 * i + 2] / (double)MAXV }, s[3];
+            xyz_t  x    = rgbspace_to_xyz(space, c);
+            xyz_to_rgbspace(RGBSPACE_SRGB, &x, s);
+            for (int k = 0; k < 3; ++k) {
+                int ref = (int)round(CLAMP(s[k], 0.0, 1.0) * 255.0);
+                maxdiff = MAX(maxdiff, abs(ref - (int)((out[i] >> (16 - 8 * k)) & 0xFF)));
+            }
+        }
+    }
+
+    bool pass = curves && oog > 0 && maxdiff <= 1;
+    return report_check("hdr-pq-hlg", "curves, 4000 10-bit pq/hlg", "ok, clip <= 1", pass, "%s, %zu oog, clip %d", curves ? "ok" : "off", oog, maxdiff);
+}
+
 // run a test case
 static bool run_test_case(const test_case_t *t) {
     color_t out = { 0 };
@@ -203,6 +1507,33 @@ int main(void) {
     print_header();
     int total = 0, passed = 0;
     for (const test_case_t *t = tests; t->id != NULL; ++t, ++total) passed += run_test_case(t); // yes this is standard compliant
+
+    // additional checks
+    if (getenv("COLOR_TEST_LUT")) { passed += run_lut_check(); ++total; }
+    passed += run_named_check();         ++total;
+    passed += run_store_check();         ++total;
+    passed += run_isa_check();           ++total;
+    passed += run_precision_check();     ++total;
+    passed += run_f32_check();           ++total;
+    passed += run_fixed16_check();       ++total;
+    passed += run_gamut_check();         ++total;
+    passed += run_gradient_check();      ++total;
+    passed += run_matrix_check();        ++total;
+    passed += run_ciede2000_check();     ++total;
+    passed += run_delta_e_check();       ++total;
+    passed += run_fix_contrast_check();  ++total;
+    passed += run_contrast_matrix_check(); ++total;
+    passed += run_apca_check();          ++total;
+    passed += run_cvd_check();           ++total;
+    passed += run_cube_check();          ++total;
+    passed += run_convgraph_check();     ++total;
+    passed += run_colorspace_check();    ++total;
+    passed += run_hdr_check();           ++total;
+    passed += run_yuv_check();           ++total;
+    passed += run_composite_check();     ++total;
+    passed += run_palette_check();       ++total;
+    passed += run_dither_check();        ++total;
+    passed += run_render_check();        ++total;
     printf("\n%d / %d tests passed\n", passed, total);
     return !(passed == total);
 }